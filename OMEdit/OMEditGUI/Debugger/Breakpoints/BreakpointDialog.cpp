@@ -88,12 +88,22 @@ BreakpointDialog::BreakpointDialog(BreakpointTreeItem *pBreakpointTreeItem, Brea
   mpConditionLabel = new Label(tr("Condition:"));
   mpConditionTextBox = new QLineEdit;
   mpConditionHintLabel = new Label(tr("* Use \"%1\" to set condition on simulation time.").arg("data->localData[0]->timeValue"));
+  // create the log message and arguments labels and text boxes
+  mpLogMessageLabel = new Label(tr("Log Message:"));
+  mpLogMessageTextBox = new QLineEdit;
+  mpLogArgumentsLabel = new Label(tr("Log Arguments:"));
+  mpLogArgumentsTextBox = new QLineEdit;
+  mpLogMessageHintLabel = new Label(tr("* A breakpoint with a log message prints the message and continues without stopping.\n"
+                                       "  The message is a printf format, e.g., \"time = %g\" with the argument \"%1\".")
+                                    .arg("data->localData[0]->timeValue"));
   // if edit case then set the existing values
   if (mpBreakpointTreeItem) {
     mpLineNumberTextBox->setText(mpBreakpointTreeItem->getLineNumber());
     mpEnableCheckBox->setChecked(mpBreakpointTreeItem->isEnabled());
     mpIgnoreCountSpinBox->setValue(mpBreakpointTreeItem->getIgnoreCount());
     mpConditionTextBox->setText(mpBreakpointTreeItem->getCondition());
+    mpLogMessageTextBox->setText(mpBreakpointTreeItem->getLogMessage());
+    mpLogArgumentsTextBox->setText(mpBreakpointTreeItem->getLogArguments());
   } else {
     mpEnableCheckBox->setChecked(true);
   }
@@ -124,7 +134,12 @@ BreakpointDialog::BreakpointDialog(BreakpointTreeItem *pBreakpointTreeItem, Brea
   pMainLayout->addWidget(mpConditionLabel, 4, 0);
   pMainLayout->addWidget(mpConditionTextBox, 4, 1, 1, 3);
   pMainLayout->addWidget(mpConditionHintLabel, 5, 0, 1, 4);
-  pMainLayout->addWidget(mpButtonBox, 6, 0, 1, 4, Qt::AlignRight);
+  pMainLayout->addWidget(mpLogMessageLabel, 6, 0);
+  pMainLayout->addWidget(mpLogMessageTextBox, 6, 1, 1, 3);
+  pMainLayout->addWidget(mpLogArgumentsLabel, 7, 0);
+  pMainLayout->addWidget(mpLogArgumentsTextBox, 7, 1, 1, 3);
+  pMainLayout->addWidget(mpLogMessageHintLabel, 8, 0, 1, 4);
+  pMainLayout->addWidget(mpButtonBox, 9, 0, 1, 4, Qt::AlignRight);
   setLayout(pMainLayout);
 }
 
@@ -167,6 +182,8 @@ void BreakpointDialog::addOrEditBreakpoint()
       pBreakpointMarker->setEnabled(mpEnableCheckBox->isChecked());
       pBreakpointMarker->setIgnoreCount(mpIgnoreCountSpinBox->value());
       pBreakpointMarker->setCondition(mpConditionTextBox->text());
+      pBreakpointMarker->setLogMessage(mpLogMessageTextBox->text());
+      pBreakpointMarker->setLogArguments(mpLogArgumentsTextBox->text());
       mpBreakpointsTreeModel->insertBreakpoint(pBreakpointMarker, 0, mpBreakpointsTreeModel->getRootBreakpointTreeItem());
     } else {  /* Edit Case */
       /* find the BreakpointMarker and update its filepath and lineNumber. */
@@ -176,6 +193,8 @@ void BreakpointDialog::addOrEditBreakpoint()
       pBreakpointMarker->setEnabled(mpEnableCheckBox->isChecked());
       pBreakpointMarker->setIgnoreCount(mpIgnoreCountSpinBox->value());
       pBreakpointMarker->setCondition(mpConditionTextBox->text());
+      pBreakpointMarker->setLogMessage(mpLogMessageTextBox->text());
+      pBreakpointMarker->setLogArguments(mpLogArgumentsTextBox->text());
       /* the breakpoint is file system breakpoint now so remove the mark from the previous editor and set LibraryTreeItem to 0. */
       if (mpBreakpointTreeItem->getLibraryTreeItem() && mpBreakpointTreeItem->getLibraryTreeItem()->getModelWidget()) {
         mpBreakpointTreeItem->getLibraryTreeItem()->getModelWidget()->getEditor()->getDocumentMarker()->removeMark(pBreakpointMarker);
@@ -183,7 +202,8 @@ void BreakpointDialog::addOrEditBreakpoint()
       mpBreakpointTreeItem->setLibraryTreeItem(0);
       /* update BreakpointTreeItem filePath and lineNumber. */
       mpBreakpointsTreeModel->updateBreakpoint(mpBreakpointTreeItem, mpFileNameTextBox->text(), lineNumber, mpEnableCheckBox->isChecked(),
-                                               mpIgnoreCountSpinBox->value(), mpConditionTextBox->text());
+                                               mpIgnoreCountSpinBox->value(), mpConditionTextBox->text(), mpLogMessageTextBox->text(),
+                                               mpLogArgumentsTextBox->text());
     }
   } else {  /* if user has selected a class using Browse Classes button */
     LibraryWidget *pLibraryWidget = MainWindow::instance()->getLibraryWidget();
@@ -204,6 +224,8 @@ void BreakpointDialog::addOrEditBreakpoint()
         pBreakpointMarker->setEnabled(mpEnableCheckBox->isChecked());
         pBreakpointMarker->setIgnoreCount(mpIgnoreCountSpinBox->value());
         pBreakpointMarker->setCondition(mpConditionTextBox->text());
+        pBreakpointMarker->setLogMessage(mpLogMessageTextBox->text());
+        pBreakpointMarker->setLogArguments(mpLogArgumentsTextBox->text());
         mpBreakpointsTreeModel->insertBreakpoint(pBreakpointMarker, pLibraryTreeItem, mpBreakpointsTreeModel->getRootBreakpointTreeItem());
         if (pLibraryTreeItem->getModelWidget()) {
           pLibraryTreeItem->getModelWidget()->getEditor()->getDocumentMarker()->addMark(pBreakpointMarker, lineNumber);
@@ -223,11 +245,14 @@ void BreakpointDialog::addOrEditBreakpoint()
         pBreakpointMarker->setEnabled(mpEnableCheckBox->isChecked());
         pBreakpointMarker->setIgnoreCount(mpIgnoreCountSpinBox->value());
         pBreakpointMarker->setCondition(mpConditionTextBox->text());
+        pBreakpointMarker->setLogMessage(mpLogMessageTextBox->text());
+        pBreakpointMarker->setLogArguments(mpLogArgumentsTextBox->text());
         /* the breakpoint is not a file system breakpoint now so set LibraryTreeItem. */
         mpBreakpointTreeItem->setLibraryTreeItem(pLibraryTreeItem);
         /* update BreakpointTreeItem filePath and lineNumber. */
         mpBreakpointsTreeModel->updateBreakpoint(mpBreakpointTreeItem, pLibraryTreeItem->getFileName(), lineNumber,
-                                                 mpEnableCheckBox->isChecked(), mpIgnoreCountSpinBox->value(), mpConditionTextBox->text());
+                                                 mpEnableCheckBox->isChecked(), mpIgnoreCountSpinBox->value(), mpConditionTextBox->text(),
+                                                 mpLogMessageTextBox->text(), mpLogArgumentsTextBox->text());
         if (pLibraryTreeItem->getModelWidget()) {
           if (!pLibraryTreeItem->getModelWidget()->getEditor()) {
             pLibraryTreeItem->getModelWidget()->createModelWidgetComponents();
@@ -65,6 +65,11 @@ private:
   Label *mpConditionLabel;
   QLineEdit *mpConditionTextBox;
   Label *mpConditionHintLabel;
+  Label *mpLogMessageLabel;
+  QLineEdit *mpLogMessageTextBox;
+  Label *mpLogArgumentsLabel;
+  QLineEdit *mpLogArgumentsTextBox;
+  Label *mpLogMessageHintLabel;
   QPushButton *mpOkButton;
   QPushButton *mpCancelButton;
   QDialogButtonBox *mpButtonBox;
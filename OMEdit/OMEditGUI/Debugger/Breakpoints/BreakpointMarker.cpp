@@ -43,6 +43,8 @@ BreakpointMarker::BreakpointMarker(const QString &fileName, int lineNumber, Brea
     , mEnabled(true)
     , mIgnoreCount(0)
     , mCondition("")
+    , mLogMessage("")
+    , mLogArguments("")
 {
 
 }
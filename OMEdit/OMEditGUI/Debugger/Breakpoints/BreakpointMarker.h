@@ -107,6 +107,10 @@ public:
   inline int getIgnoreCount() {return mIgnoreCount;}
   void setCondition(QString condition) {mCondition = condition;}
   inline QString getCondition() {return mCondition;}
+  void setLogMessage(QString logMessage) {mLogMessage = logMessage;}
+  inline QString getLogMessage() {return mLogMessage;}
+  void setLogArguments(QString logArguments) {mLogArguments = logArguments;}
+  inline QString getLogArguments() {return mLogArguments;}
 private:
   BreakpointsTreeModel *mpBreakpointsTreeModel;
   QString mpFileName;
@@ -115,6 +119,8 @@ private:
   bool mEnabled;
   int mIgnoreCount;
   QString mCondition;
+  QString mLogMessage;
+  QString mLogArguments;
 };
 
 class DocumentMarker : public ITextMarkable
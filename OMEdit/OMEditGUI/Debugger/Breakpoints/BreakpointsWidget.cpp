@@ -283,7 +283,7 @@ BreakpointsTreeModel::~BreakpointsTreeModel()
 int BreakpointsTreeModel::columnCount(const QModelIndex &parent) const
 {
   Q_UNUSED(parent);
-  return 2;
+  return 3;
 }
 
 int BreakpointsTreeModel::rowCount(const QModelIndex &parent) const
@@ -378,6 +378,24 @@ BreakpointTreeItem* BreakpointsTreeModel::findBreakpointTreeItem(const QString &
   return 0;
 }
 
+/*!
+  Finds the top level BreakpointTreeItem inserted in GDB with the breakpoint ID.
+  \param breakpointID - the GDB breakpoint number.
+  \return BreakpointTreeItem
+  */
+BreakpointTreeItem* BreakpointsTreeModel::findBreakpointTreeItem(const QString &breakpointID) const
+{
+  if (breakpointID.isEmpty()) {
+    return 0;
+  }
+  foreach (BreakpointTreeItem *pBreakpointTreeItem, mpRootBreakpointTreeItem->getChildren()) {
+    if (pBreakpointTreeItem->getBreakpointID().compare(breakpointID) == 0) {
+      return pBreakpointTreeItem;
+    }
+  }
+  return 0;
+}
+
 /*!
   Finds the BreakpointTreeItem QModelIndex.
   \return QModelIndex
@@ -429,6 +447,8 @@ void BreakpointsTreeModel::insertBreakpoint(BreakpointMarker *pBreakpointMarker,
   pBreakpointTreeItem->setEnabled(pBreakpointMarker->isEnabled());
   pBreakpointTreeItem->setIgnoreCount(pBreakpointMarker->getIgnoreCount());
   pBreakpointTreeItem->setCondition(pBreakpointMarker->getCondition());
+  pBreakpointTreeItem->setLogMessage(pBreakpointMarker->getLogMessage());
+  pBreakpointTreeItem->setLogArguments(pBreakpointMarker->getLogArguments());
   int row = pParentBreakpointTreeItem->getChildren().size();
   beginInsertRows(index, row, row);
   pParentBreakpointTreeItem->insertChild(row, pBreakpointTreeItem);
@@ -450,42 +470,59 @@ void BreakpointsTreeModel::updateBreakpoint(BreakpointMarker *pBreakpointMarker,
                                                                    mpRootBreakpointTreeItem);
   if (pBreakpointTreeItem) {
     updateBreakpoint(pBreakpointTreeItem, pBreakpointMarker->filePath(), lineNumber, pBreakpointMarker->isEnabled(),
-                     pBreakpointMarker->getIgnoreCount(), pBreakpointMarker->getCondition());
+                     pBreakpointMarker->getIgnoreCount(), pBreakpointMarker->getCondition(), pBreakpointMarker->getLogMessage(),
+                     pBreakpointMarker->getLogArguments());
   }
 }
 
 /*!
   Updates the breakpoint.\n
   If the debugger is running then enable or disable the breakpoint in GDB.\n
+  GDB can't turn a breakpoint into a logpoint so the breakpoint is deleted and inserted again when its log message changes.
   \param pBreakpointTreeItem - pointer to BreakpointTreeItem
   \param filePath - the breakpoint file location.
   \param lineNumber - the breakpoint line number.
   \param enabled - the breakpoint enabled state.
+  \param ignoreCount - the number of hits GDB ignores.
+  \param condition - the condition evaluated by GDB.
+  \param logMessage - the logpoint message format.
+  \param logArguments - the logpoint message arguments.
   */
 void BreakpointsTreeModel::updateBreakpoint(BreakpointTreeItem *pBreakpointTreeItem, QString filePath, int lineNumber, bool enabled,
-                                            int ignoreCount, QString condition)
+                                            int ignoreCount, QString condition, QString logMessage, QString logArguments)
 {
+  bool reinsert = false;
   // enable/disable the breakpoint in gdb.
   if (GDBAdapter::instance()->isGDBRunning() && !pBreakpointTreeItem->getBreakpointID().isEmpty()) {
-    if (pBreakpointTreeItem->isEnabled() != enabled) {
-      if (enabled) {
-        GDBAdapter::instance()->postCommand(CommandFactory::breakEnable(QStringList() << pBreakpointTreeItem->getBreakpointID()),
+    if ((pBreakpointTreeItem->getLogMessage().compare(logMessage) != 0) ||
+        (pBreakpointTreeItem->getLogArguments().compare(logArguments) != 0)) {
+      GDBAdapter::instance()->postCommand(CommandFactory::breakDelete(QStringList() << pBreakpointTreeItem->getBreakpointID()),
+                                          GDBAdapter::NonCriticalResponse);
+      pBreakpointTreeItem->setBreakpointID("");
+      pBreakpointTreeItem->setHitCount(0);
+      pBreakpointTreeItem->setStopCount(0);
+      reinsert = true;
+    } else {
+      if (pBreakpointTreeItem->isEnabled() != enabled) {
+        if (enabled) {
+          GDBAdapter::instance()->postCommand(CommandFactory::breakEnable(QStringList() << pBreakpointTreeItem->getBreakpointID()),
+                                              GDBAdapter::NonCriticalResponse);
+        } else {
+          GDBAdapter::instance()->postCommand(CommandFactory::breakDisable(QStringList() << pBreakpointTreeItem->getBreakpointID()),
+                                              GDBAdapter::NonCriticalResponse);
+        }
+      }
+      // add the ignore count in gdb
+      if (pBreakpointTreeItem->getIgnoreCount() != ignoreCount) {
+        GDBAdapter::instance()->postCommand(CommandFactory::breakAfter(pBreakpointTreeItem->getBreakpointID(), ignoreCount),
                                             GDBAdapter::NonCriticalResponse);
-      } else {
-        GDBAdapter::instance()->postCommand(CommandFactory::breakDisable(QStringList() << pBreakpointTreeItem->getBreakpointID()),
+      }
+      // add the condition in gdb
+      if (pBreakpointTreeItem->getCondition().compare(condition) != 0) {
+        GDBAdapter::instance()->postCommand(CommandFactory::breakCondition(pBreakpointTreeItem->getBreakpointID(), condition),
                                             GDBAdapter::NonCriticalResponse);
       }
     }
-    // add the ignore count in gdb
-    if (pBreakpointTreeItem->getIgnoreCount() != ignoreCount) {
-      GDBAdapter::instance()->postCommand(CommandFactory::breakAfter(pBreakpointTreeItem->getBreakpointID(), ignoreCount),
-                                          GDBAdapter::NonCriticalResponse);
-    }
-    // add the condition in gdb
-    if (pBreakpointTreeItem->getCondition().compare(condition) != 0) {
-      GDBAdapter::instance()->postCommand(CommandFactory::breakCondition(pBreakpointTreeItem->getBreakpointID(), condition),
-                                          GDBAdapter::NonCriticalResponse);
-    }
   }
   // update the breakpoint in the tree.
   pBreakpointTreeItem->setFilePath(filePath);
@@ -493,8 +530,54 @@ void BreakpointsTreeModel::updateBreakpoint(BreakpointTreeItem *pBreakpointTreeI
   pBreakpointTreeItem->setEnabled(enabled);
   pBreakpointTreeItem->setIgnoreCount(ignoreCount);
   pBreakpointTreeItem->setCondition(condition);
+  pBreakpointTreeItem->setLogMessage(logMessage);
+  pBreakpointTreeItem->setLogArguments(logArguments);
+  QModelIndex index = breakpointTreeItemIndex(pBreakpointTreeItem);
+  emit dataChanged(index, index.sibling(index.row(), 2));
+  // insert the breakpoint or logpoint again in gdb
+  if (reinsert) {
+    GDBAdapter::instance()->insertBreakpoint(pBreakpointTreeItem);
+  }
+}
+
+/*!
+  Updates the number of times GDB has hit the breakpoint.\n
+  GDB reports the hit count with the =breakpoint-modified notification.
+  \param pBreakpointTreeItem - pointer to BreakpointTreeItem
+  \param hitCount - the GDB hit count.
+  */
+void BreakpointsTreeModel::updateBreakpointHitCount(BreakpointTreeItem *pBreakpointTreeItem, int hitCount)
+{
+  if (pBreakpointTreeItem->getHitCount() != hitCount) {
+    pBreakpointTreeItem->setHitCount(hitCount);
+    QModelIndex index = breakpointTreeItemIndex(pBreakpointTreeItem);
+    emit dataChanged(index.sibling(index.row(), 2), index.sibling(index.row(), 2));
+  }
+}
+
+/*!
+  Increases the number of times the breakpoint has stopped the program.
+  \param pBreakpointTreeItem - pointer to BreakpointTreeItem
+  */
+void BreakpointsTreeModel::increaseBreakpointStopCount(BreakpointTreeItem *pBreakpointTreeItem)
+{
+  pBreakpointTreeItem->setStopCount(pBreakpointTreeItem->getStopCount() + 1);
   QModelIndex index = breakpointTreeItemIndex(pBreakpointTreeItem);
-  emit dataChanged(index, index);
+  emit dataChanged(index.sibling(index.row(), 2), index.sibling(index.row(), 2));
+}
+
+/*!
+  Resets the hit counts of all breakpoints. Called when a new debugging session starts.
+  */
+void BreakpointsTreeModel::resetBreakpointHitCounts()
+{
+  foreach (BreakpointTreeItem *pBreakpointTreeItem, mpRootBreakpointTreeItem->getChildren()) {
+    pBreakpointTreeItem->setHitCount(0);
+    pBreakpointTreeItem->setStopCount(0);
+  }
+  if (!mpRootBreakpointTreeItem->getChildren().isEmpty()) {
+    emit dataChanged(index(0, 2), index(mpRootBreakpointTreeItem->getChildren().size() - 1, 2));
+  }
 }
 
 /*!
@@ -552,6 +635,10 @@ BreakpointTreeItem::BreakpointTreeItem(const QVector<QVariant> &breakpointItemDa
   mEnabled = true;
   mIgnoreCount = 0;
   mCondition = "";
+  mLogMessage = "";
+  mLogArguments = "";
+  mHitCount = 0;
+  mStopCount = 0;
 }
 
 /*!
@@ -603,6 +690,8 @@ QVariant BreakpointTreeItem::data(int column, int role) const
           return mLineNumber;
         case Qt::DecorationRole:
           return mIsRootItem ? QIcon() : getBreakpointTreeItemIcon();
+        case Qt::ToolTipRole:
+          return (mIsRootItem || !isLogpoint()) ? QVariant() : tr("Logpoint: %1").arg(mLogMessage);
         default:
           return QVariant();
       }
@@ -614,6 +703,17 @@ QVariant BreakpointTreeItem::data(int column, int role) const
         default:
           return QVariant();
       }
+    case 2:
+      switch (role)
+      {
+        case Qt::DisplayRole:
+          return mIsRootItem ? tr("Filtered Hits") : QString::number(getFilteredHitCount());
+        case Qt::ToolTipRole:
+          return mIsRootItem ? QVariant() : tr("%1 of %2 hits were handled in GDB without stopping the program.")
+                                            .arg(getFilteredHitCount()).arg(mHitCount);
+        default:
+          return QVariant();
+      }
     default:
       return QVariant();
   }
@@ -98,13 +98,17 @@ public:
   QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
   BreakpointMarker* findBreakpointMarker(const QString &fileName, int lineNumber);
   BreakpointTreeItem* findBreakpointTreeItem(const QString &fileName, int lineNumber, BreakpointTreeItem *pRootBreakpointTreeItem) const;
+  BreakpointTreeItem* findBreakpointTreeItem(const QString &breakpointID) const;
   QModelIndex breakpointTreeItemIndex(const BreakpointTreeItem *pBreakpointTreeItem) const;
   QModelIndex breakpointTreeItemIndexHelper(const BreakpointTreeItem *pBreakpointTreeItem, const BreakpointTreeItem *pParentBreakpointTreeItem,
                                             const QModelIndex &parentIndex) const;
   void insertBreakpoint(BreakpointMarker *pBreakpointMarker, LibraryTreeItem *pLibraryTreeItem, BreakpointTreeItem *pParentBreakpointTreeItem);
   void updateBreakpoint(BreakpointMarker *pBreakpointMarker, int lineNumber);
   void updateBreakpoint(BreakpointTreeItem *pBreakpointTreeItem, QString filePath, int lineNumber, bool enabled, int ignoreCount,
-                        QString condition);
+                        QString condition, QString logMessage, QString logArguments);
+  void updateBreakpointHitCount(BreakpointTreeItem *pBreakpointTreeItem, int hitCount);
+  void increaseBreakpointStopCount(BreakpointTreeItem *pBreakpointTreeItem);
+  void resetBreakpointHitCounts();
   void removeBreakpoint(BreakpointMarker *pBreakpointMarker);
   void removeBreakpoint(BreakpointTreeItem *pBreakpointTreeItem);
 private:
@@ -136,6 +140,16 @@ public:
   int getIgnoreCount() {return mIgnoreCount;}
   void setCondition(QString condition) {mCondition = condition;}
   QString getCondition() {return mCondition;}
+  void setLogMessage(QString logMessage) {mLogMessage = logMessage;}
+  QString getLogMessage() {return mLogMessage;}
+  void setLogArguments(QString logArguments) {mLogArguments = logArguments;}
+  QString getLogArguments() {return mLogArguments;}
+  bool isLogpoint() const {return !mLogMessage.isEmpty();}
+  void setHitCount(int hitCount) {mHitCount = hitCount;}
+  int getHitCount() const {return mHitCount;}
+  void setStopCount(int stopCount) {mStopCount = stopCount;}
+  int getStopCount() const {return mStopCount;}
+  int getFilteredHitCount() const {return qMax(mHitCount - mStopCount, 0);}
   QIcon getBreakpointTreeItemIcon() const;
   void insertChild(int position, BreakpointTreeItem *pBreakpointTreeItem);
   BreakpointTreeItem *child(int row);
@@ -155,6 +169,10 @@ private:
   bool mEnabled;
   int mIgnoreCount;
   QString mCondition;
+  QString mLogMessage;
+  QString mLogArguments;
+  int mHitCount;
+  int mStopCount;
 };
 
 #endif // BREAKPOINTSWIDGET_H
@@ -160,6 +160,111 @@ QByteArray CommandFactory::breakCondition(QString breakpointID, QString conditio
   return QByteArray("-break-condition ").append(breakpointID).append(" ").append("\"\\\"" + condition + "\\\"\"");
 }
 
+/*!
+ * \brief miString
+ * Quotes the value as a GDB/MI c-string argument.
+ * \param value
+ * \return
+ */
+static QString miString(QString value)
+{
+  return QString("\"%1\"").arg(value.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", "\\n").replace("\t", "\\t"));
+}
+
+/*!
+ * \brief splitLogArguments
+ * Splits the comma separated logpoint arguments. Commas inside parentheses, brackets and strings are kept.
+ * \param logArguments
+ * \return
+ */
+static QStringList splitLogArguments(QString logArguments)
+{
+  QStringList arguments;
+  QString argument;
+  int depth = 0;
+  bool inString = false;
+  for (int i = 0 ; i < logArguments.size() ; i++) {
+    QChar ch = logArguments.at(i);
+    if (inString) {
+      if (ch == '\\' && i + 1 < logArguments.size()) {
+        argument.append(ch);
+        ch = logArguments.at(++i);
+      } else if (ch == '"') {
+        inString = false;
+      }
+    } else if (ch == '"') {
+      inString = true;
+    } else if (ch == '(' || ch == '[' || ch == '{') {
+      depth++;
+    } else if ((ch == ')' || ch == ']' || ch == '}') && depth > 0) {
+      depth--;
+    } else if (ch == ',' && depth == 0) {
+      if (!argument.trimmed().isEmpty()) {
+        arguments.append(argument.trimmed());
+      }
+      argument.clear();
+      continue;
+    }
+    argument.append(ch);
+  }
+  if (!argument.trimmed().isEmpty()) {
+    arguments.append(argument.trimmed());
+  }
+  return arguments;
+}
+
+/*!
+ * \brief CommandFactory::dprintfInsert
+ * Creates the -dprintf-insert command.\n
+ * The logpoint is handled completely inside GDB. The message is printed on the console stream with the logpointPrefix() and
+ * the program continues without stopping.
+ * \param fileName - the logpoint location.
+ * \param line - the logpoint line number.
+ * \param logMessage - the printf style format.
+ * \param logArguments - the comma separated expressions used by the format.
+ * \param isDisabled
+ * \param condition
+ * \param ignoreCount
+ * \param isPending - sets the logpoint pending.
+ * \return
+ */
+QByteArray CommandFactory::dprintfInsert(QString fileName, int line, QString logMessage, QString logArguments, bool isDisabled,
+                                         QString condition, int ignoreCount, bool isPending)
+{
+  QStringList command;
+  command.append("-dprintf-insert");
+  if (isPending) {
+    command.append("-f");
+  }
+  if (isDisabled) {
+    command.append("-d");
+  }
+  if (!condition.isEmpty()) {
+    command.append("-c");
+    command.append("\"\\\"" + condition + "\\\"\"");
+  }
+  if (ignoreCount > 0) {
+    command.append("-i");
+    command.append(QString::number(ignoreCount));
+  }
+  command.append("\"\\\"" + fileName + "\\\":" + QString::number(line) + "\"");
+  command.append(miString(logpointPrefix() + logMessage + "\n"));
+  foreach (QString argument, splitLogArguments(logArguments)) {
+    command.append(miString(argument));
+  }
+  return QByteArray(command.join(" ").toStdString().c_str());
+}
+
+/*!
+ * \brief CommandFactory::logpointPrefix
+ * Returns the prefix used to identify the logpoint messages on the GDB console stream.
+ * \return
+ */
+QString CommandFactory::logpointPrefix()
+{
+  return "omc_logpoint:";
+}
+
 /*!
  * \brief CommandFactory::execRun
  * Creates the -exec-run command.\n
@@ -383,6 +488,81 @@ QByteArray CommandFactory::isOptionNone(int thread, int frame, QString expressio
   return QByteArray(command.toStdString().c_str());
 }
 
+/*!
+ * \brief CommandFactory::source
+ * Creates the -interpreter-exec console "source fileName" command.\n
+ * \param fileName - the script to read.
+ * \return
+ */
+QByteArray CommandFactory::source(QString fileName)
+{
+  QString command = QString("-interpreter-exec console \"source %1\"").arg(fileName);
+  return QByteArray(command.toStdString().c_str());
+}
+
+/*!
+ * \brief pythonString
+ * Quotes the value as a python string for the python console command.
+ * \param value
+ * \return
+ */
+static QString pythonString(QString value)
+{
+  return QString("'%1'").arg(value.replace("\\", "\\\\").replace("'", "\\'"));
+}
+
+/*!
+ * \brief pythonConsoleCommand
+ * Creates the -interpreter-exec --thread 1 --frame 0 console "python statement" command.
+ * \param thread
+ * \param frame
+ * \param statement
+ * \return
+ */
+static QByteArray pythonConsoleCommand(int thread, int frame, QString statement)
+{
+  statement.replace("\\", "\\\\").replace("\"", "\\\"");
+  QString command = QString("-interpreter-exec --thread %1 --frame %2 console \"python %3\"").arg(thread).arg(frame).arg(statement);
+  return QByteArray(command.toStdString().c_str());
+}
+
+/*!
+ * \brief CommandFactory::retrieveLocals
+ * Creates the command that retrieves the types, values and children sizes of all the locals in one go.\n
+ * Calls omedit_locals of Resources/gdb/omedit_locals.py.
+ * \param thread
+ * \param frame
+ * \param locals - the locals as read from -stack-list-variables i.e., name, displayName, type and value.
+ * \param depth - the levels of children to retrieve along with the locals.
+ * \return
+ */
+QByteArray CommandFactory::retrieveLocals(int thread, int frame, const QList<QVector<QVariant> > &locals, int depth)
+{
+  QStringList localsList;
+  foreach (QVector<QVariant> local, locals) {
+    localsList.append(QString("(%1, %2, %3)").arg(pythonString(local[0].toString())).arg(pythonString(local[1].toString()))
+                      .arg(pythonString(local[2].toString())));
+  }
+  return pythonConsoleCommand(thread, frame, QString("omedit_locals([%1], %2)").arg(localsList.join(", ")).arg(depth));
+}
+
+/*!
+ * \brief CommandFactory::retrieveLocalChildren
+ * Creates the command that retrieves all the children of a value in one go.\n
+ * Calls omedit_local_children of Resources/gdb/omedit_locals.py.
+ * \param thread
+ * \param frame
+ * \param expression - the expression of the value.
+ * \param modelicaType - the Modelica type of the value.
+ * \param depth - the levels of children to retrieve below each child.
+ * \return
+ */
+QByteArray CommandFactory::retrieveLocalChildren(int thread, int frame, QString expression, QString modelicaType, int depth)
+{
+  return pythonConsoleCommand(thread, frame, QString("omedit_local_children(%1, %2, %3)").arg(pythonString(expression))
+                              .arg(pythonString(modelicaType)).arg(depth));
+}
+
 /*!
  * \brief CommandFactory::GDBExit
  * Creates the -gdb-exit command.\n
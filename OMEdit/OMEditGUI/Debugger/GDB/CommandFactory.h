@@ -35,6 +35,9 @@
 #define COMMANDFACTORY_H
 
 #include <QString>
+#include <QList>
+#include <QVector>
+#include <QVariant>
 
 class CommandFactory
 {
@@ -59,6 +62,9 @@ public:
   static QByteArray breakDisable(QStringList breakpointIDs);
   static QByteArray breakAfter(QString breakpointID, int count);
   static QByteArray breakCondition(QString breakpointID, QString condition);
+  static QByteArray dprintfInsert(QString fileName, int line, QString logMessage, QString logArguments, bool isDisabled = false,
+                                  QString condition = "", int ignoreCount = 0, bool isPending = true);
+  static QString logpointPrefix();
   /* Program Context Commands */
   static QByteArray execRun();
   static QByteArray execContinue();
@@ -79,6 +85,9 @@ public:
   static QByteArray arrayLength(int thread, int frame, QString expression);
   static QByteArray listLength(int thread, int frame, QString expression);
   static QByteArray isOptionNone(int thread, int frame, QString expression);
+  static QByteArray source(QString fileName);
+  static QByteArray retrieveLocals(int thread, int frame, const QList<QVector<QVariant> > &locals, int depth);
+  static QByteArray retrieveLocalChildren(int thread, int frame, QString expression, QString modelicaType, int depth);
   static QByteArray GDBExit();
 };
 
@@ -82,11 +82,31 @@ GDBLoggerWidget::GDBLoggerWidget(QWidget *pParent)
   pLogWindowsSplitter->addWidget(mpResponseTextBox);
   pLogWindowsSplitter->setStretchFactor(0, 0);
   pLogWindowsSplitter->setStretchFactor(1, 1);
+  /* command latency histogram */
+  mpCommandLatencyTreeWidget = new QTreeWidget;
+  mpCommandLatencyTreeWidget->setItemDelegate(new ItemDelegate(mpCommandLatencyTreeWidget));
+  mpCommandLatencyTreeWidget->setIndentation(0);
+  mpCommandLatencyTreeWidget->setColumnCount(9);
+  mpCommandLatencyTreeWidget->setTextElideMode(Qt::ElideMiddle);
+  mpCommandLatencyTreeWidget->setSortingEnabled(true);
+  mpCommandLatencyTreeWidget->sortByColumn(0, Qt::AscendingOrder);
+  QStringList headerLabels;
+  headerLabels << tr("Command") << tr("Count") << tr("Average (ms)") << tr("Maximum (ms)") << "< 1 ms" << "< 10 ms" << "< 100 ms"
+               << "< 1 s" << ">= 1 s";
+  mpCommandLatencyTreeWidget->setHeaderLabels(headerLabels);
+  QSplitter *pLatencySplitter = new QSplitter(Qt::Vertical);
+  pLatencySplitter->setChildrenCollapsible(false);
+  pLatencySplitter->setHandleWidth(4);
+  pLatencySplitter->setContentsMargins(0, 0, 0, 0);
+  pLatencySplitter->addWidget(pLogWindowsSplitter);
+  pLatencySplitter->addWidget(mpCommandLatencyTreeWidget);
+  pLatencySplitter->setStretchFactor(0, 1);
+  pLatencySplitter->setStretchFactor(1, 0);
   /* layout */
   QGridLayout *pGridLayout = new QGridLayout;
   pGridLayout->setAlignment(Qt::AlignLeft);
   pGridLayout->setContentsMargins(1, 1, 1, 1);
-  pGridLayout->addWidget(pLogWindowsSplitter, 0, 0, 1, 2);
+  pGridLayout->addWidget(pLatencySplitter, 0, 0, 1, 2);
   pGridLayout->addWidget(mpCommandTextBox, 1, 0);
   pGridLayout->addWidget(mpSendCommandButton, 1, 1);
   setLayout(pGridLayout);
@@ -124,6 +144,49 @@ void GDBLoggerWidget::logDebuggerErrorResponse(QString response)
   logDebuggerResponse(response, Qt::red);
 }
 
+/*!
+ * \brief GDBLoggerWidget::logCommandLatency
+ * Adds the response time of a command to the latency histogram of its command type.
+ * \param commandType
+ * \param latency - the response time in milliseconds.
+ */
+void GDBLoggerWidget::logCommandLatency(QString commandType, qint64 latency)
+{
+  CommandLatency &commandLatency = mCommandLatenciesHash[commandType];
+  if (!commandLatency.mpTreeWidgetItem) {
+    commandLatency.mHistogram.fill(0, 5);
+    commandLatency.mpTreeWidgetItem = new QTreeWidgetItem(QStringList(commandType));
+    commandLatency.mpTreeWidgetItem->setToolTip(0, commandType);
+    mpCommandLatencyTreeWidget->addTopLevelItem(commandLatency.mpTreeWidgetItem);
+  }
+  commandLatency.mCount++;
+  commandLatency.mTotal += latency;
+  commandLatency.mMaximum = qMax(commandLatency.mMaximum, latency);
+  // the histogram buckets are < 1 ms, < 10 ms, < 100 ms, < 1 s and >= 1 s.
+  int bucket = 0;
+  for (qint64 limit = 1 ; bucket < 4 && latency >= limit ; limit *= 10) {
+    bucket++;
+  }
+  commandLatency.mHistogram[bucket]++;
+  QTreeWidgetItem *pTreeWidgetItem = commandLatency.mpTreeWidgetItem;
+  pTreeWidgetItem->setText(1, QString::number(commandLatency.mCount));
+  pTreeWidgetItem->setText(2, QString::number((double)commandLatency.mTotal / commandLatency.mCount, 'f', 1));
+  pTreeWidgetItem->setText(3, QString::number(commandLatency.mMaximum));
+  for (int i = 0 ; i < commandLatency.mHistogram.size() ; i++) {
+    pTreeWidgetItem->setText(4 + i, QString::number(commandLatency.mHistogram.at(i)));
+  }
+}
+
+/*!
+ * \brief GDBLoggerWidget::clearCommandLatencies
+ * Clears the latency histogram.
+ */
+void GDBLoggerWidget::clearCommandLatencies()
+{
+  mCommandLatenciesHash.clear();
+  mpCommandLatencyTreeWidget->clear();
+}
+
 /*!
  * \brief GDBLoggerWidget::logDebuggerResponse
  * Writes Debugger response in Debugger Logger window.
@@ -162,6 +225,7 @@ void GDBLoggerWidget::handleGDBProcessStarted()
   if (pDebuggerPage->getClearLogOnNewRunCheckBox()->isChecked()) {
     mpCommandsTextBox->clear();
     mpResponseTextBox->clear();
+    clearCommandLatencies();
   }
   mpCommandTextBox->setEnabled(true);
   mpSendCommandButton->setEnabled(true);
@@ -287,6 +351,8 @@ GDBAdapter::GDBAdapter(QWidget *pParent)
   mIsInferiorTerminated = false;
   mIsInferiorRunning = false;
   mToken = 0;
+  mCommandsInFlight = 0;
+  mBatchedLocalsRetrieval = false;
   mCatchOMCBreakpointId = "1";
   mGDBCommandTimer.setSingleShot(true);
   connect(&mGDBCommandTimer, SIGNAL(timeout()), SLOT(GDBcommandTimeout()));
@@ -419,9 +485,32 @@ void GDBAdapter::postCommand(QByteArray command, GDBCommandFlags flags, GDBComma
   postCommand(command, flags, 0, callback);
 }
 
+/*!
+ * \brief GDBCommandType
+ * Returns the type of the command used for the latency histogram.
+ * The -data-evaluate-expression commands are distinguished by the function they call.
+ * \param command
+ * \return
+ */
+static QString GDBCommandType(const QByteArray &command)
+{
+  QString commandString(command);
+  QString commandType = commandString.section(' ', 0, 0);
+  if (commandType.compare("-data-evaluate-expression") == 0) {
+    QRegExp functionRegExp("\"(?:\\(\\w+\\*?\\))?(\\w+)\\(");
+    if (functionRegExp.indexIn(commandString) != -1) {
+      commandType.append(" ").append(functionRegExp.cap(1));
+    }
+  }
+  return commandType;
+}
+
 /*!
  * \brief GDBAdapter::postCommand
  * Sends a command to GDB.
+ * The commands are pipelined i.e., the command is written without waiting for the response of the previous commands.
+ * The response is dispatched to the callback function when it arrives.
+ * A request that is identical to a request of the same object that is still in flight is coalesced with it.
  * \param command - the command to send.
  * \param flags - the command flags.
  * \param pCallbackObject - the QObject pointer which is used to call the callback function.
@@ -429,46 +518,80 @@ void GDBAdapter::postCommand(QByteArray command, GDBCommandFlags flags, GDBComma
  */
 void GDBAdapter::postCommand(QByteArray command, GDBCommandFlags flags, QObject *pCallbackObject, GDBCommandCallback callback)
 {
-  if (isGDBRunning()) {
-    int token = currentToken() + 1;
-    setCurrentToken(token);
-    GDBMICommand cmd;
-    cmd.mFlags = flags;
-    cmd.mCommand = command;
-    cmd.mpCallbackObject = pCallbackObject;
-    cmd.mGDBCommandCallback = callback;
-    if (cmd.mFlags & GDBAdapter::ConsoleCommand) {
-      cmd.mCommand = "-interpreter-exec console \"" + cmd.mCommand + '"';
+  if (!isGDBRunning()) {
+    return;
+  }
+  if (flags & GDBAdapter::ConsoleCommand) {
+    command = "-interpreter-exec console \"" + command + '"';
+  }
+  QByteArray coalesceKey;
+  if (pCallbackObject) {
+    coalesceKey = command + '\n' + QByteArray::number((quintptr)pCallbackObject);
+    int inFlightToken = mCoalescedCommandsHash.value(coalesceKey, 0);
+    if (inFlightToken && mGDBMICommandsHash.contains(inFlightToken)
+        && mGDBMICommandsHash.value(inFlightToken).mGDBCommandCallback == callback) {
+      return;
     }
-    cmd.mCommand = QByteArray::number(token) + cmd.mCommand;
-    mGDBMICommandsHash[token] = cmd;
+  } else {
+    /* commands without callback objects e.g., -exec-next can change the state of the inferior.
+     * Don't coalesce the later requests with the ones sent before.
+     */
+    mCoalescedCommandsHash.clear();
+  }
+  int token = currentToken() + 1;
+  setCurrentToken(token);
+  GDBMICommand cmd;
+  cmd.mFlags = flags;
+  cmd.mCommand = QByteArray::number(token) + command;
+  cmd.mpCallbackObject = pCallbackObject;
+  cmd.mGDBCommandCallback = callback;
+  cmd.mCoalesceKey = coalesceKey;
+  cmd.mCommandType = GDBCommandType(command);
+  mGDBMICommandsHash[token] = cmd;
+  if (!coalesceKey.isEmpty()) {
+    mCoalescedCommandsHash.insert(coalesceKey, token);
+  }
+  mPendingCommandsQueue.enqueue(token);
+  writePendingCommands();
+}
+
+/*!
+ * \brief GDBAdapter::writePendingCommands
+ * Writes the pending commands to GDB while the number of commands in flight is below the limit.
+ */
+void GDBAdapter::writePendingCommands()
+{
+  while (!mPendingCommandsQueue.isEmpty() && mCommandsInFlight < mMaximumCommandsInFlight) {
+    int token = mPendingCommandsQueue.dequeue();
+    if (!mGDBMICommandsHash.contains(token)) {
+      continue;
+    }
+    GDBMICommand &cmd = mGDBMICommandsHash[token];
     // log command
     writeDebuggerCommandLog(cmd.mCommand);
     MainWindow::instance()->getGDBLoggerWidget()->logDebuggerCommand(QString(cmd.mCommand));
-    /* if command needs a response
-     * block until response is arrived
-     */
-    if (cmd.mFlags & GDBAdapter::BlockUntilResponse) {
-      QEventLoop eventLoop;
-      QTimer timer;
-      connect(&timer, SIGNAL(timeout()), &eventLoop, SLOT(quit()));
-      connect(this, SIGNAL(commandCompleted()), &eventLoop, SLOT(quit()));
-      /* Just in case command response doesn't arrive for some reason we don't want to stay in blocked state.
-       * So we start a timer which will quit the event loop after 5 secs.
-       */
-      timer.start(5000);
-      mpGDBProcess->write(cmd.mCommand + "\r\n");
-      eventLoop.exec();
-    } else {
-      mpGDBProcess->write(cmd.mCommand + "\r\n");
+    cmd.mElapsedTimer.start();
+    mpGDBProcess->write(cmd.mCommand + "\r\n");
+    mCommandsInFlight++;
+    if (!cmd.mCommand.endsWith("-gdb-exit")) {
       mGDBCommandTimer.setInterval(commandTimeoutTime());
-      if (!cmd.mCommand.endsWith("-gdb-exit")) {
-        mGDBCommandTimer.start();
-      }
+      mGDBCommandTimer.start();
     }
   }
 }
 
+/*!
+ * \brief GDBAdapter::clearCommands
+ * Clears the commands in flight and the pending commands.
+ */
+void GDBAdapter::clearCommands()
+{
+  mGDBMICommandsHash.clear();
+  mPendingCommandsQueue.clear();
+  mCoalescedCommandsHash.clear();
+  mCommandsInFlight = 0;
+}
+
 /*!
  * \brief GDBAdapter::commandTimeoutTime
  * Returns the GDB Command timeout.
@@ -551,7 +674,7 @@ void GDBAdapter::stackListVariablesCB(GDBMIResultRecord *pGDBMIResultRecord)
           GDBMIValue *pGDBMIValue = *valuesListiterator;
           QString name, type, value;
           if (pGDBMIValue->type == GDBMIValue::TupleValue) {
-            GDBMIResultList resultsList = pGDBMIValue->miTuple->miResultsList;
+            const GDBMIResultList &resultsList = pGDBMIValue->miTuple->miResultsList;
             name = getGDBMIConstantValue(getGDBMIResult("name", resultsList));
             type = getGDBMIConstantValue(getGDBMIResult("type", resultsList));
             value = getGDBMIConstantValue(getGDBMIResult("value", resultsList));
@@ -563,7 +686,19 @@ void GDBAdapter::stackListVariablesCB(GDBMIResultRecord *pGDBMIResultRecord)
             }
           }
         }
-        MainWindow::instance()->getLocalsWidget()->getLocalsTreeModel()->insertLocalsList(locals);
+        /* only the new and changed locals are retrieved. */
+        StackFramesWidget *pStackFramesWidget = MainWindow::instance()->getStackFramesWidget();
+        QString frame = QString("%1:%2:%3").arg(pStackFramesWidget->getSelectedThread()).arg(pStackFramesWidget->getSelectedFrame())
+            .arg(pStackFramesWidget->getSelectedFunction());
+        locals = MainWindow::instance()->getLocalsWidget()->getLocalsTreeModel()->updateLocalsCache(frame, locals);
+        if (mBatchedLocalsRetrieval && !locals.isEmpty()) {
+          /* retrieve the types, values and children sizes of all the locals with one command. See GDBAdapter::retrieveLocalsCB. */
+          int depth = OptionsDialog::instance()->getDebuggerPage()->getLocalsPrefetchDepthSpinBox()->value();
+          postCommand(CommandFactory::retrieveLocals(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(), locals,
+                                                     depth), GDBAdapter::SilentCommand, &GDBAdapter::retrieveLocalsCB);
+        } else {
+          MainWindow::instance()->getLocalsWidget()->getLocalsTreeModel()->insertLocalsList(locals);
+        }
       }
     }
   }
@@ -705,8 +840,8 @@ void GDBAdapter::getMetaTypeElementCB(GDBMIResultRecord *pGDBMIResultRecord)
       if (pGDBMIResponse) {
         if (pGDBMIResponse->type == GDBMIResponse::ResultRecordResponse) {
           GDBMIResult* pGDBMIResult = getGDBMIResult("omc_element", pGDBMIResponse->miResultRecord->miResultsList);
-          if (pGDBMIResult->miValue->type == GDBMIValue::TupleValue) {
-            GDBMIResultList resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
+          if (pGDBMIResult && pGDBMIResult->miValue->type == GDBMIValue::TupleValue) {
+            const GDBMIResultList &resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
             name = getGDBMIConstantValue(getGDBMIResult("name", resultsList));
             displayName = getGDBMIConstantValue(getGDBMIResult("displayName", resultsList));
             type = getGDBMIConstantValue(getGDBMIResult("type", resultsList));
@@ -746,6 +881,55 @@ void GDBAdapter::isOptionNoneCB(GDBMIResultRecord *pGDBMIResultRecord)
   }
 }
 
+/*!
+ * \brief GDBAdapter::retrieveLocalsCB
+ * Callback function for handling the CommandFactory::retrieveLocals command.\n
+ * Falls back to retrieving the locals value by value if the command fails.
+ * \param pGDBMIResultRecord - the result record with the omc_locals list as console stream output.
+ */
+/*
+  -interpreter-exec --thread 1 --frame 0 console "python omedit_locals([('_x', 'x', 'modelica_integer')], 1)"
+  ~"omc_locals=[{name=\"_x\",displayName=\"x\",type=\"modelica_integer\",modelicaType=\"Integer\",value=\"1\"}]\n"
+  23^done
+  */
+void GDBAdapter::retrieveLocalsCB(GDBMIResultRecord *pGDBMIResultRecord)
+{
+  QList<QVector<QVariant> > locals;
+  if (pGDBMIResultRecord->cls.compare("done") == 0 && readBatchedLocals(pGDBMIResultRecord, &locals)) {
+    MainWindow::instance()->getLocalsWidget()->getLocalsTreeModel()->insertLocalsList(locals);
+  } else {
+    mBatchedLocalsRetrieval = false;
+    /* the cache has the locals of this stop that are not retrieved. */
+    MainWindow::instance()->getLocalsWidget()->getLocalsTreeModel()->removeLocalItems();
+    StackFramesWidget *pStackFramesWidget = MainWindow::instance()->getStackFramesWidget();
+    postCommand(CommandFactory::stackListVariables(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
+                                                   "--simple-values"), &GDBAdapter::stackListVariablesCB);
+  }
+}
+
+/*!
+ * \brief GDBAdapter::retrieveLocalChildrenCB
+ * Callback function for handling the CommandFactory::retrieveLocalChildren command.\n
+ * Falls back to retrieving the children one by one if the command fails.
+ * \param pGDBMIResultRecord - the result record with the omc_locals list as console stream output.
+ */
+void GDBAdapter::retrieveLocalChildrenCB(GDBMIResultRecord *pGDBMIResultRecord)
+{
+  GDBMICommand cmd = mGDBMICommandsHash.value(pGDBMIResultRecord->token);
+  LocalsTreeItem *pLocalsTreeItem = qobject_cast<LocalsTreeItem*>(cmd.mpCallbackObject);
+  if (!pLocalsTreeItem) {
+    return;
+  }
+  QList<QVector<QVariant> > children;
+  if (pGDBMIResultRecord->cls.compare("done") == 0 && readBatchedLocals(pGDBMIResultRecord, &children)) {
+    foreach (QVector<QVariant> localItemData, children) {
+      MainWindow::instance()->getLocalsWidget()->getLocalsTreeModel()->insertLocalItemData(localItemData, pLocalsTreeItem);
+    }
+  } else if (pLocalsTreeItem->getModelicaValue()) {
+    pLocalsTreeItem->getModelicaValue()->retrieveChildren();
+  }
+}
+
 /*!
  * \brief GDBAdapter::createFullBacktraceCB
  * Callback function for handling the "-interpreter-exec console "thread apply all bt full"" command.
@@ -782,7 +966,7 @@ void GDBAdapter::insertBreakpointCB(GDBMIResultRecord *pGDBMIResultRecord)
   GDBMIResult *pBreakpointGDBMIResult = getGDBMIResult("bkpt", pGDBMIResultRecord->miResultsList);
   if (pBreakpointGDBMIResult) {
     if (pBreakpointGDBMIResult->miValue->type == GDBMIValue::TupleValue) {
-      GDBMIResultList resultsList = pBreakpointGDBMIResult->miValue->miTuple->miResultsList;
+      const GDBMIResultList &resultsList = pBreakpointGDBMIResult->miValue->miTuple->miResultsList;
       QString breakpointID = getGDBMIConstantValue(getGDBMIResult("number", resultsList));
       GDBMICommand cmd = mGDBMICommandsHash.value(pGDBMIResultRecord->token);
       if (BreakpointTreeItem *pBreakpointTreeItem = qobject_cast<BreakpointTreeItem*>(cmd.mpCallbackObject)) {
@@ -799,16 +983,79 @@ void GDBAdapter::insertBreakpointCB(GDBMIResultRecord *pGDBMIResultRecord)
  * \param resultsList - GDBMIResultList
  * \return GDBMIResult
  */
-GDBMIResult* GDBAdapter::getGDBMIResult(const char *variable, GDBMIResultList resultsList)
+GDBMIResult* GDBAdapter::getGDBMIResult(const char *variable, const GDBMIResultList &resultsList)
+{
+  return findGDBMIResult(resultsList, variable);
+}
+
+/*!
+ * \brief GDBAdapter::readBatchedLocals
+ * Reads the omc_locals list written to the console stream by Resources/gdb/omedit_locals.py.
+ * \param pGDBMIResultRecord
+ * \param pLocals - the locals as name, displayName, type, value and the QVariantMap of GDBAdapter::getBatchedLocalValue.
+ * \return false if the console stream output has no omc_locals list.
+ */
+bool GDBAdapter::readBatchedLocals(GDBMIResultRecord *pGDBMIResultRecord, QList<QVector<QVariant> > *pLocals)
 {
-  GDBMIResultList::iterator it;
-  for (it = resultsList.begin(); it != resultsList.end(); ++it) {
-    GDBMIResult *pGDBMIResult = *it;
-    if (pGDBMIResult->variable.compare(variable) == 0) {
-      return pGDBMIResult;
+  QString consoleStreamOutput = QString(pGDBMIResultRecord->consoleStreamOutput.c_str());
+  int beginIndex = consoleStreamOutput.indexOf("omc_locals=");
+  if (beginIndex < 0) {
+    return false;
+  }
+  int endIndex = consoleStreamOutput.indexOf("\n", beginIndex);
+  QByteArray output = "^done," + consoleStreamOutput.mid(beginIndex, endIndex < 0 ? -1 : endIndex - beginIndex).toUtf8();
+  bool found = false;
+  GDBMIResponse *pGDBMIResponse = parseGDBOutput(output.constData(), output.size());
+  if (pGDBMIResponse) {
+    if (pGDBMIResponse->type == GDBMIResponse::ResultRecordResponse) {
+      GDBMIResult *pGDBMIResult = getGDBMIResult("omc_locals", pGDBMIResponse->miResultRecord->miResultsList);
+      if (pGDBMIResult && pGDBMIResult->miValue->type == GDBMIValue::ListValue) {
+        GDBMIValueList::iterator valuesListIterator;
+        GDBMIValueList &valuesList = pGDBMIResult->miValue->miList->miValuesList;
+        for (valuesListIterator = valuesList.begin(); valuesListIterator != valuesList.end(); ++valuesListIterator) {
+          QVariantMap value = getBatchedLocalValue(*valuesListIterator);
+          QVector<QVariant> localItemData;
+          localItemData << value.value("name") << value.value("displayName") << value.value("type") << value.value("value") << value;
+          pLocals->append(localItemData);
+        }
+        found = true;
+      }
     }
+    delete pGDBMIResponse;
   }
-  return 0;
+  return found;
+}
+
+/*!
+ * \brief GDBAdapter::getBatchedLocalValue
+ * Converts a value of the omc_locals list to a QVariantMap.\n
+ * The prefetched children are stored as a QVariantList of QVariantMaps.
+ * \param pGDBMIValue
+ * \return
+ */
+QVariantMap GDBAdapter::getBatchedLocalValue(GDBMIValue *pGDBMIValue)
+{
+  QVariantMap value;
+  if (pGDBMIValue->type != GDBMIValue::TupleValue) {
+    return value;
+  }
+  GDBMIResultList::iterator resultsListIterator;
+  GDBMIResultList &resultsList = pGDBMIValue->miTuple->miResultsList;
+  for (resultsListIterator = resultsList.begin(); resultsListIterator != resultsList.end(); ++resultsListIterator) {
+    GDBMIResult *pGDBMIResult = *resultsListIterator;
+    if (pGDBMIResult->miValue->type == GDBMIValue::ConstantValue) {
+      value.insert(QString(pGDBMIResult->variable.c_str()), getGDBMIConstantValue(pGDBMIResult));
+    } else if (pGDBMIResult->miValue->type == GDBMIValue::ListValue) {
+      QVariantList children;
+      GDBMIValueList::iterator valuesListIterator;
+      GDBMIValueList &valuesList = pGDBMIResult->miValue->miList->miValuesList;
+      for (valuesListIterator = valuesList.begin(); valuesListIterator != valuesList.end(); ++valuesListIterator) {
+        children.append(getBatchedLocalValue(*valuesListIterator));
+      }
+      value.insert(QString(pGDBMIResult->variable.c_str()), children);
+    }
+  }
+  return value;
 }
 
 /*!
@@ -829,15 +1076,24 @@ QString GDBAdapter::getGDBMIConstantValue(GDBMIResult *pGDBMIResult)
 
 /*!
  * \brief GDBAdapter::insertBreakpoint
- * Sends the -break-insert command to GDB.
+ * Sends the -break-insert command to GDB.\n
+ * Sends the -dprintf-insert command if the breakpoint has a log message.
+ * The condition, ignore count and log message are all evaluated inside GDB so only the real stops reach OMEdit.
  * \param pBreakpointTreeItem - pointer to BreakpointTreeItem
  */
 void GDBAdapter::insertBreakpoint(BreakpointTreeItem *pBreakpointTreeItem)
 {
   QFileInfo fileInfo(pBreakpointTreeItem->getFilePath());
   QByteArray command;
-  command = CommandFactory::breakInsert(fileInfo.fileName(), pBreakpointTreeItem->getLineNumber().toInt(), !pBreakpointTreeItem->isEnabled(),
-                                        pBreakpointTreeItem->getCondition(), pBreakpointTreeItem->getIgnoreCount());
+  if (pBreakpointTreeItem->isLogpoint()) {
+    command = CommandFactory::dprintfInsert(fileInfo.fileName(), pBreakpointTreeItem->getLineNumber().toInt(),
+                                            pBreakpointTreeItem->getLogMessage(), pBreakpointTreeItem->getLogArguments(),
+                                            !pBreakpointTreeItem->isEnabled(), pBreakpointTreeItem->getCondition(),
+                                            pBreakpointTreeItem->getIgnoreCount());
+  } else {
+    command = CommandFactory::breakInsert(fileInfo.fileName(), pBreakpointTreeItem->getLineNumber().toInt(), !pBreakpointTreeItem->isEnabled(),
+                                          pBreakpointTreeItem->getCondition(), pBreakpointTreeItem->getIgnoreCount());
+  }
   postCommand(command, pBreakpointTreeItem, &GDBAdapter::insertBreakpointCB);
 }
 
@@ -910,11 +1166,41 @@ void GDBAdapter::handleGDBProcessStartedHelper()
    * GDB change the program arguments if we pass them through --args e.g -override=variableFilter=.*
    */
   postCommand(CommandFactory::GDBSet(QString("args %1").arg(mInferiorArguments.join(" "))), GDBAdapter::NonCriticalResponse);
+  sourceLocalsScript();
   /* Insert breakpoints */
   insertCatchOMCBreakpoint();
   insertBreakpoints();
 }
 
+/*!
+ * \brief GDBAdapter::sourceLocalsScript
+ * Copies Resources/gdb/omedit_locals.py to the temp directory and reads it in GDB.\n
+ * The locals are retrieved in batches only if GDB can read the script i.e., GDB is built with python.
+ */
+void GDBAdapter::sourceLocalsScript()
+{
+  mBatchedLocalsRetrieval = false;
+  QString fileName = QString("%1omedit_locals.py").arg(Utilities::tempDirectory());
+  if (QFile::exists(fileName)) {
+    QFile::remove(fileName);
+  }
+  if (QFile::copy(":/Resources/gdb/omedit_locals.py", fileName)) {
+    /* the copy of a resource file is read only. */
+    QFile::setPermissions(fileName, QFile::ReadOwner | QFile::WriteOwner);
+    postCommand(CommandFactory::source(fileName), GDBAdapter::SilentCommand, &GDBAdapter::sourceLocalsScriptCB);
+  }
+}
+
+/*!
+ * \brief GDBAdapter::sourceLocalsScriptCB
+ * Callback function for handling the -interpreter-exec console "source omedit_locals.py" command.
+ * \param pGDBMIResultRecord
+ */
+void GDBAdapter::sourceLocalsScriptCB(GDBMIResultRecord *pGDBMIResultRecord)
+{
+  mBatchedLocalsRetrieval = pGDBMIResultRecord->cls.compare("done") == 0;
+}
+
 /*!
  * \brief GDBAdapter::writeDebuggerCommandLog
  * Writes the debugger command to the omeditdebugger.log file.
@@ -950,8 +1236,10 @@ void GDBAdapter::writeDebuggerResponseLog(QString response)
  */
 void GDBAdapter::insertBreakpoints()
 {
+  BreakpointsTreeModel *pBreakpointsTreeModel = MainWindow::instance()->getBreakpointsWidget()->getBreakpointsTreeModel();
+  pBreakpointsTreeModel->resetBreakpointHitCounts();
   QList<BreakpointTreeItem*> breakpoints;
-  breakpoints = MainWindow::instance()->getBreakpointsWidget()->getBreakpointsTreeModel()->getRootBreakpointTreeItem()->getChildren();
+  breakpoints = pBreakpointsTreeModel->getRootBreakpointTreeItem()->getChildren();
   foreach (BreakpointTreeItem *pBreakpoint, breakpoints) {
     insertBreakpoint(pBreakpoint);
   }
@@ -981,14 +1269,14 @@ void GDBAdapter::startDebugger()
  * Process the GDB output.
  * \param response
  */
-void GDBAdapter::processGDBMIResponse(QString response)
+void GDBAdapter::processGDBMIResponse(const QByteArray &response)
 {
   if (response.isEmpty() || response == "(gdb) ") {
     return;
   }
 
   mCurrentResponse = response;
-  GDBMIResponse *pGDBMIResponse = parseGDBOutput(response.toStdString().c_str());
+  GDBMIResponse *pGDBMIResponse = parseGDBOutput(response.constData(), response.size());
 //  fprintf(stdout, "Read Line :: %s\n\n", response.toStdString().c_str());fflush(NULL);
 //  fprintf(stdout, "Parsed Line :: ");fflush(NULL);
 //  printGDBMIResponse(pGDBMIResponse);
@@ -1004,7 +1292,7 @@ void GDBAdapter::processGDBMIResponse(QString response)
       //qDebug() << "ResultRecordResponse" << response;
       processGDBMIResultRecord(pGDBMIResponse->miResultRecord);
     } else {
-      MainWindow::instance()->getTargetOutputWidget()->logDebuggerStandardOutput(response);
+      MainWindow::instance()->getTargetOutputWidget()->logDebuggerStandardOutput(QString(response));
     }
     delete pGDBMIResponse;
   } else {
@@ -1075,7 +1363,9 @@ void GDBAdapter::processGDBMIResultRecord(GDBMIResultRecord *pGDBMIResultRecord)
       /* Display few of the notify-async-output on the StackFramesWidget message label.
        * Not sure what to do of these notification at the moment.
        */
-      MainWindow::instance()->getStackFramesWidget()->setStatusMessage(mCurrentResponse);
+      MainWindow::instance()->getStackFramesWidget()->setStatusMessage(QString(mCurrentResponse));
+    } else if (pGDBMIResultRecord->cls.compare("breakpoint-modified") == 0) {
+      handleBreakpointModified(pGDBMIResultRecord);
     } else if (pGDBMIResultRecord->cls.compare("error") == 0) {
       /* handle the error response */
       GDBMIResult* pGDBMIResult = getGDBMIResult("msg", pGDBMIResultRecord->miResultsList);
@@ -1089,15 +1379,17 @@ void GDBAdapter::processGDBMIResultRecord(GDBMIResultRecord *pGDBMIResultRecord)
     mPendingLogStreamOutput.clear();
     if (mGDBMICommandsHash.contains(pGDBMIResultRecord->token)) {
       cmd = mGDBMICommandsHash.value(pGDBMIResultRecord->token);
+      MainWindow::instance()->getGDBLoggerWidget()->logCommandLatency(cmd.mCommandType, cmd.mElapsedTimer.elapsed());
       /* if cmd has callback function then call it. */
       if (cmd.mGDBCommandCallback) {
         (this->*cmd.mGDBCommandCallback)(pGDBMIResultRecord);
       }
-      if (cmd.mFlags & GDBAdapter::BlockUntilResponse) {
-        emit commandCompleted();
+      mGDBMICommandsHash.remove(pGDBMIResultRecord->token);
+      if (!cmd.mCoalesceKey.isEmpty() && mCoalescedCommandsHash.value(cmd.mCoalesceKey, 0) == pGDBMIResultRecord->token) {
+        mCoalescedCommandsHash.remove(cmd.mCoalesceKey);
       }
-      cmd.mCompleted = true;
-      mGDBMICommandsHash[pGDBMIResultRecord->token] = cmd;
+      mCommandsInFlight = qMax(0, mCommandsInFlight - 1);
+      writePendingCommands();
     }
     /* handle the error response */
     if (pGDBMIResultRecord->cls.compare("error") == 0) {
@@ -1142,6 +1434,11 @@ void GDBAdapter::handleGDBMIStreamRecord(GDBMIStreamRecord *pGDBMIStreamRecord)
 void GDBAdapter::handleGDBMIConsoleStream(GDBMIStreamRecord *pGDBMIStreamRecord)
 {
   QString consoleData = StringHandler::unparse(pGDBMIStreamRecord->value.c_str());
+  /* the logpoint messages are printed by GDB while the program keeps running. */
+  if (consoleData.startsWith(CommandFactory::logpointPrefix())) {
+    MainWindow::instance()->getTargetOutputWidget()->logDebuggerStandardOutput(consoleData.mid(CommandFactory::logpointPrefix().size()));
+    return;
+  }
   mPendingConsoleStreamOutput += consoleData;
   /* Only display some selected console messages */
   if (consoleData.startsWith("Reading symbols from ") || consoleData.startsWith("[New ") || consoleData.startsWith("[Thread ")) {
@@ -1180,7 +1477,7 @@ bool GDBAdapter::skipSteppedInFrames(GDBMIResultRecord *pGDBMIResultRecord)
 {
   GDBMIResult *pGDBMIResult = getGDBMIResult("frame", pGDBMIResultRecord->miResultsList);
   if (pGDBMIResult && pGDBMIResult->miValue->type == GDBMIValue::TupleValue) {
-    GDBMIResultList resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
+    const GDBMIResultList &resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
     QString file = getGDBMIConstantValue(getGDBMIResult("file", resultsList));
     QFileInfo fileInfo(file);
     if (!Utilities::isModelicaFile(fileInfo.suffix())) {
@@ -1207,7 +1504,7 @@ void GDBAdapter::handleStoppedEvent(string reason, GDBMIResultRecord *pGDBMIResu
   // call changeStdStreamBuffer no matter for what reason we have stopped
   if (!isChangeStdStreamBuffer() && !(reason.compare("\"exited-normally\"") == 0 || reason.compare("\"exited\""))) {
     setChangeStdStreamBuffer(true);
-    postCommand(CommandFactory::changeStdStreamBuffer(), GDBAdapter::NonCriticalResponse | GDBAdapter::BlockUntilResponse);
+    postCommand(CommandFactory::changeStdStreamBuffer(), GDBAdapter::NonCriticalResponse);
   }
   if (reason.compare("\"breakpoint-hit\"") == 0) {
     handleBreakpointHit(pGDBMIResultRecord);
@@ -1239,7 +1536,7 @@ void GDBAdapter::handleBreakpointHit(GDBMIResultRecord *pGDBMIResultRecord)
 {
   GDBMIResult *pGDBMIResult = getGDBMIResult("frame", pGDBMIResultRecord->miResultsList);
   if (pGDBMIResult && pGDBMIResult->miValue->type == GDBMIValue::TupleValue) {
-    GDBMIResultList resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
+    const GDBMIResultList &resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
     QString file = getGDBMIConstantValue(getGDBMIResult("file", resultsList));
     if (file.compare("Catch.omc") == 0) {
       disableCatchOMCBreakpoint();
@@ -1253,6 +1550,11 @@ void GDBAdapter::handleBreakpointHit(GDBMIResultRecord *pGDBMIResultRecord)
   /* Display stopped message */
   QString breakPoint = getGDBMIConstantValue(getGDBMIResult("bkptno", pGDBMIResultRecord->miResultsList));
   int breakPointNumber = breakPoint.toInt() - 1; /* since we add an internal breakpoint at Catch.omc:1 */
+  BreakpointsTreeModel *pBreakpointsTreeModel = MainWindow::instance()->getBreakpointsWidget()->getBreakpointsTreeModel();
+  BreakpointTreeItem *pBreakpointTreeItem = pBreakpointsTreeModel->findBreakpointTreeItem(breakPoint);
+  if (pBreakpointTreeItem) {
+    pBreakpointsTreeModel->increaseBreakpointStopCount(pBreakpointTreeItem);
+  }
   QString threadId = getGDBMIConstantValue(getGDBMIResult("thread-id", pGDBMIResultRecord->miResultsList));
   MainWindow::instance()->getStackFramesWidget()->setStatusMessage(QString("Stopped at breakpoint %1 in thread %2").arg(breakPointNumber).arg(threadId));
   /* Get the list of threads. */
@@ -1262,6 +1564,28 @@ void GDBAdapter::handleBreakpointHit(GDBMIResultRecord *pGDBMIResultRecord)
   postCommand(CommandFactory::stackListFrames(pStackFramesWidget->getSelectedThread()), &GDBAdapter::stackListFramesCB);
 }
 
+/*!
+ * \brief GDBAdapter::handleBreakpointModified
+ * Handles the GDB =breakpoint-modified notification.\n
+ * GDB sends it every time a breakpoint is hit, including the hits skipped by the ignore count and the logpoint hits,
+ * so the hit count of the breakpoint is updated without stopping the program.
+ * \param pGDBMIResultRecord
+ */
+void GDBAdapter::handleBreakpointModified(GDBMIResultRecord *pGDBMIResultRecord)
+{
+  GDBMIResult *pGDBMIResult = getGDBMIResult("bkpt", pGDBMIResultRecord->miResultsList);
+  if (pGDBMIResult && pGDBMIResult->miValue->type == GDBMIValue::TupleValue) {
+    const GDBMIResultList &resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
+    QString breakpointID = getGDBMIConstantValue(getGDBMIResult("number", resultsList));
+    BreakpointsTreeModel *pBreakpointsTreeModel = MainWindow::instance()->getBreakpointsWidget()->getBreakpointsTreeModel();
+    BreakpointTreeItem *pBreakpointTreeItem = pBreakpointsTreeModel->findBreakpointTreeItem(breakpointID);
+    if (pBreakpointTreeItem) {
+      pBreakpointsTreeModel->updateBreakpointHitCount(pBreakpointTreeItem,
+                                                      getGDBMIConstantValue(getGDBMIResult("times", resultsList)).toInt());
+    }
+  }
+}
+
 /*!
  * \brief GDBAdapter::handleSteppingRange
  * Handles the GDB end stepping range event.
@@ -1320,7 +1644,7 @@ void GDBAdapter::handleSignalReceived(GDBMIResultRecord *pGDBMIResultRecord)
         "thread-id=\"%3\"\n").arg(signalName, signalMeaning, threadId);
     GDBMIResult *pFrameGDBMIResult = getGDBMIResult("frame", pGDBMIResultRecord->miResultsList);
     if (pFrameGDBMIResult && pFrameGDBMIResult->miValue->type == GDBMIValue::TupleValue) {
-      GDBMIResultList resultsList = pFrameGDBMIResult->miValue->miTuple->miResultsList;
+      const GDBMIResultList &resultsList = pFrameGDBMIResult->miValue->miTuple->miResultsList;
       QString level = getGDBMIConstantValue(getGDBMIResult("level", resultsList));
       QString address = getGDBMIConstantValue(getGDBMIResult("addr", resultsList));
       QString function = getGDBMIConstantValue(getGDBMIResult("func", resultsList));
@@ -1429,14 +1753,9 @@ void GDBAdapter::readGDBStandardOutput()
   mGDBCommandTimer.start(); // Restart timer.
   int newstart = 0;
   int scan = mStandardOutputBuffer.size();
-  QString standardOutput = mpGDBProcess->readAllStandardOutput();
-  mStandardOutputBuffer.append(standardOutput);
-  // This can trigger when a blocking command starts an event loop.
+  mStandardOutputBuffer.append(mpGDBProcess->readAllStandardOutput());
+  // This can trigger when a callback starts an event loop e.g., a dialog. The outer call parses the appended output.
   if (isParsingStandardOutput()) {
-    GDBMICommand cmd = mGDBMICommandsHash.value(currentToken());
-    if (cmd.mFlags & GDBAdapter::BlockUntilResponse && standardOutput.startsWith(QString::number(currentToken()))) {
-      emit commandCompleted();
-    }
     return;
   }
   while (newstart < mStandardOutputBuffer.size()) {
@@ -1460,9 +1779,11 @@ void GDBAdapter::readGDBStandardOutput()
     }
 #endif
     setParsingStandardOutput(true);
-    QString response(QByteArray::fromRawData(mStandardOutputBuffer.constData() + start, end - start));
-    writeDebuggerResponseLog(response);
-    MainWindow::instance()->getGDBLoggerWidget()->logDebuggerStandardResponse(response);
+    /* A deep copy since a callback can start an event loop which appends to mStandardOutputBuffer. */
+    QByteArray response(mStandardOutputBuffer.constData() + start, end - start);
+    QString responseString(response);
+    writeDebuggerResponseLog(responseString);
+    MainWindow::instance()->getGDBLoggerWidget()->logDebuggerStandardResponse(responseString);
     processGDBMIResponse(response);
     setParsingStandardOutput(false);
   }
@@ -1522,6 +1843,7 @@ void GDBAdapter::handleGDBProcessFinished(int exitCode)
   if (mGDBCommandTimer.isActive()) {
     mGDBCommandTimer.stop();
   }
+  clearCommands();
   setGDBRunning(false);
   /* close the debugger log file */
   mDebuggerLogFile.close();
@@ -1552,7 +1874,7 @@ void GDBAdapter::GDBcommandTimeout()
   bool killIt = false;
   foreach (int key, keys) {
     const GDBMICommand &cmd = mGDBMICommandsHash.value(key);
-    if (!cmd.mCompleted && !(cmd.mFlags & GDBAdapter::NonCriticalResponse)) {
+    if (!(cmd.mFlags & GDBAdapter::NonCriticalResponse)) {
       killIt = true;
     }
   }
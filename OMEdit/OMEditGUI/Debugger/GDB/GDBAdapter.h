@@ -41,6 +41,12 @@
 #include <QProcess>
 #include <QDateTime>
 #include <QTimer>
+#include <QTreeWidget>
+#include <QPointer>
+#include <QQueue>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QVariant>
 
 #include "Debugger/Parser/GDBMIParser.h"
 #include "Debugger/Breakpoints/BreakpointsWidget.h"
@@ -61,11 +67,25 @@ public:
   void logDebuggerCommand(QString command);
   void logDebuggerStandardResponse(QString response);
   void logDebuggerErrorResponse(QString response);
+  void logCommandLatency(QString commandType, qint64 latency);
+  void clearCommandLatencies();
 private:
   QPlainTextEdit *mpCommandsTextBox;
   QPlainTextEdit *mpResponseTextBox;
   QLineEdit *mpCommandTextBox;
   QPushButton *mpSendCommandButton;
+  QTreeWidget *mpCommandLatencyTreeWidget;
+
+  struct CommandLatency
+  {
+    CommandLatency() {mCount = 0; mTotal = 0; mMaximum = 0; mpTreeWidgetItem = 0;}
+    int mCount;
+    qint64 mTotal;
+    qint64 mMaximum;
+    QVector<int> mHistogram;
+    QTreeWidgetItem *mpTreeWidgetItem;
+  };
+  QHash<QString, CommandLatency> mCommandLatenciesHash;
 
   void logDebuggerResponse(QString response, QColor color);
 public slots:
@@ -105,8 +125,7 @@ public:
     NoFlags = 0,
     ConsoleCommand = 1, // This is a command that needs to be wrapped into -interpreter-exec console
     NonCriticalResponse = 2,
-    SilentCommand = 4, // Ignore the error of this command
-    BlockUntilResponse = 8 // Blocks until the command has recieved the answer
+    SilentCommand = 4 // Ignore the error of this command
   };
   Q_DECLARE_FLAGS(GDBCommandFlags, GDBCommandFlag)
   enum ExecuteCommand {
@@ -141,6 +160,7 @@ public:
   int currentToken() {return mToken;}
   void setChangeStdStreamBuffer(bool changeStdStreamBuffer) {mChangeStdStreamBuffer = changeStdStreamBuffer;}
   bool isChangeStdStreamBuffer() {return mChangeStdStreamBuffer;}
+  bool isBatchedLocalsRetrieval() {return mBatchedLocalsRetrieval;}
   int commandTimeoutTime() const;
   void insertCatchOMCBreakpoint();
   void enableCatchOMCBreakpoint();
@@ -154,9 +174,11 @@ public:
   void arrayLengthCB(GDBMIResultRecord *pGDBMIResultRecord);
   void getMetaTypeElementCB(GDBMIResultRecord *pGDBMIResultRecord);
   void isOptionNoneCB(GDBMIResultRecord *pGDBMIResultRecord);
+  void retrieveLocalsCB(GDBMIResultRecord *pGDBMIResultRecord);
+  void retrieveLocalChildrenCB(GDBMIResultRecord *pGDBMIResultRecord);
   void createFullBacktraceCB(GDBMIResultRecord *pGDBMIResultRecord);
   void insertBreakpointCB(GDBMIResultRecord *pGDBMIResultRecord);
-  GDBMIResult* getGDBMIResult(const char *variable, GDBMIResultList resultsList);
+  GDBMIResult* getGDBMIResult(const char *variable, const GDBMIResultList &resultsList);
   QString getGDBMIConstantValue(GDBMIResult *pGDBMIResult);
   void insertBreakpoint(BreakpointTreeItem *pBreakpointTreeItem);
   void suspendDebugger();
@@ -173,13 +195,14 @@ private:
   QByteArray mStandardOutputBuffer;
   QByteArray mPendingConsoleStreamOutput;
   QByteArray mPendingLogStreamOutput;
-  QString mCurrentResponse;
+  QByteArray mCurrentResponse;
   bool mIsParsingStandardOutput;
   bool mIsInferiorSuspended;
   bool mIsInferiorTerminated;
   bool mIsInferiorRunning;
   int mToken;
   bool mChangeStdStreamBuffer;
+  bool mBatchedLocalsRetrieval;
   QString mCatchOMCBreakpointId;
   QFile mDebuggerLogFile;
   QTextStream mDebuggerLogFileTextStream;
@@ -188,22 +211,37 @@ private:
 
   struct GDBMICommand
   {
-    GDBMICommand() {mFlags = 0; mpCallbackObject = 0; mGDBCommandCallback = 0; mCompleted = false;}
+    GDBMICommand() {mFlags = 0; mGDBCommandCallback = 0;}
     int mFlags;
-    QObject *mpCallbackObject;
+    QPointer<QObject> mpCallbackObject;
     GDBCommandCallback mGDBCommandCallback;
     QByteArray mCommand;
-    bool mCompleted;
+    QByteArray mCoalesceKey;
+    QString mCommandType;
+    QElapsedTimer mElapsedTimer;
   };
+  // the commands that are waiting for the response.
   QHash<int, GDBMICommand> mGDBMICommandsHash;
+  // the commands that are not yet written to GDB.
+  QQueue<int> mPendingCommandsQueue;
+  // the in flight commands that can be coalesced with the same request.
+  QHash<QByteArray, int> mCoalescedCommandsHash;
+  int mCommandsInFlight;
+  static const int mMaximumCommandsInFlight = 64;
   QTimer mGDBCommandTimer;
 
   void handleGDBProcessStartedHelper();
+  void sourceLocalsScript();
+  void sourceLocalsScriptCB(GDBMIResultRecord *pGDBMIResultRecord);
+  bool readBatchedLocals(GDBMIResultRecord *pGDBMIResultRecord, QList<QVector<QVariant> > *pLocals);
+  QVariantMap getBatchedLocalValue(GDBMIValue *pGDBMIValue);
+  void writePendingCommands();
+  void clearCommands();
   void writeDebuggerCommandLog(QByteArray command);
   void writeDebuggerResponseLog(QString response);
   void insertBreakpoints();
   void startDebugger();
-  void processGDBMIResponse(QString response);
+  void processGDBMIResponse(const QByteArray &response);
   void processGDBMIOutOfBandRecord(GDBMIOutOfBandRecord *pGDBMIOutOfBandRecord);
   void processGDBMIResultRecord(GDBMIResultRecord *pGDBMIResultRecord);
   void handleGDBMIStreamRecord(GDBMIStreamRecord *pGDBMIStreamRecord);
@@ -212,6 +250,7 @@ private:
   bool skipSteppedInFrames(GDBMIResultRecord *pGDBMIResultRecord);
   void handleStoppedEvent(string reason, GDBMIResultRecord *pGDBMIResultRecord);
   void handleBreakpointHit(GDBMIResultRecord *pGDBMIResultRecord);
+  void handleBreakpointModified(GDBMIResultRecord *pGDBMIResultRecord);
   void handleSteppingRange(GDBMIResultRecord *pGDBMIResultRecord);
   void handleFunctionFinished(GDBMIResultRecord *pGDBMIResultRecord);
   void handleSignalReceived(GDBMIResultRecord *pGDBMIResultRecord);
@@ -220,7 +259,6 @@ private:
 signals:
   void GDBProcessStarted();
   void GDBProcessFinished();
-  void commandCompleted();
   void inferiorSuspended();
   void inferiorResumed();
   void stackListFrames(GDBMIValue *pStackGDBMIValue);
@@ -34,6 +34,7 @@
 #include "Debugger/Locals/LocalsWidget.h"
 #include "MainWindow.h"
 #include "Modeling/LibraryTreeWidget.h"
+#include "Options/OptionsDialog.h"
 #include "Debugger/GDB/GDBAdapter.h"
 #include "Debugger/StackFrames/StackFramesWidget.h"
 #include "Debugger/Locals/ModelicaValue.h"
@@ -50,7 +51,8 @@
  * 0 -> name\n
  * 1 -> displayName\n
  * 2 -> type\n
- * 3 -> value
+ * 3 -> value\n
+ * 4 -> the QVariantMap of GDBAdapter::getBatchedLocalValue if the locals are retrieved in batches.
  * \param localItemData
  * \param pLocalsTreeModel
  * \param pLocalsTreeItem
@@ -70,6 +72,11 @@ LocalsTreeItem::LocalsTreeItem(const QVector<QVariant> &localItemData, LocalsTre
     setDisplayName(getName());
     setDisplayType(getType());
     setDisplayValue(localItemData[3].toString());
+  } else if (localItemData.size() > 4) {
+    /* the type, value and children size are already retrieved by GDBAdapter::retrieveLocalsCB. */
+    setDisplayType("");
+    setDisplayValue("");
+    setBatchedValue(localItemData[4].toMap());
   } else if (mpParentLocalsTreeItem == mpLocalsTreeModel->getRootLocalsTreeItem()) {
     /* if the item is a top level item then we need to fetch the type and value. */
     setDisplayType("");
@@ -227,11 +234,11 @@ void LocalsTreeItem::retrieveModelicaMetaType()
     if (parent() && parent()->getModelicaValue() && qobject_cast<ModelicaRecordValue*>(parent()->getModelicaValue())) {
       pGDBAdapter->postCommand(CommandFactory::getTypeOfAny(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
                                                             getName(), true),
-                               GDBAdapter::BlockUntilResponse, this, &GDBAdapter::getTypeOfAnyCB);
+                               this, &GDBAdapter::getTypeOfAnyCB);
     } else {
       pGDBAdapter->postCommand(CommandFactory::getTypeOfAny(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
                                                             getName(), false),
-                               GDBAdapter::BlockUntilResponse, this, &GDBAdapter::getTypeOfAnyCB);
+                               this, &GDBAdapter::getTypeOfAnyCB);
     }
   } else {
     retrieveValue();
@@ -249,10 +256,10 @@ void LocalsTreeItem::retrieveValue()
   if (isCoreTypeExceptString()) {
     pGDBAdapter->postCommand(CommandFactory::dataEvaluateExpression(pStackFramesWidget->getSelectedThread(),
                                                                     pStackFramesWidget->getSelectedFrame(), getName()),
-                             GDBAdapter::BlockUntilResponse, this, &GDBAdapter::dataEvaluateExpressionCB);
+                             this, &GDBAdapter::dataEvaluateExpressionCB);
   } else if (isCoreType()) {
     pGDBAdapter->postCommand(CommandFactory::anyString(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
-                                                       getName()), GDBAdapter::BlockUntilResponse, this, &GDBAdapter::anyStringCB);
+                                                       getName()), this, &GDBAdapter::anyStringCB);
   } else {
     setValue(getDisplayType());
   }
@@ -276,58 +283,116 @@ void LocalsTreeItem::setModelicaMetaType(QString type)
 }
 
 void LocalsTreeItem::setValue(QString value)
+{
+  setModelicaValue(value);
+  /* update the view with new values of LocalsTreeItem */
+  mpLocalsTreeModel->updateLocalsTreeItem(this);
+}
+
+/*!
+ * \brief LocalsTreeItem::setModelicaValue
+ * Sets the value of the LocalsTreeItem without updating the view.
+ * \param value
+ * \param childrenSize - the children size if already known. Otherwise it is retrieved with ModelicaValue::retrieveChildrenSize.
+ */
+void LocalsTreeItem::setModelicaValue(QString value, QString childrenSize)
 {
   if (mpModelicaValue) {
     QString previousValue = mpModelicaValue->getValueString();
     mpModelicaValue->setValue(value);
-    setDisplayValue(mpModelicaValue->getValueString());
-    /* if value is changed then set the value changed flag. */
-    if (getDisplayValue().compare(previousValue) == 0) {
-      setValueChanged(false);
+    /* the children size may have changed as well. */
+    if (childrenSize.isNull()) {
+      mpModelicaValue->retrieveChildrenSize();
     } else {
+      mpModelicaValue->setChildrenSize(childrenSize);
+    }
+    setDisplayValue(mpModelicaValue->getValueString());
+    /* if value is changed then set the value changed flag. The flag is cleared on the next stop by LocalsTreeModel::updateLocalsCache. */
+    if (getDisplayValue().compare(previousValue) != 0) {
       setValueChanged(true);
     }
+    return;
   } else if (isCoreType()) {
     mpModelicaValue = new ModelicaCoreValue(this);
-    mpModelicaValue->setValue(value);
-    setDisplayValue(mpModelicaValue->getValueString());
   } else if (getDisplayType().startsWith(Helper::RECORD)) {
     mpModelicaValue = new ModelicaRecordValue(this);
-    mpModelicaValue->setValue(value);
-    setDisplayValue(mpModelicaValue->getValueString());
-    /* get the record elements size */
-    mpModelicaValue->retrieveChildrenSize();
   } else if (getDisplayType().startsWith(Helper::LIST)) {
     mpModelicaValue = new ModelicaListValue(this);
-    setDisplayValue(mpModelicaValue->getValueString());
-    /* get the list items size */
-    mpModelicaValue->retrieveChildrenSize();
   } else if (getDisplayType().startsWith(Helper::OPTION)) {
     mpModelicaValue = new ModelicaOptionValue(this);
-    setDisplayValue(mpModelicaValue->getValueString());
-    /* get the option item elements size */
-    mpModelicaValue->retrieveChildrenSize();
   } else if (getDisplayType().startsWith(Helper::TUPLE)) {
     mpModelicaValue = new ModelicaTupleValue(this);
-    setDisplayValue(mpModelicaValue->getValueString());
-    /* get the tuple elements size */
-    mpModelicaValue->retrieveChildrenSize();
   } else if (getDisplayType().startsWith(Helper::ARRAY)) {
     mpModelicaValue = new MetaModelicaArrayValue(this);
-    setDisplayValue(mpModelicaValue->getValueString());
-    /* get the tuple elements size */
+  } else {
+    return;
+  }
+  mpModelicaValue->setValue(value);
+  setDisplayValue(mpModelicaValue->getValueString());
+  /* get the record elements, list items, option, tuple or array elements size */
+  if (childrenSize.isNull()) {
     mpModelicaValue->retrieveChildrenSize();
+  } else {
+    mpModelicaValue->setChildrenSize(childrenSize);
+  }
+}
+
+/*!
+ * \brief LocalsTreeItem::setBatchedValue
+ * Sets the type, value and children size retrieved by the batched locals command without sending any command.
+ * \param value - the QVariantMap of GDBAdapter::getBatchedLocalValue.
+ */
+void LocalsTreeItem::setBatchedValue(const QVariantMap &value)
+{
+  setDisplayType(value.value("modelicaType").toString());
+  if (getDisplayType().compare(Helper::REPLACEABLE_TYPE_ANY) == 0) {
+    setDisplayValue(tr("<uninitialized variable>"));
+  } else if (value.contains("value")) {
+    setModelicaValue(value.value("value").toString(), value.value("size").toString());
   }
-  /* update the view with new values of LocalsTreeItem */
-  mpLocalsTreeModel->updateLocalsTreeItem(this);
 }
 
+/*!
+ * \brief LocalsTreeItem::retrievalQueriesCount
+ * Returns the number of queries needed to retrieve the type, value and children size of the LocalsTreeItem.
+ * \return
+ */
+int LocalsTreeItem::retrievalQueriesCount()
+{
+  int count = 0;
+  if ((getType().compare(Helper::MODELICA_METATYPE) == 0) || (getType().compare(Helper::MODELICA_STRING) == 0)) {
+    count++;
+  }
+  /* the value of a core type or the children size of the other values. */
+  if (isCoreType() || mpModelicaValue) {
+    count++;
+  }
+  return count;
+}
+
+/*!
+ * \brief LocalsTreeItem::retrieveLocalChildren
+ * Retrieves the children of the LocalsTreeItem.\n
+ * With the batched locals retrieval all the children are retrieved with one command unless they are already prefetched.
+ */
 void LocalsTreeItem::retrieveLocalChildren()
 {
   if (!mpModelicaValue) {
     return;
   }
-  mpModelicaValue->retrieveChildren();
+  GDBAdapter *pGDBAdapter = GDBAdapter::instance();
+  if (pGDBAdapter->isBatchedLocalsRetrieval()) {
+    if (mChildren.isEmpty() && mpModelicaValue->hasChildren()) {
+      StackFramesWidget *pStackFramesWidget = MainWindow::instance()->getStackFramesWidget();
+      int depth = OptionsDialog::instance()->getDebuggerPage()->getLocalsPrefetchDepthSpinBox()->value();
+      pGDBAdapter->postCommand(CommandFactory::retrieveLocalChildren(pStackFramesWidget->getSelectedThread(),
+                                                                     pStackFramesWidget->getSelectedFrame(), getName(), getDisplayType(),
+                                                                     qMax(depth - 1, 0)),
+                               GDBAdapter::SilentCommand, this, &GDBAdapter::retrieveLocalChildrenCB);
+    }
+  } else {
+    mpModelicaValue->retrieveChildren();
+  }
 }
 
 LocalsTreeModel::LocalsTreeModel(LocalsWidget *pLocalsWidget)
@@ -449,43 +514,32 @@ LocalsTreeItem* LocalsTreeModel::findLocalsTreeItem(const QString &name, LocalsT
 
 QModelIndex LocalsTreeModel::localsTreeItemIndex(const LocalsTreeItem *pLocalsTreeItem) const
 {
-  return localsTreeItemIndexHelper(pLocalsTreeItem, mpRootLocalsTreeItem, QModelIndex());
-}
-
-QModelIndex LocalsTreeModel::localsTreeItemIndexHelper(const LocalsTreeItem *pLocalsTreeItem, const LocalsTreeItem *pParentLocalsTreeItem,
-                                                       const QModelIndex &parentIndex) const
-{
-  if (pLocalsTreeItem == pParentLocalsTreeItem) {
-    return parentIndex;
+  if (!pLocalsTreeItem || pLocalsTreeItem == mpRootLocalsTreeItem) {
+    return QModelIndex();
   }
-  for (int i = pParentLocalsTreeItem->getChildren().size(); --i >= 0; ) {
-    const LocalsTreeItem *childItem = pParentLocalsTreeItem->getChildren().at(i);
-    QModelIndex childIndex = index(i, 0, parentIndex);
-    QModelIndex index = localsTreeItemIndexHelper(pLocalsTreeItem, childItem, childIndex);
-    if (index.isValid()) {
-      return index;
-    }
+  int row = pLocalsTreeItem->row();
+  /* the item is not yet inserted in the model. */
+  if (row < 0) {
+    return QModelIndex();
   }
-  return QModelIndex();
+  return createIndex(row, 0, const_cast<LocalsTreeItem*>(pLocalsTreeItem));
 }
 
 void LocalsTreeModel::insertLocalItemData(const QVector<QVariant> &localItemData, LocalsTreeItem *pParentLocalsTreeItem)
 {
-  QString nameStructure;
-  /* construct the item name structure. */
-  if (mpRootLocalsTreeItem == pParentLocalsTreeItem) {
-    nameStructure = QString("%1.%2").arg(pParentLocalsTreeItem->getNameStructure()).arg(localItemData[0].toString());
-  } else {
-    nameStructure = QString("%1.%2%3").arg(pParentLocalsTreeItem->getNameStructure()).arg(localItemData[0].toString()).arg(localItemData[1].toString());
-  }
-  /* find the item */
-  LocalsTreeItem *pLocalsTreeItem = findLocalsTreeItem(nameStructure, pParentLocalsTreeItem);
-  if (pLocalsTreeItem) {
+  LocalsTreeItem *pLocalsTreeItem = findChildLocalsTreeItem(localItemNameStructure(localItemData, pParentLocalsTreeItem),
+                                                            pParentLocalsTreeItem);
+  if (pLocalsTreeItem && localItemData.size() > 4) {
+    QVariantMap value = localItemData[4].toMap();
+    pLocalsTreeItem->setBatchedValue(value);
+    updateLocalsTreeItem(pLocalsTreeItem);
+    insertBatchedChildren(value, pLocalsTreeItem);
+  } else if (pLocalsTreeItem) {
     pLocalsTreeItem->retrieveModelicaMetaType();
   } else {
     QModelIndex index = localsTreeItemIndex(pParentLocalsTreeItem);
-    pLocalsTreeItem = new LocalsTreeItem(localItemData, this, pParentLocalsTreeItem);
-    pLocalsTreeItem->setNameStructure(nameStructure);
+    /* the prefetched children are created along with the item so the view is notified once for the whole subtree. */
+    pLocalsTreeItem = createLocalsTreeItem(localItemData, pParentLocalsTreeItem);
     int row = pParentLocalsTreeItem->getChildren().size();
     beginInsertRows(index, row, row);
     pParentLocalsTreeItem->insertChild(row, pLocalsTreeItem);
@@ -493,30 +547,65 @@ void LocalsTreeModel::insertLocalItemData(const QVector<QVariant> &localItemData
   }
 }
 
-void LocalsTreeModel::insertLocalsList(const QList<QVector<QVariant> > &locals)
-{
-  QList<LocalsTreeItem*> localsTreeItems = mpRootLocalsTreeItem->getChildren();
-  foreach (LocalsTreeItem *pLocalsTreeItem, localsTreeItems) {
-    bool isFound = false;
-    foreach (QVector<QVariant> local, locals) {
-      QString nameStructure;
-      /* construct the item name structure. */
-      if (pLocalsTreeItem->parent() == mpRootLocalsTreeItem) {
-        nameStructure = QString("%1.%2").arg(pLocalsTreeItem->parent()->getNameStructure()).arg(local[0].toString());
-      } else {
-        nameStructure = QString("%1.%2%3").arg(pLocalsTreeItem->parent()->getNameStructure()).arg(local[0].toString()).arg(local[1].toString());
+/*!
+ * \brief LocalsTreeModel::updateLocalsCache
+ * Compares the locals of -stack-list-variables with the locals cache of the frame.\n
+ * A local is unchanged if its type and --simple-values value are the same as on the last stop. For MetaModelica values the value is
+ * the address of the immutable data so the type, value and children of an unchanged local need not be retrieved again.\n
+ * Removes the locals that are not on the stack anymore and clears the value changed highlighting of the last stop.\n
+ * The other locals are retrieved again and highlighted only if their retrieved values differ.
+ * \param frame - the thread, frame and function of the locals.
+ * \param locals - the locals as read from -stack-list-variables i.e., name, displayName, type and value.
+ * \return the new and changed locals.
+ */
+QList<QVector<QVariant> > LocalsTreeModel::updateLocalsCache(const QString &frame, const QList<QVector<QVariant> > &locals)
+{
+  /* the locals of another function. */
+  if (frame.compare(mLocalsCacheFrame) != 0) {
+    removeLocalItems();
+    mLocalsCacheFrame = frame;
+  }
+  removeStaleLocalItems(locals);
+  clearValueChanged(mpRootLocalsTreeItem);
+  QHash<QString, QPair<QString, QString> > localsCache;
+  QList<QVector<QVariant> > changedLocals;
+  int unchangedLocals = 0;
+  int savedQueries = 0;
+  foreach (QVector<QVariant> local, locals) {
+    QPair<QString, QString> typeAndValue = qMakePair(local[2].toString(), local[3].toString());
+    localsCache.insert(local[0].toString(), typeAndValue);
+    LocalsTreeItem *pLocalsTreeItem = findChildLocalsTreeItem(localItemNameStructure(local, mpRootLocalsTreeItem), mpRootLocalsTreeItem);
+    if (pLocalsTreeItem) {
+      /* GDB gives no value for the structures so we can't tell if they are changed. */
+      if (!typeAndValue.second.isEmpty() && mLocalsCache.value(local[0].toString()) == typeAndValue) {
+        unchangedLocals++;
+        savedQueries += pLocalsTreeItem->retrievalQueriesCount();
+        continue;
       }
-      /* compare the name structure to find the item. */
-      if (nameStructure.compare(pLocalsTreeItem->getNameStructure()) == 0) {
-        isFound = true;
-        break;
+      /* the local is retrieved again and LocalsTreeItem::setModelicaValue marks it changed only if the retrieved value differs. */
+      /* the type of a MetaModelica value can change as well e.g., another record of the uniontype. */
+      if ((pLocalsTreeItem->getType().compare(Helper::MODELICA_METATYPE) == 0)
+          || (pLocalsTreeItem->getType().compare(Helper::MODELICA_STRING) == 0)) {
+        pLocalsTreeItem->setDisplayType("");
       }
+      updateLocalsTreeItem(pLocalsTreeItem);
     }
-    /* if not found then the item has been removed from the stack so we must also remove it from the locals tree. */
-    if (!isFound) {
-      removeLocalItem(pLocalsTreeItem);
-    }
+    changedLocals.append(local);
   }
+  mLocalsCache = localsCache;
+  MainWindow::instance()->getGDBLoggerWidget()->logDebuggerStandardResponse(tr("Locals cache: %1 of %2 locals unchanged, %3 queries saved.")
+                                                                            .arg(unchangedLocals).arg(locals.size()).arg(savedQueries));
+  return changedLocals;
+}
+
+/*!
+ * \brief LocalsTreeModel::insertLocalsList
+ * Inserts the new locals and updates the existing ones.
+ * \param locals
+ * \see LocalsTreeModel::updateLocalsCache
+ */
+void LocalsTreeModel::insertLocalsList(const QList<QVector<QVariant> > &locals)
+{
   foreach (QVector<QVariant> local, locals) {
     insertLocalItemData(local, mpRootLocalsTreeItem);
   }
@@ -537,6 +626,8 @@ void LocalsTreeModel::removeLocalItem(LocalsTreeItem *pLocalsTreeItem)
 
 void LocalsTreeModel::removeLocalItems()
 {
+  mLocalsCacheFrame.clear();
+  mLocalsCache.clear();
   int n = mpRootLocalsTreeItem->getChildren().size();
   if (n == 0) {
     return;
@@ -555,7 +646,117 @@ void LocalsTreeModel::removeLocalItems()
 void LocalsTreeModel::updateLocalsTreeItem(LocalsTreeItem *pLocalsTreeItem)
 {
   QModelIndex index = localsTreeItemIndex(pLocalsTreeItem);
-  emit dataChanged(index, index);
+  if (index.isValid()) {
+    emit dataChanged(index, index);
+  }
+}
+
+/*!
+ * \brief LocalsTreeModel::findChildLocalsTreeItem
+ * Finds the LocalsTreeItem by name structure.\n
+ * Only the direct children of pParentLocalsTreeItem can have the name structure made by LocalsTreeModel::localItemNameStructure.
+ * \param nameStructure
+ * \param pParentLocalsTreeItem
+ * \return
+ */
+LocalsTreeItem* LocalsTreeModel::findChildLocalsTreeItem(const QString &nameStructure, LocalsTreeItem *pParentLocalsTreeItem) const
+{
+  foreach (LocalsTreeItem *pLocalsTreeItem, pParentLocalsTreeItem->getChildren()) {
+    if (pLocalsTreeItem->getNameStructure().compare(nameStructure) == 0) {
+      return pLocalsTreeItem;
+    }
+  }
+  return 0;
+}
+
+/*!
+ * \brief LocalsTreeModel::removeStaleLocalItems
+ * Removes the top level items that are not in the locals list anymore.
+ * \param locals
+ */
+void LocalsTreeModel::removeStaleLocalItems(const QList<QVector<QVariant> > &locals)
+{
+  QSet<QString> nameStructures;
+  foreach (QVector<QVariant> local, locals) {
+    nameStructures.insert(localItemNameStructure(local, mpRootLocalsTreeItem));
+  }
+  QList<LocalsTreeItem*> localsTreeItems = mpRootLocalsTreeItem->getChildren();
+  foreach (LocalsTreeItem *pLocalsTreeItem, localsTreeItems) {
+    /* if not found then the item has been removed from the stack so we must also remove it from the locals tree. */
+    if (!nameStructures.contains(pLocalsTreeItem->getNameStructure())) {
+      removeLocalItem(pLocalsTreeItem);
+    }
+  }
+}
+
+/*!
+ * \brief LocalsTreeModel::clearValueChanged
+ * Clears the value changed highlighting of the LocalsTreeItem and its children.
+ * \param pLocalsTreeItem
+ */
+void LocalsTreeModel::clearValueChanged(LocalsTreeItem *pLocalsTreeItem)
+{
+  if (pLocalsTreeItem->valueChanged()) {
+    pLocalsTreeItem->setValueChanged(false);
+    updateLocalsTreeItem(pLocalsTreeItem);
+  }
+  foreach (LocalsTreeItem *pChildLocalsTreeItem, pLocalsTreeItem->getChildren()) {
+    clearValueChanged(pChildLocalsTreeItem);
+  }
+}
+
+/*!
+ * \brief LocalsTreeModel::localItemNameStructure
+ * Returns the name structure of the local item i.e., the name structure of the parent followed by the name.
+ * \param localItemData
+ * \param pParentLocalsTreeItem
+ * \return
+ */
+QString LocalsTreeModel::localItemNameStructure(const QVector<QVariant> &localItemData, LocalsTreeItem *pParentLocalsTreeItem) const
+{
+  if (mpRootLocalsTreeItem == pParentLocalsTreeItem) {
+    return QString("%1.%2").arg(pParentLocalsTreeItem->getNameStructure()).arg(localItemData[0].toString());
+  } else {
+    return QString("%1.%2%3").arg(pParentLocalsTreeItem->getNameStructure()).arg(localItemData[0].toString()).arg(localItemData[1].toString());
+  }
+}
+
+/*!
+ * \brief LocalsTreeModel::createLocalsTreeItem
+ * Creates the LocalsTreeItem and its prefetched children without adding it to pParentLocalsTreeItem.
+ * \param localItemData
+ * \param pParentLocalsTreeItem
+ * \return
+ */
+LocalsTreeItem* LocalsTreeModel::createLocalsTreeItem(const QVector<QVariant> &localItemData, LocalsTreeItem *pParentLocalsTreeItem)
+{
+  LocalsTreeItem *pLocalsTreeItem = new LocalsTreeItem(localItemData, this, pParentLocalsTreeItem);
+  pLocalsTreeItem->setNameStructure(localItemNameStructure(localItemData, pParentLocalsTreeItem));
+  if (localItemData.size() > 4) {
+    foreach (QVariant child, localItemData[4].toMap().value("children").toList()) {
+      QVariantMap value = child.toMap();
+      QVector<QVariant> childItemData;
+      childItemData << value.value("name") << value.value("displayName") << value.value("type") << "" << value;
+      pLocalsTreeItem->insertChild(pLocalsTreeItem->getChildren().size(), createLocalsTreeItem(childItemData, pLocalsTreeItem));
+    }
+  }
+  return pLocalsTreeItem;
+}
+
+/*!
+ * \brief LocalsTreeModel::insertBatchedChildren
+ * Updates the children of pLocalsTreeItem with the prefetched children of the batched value.
+ * \param value - the QVariantMap of GDBAdapter::getBatchedLocalValue.
+ * \param pLocalsTreeItem
+ */
+void LocalsTreeModel::insertBatchedChildren(const QVariantMap &value, LocalsTreeItem *pLocalsTreeItem)
+{
+  foreach (QVariant child, value.value("children").toList()) {
+    QVariantMap childValue = child.toMap();
+    QVector<QVariant> childItemData;
+    childItemData << childValue.value("name") << childValue.value("displayName") << childValue.value("type") << "" << childValue;
+    insertLocalItemData(childItemData, pLocalsTreeItem);
+  }
 }
 
 /*!
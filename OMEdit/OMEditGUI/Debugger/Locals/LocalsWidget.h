@@ -35,6 +35,9 @@
 #define LOCALSWIDGET_H
 
 #include <QVector>
+#include <QHash>
+#include <QPair>
+#include <QSet>
 #include <QSortFilterProxyModel>
 #include <QTreeView>
 #include <QPlainTextEdit>
@@ -83,7 +86,10 @@ public:
   void retrieveValue();
   void setModelicaMetaType(QString type);
   void setValue(QString value);
+  void setModelicaValue(QString value, QString childrenSize = QString());
+  void setBatchedValue(const QVariantMap &value);
   void retrieveLocalChildren();
+  int retrievalQueriesCount();
 private:
   LocalsTreeModel *mpLocalsTreeModel;
   QList<LocalsTreeItem*> mChildren;
@@ -116,9 +122,8 @@ public:
   QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
   LocalsTreeItem* findLocalsTreeItem(const QString &name, LocalsTreeItem *root) const;
   QModelIndex localsTreeItemIndex(const LocalsTreeItem *pLocalsTreeItem) const;
-  QModelIndex localsTreeItemIndexHelper(const LocalsTreeItem *pLocalsTreeItem, const LocalsTreeItem *pParentLocalsTreeItem,
-                                        const QModelIndex &parentIndex) const;
   void insertLocalItemData(const QVector<QVariant> &localItemData, LocalsTreeItem *pParentLocalsTreeItem);
+  QList<QVector<QVariant> > updateLocalsCache(const QString &frame, const QList<QVector<QVariant> > &locals);
   void insertLocalsList(const QList<QVector<QVariant> > &locals);
   void removeLocalItem(LocalsTreeItem *pLocalsTreeItem);
   void removeLocalItems();
@@ -126,6 +131,17 @@ public:
 private:
   LocalsWidget *mpLocalsWidget;
   LocalsTreeItem *mpRootLocalsTreeItem;
+  /* the thread, frame and function of the locals in the cache. */
+  QString mLocalsCacheFrame;
+  /* the type and the --simple-values value of the locals i.e., the address of the MetaModelica values. */
+  QHash<QString, QPair<QString, QString> > mLocalsCache;
+
+  LocalsTreeItem* findChildLocalsTreeItem(const QString &nameStructure, LocalsTreeItem *pParentLocalsTreeItem) const;
+  void removeStaleLocalItems(const QList<QVector<QVariant> > &locals);
+  void clearValueChanged(LocalsTreeItem *pLocalsTreeItem);
+  QString localItemNameStructure(const QVector<QVariant> &localItemData, LocalsTreeItem *pParentLocalsTreeItem) const;
+  LocalsTreeItem* createLocalsTreeItem(const QVector<QVariant> &localItemData, LocalsTreeItem *pParentLocalsTreeItem);
+  void insertBatchedChildren(const QVariantMap &value, LocalsTreeItem *pLocalsTreeItem);
 };
 
 class LocalsTreeProxyModel : public QSortFilterProxyModel
@@ -80,7 +80,7 @@ void ModelicaRecordValue::retrieveChildrenSize()
   StackFramesWidget *pStackFramesWidget = MainWindow::instance()->getStackFramesWidget();
   pGDBAdapter->postCommand(CommandFactory::arrayLength(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
                                                        mpLocalsTreeItem->getName()),
-                           GDBAdapter::BlockUntilResponse, this, &GDBAdapter::arrayLengthCB);
+                           this, &GDBAdapter::arrayLengthCB);
 }
 
 QString ModelicaRecordValue::getValueString()
@@ -100,7 +100,7 @@ void ModelicaRecordValue::retrieveChildren()
     StackFramesWidget *pStackFramesWidget = MainWindow::instance()->getStackFramesWidget();
     QByteArray cmd = CommandFactory::getMetaTypeElement(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
                                                         mpLocalsTreeItem->getName(), i, CommandFactory::record_metaType);
-    pGDBAdapter->postCommand(cmd, GDBAdapter::BlockUntilResponse, mpLocalsTreeItem, &GDBAdapter::getMetaTypeElementCB);
+    pGDBAdapter->postCommand(cmd, mpLocalsTreeItem, &GDBAdapter::getMetaTypeElementCB);
   }
 }
 
@@ -116,7 +116,7 @@ void ModelicaListValue::retrieveChildrenSize()
   StackFramesWidget *pStackFramesWidget = MainWindow::instance()->getStackFramesWidget();
   pGDBAdapter->postCommand(CommandFactory::listLength(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
                                                       mpLocalsTreeItem->getName()),
-                           GDBAdapter::BlockUntilResponse, this, &GDBAdapter::arrayLengthCB);
+                           this, &GDBAdapter::arrayLengthCB);
 }
 
 QString ModelicaListValue::getValueString()
@@ -137,7 +137,7 @@ void ModelicaListValue::retrieveChildren()
     StackFramesWidget *pStackFramesWidget = MainWindow::instance()->getStackFramesWidget();
     QByteArray cmd = CommandFactory::getMetaTypeElement(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
                                                         mpLocalsTreeItem->getName(), i, CommandFactory::list_metaType);
-    pGDBAdapter->postCommand(cmd, GDBAdapter::BlockUntilResponse, mpLocalsTreeItem, &GDBAdapter::getMetaTypeElementCB);
+    pGDBAdapter->postCommand(cmd, mpLocalsTreeItem, &GDBAdapter::getMetaTypeElementCB);
   }
 }
 
@@ -153,7 +153,7 @@ void ModelicaOptionValue::retrieveChildrenSize()
   StackFramesWidget *pStackFramesWidget = MainWindow::instance()->getStackFramesWidget();
   pGDBAdapter->postCommand(CommandFactory::isOptionNone(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
                                                         mpLocalsTreeItem->getName()),
-                           GDBAdapter::BlockUntilResponse, this, &GDBAdapter::arrayLengthCB);
+                           this, &GDBAdapter::arrayLengthCB);
 }
 
 QString ModelicaOptionValue::getValueString()
@@ -178,7 +178,7 @@ void ModelicaOptionValue::retrieveChildren()
     StackFramesWidget *pStackFramesWidget = MainWindow::instance()->getStackFramesWidget();
     QByteArray cmd = CommandFactory::getMetaTypeElement(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
                                                         mpLocalsTreeItem->getName(), 1, CommandFactory::option_metaType);
-    pGDBAdapter->postCommand(cmd, GDBAdapter::BlockUntilResponse, mpLocalsTreeItem, &GDBAdapter::getMetaTypeElementCB);
+    pGDBAdapter->postCommand(cmd, mpLocalsTreeItem, &GDBAdapter::getMetaTypeElementCB);
   }
 }
 
@@ -194,7 +194,7 @@ void ModelicaTupleValue::retrieveChildrenSize()
   StackFramesWidget *pStackFramesWidget = MainWindow::instance()->getStackFramesWidget();
   pGDBAdapter->postCommand(CommandFactory::arrayLength(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
                                                        mpLocalsTreeItem->getName()),
-                           GDBAdapter::BlockUntilResponse, this, &GDBAdapter::arrayLengthCB);
+                           this, &GDBAdapter::arrayLengthCB);
 }
 
 QString ModelicaTupleValue::getValueString()
@@ -215,7 +215,7 @@ void ModelicaTupleValue::retrieveChildren()
     StackFramesWidget *pStackFramesWidget = MainWindow::instance()->getStackFramesWidget();
     QByteArray cmd = CommandFactory::getMetaTypeElement(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
                                                         mpLocalsTreeItem->getName(), i, CommandFactory::tuple_metaType);
-    pGDBAdapter->postCommand(cmd, GDBAdapter::BlockUntilResponse, mpLocalsTreeItem, &GDBAdapter::getMetaTypeElementCB);
+    pGDBAdapter->postCommand(cmd, mpLocalsTreeItem, &GDBAdapter::getMetaTypeElementCB);
   }
 }
 
@@ -231,7 +231,7 @@ void MetaModelicaArrayValue::retrieveChildrenSize()
   StackFramesWidget *pStackFramesWidget = MainWindow::instance()->getStackFramesWidget();
   pGDBAdapter->postCommand(CommandFactory::arrayLength(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
                                                        mpLocalsTreeItem->getName()),
-                           GDBAdapter::BlockUntilResponse, this, &GDBAdapter::arrayLengthCB);
+                           this, &GDBAdapter::arrayLengthCB);
 }
 
 QString MetaModelicaArrayValue::getValueString()
@@ -252,6 +252,6 @@ void MetaModelicaArrayValue::retrieveChildren()
     StackFramesWidget *pStackFramesWidget = MainWindow::instance()->getStackFramesWidget();
     QByteArray cmd = CommandFactory::getMetaTypeElement(pStackFramesWidget->getSelectedThread(), pStackFramesWidget->getSelectedFrame(),
                                                         mpLocalsTreeItem->getName(), i, CommandFactory::array_metaType);
-    pGDBAdapter->postCommand(cmd, GDBAdapter::BlockUntilResponse, mpLocalsTreeItem, &GDBAdapter::getMetaTypeElementCB);
+    pGDBAdapter->postCommand(cmd, mpLocalsTreeItem, &GDBAdapter::getMetaTypeElementCB);
   }
 }
@@ -153,7 +153,7 @@ result returns [GDBMIResult* miResult]
     miResult = new GDBMIResult;
   }
   : (var '=' value) {
-      miResult->variable = (char*)$var.text->chars;
+      miResult->setVariable((char*)$var.text->chars, strlen((char*)$var.text->chars));
       miResult->miValue = $value.miValue;
     }
   ;
@@ -0,0 +1,400 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "GDBMIParser.h"
+
+#include <string.h>
+
+namespace GDBMIParser {
+
+/* Hand-written recursive descent parser for GDB/MI output.
+ * It reads the bytes received from GDB in place. There is no token stream and every string is copied exactly once,
+ * into the GDBMI tree. Accepts the same language as GDBMIOutput.g, see
+ * https://sourceware.org/gdb/current/onlinedocs/gdb/GDB_002fMI-Output-Syntax.html#GDB_002fMI-Output-Syntax
+ */
+class GDBMIOutputReader
+{
+public:
+  GDBMIOutputReader(const char *data, size_t length)
+    : mpBegin(data), mpCurrent(data), mpEnd(data + length), mpError(0) {}
+  GDBMIResponse* readOutput();
+  const char* getError() const {return mpError;}
+  size_t getErrorOffset() const {return mpCurrent - mpBegin;}
+private:
+  const char *mpBegin;
+  const char *mpCurrent;
+  const char *mpEnd;
+  const char *mpError;
+
+  char peek() const {return mpCurrent < mpEnd ? *mpCurrent : '\0';}
+  bool fail(const char *error);
+  bool isRecordStart() const;
+  bool isTrailingWhitespace() const;
+  int readToken();
+  bool readIdentifier(const char **pBegin, size_t *pLength);
+  bool readCString(string *pString);
+  bool readRecordBody(GDBMIResultRecord *pGDBMIResultRecord);
+  GDBMIResult* readResult();
+  GDBMIValue* readValue();
+  GDBMITuple* readTuple();
+  GDBMIList* readList();
+};
+
+bool GDBMIOutputReader::fail(const char *error)
+{
+  if (!mpError) {
+    mpError = error;
+  }
+  return false;
+}
+
+/* [token] followed by one of the record prefixes. Stream records never have a token. */
+bool GDBMIOutputReader::isRecordStart() const
+{
+  const char *p = mpCurrent;
+  while (p < mpEnd && *p >= '0' && *p <= '9') {
+    ++p;
+  }
+  if (p >= mpEnd) {
+    return false;
+  }
+  switch (*p) {
+    case '^':
+    case '*':
+    case '+':
+    case '=':
+      return true;
+    case '~':
+    case '@':
+    case '&':
+      return p == mpCurrent;
+    default:
+      return false;
+  }
+}
+
+bool GDBMIOutputReader::isTrailingWhitespace() const
+{
+  for (const char *p = mpCurrent ; p < mpEnd ; ++p) {
+    if (*p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+      return false;
+    }
+  }
+  return true;
+}
+
+int GDBMIOutputReader::readToken()
+{
+  if (peek() < '0' || peek() > '9') {
+    return -1;
+  }
+  int token = 0;
+  while (mpCurrent < mpEnd && *mpCurrent >= '0' && *mpCurrent <= '9') {
+    token = token * 10 + (*mpCurrent - '0');
+    ++mpCurrent;
+  }
+  return token;
+}
+
+bool GDBMIOutputReader::readIdentifier(const char **pBegin, size_t *pLength)
+{
+  const char *begin = mpCurrent;
+  char c = peek();
+  if (!(c == '_' || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))) {
+    return fail("Expected an identifier");
+  }
+  ++mpCurrent;
+  while (mpCurrent < mpEnd) {
+    c = *mpCurrent;
+    if (c == '-' || c == '_' || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+      ++mpCurrent;
+    } else {
+      break;
+    }
+  }
+  *pBegin = begin;
+  *pLength = mpCurrent - begin;
+  return true;
+}
+
+/* Reads a c-string. Like the ANTLR parser the quotes and escapes are kept, callers use StringHandler::unparse. */
+bool GDBMIOutputReader::readCString(string *pString)
+{
+  const char *begin = mpCurrent;
+  if (peek() != '"') {
+    return fail("Expected a c-string");
+  }
+  ++mpCurrent;
+  while (mpCurrent < mpEnd) {
+    char c = *mpCurrent;
+    if (c == '\\') {
+      mpCurrent += 2;
+    } else if (c == '"') {
+      ++mpCurrent;
+      pString->assign(begin, mpCurrent - begin);
+      return true;
+    } else if (c == '\n' || c == '\r') {
+      break;
+    } else {
+      ++mpCurrent;
+    }
+  }
+  if (mpCurrent > mpEnd) {
+    mpCurrent = mpEnd;
+  }
+  return fail("Unterminated c-string");
+}
+
+/* result-class ( "," result )* */
+bool GDBMIOutputReader::readRecordBody(GDBMIResultRecord *pGDBMIResultRecord)
+{
+  const char *cls;
+  size_t length;
+  if (!readIdentifier(&cls, &length)) {
+    return false;
+  }
+  pGDBMIResultRecord->cls.assign(cls, length);
+  while (peek() == ',') {
+    ++mpCurrent;
+    GDBMIResult *pGDBMIResult = readResult();
+    if (!pGDBMIResult) {
+      return false;
+    }
+    pGDBMIResultRecord->miResultsList.push_back(pGDBMIResult);
+  }
+  return true;
+}
+
+/* variable "=" value */
+GDBMIResult* GDBMIOutputReader::readResult()
+{
+  const char *variable;
+  size_t length;
+  if (!readIdentifier(&variable, &length)) {
+    return 0;
+  }
+  if (peek() != '=') {
+    fail("Expected '='");
+    return 0;
+  }
+  ++mpCurrent;
+  GDBMIValue *pGDBMIValue = readValue();
+  if (!pGDBMIValue) {
+    return 0;
+  }
+  GDBMIResult *pGDBMIResult = new GDBMIResult;
+  pGDBMIResult->setVariable(variable, length);
+  pGDBMIResult->miValue = pGDBMIValue;
+  return pGDBMIResult;
+}
+
+/* const | tuple | list */
+GDBMIValue* GDBMIOutputReader::readValue()
+{
+  GDBMIValue *pGDBMIValue = new GDBMIValue;
+  switch (peek()) {
+    case '"':
+      pGDBMIValue->type = GDBMIValue::ConstantValue;
+      if (readCString(&pGDBMIValue->value)) {
+        return pGDBMIValue;
+      }
+      break;
+    case '{':
+      pGDBMIValue->type = GDBMIValue::TupleValue;
+      pGDBMIValue->miTuple = readTuple();
+      if (pGDBMIValue->miTuple) {
+        return pGDBMIValue;
+      }
+      break;
+    case '[':
+      pGDBMIValue->type = GDBMIValue::ListValue;
+      pGDBMIValue->miList = readList();
+      if (pGDBMIValue->miList) {
+        return pGDBMIValue;
+      }
+      break;
+    default:
+      fail("Expected a value");
+      break;
+  }
+  delete pGDBMIValue;
+  return 0;
+}
+
+/* "{}" | "{" result ( "," result )* "}" */
+GDBMITuple* GDBMIOutputReader::readTuple()
+{
+  ++mpCurrent;
+  GDBMITuple *pGDBMITuple = new GDBMITuple;
+  if (peek() == '}') {
+    ++mpCurrent;
+    return pGDBMITuple;
+  }
+  for (;;) {
+    GDBMIResult *pGDBMIResult = readResult();
+    if (!pGDBMIResult) {
+      break;
+    }
+    pGDBMITuple->miResultsList.push_back(pGDBMIResult);
+    char c = peek();
+    ++mpCurrent;
+    if (c == '}') {
+      return pGDBMITuple;
+    } else if (c != ',') {
+      --mpCurrent;
+      fail("Expected ',' or '}'");
+      break;
+    }
+  }
+  delete pGDBMITuple;
+  return 0;
+}
+
+/* "[]" | "[" value ( "," value )* "]" | "[" result ( "," result )* "]" */
+GDBMIList* GDBMIOutputReader::readList()
+{
+  ++mpCurrent;
+  GDBMIList *pGDBMIList = new GDBMIList;
+  if (peek() == ']') {
+    ++mpCurrent;
+    return pGDBMIList;
+  }
+  char c = peek();
+  pGDBMIList->type = (c == '"' || c == '{' || c == '[') ? GDBMIList::ValuesList : GDBMIList::ResultsList;
+  for (;;) {
+    if (pGDBMIList->type == GDBMIList::ValuesList) {
+      GDBMIValue *pGDBMIValue = readValue();
+      if (!pGDBMIValue) {
+        break;
+      }
+      pGDBMIList->miValuesList.push_back(pGDBMIValue);
+    } else {
+      GDBMIResult *pGDBMIResult = readResult();
+      if (!pGDBMIResult) {
+        break;
+      }
+      pGDBMIList->miResultsList.push_back(pGDBMIResult);
+    }
+    c = peek();
+    ++mpCurrent;
+    if (c == ']') {
+      return pGDBMIList;
+    } else if (c != ',') {
+      --mpCurrent;
+      fail("Expected ',' or ']'");
+      break;
+    }
+  }
+  delete pGDBMIList;
+  return 0;
+}
+
+/* ( out-of-band-record )* [ result-record ] [ nl ]
+ * A line that does not start with a record e.g., the output of the program being debugged gives a NoneResponse.
+ */
+GDBMIResponse* GDBMIOutputReader::readOutput()
+{
+  GDBMIResponse *pGDBMIResponse = new GDBMIResponse;
+  while (isRecordStart()) {
+    int token = readToken();
+    char prefix = *mpCurrent++;
+    if (prefix == '^') {
+      GDBMIResultRecord *pGDBMIResultRecord = new GDBMIResultRecord;
+      pGDBMIResultRecord->token = token;
+      pGDBMIResponse->type = GDBMIResponse::ResultRecordResponse;
+      pGDBMIResponse->miResultRecord = pGDBMIResultRecord;
+      if (!readRecordBody(pGDBMIResultRecord)) {
+        delete pGDBMIResponse;
+        return 0;
+      }
+      break;
+    }
+    GDBMIOutOfBandRecord *pGDBMIOutOfBandRecord = new GDBMIOutOfBandRecord;
+    pGDBMIResponse->type = GDBMIResponse::OutOfBandRecordResponse;
+    pGDBMIResponse->miOutOfBandRecordList.push_back(pGDBMIOutOfBandRecord);
+    if (prefix == '*' || prefix == '+' || prefix == '=') {
+      /* The token of async records is dropped as GDBMIOutput.g does. GDBAdapter treats records with a token as command replies. */
+      pGDBMIOutOfBandRecord->type = GDBMIOutOfBandRecord::AsyncRecord;
+      pGDBMIOutOfBandRecord->miResultRecord = new GDBMIResultRecord;
+      if (!readRecordBody(pGDBMIOutOfBandRecord->miResultRecord)) {
+        delete pGDBMIResponse;
+        return 0;
+      }
+    } else {
+      pGDBMIOutOfBandRecord->type = GDBMIOutOfBandRecord::StreamRecord;
+      pGDBMIOutOfBandRecord->miStreamRecord = new GDBMIStreamRecord;
+      if (prefix == '~') {
+        pGDBMIOutOfBandRecord->miStreamRecord->type = GDBMIStreamRecord::ConsoleStream;
+      } else if (prefix == '@') {
+        pGDBMIOutOfBandRecord->miStreamRecord->type = GDBMIStreamRecord::TargetStream;
+      } else {
+        pGDBMIOutOfBandRecord->miStreamRecord->type = GDBMIStreamRecord::LogStream;
+      }
+      if (!readCString(&pGDBMIOutOfBandRecord->miStreamRecord->value)) {
+        delete pGDBMIResponse;
+        return 0;
+      }
+    }
+    /* records may be separated by a newline */
+    if (peek() == '\r') {
+      ++mpCurrent;
+    }
+    if (peek() == '\n') {
+      ++mpCurrent;
+    }
+  }
+  if (pGDBMIResponse->type != GDBMIResponse::NoneResponse && !isTrailingWhitespace()) {
+    fail("Unexpected characters after the record");
+    delete pGDBMIResponse;
+    return 0;
+  }
+  return pGDBMIResponse;
+}
+
+GDBMIResponse* parseGDBOutput(const char* data)
+{
+  return parseGDBOutput(data, strlen(data));
+}
+
+GDBMIResponse* parseGDBOutput(const char* data, size_t length)
+{
+  clearParserErrorsList();
+  GDBMIOutputReader reader(data, length);
+  GDBMIResponse *pGDBMIResponse = reader.readOutput();
+  if (!pGDBMIResponse) {
+    std::stringstream errorStr;
+    errorStr << "Parser error: " << reader.getError() << " at offset " << reader.getErrorOffset();
+    addParserError(errorStr.str());
+    addParserError(string(data, length));
+  }
+  return pGDBMIResponse;
+}
+
+} // namespace GDBMIParser
@@ -35,7 +35,61 @@
 #include "GDBMIOutputLexer.h"
 #include "GDBMIOutputParser.h"
 
+#include <new>
+#include <string.h>
+
 namespace GDBMIParser {
+/* Free-list pool for the nodes of the GDB/MI output tree.
+ * A single stack or locals response creates hundreds of small nodes which are all deleted right after the callback.
+ * Recycling them avoids a malloc/free pair per node. The memory is kept for the next response and never returned.
+ * The debugger parses the output on the GUI thread only so the pool is not locked.
+ */
+template <typename T>
+class GDBMINodePool
+{
+public:
+  static void* allocate(size_t size)
+  {
+    if (size != sizeof(T)) {
+      return ::operator new(size);
+    }
+    if (!mpFreeList) {
+      grow();
+    }
+    FreeNode *pFreeNode = mpFreeList;
+    mpFreeList = pFreeNode->mpNext;
+    return pFreeNode;
+  }
+  static void deallocate(void *p)
+  {
+    if (p) {
+      FreeNode *pFreeNode = static_cast<FreeNode*>(p);
+      pFreeNode->mpNext = mpFreeList;
+      mpFreeList = pFreeNode;
+    }
+  }
+private:
+  union FreeNode {
+    FreeNode *mpNext;
+    char mStorage[sizeof(T)];
+    double mAlignment;
+  };
+  enum {BlockSize = 256};
+  static FreeNode *mpFreeList;
+
+  static void grow()
+  {
+    FreeNode *pBlock = static_cast<FreeNode*>(::operator new(sizeof(FreeNode) * BlockSize));
+    for (int i = 0 ; i < BlockSize ; i++) {
+      pBlock[i].mpNext = mpFreeList;
+      mpFreeList = &pBlock[i];
+    }
+  }
+};
+
+template <typename T>
+typename GDBMINodePool<T>::FreeNode* GDBMINodePool<T>::mpFreeList = 0;
+
 GDBMIValue::GDBMIValue()
 {
   type = GDBMIValue::NoneValue;
@@ -50,6 +104,16 @@ GDBMIValue::~GDBMIValue()
   if (miList) delete miList;
 }
 
+void* GDBMIValue::operator new(size_t size)
+{
+  return GDBMINodePool<GDBMIValue>::allocate(size);
+}
+
+void GDBMIValue::operator delete(void *p)
+{
+  GDBMINodePool<GDBMIValue>::deallocate(p);
+}
+
 GDBMITuple::~GDBMITuple()
 {
   /* Delete the GDBMIResultList */
@@ -61,6 +125,16 @@ GDBMITuple::~GDBMITuple()
   miResultsList.clear();
 }
 
+void* GDBMITuple::operator new(size_t size)
+{
+  return GDBMINodePool<GDBMITuple>::allocate(size);
+}
+
+void GDBMITuple::operator delete(void *p)
+{
+  GDBMINodePool<GDBMITuple>::deallocate(p);
+}
+
 GDBMIList::GDBMIList()
 {
   type = GDBMIList::NoneList;
@@ -84,9 +158,20 @@ GDBMIList::~GDBMIList()
   miResultsList.clear();
 }
 
+void* GDBMIList::operator new(size_t size)
+{
+  return GDBMINodePool<GDBMIList>::allocate(size);
+}
+
+void GDBMIList::operator delete(void *p)
+{
+  GDBMINodePool<GDBMIList>::deallocate(p);
+}
+
 GDBMIResult::GDBMIResult()
 {
   variable = "";
+  variableHash = 0;
   miValue = 0;
 }
 
@@ -95,6 +180,22 @@ GDBMIResult::~GDBMIResult()
   if (miValue) delete miValue;
 }
 
+void GDBMIResult::setVariable(const char *data, size_t length)
+{
+  variable.assign(data, length);
+  variableHash = hashGDBMIVariable(data, length);
+}
+
+void* GDBMIResult::operator new(size_t size)
+{
+  return GDBMINodePool<GDBMIResult>::allocate(size);
+}
+
+void GDBMIResult::operator delete(void *p)
+{
+  GDBMINodePool<GDBMIResult>::deallocate(p);
+}
+
 GDBMIResultRecord::GDBMIResultRecord()
 {
   token = -1;
@@ -398,6 +499,31 @@ void printGDBMIList(GDBMIList *miList)
   }
 }
 
+/* FNV-1a hash of the variable name. */
+unsigned int hashGDBMIVariable(const char *data, size_t length)
+{
+  unsigned int hash = 2166136261u;
+  for (size_t i = 0 ; i < length ; i++) {
+    hash ^= (unsigned char)data[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+GDBMIResult* findGDBMIResult(const GDBMIResultList &resultsList, const char *variable)
+{
+  size_t length = strlen(variable);
+  unsigned int hash = hashGDBMIVariable(variable, length);
+  GDBMIResultList::const_iterator it;
+  for (it = resultsList.begin(); it != resultsList.end(); ++it) {
+    GDBMIResult *pGDBMIResult = *it;
+    if (pGDBMIResult->variableHash == hash && pGDBMIResult->variable.compare(variable) == 0) {
+      return pGDBMIResult;
+    }
+  }
+  return 0;
+}
+
 list<string> getLexerErrorsList()
 {
   return lexerErrorsList;
@@ -418,7 +544,15 @@ void clearParserErrorsList()
   parserErrorsList.clear();
 }
 
-GDBMIResponse* parseGDBOutput(const char* output) {
+void addParserError(const string &error)
+{
+  parserErrorsList.push_back(error);
+}
+
+/* The ANTLR generated parser. OMEdit uses the hand-written parseGDBOutput() in GDBMIOutputReader.cpp,
+ * this one is kept as the reference for GDBMIParserBenchmark.
+ */
+GDBMIResponse* parseGDBOutputWithANTLR(const char* output) {
   pANTLR3_INPUT_STREAM           input;
   pGDBMIOutputLexer                lex;
   pANTLR3_COMMON_TOKEN_STREAM    tokens;
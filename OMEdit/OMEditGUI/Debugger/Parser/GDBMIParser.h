@@ -62,6 +62,8 @@ public:
 
   GDBMIValue();
   ~GDBMIValue();
+  static void* operator new(size_t size);
+  static void operator delete(void *p);
 };
 
 class GDBMIResult;
@@ -72,6 +74,8 @@ public:
   GDBMIResultList miResultsList;
 
   ~GDBMITuple();
+  static void* operator new(size_t size);
+  static void operator delete(void *p);
 };
 
 typedef list<GDBMIValue*>GDBMIValueList;
@@ -89,16 +93,22 @@ public:
 
   GDBMIList();
   ~GDBMIList();
+  static void* operator new(size_t size);
+  static void operator delete(void *p);
 };
 
 class GDBMIResult
 {
 public:
   string variable;
+  unsigned int variableHash;  /* hashGDBMIVariable() of variable, compared before the string in findGDBMIResult(). */
   GDBMIValue *miValue;
 
   GDBMIResult();
   ~GDBMIResult();
+  void setVariable(const char *data, size_t length);
+  static void* operator new(size_t size);
+  static void operator delete(void *p);
 };
 
 class GDBMIResultRecord
@@ -170,11 +180,17 @@ void printGDBMIValue(GDBMIValue *miValue);
 void printGDBMITuple(GDBMITuple *miTuple);
 void printGDBMIList(GDBMIList *miList);
 
+unsigned int hashGDBMIVariable(const char *data, size_t length);
+GDBMIResult* findGDBMIResult(const GDBMIResultList &resultsList, const char *variable);
+
 list<string> getLexerErrorsList();
 void clearLexerErrorsList();
 list<string> getParserErrorsList();
 void clearParserErrorsList();
+void addParserError(const string &error);
 GDBMIResponse* parseGDBOutput(const char* data);
+GDBMIResponse* parseGDBOutput(const char* data, size_t length);
+GDBMIResponse* parseGDBOutputWithANTLR(const char* data);
 
 } // namespace GDBMIParser
 #endif // GDBMIPARSER_H
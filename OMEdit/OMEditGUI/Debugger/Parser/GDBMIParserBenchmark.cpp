@@ -0,0 +1,182 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+/* Compares the hand-written parseGDBOutput with the ANTLR generated parser.
+ * Usage: GDBMIParserBenchmark [SampleGDBMIOutput.txt] [iterations]
+ * Every record line of the file is parsed by both parsers, the trees are compared and then each parser is timed separately.
+ */
+
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+#include "GDBMIParser.h"
+
+using namespace GDBMIParser;
+
+static bool isSameValue(GDBMIValue *pValue1, GDBMIValue *pValue2);
+
+static bool isSameResultList(const GDBMIResultList &resultsList1, const GDBMIResultList &resultsList2)
+{
+  if (resultsList1.size() != resultsList2.size()) {
+    return false;
+  }
+  GDBMIResultList::const_iterator it1 = resultsList1.begin();
+  GDBMIResultList::const_iterator it2 = resultsList2.begin();
+  for (; it1 != resultsList1.end() ; ++it1, ++it2) {
+    if ((*it1)->variable != (*it2)->variable || (*it1)->variableHash != (*it2)->variableHash || !isSameValue((*it1)->miValue, (*it2)->miValue)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool isSameValue(GDBMIValue *pValue1, GDBMIValue *pValue2)
+{
+  if (pValue1->type != pValue2->type) {
+    return false;
+  }
+  switch (pValue1->type) {
+    case GDBMIValue::ConstantValue:
+      return pValue1->value == pValue2->value;
+    case GDBMIValue::TupleValue:
+      return isSameResultList(pValue1->miTuple->miResultsList, pValue2->miTuple->miResultsList);
+    case GDBMIValue::ListValue:
+      if (pValue1->miList->type != pValue2->miList->type || pValue1->miList->miValuesList.size() != pValue2->miList->miValuesList.size()) {
+        return false;
+      } else {
+        GDBMIValueList::const_iterator it1 = pValue1->miList->miValuesList.begin();
+        GDBMIValueList::const_iterator it2 = pValue2->miList->miValuesList.begin();
+        for (; it1 != pValue1->miList->miValuesList.end() ; ++it1, ++it2) {
+          if (!isSameValue(*it1, *it2)) {
+            return false;
+          }
+        }
+      }
+      return isSameResultList(pValue1->miList->miResultsList, pValue2->miList->miResultsList);
+    default:
+      return true;
+  }
+}
+
+static bool isSameResultRecord(GDBMIResultRecord *pResultRecord1, GDBMIResultRecord *pResultRecord2)
+{
+  return pResultRecord1->token == pResultRecord2->token && pResultRecord1->cls == pResultRecord2->cls
+      && isSameResultList(pResultRecord1->miResultsList, pResultRecord2->miResultsList);
+}
+
+static bool isSameResponse(GDBMIResponse *pResponse1, GDBMIResponse *pResponse2)
+{
+  if (pResponse1->type != pResponse2->type || pResponse1->miOutOfBandRecordList.size() != pResponse2->miOutOfBandRecordList.size()) {
+    return false;
+  }
+  GDBMIOutOfBandRecordList::const_iterator it1 = pResponse1->miOutOfBandRecordList.begin();
+  GDBMIOutOfBandRecordList::const_iterator it2 = pResponse2->miOutOfBandRecordList.begin();
+  for (; it1 != pResponse1->miOutOfBandRecordList.end() ; ++it1, ++it2) {
+    if ((*it1)->type != (*it2)->type) {
+      return false;
+    } else if ((*it1)->type == GDBMIOutOfBandRecord::AsyncRecord && !isSameResultRecord((*it1)->miResultRecord, (*it2)->miResultRecord)) {
+      return false;
+    } else if ((*it1)->type == GDBMIOutOfBandRecord::StreamRecord
+               && ((*it1)->miStreamRecord->type != (*it2)->miStreamRecord->type || (*it1)->miStreamRecord->value != (*it2)->miStreamRecord->value)) {
+      return false;
+    }
+  }
+  if (pResponse1->type == GDBMIResponse::ResultRecordResponse) {
+    return isSameResultRecord(pResponse1->miResultRecord, pResponse2->miResultRecord);
+  }
+  return true;
+}
+
+static double runParser(GDBMIResponse* (*parser)(const char*), const vector<string> &lines, int iterations)
+{
+  clock_t start = clock();
+  for (int i = 0 ; i < iterations ; i++) {
+    for (size_t j = 0 ; j < lines.size() ; j++) {
+      delete parser(lines[j].c_str());
+    }
+  }
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char** argv)
+{
+  const char *fileName = argc > 1 ? argv[1] : "SampleGDBMIOutput.txt";
+  int iterations = argc > 2 ? atoi(argv[2]) : 10000;
+  ifstream file(fileName);
+  if (!file) {
+    fprintf(stderr, "Unable to open %s\n", fileName);
+    return 1;
+  }
+  /* only the record lines, skip the license header. */
+  vector<string> lines;
+  string line;
+  while (getline(file, line)) {
+    if (!line.empty() && line[line.size() - 1] == '\r') {
+      line.erase(line.size() - 1);
+    }
+    if (line.empty() || line.compare(0, 2, "*/") == 0 || string("0123456789^*+=~@&").find(line[0]) == string::npos) {
+      continue;
+    }
+    lines.push_back(line);
+  }
+  if (lines.empty() || iterations < 1) {
+    fprintf(stderr, "Nothing to parse\n");
+    return 1;
+  }
+
+  int mismatches = 0;
+  for (size_t i = 0 ; i < lines.size() ; i++) {
+    GDBMIResponse *pResponse = parseGDBOutput(lines[i].c_str());
+    GDBMIResponse *pANTLRResponse = parseGDBOutputWithANTLR(lines[i].c_str());
+    if (!pResponse || !pANTLRResponse || !isSameResponse(pResponse, pANTLRResponse)) {
+      fprintf(stderr, "Mismatch : %s\n", lines[i].c_str());
+      mismatches++;
+    }
+    delete pResponse;
+    delete pANTLRResponse;
+  }
+
+  size_t bytes = 0;
+  for (size_t i = 0 ; i < lines.size() ; i++) {
+    bytes += lines[i].size();
+  }
+  double antlrSeconds = runParser(parseGDBOutputWithANTLR, lines, iterations);
+  double seconds = runParser(parseGDBOutput, lines, iterations);
+  double megabytes = (double)bytes * iterations / (1024 * 1024);
+  fprintf(stdout, "%d lines x %d iterations (%.1f MB)\n", (int)lines.size(), iterations, megabytes);
+  fprintf(stdout, "ANTLR       : %8.3f s %8.1f MB/s\n", antlrSeconds, antlrSeconds > 0 ? megabytes / antlrSeconds : 0);
+  fprintf(stdout, "hand-written: %8.3f s %8.1f MB/s\n", seconds, seconds > 0 ? megabytes / seconds : 0);
+  if (seconds > 0) {
+    fprintf(stdout, "speedup     : %8.1fx\n", antlrSeconds / seconds);
+  }
+  return mismatches == 0 ? 0 : 1;
+}
@@ -216,6 +216,7 @@ void StackFramesTreeWidget::setCurrentStackFrame(QTreeWidgetItem *pQTreeWidgetIt
     }
     /* set the current item and add icon to it */
     mpStackFramesWidget->setSelectedFrame(pStackFrameItem->getLevel().toInt());
+    mpStackFramesWidget->setSelectedFunction(pStackFrameItem->getFunction());
     pStackFrameItem->setIcon(0, QIcon(":/Resources/icons/next.svg"));
   }
 }
@@ -254,7 +255,7 @@ void StackFramesTreeWidget::createStackFrames(GDBMIValue *pGDBMIValue)
         QString level, address, function, line, file, fullName;
         if (pGDBMIResult->miValue->type == GDBMIValue::TupleValue) {
           GDBAdapter *pGDBAdapter = GDBAdapter::instance();
-          GDBMIResultList resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
+          const GDBMIResultList &resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
           level = pGDBAdapter->getGDBMIConstantValue(pGDBAdapter->getGDBMIResult("level", resultsList));
           address = pGDBAdapter->getGDBMIConstantValue(pGDBAdapter->getGDBMIResult("addr", resultsList));
           function = pGDBAdapter->getGDBMIConstantValue(pGDBAdapter->getGDBMIResult("func", resultsList));
@@ -275,8 +276,7 @@ void StackFramesTreeWidget::createStackFrames(GDBMIValue *pGDBMIValue)
     }
   }
   // if there are no stack frames or no enabled stack frames then we need to clear locals browser.
-  QList<QVector<QVariant> > locals;
-  MainWindow::instance()->getLocalsWidget()->getLocalsTreeModel()->insertLocalsList(locals);
+  MainWindow::instance()->getLocalsWidget()->getLocalsTreeModel()->removeLocalItems();
   /* if we reach here we should suspend the debugger. Otherwise the debugger is suspended in GDBAdapter::stackListVariablesCB */
   GDBAdapter::instance()->suspendDebugger();
 }
@@ -407,6 +407,7 @@ StackFramesWidget::StackFramesWidget(QWidget *pParent)
   mpStackFramesTreeWidget = new StackFramesTreeWidget(this);
   setSelectedThread(1);
   setSelectedFrame(0);
+  setSelectedFunction("");
   /* set layout */
   QGridLayout *pMainLayout = new QGridLayout;
   pMainLayout->setAlignment(Qt::AlignLeft | Qt::AlignTop);
@@ -608,7 +609,7 @@ void StackFramesWidget::fillThreadComboBox(GDBMIValue *pThreadsGDBMIValue, QStri
       GDBMIValue *pGDBMIValue = *valuesListiterator;
       QString threadId;
       if (pGDBMIValue->type == GDBMIValue::TupleValue) {
-        GDBMIResultList resultsList = pGDBMIValue->miTuple->miResultsList;
+        const GDBMIResultList &resultsList = pGDBMIValue->miTuple->miResultsList;
         threadId = GDBAdapter::instance()->getGDBMIConstantValue(GDBAdapter::instance()->getGDBMIResult("id", resultsList));
         if (!threadId.isEmpty()) {
           mpThreadsComboBox->addItem(threadId);
@@ -52,6 +52,7 @@ class StackFrameItem : public QTreeWidgetItem
 public:
   StackFrameItem(QString level, QString address, QString function, QString line, QString file, QString fullName, StackFramesTreeWidget *pStackFramesTreeWidget);
   QString getLevel() {return mLevel;}
+  QString getFunction() {return mFunction;}
   QString getLine() {return mLine;}
   QString getFile() {return mFile;}
   QString getFullName() {return mFullName;}
@@ -102,6 +103,8 @@ public:
   int getSelectedThread() {return mSelectedThread;}
   void setSelectedFrame(int frame) {mSelectedFrame = frame;}
   int getSelectedFrame() {return mSelectedFrame;}
+  void setSelectedFunction(QString function) {mSelectedFunction = function;}
+  QString getSelectedFunction() {return mSelectedFunction;}
   void setStatusMessage(QString statusMessage);
 private:
   QToolButton *mpResumeToolButton;
@@ -117,6 +120,7 @@ private:
   StackFramesTreeWidget *mpStackFramesTreeWidget;
   int mSelectedThread;
   int mSelectedFrame;
+  QString mSelectedFunction;
 public slots:
   void resumeButtonClicked();
   void interruptButtonClicked();
@@ -42,6 +42,7 @@
 #include <QCompleter>
 #include <QMessageBox>
 #include <QTextDocumentFragment>
+#include <QSyntaxHighlighter>
 
 /*!
  * \class TabSettings
@@ -483,7 +484,8 @@ bool isComment(const QString &text,
  * Implements a custom text layout for BaseEditor to be able to work with QTextDocument::setDocumentLayout().
  */
 BaseEditorDocumentLayout::BaseEditorDocumentLayout(QTextDocument *document)
-  : QPlainTextDocumentLayout(document), mHasBreakpoint(false)
+  : QPlainTextDocumentLayout(document), mHasBreakpoint(false), mHighlightingFirstBlockNumber(0),
+    mHighlightingLastBlockNumber(BaseEditor::LargeFileLookAheadBlocks * 2), mHasDeferredBlocks(false)
 {
 
 }
@@ -547,6 +549,20 @@ int BaseEditorDocumentLayout::foldingIndent(const QTextBlock &block)
   return 0;
 }
 
+/*!
+ * \brief BaseEditorDocumentLayout::classFoldingIndent
+ * Returns the class folding indent of the block.
+ * \param block
+ * \return
+ */
+int BaseEditorDocumentLayout::classFoldingIndent(const QTextBlock &block)
+{
+  if (TextBlockUserData *userData = testUserData(block)) {
+    return userData->classFoldingIndent();
+  }
+  return 0;
+}
+
 /*!
  * \brief BaseEditorDocumentLayout::canFold
  * Checks if block is foldable.
@@ -641,6 +657,80 @@ TextBlockUserData* BaseEditorDocumentLayout::userData(const QTextBlock &block)
   return data;
 }
 
+/*!
+ * \brief BaseEditorDocumentLayout::isHighlightingDeferred
+ * Checks if the highlighting of the block should be deferred i.e., the document is in large-file mode and the block is
+ * not near the viewport.\n
+ * The highlighters then only carry the state of the block. BaseEditor highlights the block once it is scrolled into view.
+ * \param block
+ * \return
+ */
+bool BaseEditorDocumentLayout::isHighlightingDeferred(const QTextBlock &block)
+{
+  BaseEditorDocumentLayout *pBaseEditorDocumentLayout = qobject_cast<BaseEditorDocumentLayout*>(block.document()->documentLayout());
+  if (!pBaseEditorDocumentLayout || !pBaseEditorDocumentLayout->isLargeFile()) {
+    return false;
+  }
+  int blockNumber = block.blockNumber();
+  if (blockNumber >= pBaseEditorDocumentLayout->mHighlightingFirstBlockNumber
+      && blockNumber <= pBaseEditorDocumentLayout->mHighlightingLastBlockNumber) {
+    return false;
+  }
+  pBaseEditorDocumentLayout->setHasDeferredBlocks(true);
+  return true;
+}
+
+/*!
+ * \brief BaseEditorDocumentLayout::isHighlighted
+ * Returns true if the block is highlighted.
+ * \param block
+ * \return
+ */
+bool BaseEditorDocumentLayout::isHighlighted(const QTextBlock &block)
+{
+  if (TextBlockUserData *userData = testUserData(block)) {
+    return userData->highlighted();
+  }
+  return false;
+}
+
+/*!
+ * \brief BaseEditorDocumentLayout::setHighlighted
+ * Marks the block as highlighted or deferred.
+ * \param block
+ * \param highlighted
+ */
+void BaseEditorDocumentLayout::setHighlighted(const QTextBlock &block, bool highlighted)
+{
+  if (highlighted) {
+    userData(block)->setHighlighted(true);
+  } else if (TextBlockUserData *userData = testUserData(block)) {
+    userData->setHighlighted(false);
+  }
+}
+
+/*!
+ * \brief BaseEditorDocumentLayout::isLargeFile
+ * Returns true if the document has at least BaseEditor::LargeFileBlockCount lines.
+ * \return
+ */
+bool BaseEditorDocumentLayout::isLargeFile() const
+{
+  return document()->blockCount() >= BaseEditor::LargeFileBlockCount;
+}
+
+/*!
+ * \brief BaseEditorDocumentLayout::setHighlightingRange
+ * Sets the range of the blocks that are highlighted in large-file mode.
+ * \param firstBlockNumber
+ * \param lastBlockNumber
+ */
+void BaseEditorDocumentLayout::setHighlightingRange(int firstBlockNumber, int lastBlockNumber)
+{
+  mHighlightingFirstBlockNumber = firstBlockNumber;
+  mHighlightingLastBlockNumber = lastBlockNumber;
+}
+
 /*!
  * \brief foldBoxWidth
  * Returns the width for folding control.
@@ -1116,6 +1206,48 @@ void BaseEditor::PlainTextEdit::ensureCursorVisible()
   QPlainTextEdit::ensureCursorVisible();
 }
 
+/*!
+ * \brief BaseEditor::PlainTextEdit::highlightVisibleBlocks
+ * Highlights the deferred blocks of a large-file near the viewport.\n
+ * Rehighlights the whole document once it is no longer a large-file.
+ */
+void BaseEditor::PlainTextEdit::highlightVisibleBlocks()
+{
+  BaseEditorDocumentLayout *pDocumentLayout = qobject_cast<BaseEditorDocumentLayout*>(document()->documentLayout());
+  if (!pDocumentLayout || !pDocumentLayout->hasDeferredBlocks()) {
+    return;
+  }
+  QSyntaxHighlighter *pSyntaxHighlighter = document()->findChild<QSyntaxHighlighter*>();
+  if (!pSyntaxHighlighter) {
+    return;
+  }
+  if (!pDocumentLayout->isLargeFile()) {
+    pDocumentLayout->setHasDeferredBlocks(false);
+    pSyntaxHighlighter->rehighlight();
+    return;
+  }
+  // find the last visible block
+  QTextBlock block = firstVisibleBlock();
+  int firstBlockNumber = block.blockNumber();
+  int lastBlockNumber = firstBlockNumber;
+  qreal top = blockBoundingGeometry(block).translated(contentOffset()).top();
+  while (block.isValid() && top <= viewport()->rect().bottom()) {
+    top += blockBoundingRect(block).height();
+    lastBlockNumber = block.blockNumber();
+    block = block.next();
+  }
+  firstBlockNumber = qMax(firstBlockNumber - BaseEditor::LargeFileLookAheadBlocks, 0);
+  lastBlockNumber += BaseEditor::LargeFileLookAheadBlocks;
+  pDocumentLayout->setHighlightingRange(firstBlockNumber, lastBlockNumber);
+  block = document()->findBlockByNumber(firstBlockNumber);
+  for (int blockNumber = firstBlockNumber ; block.isValid() && blockNumber <= lastBlockNumber ; blockNumber++) {
+    if (!BaseEditorDocumentLayout::isHighlighted(block)) {
+      pSyntaxHighlighter->rehighlightBlock(block);
+    }
+    block = block.next();
+  }
+}
+
 /*!
  * \brief BaseEditor::PlainTextEdit::highlightCurrentLine
  * Hightlights the current line.
@@ -1444,7 +1576,7 @@ void BaseEditor::PlainTextEdit::paintEvent(QPaintEvent *e)
  * \param pParent
  */
 BaseEditor::BaseEditor(QWidget *pParent)
-  : QWidget(pParent), mCanHaveBreakpoints(false)
+  : QWidget(pParent), mCanHaveBreakpoints(false), mpLoadFile(0), mpLoadFileTextStream(0), mReadOnlyBeforeLoadFile(false)
 {
   if (qobject_cast<ModelWidget*>(pParent)) {
     mpModelWidget = qobject_cast<ModelWidget*>(pParent);
@@ -1454,6 +1586,11 @@ BaseEditor::BaseEditor(QWidget *pParent)
   initialize();
 }
 
+BaseEditor::~BaseEditor()
+{
+  closeLoadFile();
+}
+
 /*!
  * \brief BaseEditor::setCanHaveBreakpoints
  * Sets whether editor supports breakpoints or not. Also sets/unsets the editor's LineNumberArea mouse tracking.
@@ -1489,6 +1626,37 @@ void BaseEditor::toggleBlockVisible(const QTextBlock &block)
   pBaseEditorDocumentLayout->emitDocumentSizeChanged();
 }
 
+/*!
+ * \brief BaseEditor::loadFile
+ * Loads the file in the editor LargeFileChunkSize characters at a time.\n
+ * The first chunk is shown immediately and the rest is appended from the event loop so the editor opens instantly
+ * regardless of the file size. The editor is read-only until the whole file is loaded.
+ * \param fileName
+ * \return true if the file is opened.
+ */
+bool BaseEditor::loadFile(const QString &fileName)
+{
+  closeLoadFile();
+  mpLoadFile = new QFile(fileName);
+  if (!mpLoadFile->open(QIODevice::ReadOnly | QIODevice::Text)) {
+    delete mpLoadFile;
+    mpLoadFile = 0;
+    return false;
+  }
+  mpLoadFileTextStream = new QTextStream(mpLoadFile);
+  mpLoadFileTextStream->setCodec(Helper::utf8.toStdString().data());
+  mReadOnlyBeforeLoadFile = mpPlainTextEdit->isReadOnly();
+  mpPlainTextEdit->setReadOnly(true);
+  mpPlainTextEdit->document()->setUndoRedoEnabled(false);
+  mpPlainTextEdit->setPlainText(mpLoadFileTextStream->read(LargeFileChunkSize));
+  if (mpLoadFileTextStream->atEnd()) {
+    closeLoadFile();
+  } else {
+    mLoadFileTimer.start();
+  }
+  return true;
+}
+
 /*!
  * \brief BaseEditor::initialize
  * Initializes the editor with default values.
@@ -1501,6 +1669,14 @@ void BaseEditor::initialize()
   mpFindReplaceWidget = new FindReplaceWidget(this);
   mpFindReplaceWidget->hide();
   createActions();
+  // highlight the blocks near the viewport of the large-files when the editor is idle
+  mHighlightVisibleBlocksTimer.setSingleShot(true);
+  mHighlightVisibleBlocksTimer.setInterval(100);
+  connect(&mHighlightVisibleBlocksTimer, SIGNAL(timeout()), SLOT(highlightVisibleBlocks()));
+  connect(mpPlainTextEdit, SIGNAL(updateRequest(QRect,int)), &mHighlightVisibleBlocksTimer, SLOT(start()));
+  mLoadFileTimer.setSingleShot(true);
+  mLoadFileTimer.setInterval(0);
+  connect(&mLoadFileTimer, SIGNAL(timeout()), SLOT(loadFileChunk()));
   // set the layout
   QVBoxLayout *pMainLayout = new QVBoxLayout;
   pMainLayout->setContentsMargins(0, 0, 0, 0);
@@ -1572,7 +1748,9 @@ void BaseEditor::foldOrUnfold(bool unFold)
 
   QTextBlock block = pTextDocument->firstBlock();
   while (block.isValid()) {
-    if (BaseEditorDocumentLayout::canFold(block)) {
+    /* Only the user folds the classes. Folding all of them would hide the whole document behind the first line. */
+    if (BaseEditorDocumentLayout::canFold(block)
+        && (unFold || BaseEditorDocumentLayout::classFoldingIndent(block.next()) <= BaseEditorDocumentLayout::classFoldingIndent(block))) {
       BaseEditorDocumentLayout::foldOrUnfold(block, unFold);
     }
     block = block.next();
@@ -1584,6 +1762,25 @@ void BaseEditor::foldOrUnfold(bool unFold)
   mpPlainTextEdit->centerCursor();
 }
 
+/*!
+ * \brief BaseEditor::closeLoadFile
+ * Closes the file loaded with BaseEditor::loadFile and restores the editor.
+ */
+void BaseEditor::closeLoadFile()
+{
+  if (!mpLoadFile) {
+    return;
+  }
+  mLoadFileTimer.stop();
+  delete mpLoadFileTextStream;
+  mpLoadFileTextStream = 0;
+  mpLoadFile->close();
+  delete mpLoadFile;
+  mpLoadFile = 0;
+  mpPlainTextEdit->document()->setUndoRedoEnabled(true);
+  mpPlainTextEdit->setReadOnly(mReadOnlyBeforeLoadFile);
+}
+
 /*!
  * \brief BaseEditor::createStandardContextMenu
  * Creates a standard context menu for ediotr.
@@ -1924,6 +2121,35 @@ void BaseEditor::unFoldAll()
   }
 }
 
+/*!
+ * \brief BaseEditor::highlightVisibleBlocks
+ * Slot activated when mHighlightVisibleBlocksTimer timeout SIGNAL is raised.
+ */
+void BaseEditor::highlightVisibleBlocks()
+{
+  mpPlainTextEdit->highlightVisibleBlocks();
+}
+
+/*!
+ * \brief BaseEditor::loadFileChunk
+ * Slot activated when mLoadFileTimer timeout SIGNAL is raised.\n
+ * Appends the next chunk of the file loaded with BaseEditor::loadFile.
+ */
+void BaseEditor::loadFileChunk()
+{
+  if (!mpLoadFileTextStream) {
+    return;
+  }
+  QTextCursor cursor(mpPlainTextEdit->document());
+  cursor.movePosition(QTextCursor::End);
+  cursor.insertText(mpLoadFileTextStream->read(LargeFileChunkSize));
+  if (mpLoadFileTextStream->atEnd()) {
+    closeLoadFile();
+  } else {
+    mLoadFileTimer.start();
+  }
+}
+
 /*!
  * \class FindReplaceWidget
  * Creates a widget within editor for find and replace.
@@ -41,6 +41,9 @@
 #include <QLineEdit>
 #include <QCheckBox>
 #include <QToolButton>
+#include <QTimer>
+#include <QFile>
+#include <QTextStream>
 
 class ModelWidget;
 class InfoBar;
@@ -99,10 +102,12 @@ class TextBlockUserData : public QTextBlockUserData
 public:
   inline TextBlockUserData()
     : mFoldingIndent(0)
+    , mClassFoldingIndent(0)
     , mFolded(false)
     , mFoldingEndIncluded(false)
     , mFoldingState(false)
     , mLeadingSpaces(-1)
+    , mHighlighted(false)
   {}
   ~TextBlockUserData();
 
@@ -136,6 +141,9 @@ public:
    */
   inline int foldingIndent() const {return mFoldingIndent;}
   inline void setFoldingIndent(int indent) {mFoldingIndent = indent;}
+  // The part of the folding indent that comes from the nesting of the classes. The rest comes from the annotations.
+  inline int classFoldingIndent() const {return mClassFoldingIndent;}
+  inline void setClassFoldingIndent(int indent) {mClassFoldingIndent = indent;}
   inline void setFolded(bool b) {mFolded = b;}
   inline bool folded() const {return mFolded;}
   // Set whether the last character of the folded region will show when the code is folded.
@@ -146,14 +154,19 @@ public:
 
   inline void setLeadingSpaces(int leadingSpaces) {mLeadingSpaces = leadingSpaces;}
   inline int getLeadingSpaces() {return mLeadingSpaces;}
+  // Set whether the highlighter has formatted the block. In large-file mode only the blocks near the viewport are formatted.
+  inline void setHighlighted(bool highlighted) {mHighlighted = highlighted;}
+  inline bool highlighted() const {return mHighlighted;}
 private:
   TextMarks _marks;
   Parentheses mParentheses;
   int mFoldingIndent;
+  int mClassFoldingIndent;
   bool mFolded;
   bool mFoldingEndIncluded;
   bool mFoldingState;
   int mLeadingSpaces;
+  bool mHighlighted;
 };
 
 class CommentDefinition
@@ -187,14 +200,26 @@ public:
   static bool hasParentheses(const QTextBlock &block);
   static void setFoldingIndent(const QTextBlock &block, int indent);
   static int foldingIndent(const QTextBlock &block);
+  static int classFoldingIndent(const QTextBlock &block);
   static bool canFold(const QTextBlock &block);
   static void foldOrUnfold(const QTextBlock& block, bool unfold);
   static bool isFolded(const QTextBlock &block);
   static void setFolded(const QTextBlock &block, bool folded);
   static TextBlockUserData *testUserData(const QTextBlock &block);
   static TextBlockUserData *userData(const QTextBlock &block);
+  static bool isHighlightingDeferred(const QTextBlock &block);
+  static bool isHighlighted(const QTextBlock &block);
+  static void setHighlighted(const QTextBlock &block, bool highlighted);
   void emitDocumentSizeChanged() {emit documentSizeChanged(documentSize());}
+  bool isLargeFile() const;
+  void setHighlightingRange(int firstBlockNumber, int lastBlockNumber);
+  bool hasDeferredBlocks() const {return mHasDeferredBlocks;}
+  void setHasDeferredBlocks(bool hasDeferredBlocks) {mHasDeferredBlocks = hasDeferredBlocks;}
   bool mHasBreakpoint;
+private:
+  int mHighlightingFirstBlockNumber;
+  int mHighlightingLastBlockNumber;
+  bool mHasDeferredBlocks;
 };
 
 class BaseEditor : public QWidget
@@ -219,6 +244,7 @@ private:
     void indentOrUnindent(bool doIndent);
     void moveCursorVisible(bool ensureVisible = true);
     void ensureCursorVisible();
+    void highlightVisibleBlocks();
   private:
     BaseEditor *mpBaseEditor;
     LineNumberArea *mpLineNumberArea;
@@ -238,7 +264,13 @@ private:
     void paintEvent(QPaintEvent *e);
   };
 public:
+  /* Documents with at least LargeFileBlockCount lines are in large-file mode i.e., only the blocks near the viewport
+   * (LargeFileLookAheadBlocks before and after it) are highlighted and folded. The files are loaded LargeFileChunkSize
+   * characters at a time.
+   */
+  enum {LargeFileBlockCount = 10000, LargeFileLookAheadBlocks = 50, LargeFileChunkSize = 262144};
   BaseEditor(QWidget *pParent);
+  ~BaseEditor();
   ModelWidget *getModelWidget() {return mpModelWidget;}
   InfoBar* getInfoBar() {return mpInfoBar;}
   PlainTextEdit *getPlainTextEdit() {return mpPlainTextEdit;}
@@ -249,10 +281,18 @@ public:
   DocumentMarker* getDocumentMarker() {return mpDocumentMarker;}
   void goToLineNumber(int lineNumber);
   void toggleBlockVisible(const QTextBlock &block);
+  bool loadFile(const QString &fileName);
 private:
+  QTimer mHighlightVisibleBlocksTimer;
+  QTimer mLoadFileTimer;
+  QFile *mpLoadFile;
+  QTextStream *mpLoadFileTextStream;
+  bool mReadOnlyBeforeLoadFile;
+
   void initialize();
   void createActions();
   void foldOrUnfold(bool unFold);
+  void closeLoadFile();
 protected:
   ModelWidget *mpModelWidget;
   InfoBar *mpInfoBar;
@@ -272,6 +312,8 @@ protected:
   QMenu* createStandardContextMenu();
 private slots:
   virtual void showContextMenu(QPoint point) = 0;
+  void highlightVisibleBlocks();
+  void loadFileChunk();
 public slots:
   void textSettingsChanged();
   void updateLineNumberAreaWidth(int newBlockCount);
@@ -38,6 +38,7 @@
 #include <QPlainTextEdit>
 
 #include "Editors/BaseEditor.h"
+#include "Editors/SyntaxTokenizer.h"
 
 class CEditor : public BaseEditor
 {
@@ -61,18 +62,13 @@ class CHighlighter : public QSyntaxHighlighter
 public:
   CHighlighter(CEditorPage *pCEditorPage, QPlainTextEdit *pPlainTextEdit = 0);
   void initializeSettings();
-  void highlightMultiLine(const QString &text);
 protected:
   virtual void highlightBlock(const QString &text);
 private:
   CEditorPage *mpCEditorPage;
   QPlainTextEdit *mpPlainTextEdit;
-  struct HighlightingRule
-  {
-    QRegExp mPattern;
-    QTextCharFormat mFormat;
-  };
-  QVector<HighlightingRule> mHighlightingRules;
+  SyntaxTokenizer mSyntaxTokenizer;
+  QVector<SyntaxTokenizer::Token> mTokens;
   QTextCharFormat mTextFormat;
   QTextCharFormat mKeywordFormat;
   QTextCharFormat mTypeFormat;
@@ -80,6 +76,9 @@ private:
   QTextCharFormat mSingleLineCommentFormat;
   QTextCharFormat mMultiLineCommentFormat;
   QTextCharFormat mNumberFormat;
+
+  void setTokensFormat();
+  void updateTextBlockUserData(const QString &text);
 public slots:
   void settingsChanged();
 };
@@ -34,6 +34,7 @@
 #define METAMODELICAEDITOR_H
 
 #include "Editors/BaseEditor.h"
+#include "Editors/SyntaxTokenizer.h"
 
 #include <QSyntaxHighlighter>
 
@@ -59,18 +60,13 @@ class MetaModelicaHighlighter : public QSyntaxHighlighter
 public:
   MetaModelicaHighlighter(MetaModelicaEditorPage *pMetaModelicaEditorPage, QPlainTextEdit *pPlainTextEdit = 0);
   void initializeSettings();
-  void highlightMultiLine(const QString &text);
 protected:
   virtual void highlightBlock(const QString &text);
 private:
   MetaModelicaEditorPage *mpMetaModelicaEditorPage;
   QPlainTextEdit *mpPlainTextEdit;
-  struct HighlightingRule
-  {
-    QRegExp mPattern;
-    QTextCharFormat mFormat;
-  };
-  QVector<HighlightingRule> mHighlightingRules;
+  SyntaxTokenizer mSyntaxTokenizer;
+  QVector<SyntaxTokenizer::Token> mTokens;
   QTextCharFormat mTextFormat;
   QTextCharFormat mKeywordFormat;
   QTextCharFormat mTypeFormat;
@@ -78,6 +74,9 @@ private:
   QTextCharFormat mSingleLineCommentFormat;
   QTextCharFormat mMultiLineCommentFormat;
   QTextCharFormat mNumberFormat;
+
+  void setTokensFormat();
+  void updateTextBlockUserData(const QString &text);
 public slots:
   void settingsChanged();
 };
@@ -41,6 +41,7 @@
 
 #include <QMenu>
 #include <QMessageBox>
+#include <QVBoxLayout>
 
 /*!
  * \class ModelicaEditor
@@ -56,11 +57,37 @@ ModelicaEditor::ModelicaEditor(QWidget *pParent)
   setCanHaveBreakpoints(true);
   /* set the document marker */
   mpDocumentMarker = new DocumentMarker(mpPlainTextEdit->document());
+  // outline of the classes, hidden until the user asks for it.
+  mpOutlineTreeWidget = new QTreeWidget;
+  mpOutlineTreeWidget->setHeaderLabel(tr("Outline"));
+  mpOutlineTreeWidget->setIndentation(Helper::treeIndentation);
+  mpOutlineTreeWidget->setExpandsOnDoubleClick(false);
+  mpOutlineTreeWidget->setVisible(false);
+  connect(mpOutlineTreeWidget, SIGNAL(itemActivated(QTreeWidgetItem*,int)), SLOT(goToOutlineClass(QTreeWidgetItem*)));
+  // show outline action
+  mpShowOutlineAction = new QAction(tr("Show Outline"), this);
+  mpShowOutlineAction->setCheckable(true);
+  connect(mpShowOutlineAction, SIGNAL(toggled(bool)), SLOT(showOutline(bool)));
+  // put the outline next to the text
+  QVBoxLayout *pMainLayout = qobject_cast<QVBoxLayout*>(layout());
+  int index = pMainLayout->indexOf(mpPlainTextEdit);
+  pMainLayout->removeWidget(mpPlainTextEdit);
+  mpOutlineSplitter = new QSplitter;
+  mpOutlineSplitter->setChildrenCollapsible(false);
+  mpOutlineSplitter->addWidget(mpPlainTextEdit);
+  mpOutlineSplitter->addWidget(mpOutlineTreeWidget);
+  mpOutlineSplitter->setStretchFactor(0, 1);
+  pMainLayout->insertWidget(index, mpOutlineSplitter, 1);
+  // the outline is read again when the user stops typing.
+  mUpdateOutlineTimer.setSingleShot(true);
+  mUpdateOutlineTimer.setInterval(500);
+  connect(&mUpdateOutlineTimer, SIGNAL(timeout()), SLOT(updateOutline()));
 }
 
 /*!
  * \brief ModelicaEditor::getClassNames
- * Uses the OMC parseString API to check the class names inside the Modelica Text
+ * Reads the class names inside the Modelica Text with the ModelicaOutlineParser.\n
+ * Uses the OMC parseString API only if the outline parser finds an error so that OMC reports it.
  * \param errorString
  * \return QStringList a list of class names
  * \sa ModelWidget::modelicaEditorTextChanged()
@@ -76,22 +103,29 @@ QStringList ModelicaEditor::getClassNames(QString *errorString)
   } else {
     QString modelicaText = mpPlainTextEdit->toPlainText();
     QString stringToParse = modelicaText;
-    if (!modelicaText.startsWith("within")) {
-      if (pLibraryTreeItem->isInPackageOneFile()) {
-        stringToParse = pLibraryTreeItem->getClassTextBefore() + modelicaText + pLibraryTreeItem->getClassTextAfter();
-        // first we try to parse whole string so that we get correct line numbers for errors if any (see Ticket #3969).
-        classNames = pOMCProxy->parseString(stringToParse, pLibraryTreeItem->getFileName());
-        // if the whole string parses successfully then parse the subset for just this class.
-        if (classNames.size() > 0) {
+    ModelicaOutlineParser modelicaOutlineParser;
+    if (modelicaOutlineParser.parse(modelicaText)) {
+      classNames = modelicaOutlineParser.getTopLevelClassNames(pLibraryTreeItem->parent()->getNameStructure());
+    }
+    // if the outline parser finds an error then let OMC parse the text and report the error.
+    if (classNames.isEmpty()) {
+      if (!modelicaText.startsWith("within")) {
+        if (pLibraryTreeItem->isInPackageOneFile()) {
+          stringToParse = pLibraryTreeItem->getClassTextBefore() + modelicaText + pLibraryTreeItem->getClassTextAfter();
+          // first we try to parse whole string so that we get correct line numbers for errors if any (see Ticket #3969).
+          classNames = pOMCProxy->parseString(stringToParse, pLibraryTreeItem->getFileName());
+          // if the whole string parses successfully then parse the subset for just this class.
+          if (classNames.size() > 0) {
+            stringToParse = QString("within %1;%2").arg(pLibraryTreeItem->parent()->getNameStructure()).arg(modelicaText);
+            classNames = pOMCProxy->parseString(stringToParse, pLibraryTreeItem->getFileName());
+          }
+        } else {
           stringToParse = QString("within %1;%2").arg(pLibraryTreeItem->parent()->getNameStructure()).arg(modelicaText);
           classNames = pOMCProxy->parseString(stringToParse, pLibraryTreeItem->getFileName());
         }
       } else {
-        stringToParse = QString("within %1;%2").arg(pLibraryTreeItem->parent()->getNameStructure()).arg(modelicaText);
         classNames = pOMCProxy->parseString(stringToParse, pLibraryTreeItem->getFileName());
       }
-    } else {
-      classNames = pOMCProxy->parseString(stringToParse, pLibraryTreeItem->getFileName());
     }
   }
   // if user is defining multiple top level classes.
@@ -254,10 +288,50 @@ void ModelicaEditor::showContextMenu(QPoint point)
   pMenu->addSeparator();
   pMenu->addAction(mpFoldAllAction);
   pMenu->addAction(mpUnFoldAllAction);
+  pMenu->addSeparator();
+  pMenu->addAction(mpShowOutlineAction);
   pMenu->exec(mapToGlobal(point));
   delete pMenu;
 }
 
+/*!
+ * \brief ModelicaEditor::replaceLines
+ * Replaces the lines from startLine to endLine with text through a QTextCursor.
+ * The rest of the document keeps its blocks so it is not laid out and highlighted again like with setPlainText.
+ * \param startLine - the first replaced line, starting at 1.
+ * \param endLine - the last replaced line.
+ * \param text - the new lines.
+ * \param contents - the whole new text, used with setPlainText if the lines can't be replaced.
+ */
+void ModelicaEditor::replaceLines(int startLine, int endLine, const QString &text, const QString &contents)
+{
+  QTextDocument *pTextDocument = mpPlainTextEdit->document();
+  QTextBlock startBlock = pTextDocument->findBlockByNumber(startLine - 1);
+  QTextBlock endBlock = pTextDocument->findBlockByNumber(endLine - 1);
+  // the classes in a package saved in one file have their leading spaces removed, see ModelicaEditor::setPlainText.
+  if (mpModelWidget->getLibraryTreeItem()->isInPackageOneFile() || !startBlock.isValid() || !endBlock.isValid()) {
+    setPlainText(contents);
+    return;
+  }
+  // the newline of the last line is kept in the document.
+  QString lines = text;
+  if (lines.endsWith(QLatin1Char('\n'))) {
+    lines.chop(1);
+  }
+  mForceSetPlainText = true;
+  QTextCursor textCursor(pTextDocument);
+  textCursor.setPosition(startBlock.position());
+  textCursor.setPosition(endBlock.position() + endBlock.length() - 1, QTextCursor::KeepAnchor);
+  textCursor.insertText(lines);
+  // like setPlainText the text changed by OMC is not undoable in the editor.
+  pTextDocument->setUndoRedoEnabled(false);
+  pTextDocument->setUndoRedoEnabled(true);
+  setTextChanged(false);
+  mForceSetPlainText = false;
+  mLastValidText = mpPlainTextEdit->toPlainText();
+  mUpdateOutlineTimer.start();
+}
+
 /*!
  * \brief ModelicaEditor::setPlainText
  * Reimplementation of QPlainTextEdit::setPlainText method.
@@ -285,10 +359,126 @@ void ModelicaEditor::setPlainText(const QString &text)
     setTextChanged(false);
     mForceSetPlainText = false;
     mLastValidText = contents;
+    mUpdateOutlineTimer.stop();
+    updateOutline();
     foldAll();
   }
 }
 
+/*!
+ * \brief ModelicaEditor::updateClassFoldingIndents
+ * Sets the class folding indent of each block to the number of classes around it so that the classes can be folded.\n
+ * The lines of the class definition and of its end are not inside the class so they stay visible when it is folded.
+ * \param classes
+ */
+void ModelicaEditor::updateClassFoldingIndents(const QVector<ModelicaOutlineParser::Class> &classes)
+{
+  QTextDocument *pTextDocument = mpPlainTextEdit->document();
+  QVector<int> depthChanges(pTextDocument->blockCount() + 1, 0);
+  foreach (const ModelicaOutlineParser::Class &modelicaClass, classes) {
+    // the block numbers start at 0 and the lines at 1.
+    if (modelicaClass.mEndLine - modelicaClass.mStartLine > 1 && modelicaClass.mEndLine <= depthChanges.size()) {
+      depthChanges[modelicaClass.mStartLine]++;
+      depthChanges[modelicaClass.mEndLine - 1]--;
+    }
+  }
+  bool changed = false;
+  int depth = 0;
+  for (QTextBlock block = pTextDocument->firstBlock(); block.isValid(); block = block.next()) {
+    depth += depthChanges.at(block.blockNumber());
+    TextBlockUserData *pTextBlockUserData = BaseEditorDocumentLayout::testUserData(block);
+    if (!pTextBlockUserData) {
+      if (depth == 0) {
+        continue;
+      }
+      pTextBlockUserData = BaseEditorDocumentLayout::userData(block);
+    }
+    if (pTextBlockUserData->classFoldingIndent() != depth) {
+      // keep the annotation folding on top of the class folding.
+      pTextBlockUserData->setFoldingIndent(pTextBlockUserData->foldingIndent() - pTextBlockUserData->classFoldingIndent() + depth);
+      pTextBlockUserData->setClassFoldingIndent(depth);
+      changed = true;
+    }
+  }
+  if (changed) {
+    BaseEditorDocumentLayout *pBaseEditorDocumentLayout = qobject_cast<BaseEditorDocumentLayout*>(pTextDocument->documentLayout());
+    pBaseEditorDocumentLayout->requestUpdate();
+  }
+}
+
+/*!
+ * \brief ModelicaEditor::updateOutlineTreeWidget
+ * Lists the classes in the outline with the nested classes under their parent.
+ * \param classes
+ */
+void ModelicaEditor::updateOutlineTreeWidget(const QVector<ModelicaOutlineParser::Class> &classes)
+{
+  mpOutlineTreeWidget->clear();
+  QList<QTreeWidgetItem*> items;
+  foreach (const ModelicaOutlineParser::Class &modelicaClass, classes) {
+    QTreeWidgetItem *pTreeWidgetItem = new QTreeWidgetItem;
+    pTreeWidgetItem->setText(0, QString("%1 %2").arg(modelicaClass.mRestriction, modelicaClass.mName));
+    pTreeWidgetItem->setToolTip(0, tr("Line %1").arg(modelicaClass.mStartLine));
+    pTreeWidgetItem->setData(0, Qt::UserRole, modelicaClass.mStartLine);
+    // the parent is always read before its nested classes.
+    if (modelicaClass.mParentIndex >= 0 && modelicaClass.mParentIndex < items.size()) {
+      items.at(modelicaClass.mParentIndex)->addChild(pTreeWidgetItem);
+    } else {
+      mpOutlineTreeWidget->addTopLevelItem(pTreeWidgetItem);
+    }
+    items.append(pTreeWidgetItem);
+  }
+  mpOutlineTreeWidget->expandAll();
+}
+
+/*!
+ * \brief ModelicaEditor::updateOutline
+ * Reads the classes of the text with the ModelicaOutlineParser and updates the class folding and the outline.\n
+ * Keeps the previous outline if the text has errors, most likely the user is still typing.
+ */
+void ModelicaEditor::updateOutline()
+{
+  ModelicaOutlineParser modelicaOutlineParser;
+  if (!modelicaOutlineParser.parse(mpPlainTextEdit->toPlainText())) {
+    return;
+  }
+  updateClassFoldingIndents(modelicaOutlineParser.getClasses());
+  if (mpOutlineTreeWidget->isVisible()) {
+    updateOutlineTreeWidget(modelicaOutlineParser.getClasses());
+  }
+}
+
+/*!
+ * \brief ModelicaEditor::showOutline
+ * Slot activated when mpShowOutlineAction toggled SIGNAL is raised.\n
+ * Shows/hides the outline.
+ * \param show
+ */
+void ModelicaEditor::showOutline(bool show)
+{
+  mpOutlineTreeWidget->setVisible(show);
+  if (show) {
+    updateOutline();
+  }
+}
+
+/*!
+ * \brief ModelicaEditor::goToOutlineClass
+ * Slot activated when mpOutlineTreeWidget itemActivated SIGNAL is raised.\n
+ * Moves the cursor to the definition of the class.
+ * \param pTreeWidgetItem
+ */
+void ModelicaEditor::goToOutlineClass(QTreeWidgetItem *pTreeWidgetItem)
+{
+  QTextBlock block = mpPlainTextEdit->document()->findBlockByNumber(pTreeWidgetItem->data(0, Qt::UserRole).toInt() - 1);
+  if (block.isValid()) {
+    mpPlainTextEdit->setTextCursor(QTextCursor(block));
+    mpPlainTextEdit->moveCursorVisible();
+    mpPlainTextEdit->centerCursor();
+    mpPlainTextEdit->setFocus();
+  }
+}
+
 //! Slot activated when ModelicaTextEdit's QTextDocument contentsChanged SIGNAL is raised.
 //! Sets the model as modified so that user knows that his current model is not saved.
 void ModelicaEditor::contentsHasChanged(int position, int charsRemoved, int charsAdded)
@@ -298,6 +488,7 @@ void ModelicaEditor::contentsHasChanged(int position, int charsRemoved, int char
     if (charsRemoved == 0 && charsAdded == 0) {
       return;
     }
+    mUpdateOutlineTimer.start();
     /* if user is changing the system library class. */
     if (mpModelWidget->getLibraryTreeItem()->isSystemLibrary() && !mForceSetPlainText) {
       mpInfoBar->showMessage(tr("<b>Warning: </b>You are changing a system library class. System libraries are always read-only. Your changes will not be saved."));
@@ -360,8 +551,6 @@ void ModelicaHighlighter::initializeSettings()
   mpPlainTextEdit->document()->setDefaultFont(font);
   mpPlainTextEdit->setTabStopWidth(mpModelicaEditorPage->getOptionsDialog()->getTextEditorPage()->getTabSizeSpinBox()->value() * QFontMetrics(font).width(QLatin1Char(' ')));
   // set color highlighting
-  mHighlightingRules.clear();
-  HighlightingRule rule;
   mTextFormat.setForeground(mpModelicaEditorPage->getColor("Text"));
   mKeywordFormat.setForeground(mpModelicaEditorPage->getColor("Keyword"));
   mTypeFormat.setForeground(mpModelicaEditorPage->getColor("Type"));
@@ -369,235 +558,200 @@ void ModelicaHighlighter::initializeSettings()
   mMultiLineCommentFormat.setForeground(mpModelicaEditorPage->getColor("Comment"));
   mFunctionFormat.setForeground(mpModelicaEditorPage->getColor("Function"));
   mQuotationFormat.setForeground(mpModelicaEditorPage->getColor("Quotes"));
-  // Priority: keyword > func() > ident > number. Yes, the order matters :)
   mNumberFormat.setForeground(mpModelicaEditorPage->getColor("Number"));
-  rule.mPattern = QRegExp("[0-9][0-9]*([.][0-9]*)?([eE][+-]?[0-9]*)?");
-  rule.mFormat = mNumberFormat;
-  mHighlightingRules.append(rule);
-  rule.mPattern = QRegExp("\\b[A-Za-z_][A-Za-z0-9_]*");
-  rule.mFormat = mTextFormat;
-  mHighlightingRules.append(rule);
-  // functions
-  rule.mPattern = QRegExp("\\b[A-Za-z0-9_]+(?=\\()");
-  rule.mFormat = mFunctionFormat;
-  mHighlightingRules.append(rule);
   // keywords
-  QStringList keywordPatterns;
-  keywordPatterns << "\\balgorithm\\b"
-                  << "\\band\\b"
-                  << "\\bannotation\\b"
-                  << "\\bassert\\b"
-                  << "\\bblock\\b"
-                  << "\\bbreak\\b"
-                  << "\\bBoolean\\b"
-                  << "\\bclass\\b"
-                  << "\\bconnect\\b"
-                  << "\\bconnector\\b"
-                  << "\\bconstant\\b"
-                  << "\\bconstrainedby\\b"
-                  << "\\bder\\b"
-                  << "\\bdiscrete\\b"
-                  << "\\beach\\b"
-                  << "\\belse\\b"
-                  << "\\belseif\\b"
-                  << "\\belsewhen\\b"
-                  << "\\bencapsulated\\b"
-                  << "\\bend\\b"
-                  << "\\benumeration\\b"
-                  << "\\bequation\\b"
-                  << "\\bexpandable\\b"
-                  << "\\bextends\\b"
-                  << "\\bexternal\\b"
-                  << "\\bfalse\\b"
-                  << "\\bfinal\\b"
-                  << "\\bflow\\b"
-                  << "\\bfor\\b"
-                  << "\\bfunction\\b"
-                  << "\\bif\\b"
-                  << "\\bimport\\b"
-                  << "\\bimpure\\b"
-                  << "\\bin\\b"
-                  << "\\binitial\\b"
-                  << "\\binner\\b"
-                  << "\\binput\\b"
-                  << "\\bloop\\b"
-                  << "\\bmodel\\b"
-                  << "\\bnot\\b"
-                  << "\\boperator\\b"
-                  << "\\bor\\b"
-                  << "\\bouter\\b"
-                  << "\\boutput\\b"
-                  << "\\boptimization\\b"
-                  << "\\bpackage\\b"
-                  << "\\bparameter\\b"
-                  << "\\bpartial\\b"
-                  << "\\bprotected\\b"
-                  << "\\bpublic\\b"
-                  << "\\bpure\\b"
-                  << "\\brecord\\b"
-                  << "\\bredeclare\\b"
-                  << "\\breplaceable\\b"
-                  << "\\breturn\\b"
-                  << "\\bstream\\b"
-                  << "\\bthen\\b"
-                  << "\\btrue\\b"
-                  << "\\btype\\b"
-                  << "\\bwhen\\b"
-                  << "\\bwhile\\b"
-                  << "\\bwithin\\b";
-  foreach (const QString &pattern, keywordPatterns) {
-    rule.mPattern = QRegExp(pattern);
-    rule.mFormat = mKeywordFormat;
-    mHighlightingRules.append(rule);
-  }
+  QStringList keywords;
+  keywords << "algorithm"
+           << "and"
+           << "annotation"
+           << "assert"
+           << "block"
+           << "break"
+           << "Boolean"
+           << "class"
+           << "connect"
+           << "connector"
+           << "constant"
+           << "constrainedby"
+           << "der"
+           << "discrete"
+           << "each"
+           << "else"
+           << "elseif"
+           << "elsewhen"
+           << "encapsulated"
+           << "end"
+           << "enumeration"
+           << "equation"
+           << "expandable"
+           << "extends"
+           << "external"
+           << "false"
+           << "final"
+           << "flow"
+           << "for"
+           << "function"
+           << "if"
+           << "import"
+           << "impure"
+           << "in"
+           << "initial"
+           << "inner"
+           << "input"
+           << "loop"
+           << "model"
+           << "not"
+           << "operator"
+           << "or"
+           << "outer"
+           << "output"
+           << "optimization"
+           << "package"
+           << "parameter"
+           << "partial"
+           << "protected"
+           << "public"
+           << "pure"
+           << "record"
+           << "redeclare"
+           << "replaceable"
+           << "return"
+           << "stream"
+           << "then"
+           << "true"
+           << "type"
+           << "when"
+           << "while"
+           << "within";
   // Modelica types
-  QStringList typePatterns;
-  typePatterns << "\\bString\\b"
-               << "\\bInteger\\b"
-               << "\\bBoolean\\b"
-               << "\\bReal\\b";
-  foreach (const QString &pattern, typePatterns) {
-    rule.mPattern = QRegExp(pattern);
-    rule.mFormat = mTypeFormat;
-    mHighlightingRules.append(rule);
+  QStringList types;
+  types << "String"
+        << "Integer"
+        << "Boolean"
+        << "Real";
+  mSyntaxTokenizer.setWords(keywords, types);
+  mSyntaxTokenizer.setHighlightFunctions(true);
+}
+
+/*!
+ * \brief ModelicaHighlighter::setTokensFormat
+ * Sets the format of the tokens of the current block.
+ */
+void ModelicaHighlighter::setTokensFormat()
+{
+  foreach (const SyntaxTokenizer::Token &token, mTokens) {
+    switch (token.mKind) {
+      case SyntaxTokenizer::Keyword:
+        setFormat(token.mPosition, token.mLength, mKeywordFormat);
+        break;
+      case SyntaxTokenizer::Type:
+        setFormat(token.mPosition, token.mLength, mTypeFormat);
+        break;
+      case SyntaxTokenizer::Function:
+        setFormat(token.mPosition, token.mLength, mFunctionFormat);
+        break;
+      case SyntaxTokenizer::Number:
+        setFormat(token.mPosition, token.mLength, mNumberFormat);
+        break;
+      case SyntaxTokenizer::Quotation:
+        setFormat(token.mPosition, token.mLength, mQuotationFormat);
+        break;
+      case SyntaxTokenizer::SingleLineComment:
+        setFormat(token.mPosition, token.mLength, mSingleLineCommentFormat);
+        break;
+      case SyntaxTokenizer::MultiLineComment:
+        setFormat(token.mPosition, token.mLength, mMultiLineCommentFormat);
+        break;
+      default:
+        break;
+    }
   }
 }
 
 /*!
- * \brief ModelicaTextHighlighter::highlightMultiLine
- * Highlights the multilines text.
- * Quoted text or multiline comments.
- * \param text
+ * \brief ModelicaHighlighter::updateTextBlockUserData
+ * Stores the parentheses and the annotation folding information of the block from the tokens of the block.
  * \param text
  */
-void ModelicaHighlighter::highlightMultiLine(const QString &text)
+void ModelicaHighlighter::updateTextBlockUserData(const QString &text)
 {
-  /* Hand-written recognizer beats the crap known as QRegEx ;) */
-  int index = 0, startIndex = 0;
-  int blockState = previousBlockState();
+  TextBlockUserData *pTextBlockUserData = BaseEditorDocumentLayout::userData(currentBlock());
+  if (!pTextBlockUserData) {
+    return;
+  }
   bool foldingState = false;
-  QTextBlock previousTextBlck = currentBlock().previous();
-  TextBlockUserData *pPreviousTextBlockUserData = BaseEditorDocumentLayout::userData(previousTextBlck);
+  TextBlockUserData *pPreviousTextBlockUserData = BaseEditorDocumentLayout::userData(currentBlock().previous());
   if (pPreviousTextBlockUserData) {
     foldingState = pPreviousTextBlockUserData->foldingState();
   }
-  QRegExp annotationRegExp("\\bannotation\\b");
-  int annotationIndex = annotationRegExp.indexIn(text);
-  // store parentheses info
+  int annotationIndex = SyntaxTokenizer::indexOfWord(text, "annotation");
+  bool matchParenthesesCommentsQuotes = mpModelicaEditorPage->getOptionsDialog()->getTextEditorPage()->getMatchParenthesesCommentsQuotesCheckBox()->isChecked();
+  // the annotations are folded inside the class folding set by ModelicaEditor::updateOutline.
+  int classFoldingIndent = pTextBlockUserData->classFoldingIndent();
   Parentheses parentheses;
-  TextBlockUserData *pTextBlockUserData = BaseEditorDocumentLayout::userData(currentBlock());
-  if (pTextBlockUserData) {
-    pTextBlockUserData->clearParentheses();
-    pTextBlockUserData->setFoldingIndent(0);
-    pTextBlockUserData->setFoldingEndIncluded(false);
+  pTextBlockUserData->clearParentheses();
+  pTextBlockUserData->setFoldingIndent(classFoldingIndent);
+  pTextBlockUserData->setFoldingEndIncluded(false);
+  // if we are inside a multi line annotation which doesn't end on this line then fold the line.
+  if (foldingState && annotationIndex < 0) {
+    pTextBlockUserData->setFoldingIndent(classFoldingIndent + 1);
   }
-  while (index < text.length()) {
-    switch (blockState) {
-      /* if the block already has single line comment then don't check for multi line comment and quotes. */
-      case 1:
-        if (text[index] == '/' && index+1<text.length() && text[index+1] == '/') {
-          index++;
-          blockState = 1; /* don't change the blockstate. */
-        }
-        break;
-      case 2:
-        if (text[index] == '*' && index+1<text.length() && text[index+1] == '/') {
-          index++;
-          setFormat(startIndex, index-startIndex+1, mMultiLineCommentFormat);
-          blockState = 0;
+  foreach (const SyntaxTokenizer::Token &token, mTokens) {
+    switch (token.mKind) {
+      case SyntaxTokenizer::QuotedParenthesis:
+        if (!matchParenthesesCommentsQuotes) {
+          break;
         }
+        // fall through
+      case SyntaxTokenizer::Parenthesis: {
+        QChar character = text.at(token.mPosition);
+        bool opened = character == '(' || character == '{' || character == '[';
+        parentheses.append(Parenthesis(opened ? Parenthesis::Opened : Parenthesis::Closed, character, token.mPosition));
         break;
-      case 3:
-        if (text[index] == '\\') {
-          index++;
-        } else if (text[index] == '"') {
-          setFormat(startIndex, index-startIndex+1, mQuotationFormat);
-          blockState = 0;
+      }
+      case SyntaxTokenizer::Quotation:
+      case SyntaxTokenizer::SingleLineComment:
+      case SyntaxTokenizer::MultiLineComment:
+        // if we have annotation word before quote or comment block is starting then fold.
+        if (foldingState && annotationIndex >= 0 && token.mPosition < annotationIndex) {
+          pTextBlockUserData->setFoldingIndent(classFoldingIndent + 1);
         }
         break;
-      default:
-        /* check if single line comment then set the blockstate to 1. */
-        if (text[index] == '/' && index+1<text.length() && text[index+1] == '/') {
-          startIndex = index++;
-          setFormat(startIndex, text.length(), mSingleLineCommentFormat);
-          blockState = 1;
-        } else if (text[index] == '/' && index+1<text.length() && text[index+1] == '*') {
-          startIndex = index++;
-          blockState = 2;
-        } else if (text[index] == '"') {
-          startIndex = index;
-          blockState = 3;
-        }
-    }
-    // if no single line comment, no multi line comment and no quotes then store the parentheses
-    if (pTextBlockUserData && (blockState < 1 || blockState > 3 || mpModelicaEditorPage->getOptionsDialog()->getTextEditorPage()->getMatchParenthesesCommentsQuotesCheckBox()->isChecked())) {
-      if (text[index] == '(' || text[index] == '{' || text[index] == '[') {
-        parentheses.append(Parenthesis(Parenthesis::Opened, text[index], index));
-      } else if (text[index] == ')' || text[index] == '}' || text[index] == ']') {
-        parentheses.append(Parenthesis(Parenthesis::Closed, text[index], index));
-      }
-    }
-    if (foldingState) {
-      // if no single line comment, no multi line comment and no quotes then check for annotation end
-      if (blockState < 1 || blockState > 3) {
-        if (text[index] == ';') {
-          if (index == text.length() - 1) { // if we have some text after closing the annotation then we don't want to fold it.
-            if (annotationIndex < 0) { // if we have one line annotation, we don't want to fold it.
-              pTextBlockUserData->setFoldingIndent(1);
-            }
+      case SyntaxTokenizer::Semicolon:
+        // check for annotation end
+        if (foldingState) {
+          if (token.mPosition == text.length() - 1) { // if we have some text after closing the annotation then we don't want to fold it.
             pTextBlockUserData->setFoldingEndIncluded(true);
           } else {
-            pTextBlockUserData->setFoldingIndent(0);
+            pTextBlockUserData->setFoldingIndent(classFoldingIndent);
           }
           foldingState = false;
-        } else if (annotationIndex < 0) { // if we have one line annotation, we don't want to fold it.
-          pTextBlockUserData->setFoldingIndent(1);
         }
-      } else if (annotationIndex < 0) { // if we have one line annotation, we don't want to fold it.
-        pTextBlockUserData->setFoldingIndent(1);
-      } else if (startIndex < annotationIndex) {  // if we have annotation word before quote or comment block is starting then fold.
-        pTextBlockUserData->setFoldingIndent(1);
-      }
-    } else {
-      // if no single line comment, no multi line comment and no quotes then check for annotation start
-      if (blockState < 1 || blockState > 3) {
-        if (text[index] == 'a' && index+9<text.length() && text[index+1] == 'n' && text[index+2] == 'n' && text[index+3] == 'o'
-            && text[index+4] == 't' && text[index+5] == 'a' && text[index+6] == 't' && text[index+7] == 'i' && text[index+8] == 'o'
-            && text[index+9] == 'n') {
-          if (index+9 == text.length() - 1) { // if we just have annotation keyword in the line
-            index = index + 8;
-            foldingState = true;
-          } else if (index+10<text.length() && (text[index+10] == '(' || text[index+10] == ' ')) { // if annotation keyword is followed by '(' or space.
-            index = index + 9;
+        break;
+      case SyntaxTokenizer::Keyword:
+        // check for annotation start
+        if (!foldingState && token.mLength == 10 && text.midRef(token.mPosition, token.mLength) == QLatin1String("annotation")) {
+          int index = token.mPosition + token.mLength;
+          // if we just have annotation keyword in the line or annotation keyword is followed by '(' or space.
+          if (index == text.length() || text.at(index) == '(' || text.at(index) == ' ') {
             foldingState = true;
           }
         }
-      }
+        break;
+      default:
+        break;
     }
-    index++;
   }
-  if (pTextBlockUserData) {
-    pTextBlockUserData->setParentheses(parentheses);
-    if (foldingState) {
-      pTextBlockUserData->setFoldingState(true);
-      // Hanldle empty blocks inside annotaiton section
-      if (text.isEmpty() && foldingState) {
-        pTextBlockUserData->setFoldingIndent(1);
-      }
+  pTextBlockUserData->setParentheses(parentheses);
+  if (foldingState) {
+    pTextBlockUserData->setFoldingState(true);
+    // Hanldle empty blocks inside annotaiton section
+    if (text.isEmpty()) {
+      pTextBlockUserData->setFoldingIndent(classFoldingIndent + 1);
     }
-    // set text block user data
-    setCurrentBlockUserData(pTextBlockUserData);
-  }
-  switch (blockState) {
-    case 2:
-      setFormat(startIndex, text.length()-startIndex, mMultiLineCommentFormat);
-      setCurrentBlockState(2);
-      break;
-    case 3:
-      setFormat(startIndex, text.length()-startIndex, mQuotationFormat);
-      setCurrentBlockState(3);
-      break;
   }
+  // set text block user data
+  setCurrentBlockUserData(pTextBlockUserData);
 }
 
 //! Reimplementation of QSyntaxHighlighter::highlightBlock
@@ -607,23 +761,23 @@ void ModelicaHighlighter::highlightBlock(const QString &text)
   if (!mpModelicaEditorPage->getOptionsDialog()->getTextEditorPage()->getSyntaxHighlightingGroupBox()->isChecked()) {
     return;
   }
-  // set text block state
-  setCurrentBlockState(0);
+  setCurrentBlockState(mSyntaxTokenizer.tokenize(text, previousBlockState(), mTokens));
+  // in large-file mode only carry the state of the blocks away from the viewport. BaseEditor highlights them later.
+  if (BaseEditorDocumentLayout::isHighlightingDeferred(currentBlock())) {
+    if (TextBlockUserData *pTextBlockUserData = BaseEditorDocumentLayout::testUserData(currentBlock())) {
+      pTextBlockUserData->setFoldingState(false);
+    }
+    BaseEditorDocumentLayout::setHighlighted(currentBlock(), false);
+    return;
+  }
   TextBlockUserData *pTextBlockUserData = BaseEditorDocumentLayout::userData(currentBlock());
   if (pTextBlockUserData) {
     pTextBlockUserData->setFoldingState(false);
   }
   setFormat(0, text.length(), mpModelicaEditorPage->getColor("Text"));
-  foreach (const HighlightingRule &rule, mHighlightingRules) {
-    QRegExp expression(rule.mPattern);
-    int index = expression.indexIn(text);
-    while (index >= 0) {
-      int length = expression.matchedLength();
-      setFormat(index, length, rule.mFormat);
-      index = expression.indexIn(text, index + length);
-    }
-  }
-  highlightMultiLine(text);
+  setTokensFormat();
+  updateTextBlockUserData(text);
+  BaseEditorDocumentLayout::setHighlighted(currentBlock(), true);
 }
 
 /*!
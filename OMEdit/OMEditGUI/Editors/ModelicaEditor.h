@@ -38,8 +38,12 @@
 #include "Util/Helper.h"
 #include "Util/Utilities.h"
 #include "Editors/BaseEditor.h"
+#include "Editors/SyntaxTokenizer.h"
+#include "Editors/ModelicaOutlineParser.h"
 
 #include <QSyntaxHighlighter>
+#include <QSplitter>
+#include <QTreeWidget>
 
 class ModelWidget;
 class LibraryTreeItem;
@@ -57,12 +61,23 @@ public:
   QString getPlainText();
   void setTextChanged(bool changed) {mTextChanged = changed;}
   bool isTextChanged() {return mTextChanged;}
+  void replaceLines(int startLine, int endLine, const QString &text, const QString &contents);
 private:
   QString mLastValidText;
   bool mTextChanged;
   bool mForceSetPlainText;
+  QSplitter *mpOutlineSplitter;
+  QTreeWidget *mpOutlineTreeWidget;
+  QAction *mpShowOutlineAction;
+  QTimer mUpdateOutlineTimer;
+
+  void updateClassFoldingIndents(const QVector<ModelicaOutlineParser::Class> &classes);
+  void updateOutlineTreeWidget(const QVector<ModelicaOutlineParser::Class> &classes);
 private slots:
   virtual void showContextMenu(QPoint point);
+  void updateOutline();
+  void showOutline(bool show);
+  void goToOutlineClass(QTreeWidgetItem *pTreeWidgetItem);
 public slots:
   void setPlainText(const QString &text);
   virtual void contentsHasChanged(int position, int charsRemoved, int charsAdded);
@@ -76,18 +91,13 @@ class ModelicaHighlighter : public QSyntaxHighlighter
 public:
   ModelicaHighlighter(ModelicaEditorPage *pModelicaEditorPage, QPlainTextEdit *pPlainTextEdit = 0);
   void initializeSettings();
-  void highlightMultiLine(const QString &text);
 protected:
   virtual void highlightBlock(const QString &text);
 private:
   ModelicaEditorPage *mpModelicaEditorPage;
   QPlainTextEdit *mpPlainTextEdit;
-  struct HighlightingRule
-  {
-    QRegExp mPattern;
-    QTextCharFormat mFormat;
-  };
-  QVector<HighlightingRule> mHighlightingRules;
+  SyntaxTokenizer mSyntaxTokenizer;
+  QVector<SyntaxTokenizer::Token> mTokens;
   QTextCharFormat mTextFormat;
   QTextCharFormat mKeywordFormat;
   QTextCharFormat mTypeFormat;
@@ -96,6 +106,9 @@ private:
   QTextCharFormat mSingleLineCommentFormat;
   QTextCharFormat mMultiLineCommentFormat;
   QTextCharFormat mNumberFormat;
+
+  void setTokensFormat();
+  void updateTextBlockUserData(const QString &text);
 public slots:
   void settingsChanged();
 };
@@ -0,0 +1,394 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "ModelicaOutlineParser.h"
+
+/* The reserved words of Modelica. A class name or the name after end can't be one of them. */
+static const char *keywords[] = {
+  "algorithm", "and", "annotation", "block", "break", "class", "connect", "connector", "constant", "constrainedby", "der",
+  "discrete", "each", "else", "elseif", "elsewhen", "encapsulated", "end", "enumeration", "equation", "expandable", "extends",
+  "external", "false", "final", "flow", "for", "function", "if", "import", "impure", "in", "initial", "inner", "input", "loop",
+  "model", "not", "operator", "or", "outer", "output", "package", "parameter", "partial", "protected", "public", "pure", "record",
+  "redeclare", "replaceable", "return", "stream", "then", "true", "type", "when", "while", "within", 0
+};
+
+static const char *classKeywords[] = {
+  "class", "model", "record", "block", "connector", "type", "package", "function", "operator", 0
+};
+
+/* The prefixes that can come before the class keyword. */
+static const char *classPrefixes[] = {
+  "final", "encapsulated", "partial", "replaceable", "redeclare", "inner", "outer", "expandable", "pure", "impure", 0
+};
+
+static inline bool isIdentifierStart(QChar character)
+{
+  ushort c = character.unicode();
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static inline bool isDigit(QChar character)
+{
+  return character.unicode() >= '0' && character.unicode() <= '9';
+}
+
+ModelicaOutlineParser::ModelicaOutlineParser()
+  : mPosition(0), mLine(1), mLineStart(0), mHasWithin(false)
+{
+}
+
+/*!
+ * \brief ModelicaOutlineParser::parse
+ * Parses the outline of the text in one pass.
+ * \param text
+ * \return true if no error is found.
+ */
+bool ModelicaOutlineParser::parse(const QString &text)
+{
+  mText = text;
+  mPosition = 0;
+  mLine = 1;
+  mLineStart = 0;
+  mHasWithin = false;
+  mWithin.clear();
+  mClasses.clear();
+  mErrors.clear();
+
+  QVector<Token> brackets;      /* the open parentheses, brackets and braces. */
+  QVector<int> classesStack;    /* the indexes of the classes whose end is not read yet. */
+  int shortClassIndex = -1;     /* the short class definition i.e., class A = B waiting for its ; */
+  Token token = nextToken();
+  bool hasPrefix = false;
+  Token prefixToken = token;
+  // within clause
+  if (isWord(token, "within")) {
+    mHasWithin = true;
+    token = nextToken();
+    while (token.mKind != EndOfTextToken && !isSymbol(token, ';')) {
+      mWithin.append(tokenText(token));
+      token = nextToken();
+    }
+    if (token.mKind == EndOfTextToken) {
+      addError(token, QLatin1String("Missing ; after the within clause."));
+      return false;
+    }
+    token = nextToken();
+  }
+  while (token.mKind != EndOfTextToken) {
+    if (token.mKind == SymbolToken) {
+      hasPrefix = false;
+      QChar character = mText.at(token.mPosition);
+      if (character == QLatin1Char('(') || character == QLatin1Char('[') || character == QLatin1Char('{')) {
+        brackets.append(token);
+      } else if (character == QLatin1Char(')') || character == QLatin1Char(']') || character == QLatin1Char('}')) {
+        QChar openCharacter = brackets.isEmpty() ? QChar() : mText.at(brackets.last().mPosition);
+        if ((character == QLatin1Char(')') && openCharacter != QLatin1Char('('))
+            || (character == QLatin1Char(']') && openCharacter != QLatin1Char('['))
+            || (character == QLatin1Char('}') && openCharacter != QLatin1Char('{'))) {
+          addError(token, QString("Unexpected %1.").arg(character));
+          return false;
+        }
+        brackets.resize(brackets.size() - 1);
+      } else if (character == QLatin1Char(';') && brackets.isEmpty() && shortClassIndex >= 0) {
+        mClasses[shortClassIndex].mEndLine = token.mLine;
+        mClasses[shortClassIndex].mEndColumn = token.mColumn + 1;
+        shortClassIndex = -1;
+      } else if (character != QLatin1Char(';') && brackets.isEmpty() && shortClassIndex < 0 && classesStack.isEmpty()) {
+        addError(token, QString("Unexpected %1, expected a class definition.").arg(character));
+        return false;
+      }
+      token = nextToken();
+      continue;
+    }
+    // skip the modifiers, the annotations and the right hand side of the short class definitions.
+    if (!brackets.isEmpty() || shortClassIndex >= 0) {
+      token = nextToken();
+      continue;
+    }
+    if (token.mKind == IdentifierToken) {
+      bool isPrefix = false;
+      for (int i = 0 ; classPrefixes[i] ; i++) {
+        if (isWord(token, classPrefixes[i])) {
+          isPrefix = true;
+          break;
+        }
+      }
+      if (isPrefix) {
+        if (!hasPrefix) {
+          prefixToken = token;
+          hasPrefix = true;
+        }
+        token = nextToken();
+        continue;
+      }
+    }
+    if (isClassKeyword(token)) {
+      Class modelicaClass;
+      const Token &startToken = hasPrefix ? prefixToken : token;
+      hasPrefix = false;
+      modelicaClass.mStartLine = startToken.mLine;
+      modelicaClass.mStartColumn = startToken.mColumn;
+      modelicaClass.mEndLine = 0;
+      modelicaClass.mEndColumn = 0;
+      modelicaClass.mRestriction = tokenText(token);
+      token = nextToken();
+      // operator record and operator function
+      if (isWord(token, "record") || isWord(token, "function")) {
+        modelicaClass.mRestriction.append(QLatin1Char(' ')).append(tokenText(token));
+        token = nextToken();
+      }
+      // model extends A
+      if (isWord(token, "extends")) {
+        token = nextToken();
+      }
+      if (!isName(token)) {
+        addError(token, QString("Expected the name of the %1.").arg(modelicaClass.mRestriction));
+        return false;
+      }
+      modelicaClass.mName = tokenText(token);
+      modelicaClass.mParentIndex = classesStack.isEmpty() ? -1 : classesStack.last();
+      mClasses.append(modelicaClass);
+      token = nextToken();
+      if (isSymbol(token, '=')) {
+        shortClassIndex = mClasses.size() - 1;
+      } else {
+        classesStack.append(mClasses.size() - 1);
+      }
+      continue;
+    }
+    hasPrefix = false;
+    if (classesStack.isEmpty()) {
+      addError(token, QString("Unexpected %1, expected a class definition.").arg(tokenText(token)));
+      return false;
+    }
+    if (isWord(token, "end")) {
+      token = nextToken();
+      // end of the if, for, when and while statements and equations.
+      if (isWord(token, "if") || isWord(token, "for") || isWord(token, "when") || isWord(token, "while")) {
+        token = nextToken();
+        continue;
+      }
+      Class &modelicaClass = mClasses[classesStack.last()];
+      if (!isName(token) || tokenText(token).compare(modelicaClass.mName) != 0) {
+        addError(token, QString("Start and End modifiers are different, expected end %1;").arg(modelicaClass.mName));
+        return false;
+      }
+      token = nextToken();
+      if (!isSymbol(token, ';')) {
+        addError(token, QString("Missing ; after end %1.").arg(modelicaClass.mName));
+        return false;
+      }
+      modelicaClass.mEndLine = token.mLine;
+      modelicaClass.mEndColumn = token.mColumn + 1;
+      classesStack.resize(classesStack.size() - 1);
+    }
+    token = nextToken();
+  }
+  // the unterminated comments and strings.
+  if (!mErrors.isEmpty()) {
+    return false;
+  }
+  if (!brackets.isEmpty()) {
+    addError(brackets.last(), QString("Unbalanced %1.").arg(mText.at(brackets.last().mPosition)));
+  } else if (shortClassIndex >= 0) {
+    addError(token, QString("Missing ; after the definition of %1.").arg(mClasses.at(shortClassIndex).mName));
+  } else if (!classesStack.isEmpty()) {
+    addError(token, QString("Missing end %1;").arg(mClasses.at(classesStack.last()).mName));
+  }
+  return mErrors.isEmpty();
+}
+
+/*!
+ * \brief ModelicaOutlineParser::getTopLevelClassNames
+ * Returns the names of the top level classes qualified with the within clause of the text.
+ * \param within - used if the text has no within clause.
+ * \return
+ */
+QStringList ModelicaOutlineParser::getTopLevelClassNames(const QString &within) const
+{
+  QString prefix = mHasWithin ? mWithin : within;
+  QStringList classNames;
+  foreach (const Class &modelicaClass, mClasses) {
+    if (modelicaClass.mParentIndex < 0) {
+      classNames.append(prefix.isEmpty() ? modelicaClass.mName : QString("%1.%2").arg(prefix).arg(modelicaClass.mName));
+    }
+  }
+  return classNames;
+}
+
+/*!
+ * \brief ModelicaOutlineParser::nextToken
+ * Reads the next token. Skips the whitespace and the comments.
+ * \return
+ */
+ModelicaOutlineParser::Token ModelicaOutlineParser::nextToken()
+{
+  const int length = mText.length();
+  for (;;) {
+    while (mPosition < length && mText.at(mPosition).isSpace()) {
+      if (mText.at(mPosition) == QLatin1Char('\n')) {
+        mLine++;
+        mLineStart = mPosition + 1;
+      }
+      mPosition++;
+    }
+    if (mPosition + 1 < length && mText.at(mPosition) == QLatin1Char('/') && mText.at(mPosition + 1) == QLatin1Char('/')) {
+      while (mPosition < length && mText.at(mPosition) != QLatin1Char('\n')) {
+        mPosition++;
+      }
+    } else if (mPosition + 1 < length && mText.at(mPosition) == QLatin1Char('/') && mText.at(mPosition + 1) == QLatin1Char('*')) {
+      Token commentToken;
+      commentToken.mLine = mLine;
+      commentToken.mColumn = mPosition - mLineStart + 1;
+      mPosition += 2;
+      while (mPosition < length && !(mText.at(mPosition) == QLatin1Char('*') && mPosition + 1 < length && mText.at(mPosition + 1) == QLatin1Char('/'))) {
+        if (mText.at(mPosition) == QLatin1Char('\n')) {
+          mLine++;
+          mLineStart = mPosition + 1;
+        }
+        mPosition++;
+      }
+      if (mPosition >= length) {
+        addError(commentToken, QLatin1String("Unterminated comment."));
+      } else {
+        mPosition += 2;
+      }
+    } else {
+      break;
+    }
+  }
+  Token token;
+  token.mPosition = mPosition;
+  token.mLine = mLine;
+  token.mColumn = mPosition - mLineStart + 1;
+  if (mPosition >= length) {
+    token.mKind = EndOfTextToken;
+    token.mLength = 0;
+    return token;
+  }
+  QChar character = mText.at(mPosition);
+  if (character == QLatin1Char('"') || character == QLatin1Char('\'')) {
+    // strings and quoted identifiers
+    token.mKind = character == QLatin1Char('"') ? StringToken : QuotedIdentifierToken;
+    mPosition++;
+    while (mPosition < length && mText.at(mPosition) != character) {
+      if (mText.at(mPosition) == QLatin1Char('\\')) {
+        mPosition++;
+      } else if (mText.at(mPosition) == QLatin1Char('\n')) {
+        mLine++;
+        mLineStart = mPosition + 1;
+      }
+      mPosition++;
+    }
+    if (mPosition >= length) {
+      addError(token, token.mKind == StringToken ? QLatin1String("Unterminated string.") : QLatin1String("Unterminated quoted identifier."));
+      mPosition = length;
+      token.mKind = EndOfTextToken;
+      token.mLength = 0;
+      return token;
+    }
+    mPosition++;
+  } else if (isIdentifierStart(character)) {
+    token.mKind = IdentifierToken;
+    while (mPosition < length && (isIdentifierStart(mText.at(mPosition)) || isDigit(mText.at(mPosition)))) {
+      mPosition++;
+    }
+  } else if (isDigit(character)) {
+    token.mKind = NumberToken;
+    while (mPosition < length && isDigit(mText.at(mPosition))) {
+      mPosition++;
+    }
+    if (mPosition < length && mText.at(mPosition) == QLatin1Char('.')) {
+      mPosition++;
+      while (mPosition < length && isDigit(mText.at(mPosition))) {
+        mPosition++;
+      }
+    }
+    if (mPosition < length && (mText.at(mPosition) == QLatin1Char('e') || mText.at(mPosition) == QLatin1Char('E'))) {
+      mPosition++;
+      if (mPosition < length && (mText.at(mPosition) == QLatin1Char('+') || mText.at(mPosition) == QLatin1Char('-'))) {
+        mPosition++;
+      }
+      while (mPosition < length && isDigit(mText.at(mPosition))) {
+        mPosition++;
+      }
+    }
+  } else {
+    token.mKind = SymbolToken;
+    mPosition++;
+  }
+  token.mLength = mPosition - token.mPosition;
+  return token;
+}
+
+bool ModelicaOutlineParser::isWord(const Token &token, const char *word) const
+{
+  return token.mKind == IdentifierToken && mText.midRef(token.mPosition, token.mLength) == QLatin1String(word);
+}
+
+bool ModelicaOutlineParser::isSymbol(const Token &token, char symbol) const
+{
+  return token.mKind == SymbolToken && mText.at(token.mPosition) == QLatin1Char(symbol);
+}
+
+bool ModelicaOutlineParser::isName(const Token &token) const
+{
+  return token.mKind == QuotedIdentifierToken || (token.mKind == IdentifierToken && !isKeyword(token));
+}
+
+bool ModelicaOutlineParser::isClassKeyword(const Token &token) const
+{
+  for (int i = 0 ; classKeywords[i] ; i++) {
+    if (isWord(token, classKeywords[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ModelicaOutlineParser::isKeyword(const Token &token) const
+{
+  for (int i = 0 ; keywords[i] ; i++) {
+    if (isWord(token, keywords[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ModelicaOutlineParser::addError(const Token &token, const QString &message)
+{
+  Error error;
+  error.mLine = token.mLine;
+  error.mColumn = token.mColumn;
+  error.mMessage = message;
+  mErrors.append(error);
+}
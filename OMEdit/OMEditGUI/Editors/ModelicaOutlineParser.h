@@ -0,0 +1,108 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#ifndef MODELICAOUTLINEPARSER_H
+#define MODELICAOUTLINEPARSER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/*!
+ * \class ModelicaOutlineParser
+ * \brief Lightweight parser of the outline of a Modelica text i.e., the within clause and the class definitions.
+ * Reads the text once and only looks at the tokens at the element level, the equations, the algorithms, the modifiers and the
+ * annotations are skipped. Finds the unbalanced parentheses, the unterminated comments and strings, the missing or mismatching
+ * end of the classes. Everything else is left to OMC.
+ * Only uses QtCore so it can be used without OMC.
+ */
+class ModelicaOutlineParser
+{
+public:
+  typedef struct {
+    QString mName;
+    QString mRestriction;
+    int mParentIndex;         /* index of the enclosing class in the classes or -1 for a top level class. */
+    int mStartLine;           /* the lines and columns start at 1 like in OMC getClassInformation. */
+    int mStartColumn;
+    int mEndLine;
+    int mEndColumn;
+  } Class;
+  typedef struct {
+    int mLine;
+    int mColumn;
+    QString mMessage;
+  } Error;
+
+  ModelicaOutlineParser();
+  bool parse(const QString &text);
+  bool hasWithin() const {return mHasWithin;}
+  QString getWithin() const {return mWithin;}
+  const QVector<Class>& getClasses() const {return mClasses;}
+  const QVector<Error>& getErrors() const {return mErrors;}
+  QStringList getTopLevelClassNames(const QString &within = QString()) const;
+private:
+  enum TokenKind {
+    IdentifierToken,
+    QuotedIdentifierToken,
+    StringToken,
+    NumberToken,
+    SymbolToken,
+    EndOfTextToken
+  };
+  typedef struct {
+    TokenKind mKind;
+    int mPosition;
+    int mLength;
+    int mLine;
+    int mColumn;
+  } Token;
+
+  QString mText;
+  int mPosition;
+  int mLine;
+  int mLineStart;
+  bool mHasWithin;
+  QString mWithin;
+  QVector<Class> mClasses;
+  QVector<Error> mErrors;
+
+  Token nextToken();
+  QString tokenText(const Token &token) const {return mText.mid(token.mPosition, token.mLength);}
+  bool isWord(const Token &token, const char *word) const;
+  bool isSymbol(const Token &token, char symbol) const;
+  bool isName(const Token &token) const;
+  bool isClassKeyword(const Token &token) const;
+  bool isKeyword(const Token &token) const;
+  void addError(const Token &token, const QString &message);
+};
+
+#endif // MODELICAOUTLINEPARSER_H
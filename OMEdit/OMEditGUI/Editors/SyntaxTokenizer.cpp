@@ -0,0 +1,282 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "SyntaxTokenizer.h"
+
+/*!
+ * \brief isWordCharacter
+ * Returns true if the character can be part of an identifier i.e., the \w of QRegExp.
+ * \param character
+ * \return
+ */
+static inline bool isWordCharacter(QChar character)
+{
+  ushort c = character.unicode();
+  if (c < 128) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+  }
+  return character.isLetterOrNumber();
+}
+
+static inline bool isDigit(QChar character)
+{
+  return character.unicode() >= '0' && character.unicode() <= '9';
+}
+
+static inline bool isParenthesis(QChar character)
+{
+  ushort c = character.unicode();
+  return c == '(' || c == ')' || c == '{' || c == '}' || c == '[' || c == ']';
+}
+
+static inline void appendToken(QVector<SyntaxTokenizer::Token> &tokens, int position, int length, SyntaxTokenizer::Kind kind)
+{
+  SyntaxTokenizer::Token token;
+  token.mPosition = position;
+  token.mLength = length;
+  token.mKind = kind;
+  tokens.append(token);
+}
+
+SyntaxTokenizer::SyntaxTokenizer()
+  : mWordsTableMask(0), mWordsTableSeed(0), mHighlightFunctions(false)
+{
+}
+
+/*!
+ * \brief SyntaxTokenizer::setWords
+ * Sets the keywords and the types. A word in both lists is a type.\n
+ * The words are stored in a perfect hash table i.e., the seed of the hash function is chosen so that no two words share a slot.
+ * Looking up an identifier then needs one hash and at most one comparison.
+ * \param keywords
+ * \param types
+ */
+void SyntaxTokenizer::setWords(const QStringList &keywords, const QStringList &types)
+{
+  QVector<Word> words;
+  QStringList allWords;
+  foreach (const QString &type, types) {
+    if (!allWords.contains(type)) {
+      Word word = {type, Type};
+      words.append(word);
+      allWords.append(type);
+    }
+  }
+  foreach (const QString &keyword, keywords) {
+    if (!allWords.contains(keyword)) {
+      Word word = {keyword, Keyword};
+      words.append(word);
+      allWords.append(keyword);
+    }
+  }
+  uint size = 16;
+  while (size < (uint)words.size() * 2) {
+    size *= 2;
+  }
+  for (;;) {
+    for (uint seed = 1 ; seed <= 256 ; seed++) {
+      QVector<Word> table(size);
+      bool collision = false;
+      foreach (const Word &word, words) {
+        Word &slot = table[wordHash(word.mWord.constData(), word.mWord.size(), seed) & (size - 1)];
+        if (!slot.mWord.isEmpty()) {
+          collision = true;
+          break;
+        }
+        slot = word;
+      }
+      if (!collision) {
+        mWordsTable = table;
+        mWordsTableMask = size - 1;
+        mWordsTableSeed = seed;
+        return;
+      }
+    }
+    size *= 2;
+  }
+}
+
+/*!
+ * \brief SyntaxTokenizer::tokenize
+ * Splits the text block into tokens in one pass.\n
+ * Identifiers, whitespace and operators are not reported since they use the text format.
+ * \param text
+ * \param state - the state at the end of the previous block.
+ * \param tokens
+ * \return the state at the end of the block.
+ */
+int SyntaxTokenizer::tokenize(const QString &text, int state, QVector<Token> &tokens) const
+{
+  tokens.clear();
+  const QChar *pText = text.constData();
+  int length = text.length();
+  int index = 0;
+  int startIndex = 0;
+  if (state != MultiLineCommentState && state != QuotationState) {
+    state = NormalState;
+  }
+  while (index < length) {
+    QChar character = pText[index];
+    if (state == MultiLineCommentState) {
+      if (character == QLatin1Char('*') && index + 1 < length && pText[index + 1] == QLatin1Char('/')) {
+        index += 2;
+        appendToken(tokens, startIndex, index - startIndex, MultiLineComment);
+        state = NormalState;
+        continue;
+      } else if (isParenthesis(character)) {
+        appendToken(tokens, index, 1, QuotedParenthesis);
+      }
+      index++;
+    } else if (state == QuotationState) {
+      if (character == QLatin1Char('\\')) {
+        index += 2;
+        continue;
+      } else if (character == QLatin1Char('"')) {
+        index++;
+        appendToken(tokens, startIndex, index - startIndex, Quotation);
+        state = NormalState;
+        continue;
+      } else if (isParenthesis(character)) {
+        appendToken(tokens, index, 1, QuotedParenthesis);
+      }
+      index++;
+    } else if (character == QLatin1Char('/') && index + 1 < length && pText[index + 1] == QLatin1Char('/')) {
+      for (int i = index + 2 ; i < length ; i++) {
+        if (isParenthesis(pText[i])) {
+          appendToken(tokens, i, 1, QuotedParenthesis);
+        }
+      }
+      appendToken(tokens, index, length - index, SingleLineComment);
+      index = length;
+    } else if (character == QLatin1Char('/') && index + 1 < length && pText[index + 1] == QLatin1Char('*')) {
+      startIndex = index;
+      index += 2;
+      state = MultiLineCommentState;
+    } else if (character == QLatin1Char('"')) {
+      startIndex = index;
+      index++;
+      state = QuotationState;
+    } else if (isDigit(character)) {
+      // [0-9]+([.][0-9]*)?([eE][+-]?[0-9]*)?
+      int end = index + 1;
+      while (end < length && isDigit(pText[end])) {
+        end++;
+      }
+      if (end < length && pText[end] == QLatin1Char('.')) {
+        end++;
+        while (end < length && isDigit(pText[end])) {
+          end++;
+        }
+      }
+      if (end < length && (pText[end] == QLatin1Char('e') || pText[end] == QLatin1Char('E'))) {
+        end++;
+        if (end < length && (pText[end] == QLatin1Char('+') || pText[end] == QLatin1Char('-'))) {
+          end++;
+        }
+        while (end < length && isDigit(pText[end])) {
+          end++;
+        }
+      }
+      appendToken(tokens, index, end - index, Number);
+      // the rest of a word like 2abc is text.
+      index = end;
+      while (index < length && isWordCharacter(pText[index])) {
+        index++;
+      }
+    } else if (isWordCharacter(character)) {
+      int end = index + 1;
+      while (end < length && isWordCharacter(pText[end])) {
+        end++;
+      }
+      const Word *pWord = findWord(pText + index, end - index);
+      if (pWord) {
+        appendToken(tokens, index, end - index, pWord->mKind);
+      } else if (mHighlightFunctions && end < length && pText[end] == QLatin1Char('(')) {
+        appendToken(tokens, index, end - index, Function);
+      }
+      index = end;
+    } else {
+      if (isParenthesis(character)) {
+        appendToken(tokens, index, 1, Parenthesis);
+      } else if (character == QLatin1Char(';')) {
+        appendToken(tokens, index, 1, Semicolon);
+      }
+      index++;
+    }
+  }
+  if (state == MultiLineCommentState) {
+    appendToken(tokens, startIndex, length - startIndex, MultiLineComment);
+  } else if (state == QuotationState) {
+    appendToken(tokens, startIndex, length - startIndex, Quotation);
+  }
+  return state;
+}
+
+/*!
+ * \brief SyntaxTokenizer::indexOfWord
+ * Returns the index of the first occurrence of the whole word in the text or -1 i.e., the same as QRegExp("\\bword\\b").indexIn(text).
+ * \param text
+ * \param word
+ * \return
+ */
+int SyntaxTokenizer::indexOfWord(const QString &text, const QString &word)
+{
+  int index = text.indexOf(word);
+  while (index >= 0) {
+    int end = index + word.length();
+    if ((index == 0 || !isWordCharacter(text.at(index - 1))) && (end == text.length() || !isWordCharacter(text.at(end)))) {
+      return index;
+    }
+    index = text.indexOf(word, index + 1);
+  }
+  return -1;
+}
+
+uint SyntaxTokenizer::wordHash(const QChar *pWord, int length, uint seed)
+{
+  uint hash = seed ^ (uint)length;
+  for (int i = 0 ; i < length ; i++) {
+    hash = (hash * 16777619u) ^ pWord[i].unicode();
+  }
+  return hash ^ (hash >> 15);
+}
+
+const SyntaxTokenizer::Word* SyntaxTokenizer::findWord(const QChar *pWord, int length) const
+{
+  if (mWordsTable.isEmpty()) {
+    return 0;
+  }
+  const Word &word = mWordsTable.at(wordHash(pWord, length, mWordsTableSeed) & mWordsTableMask);
+  if (word.mWord.size() == length && word.mWord == QString::fromRawData(pWord, length)) {
+    return &word;
+  }
+  return 0;
+}
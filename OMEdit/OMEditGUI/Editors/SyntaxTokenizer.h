@@ -0,0 +1,91 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#ifndef SYNTAXTOKENIZER_H
+#define SYNTAXTOKENIZER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/*!
+ * \class SyntaxTokenizer
+ * \brief Hand-written tokenizer shared by the Modelica, MetaModelica and C highlighters.
+ * Classifies a text block in one pass. The multi line comments and the quotes are carried to the next block by the returned state.
+ * Only uses QtCore so it can be benchmarked without the editors.
+ */
+class SyntaxTokenizer
+{
+public:
+  /* The states are the same as the text block states used by the highlighters. */
+  enum State {
+    NormalState = 0,
+    MultiLineCommentState = 2,
+    QuotationState = 3
+  };
+  enum Kind {
+    Keyword,
+    Type,
+    Function,
+    Number,
+    Quotation,
+    SingleLineComment,
+    MultiLineComment,
+    Parenthesis,              /* (, ), {, }, [ or ] outside of comments and quotes. */
+    QuotedParenthesis,        /* parenthesis inside a comment or quotes. */
+    Semicolon                 /* ; outside of comments and quotes. */
+  };
+  typedef struct {
+    int mPosition;
+    int mLength;
+    Kind mKind;
+  } Token;
+
+  SyntaxTokenizer();
+  void setWords(const QStringList &keywords, const QStringList &types);
+  void setHighlightFunctions(bool highlightFunctions) {mHighlightFunctions = highlightFunctions;}
+  int tokenize(const QString &text, int state, QVector<Token> &tokens) const;
+  static int indexOfWord(const QString &text, const QString &word);
+private:
+  typedef struct {
+    QString mWord;
+    Kind mKind;
+  } Word;
+  QVector<Word> mWordsTable;
+  uint mWordsTableMask;
+  uint mWordsTableSeed;
+  bool mHighlightFunctions;
+
+  static uint wordHash(const QChar *pWord, int length, uint seed);
+  const Word* findWord(const QChar *pWord, int length) const;
+};
+
+#endif // SYNTAXTOKENIZER_H
@@ -0,0 +1,188 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/* Compares the Modelica syntax highlighting before and after the SyntaxTokenizer.
+ * Usage: SyntaxTokenizerBenchmark [number of lines]
+ * Synthetic Modelica lines (declarations, equations, annotations, comments and strings) are classified
+ * with the previous rules i.e., a QRegExp per keyword plus the number, identifier and function patterns
+ * followed by the character scan of the comments and quotes, and then with SyntaxTokenizer::tokenize.
+ * Only the matching is timed, the formats are not applied since that needs a QTextDocument.
+ * Fails if the state at the end of a line i.e., inside a multi line comment or string, differs between the two.
+ */
+
+#include "SyntaxTokenizer.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRegExp>
+#include <QStringList>
+#include <QVector>
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char *keywordsList[] = {
+  "algorithm", "and", "annotation", "assert", "block", "break", "Boolean", "class", "connect", "connector", "constant",
+  "constrainedby", "der", "discrete", "each", "else", "elseif", "elsewhen", "encapsulated", "end", "enumeration",
+  "equation", "expandable", "extends", "external", "false", "final", "flow", "for", "function", "if", "import", "impure",
+  "in", "initial", "inner", "input", "loop", "model", "not", "operator", "or", "outer", "output", "optimization", "package",
+  "parameter", "partial", "protected", "public", "pure", "record", "redeclare", "replaceable", "return", "stream", "then",
+  "true", "type", "when", "while", "within", 0
+};
+
+static const char *typesList[] = {"String", "Integer", "Boolean", "Real", 0};
+
+static const char *linesList[] = {
+  "  parameter Real k%1(unit = \"N/m\") = %1.5e-3 \"Spring constant %1\";",
+  "  Modelica.Mechanics.Translational.Components.Mass mass%1(m = %1) annotation(Placement(transformation(extent = {{-10, -10}, {10, 10}})));",
+  "  der(x%1) = -k%1 * x%1 + sin(time) / (1 + abs(y%1)); // equation %1",
+  "  /* multi line comment %1",
+  "     still the comment */ Integer n%1 = %1;",
+  "  if x%1 > 0.5 then y%1 := \"positive \\\" value\"; else y%1 := String(x%1); end if;",
+  0
+};
+
+/* The previous highlighting, one QRegExp per rule and a character scan for the multi line spans. */
+static int highlightWithRules(const QVector<QRegExp> &rules, const QString &text, int blockState)
+{
+  int matches = 0;
+  foreach (QRegExp expression, rules) {
+    int index = expression.indexIn(text);
+    while (index >= 0) {
+      int length = expression.matchedLength();
+      matches++;
+      index = expression.indexIn(text, index + length);
+    }
+  }
+  int index = 0;
+  while (index < text.length()) {
+    switch (blockState) {
+      case 1:
+        break;
+      case 2:
+        if (text[index] == '*' && index+1<text.length() && text[index+1] == '/') {
+          index++;
+          blockState = 0;
+        }
+        break;
+      case 3:
+        if (text[index] == '\\') {
+          index++;
+        } else if (text[index] == '"') {
+          blockState = 0;
+        }
+        break;
+      default:
+        if (text[index] == '/' && index+1<text.length() && text[index+1] == '/') {
+          index++;
+          blockState = 1;
+        } else if (text[index] == '/' && index+1<text.length() && text[index+1] == '*') {
+          index++;
+          blockState = 2;
+        } else if (text[index] == '"') {
+          blockState = 3;
+        }
+    }
+    if (text[index] == '(' || text[index] == ')' || text[index] == ';') {
+      matches++;
+    }
+    index++;
+  }
+  return blockState == 1 ? 0 : blockState;
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication application(argc, argv);
+  int count = argc > 1 ? atoi(argv[1]) : 100000;
+  if (count <= 0) {
+    fprintf(stderr, "Usage: %s [number of lines]\n", argv[0]);
+    return 1;
+  }
+
+  QStringList keywords, types;
+  for (int i = 0 ; keywordsList[i] ; i++) {
+    keywords.append(QLatin1String(keywordsList[i]));
+  }
+  for (int i = 0 ; typesList[i] ; i++) {
+    types.append(QLatin1String(typesList[i]));
+  }
+  QStringList lines;
+  for (int i = 0 ; lines.size() < count ; i++) {
+    for (int j = 0 ; linesList[j] && lines.size() < count ; j++) {
+      lines.append(QString(QLatin1String(linesList[j])).arg(i));
+    }
+  }
+
+  QVector<QRegExp> rules;
+  rules.append(QRegExp("[0-9][0-9]*([.][0-9]*)?([eE][+-]?[0-9]*)?"));
+  rules.append(QRegExp("\\b[A-Za-z_][A-Za-z0-9_]*"));
+  rules.append(QRegExp("\\b[A-Za-z0-9_]+(?=\\()"));
+  foreach (const QString &keyword, keywords) {
+    rules.append(QRegExp(QString("\\b%1\\b").arg(keyword)));
+  }
+  foreach (const QString &type, types) {
+    rules.append(QRegExp(QString("\\b%1\\b").arg(type)));
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  int state = 0;
+  QVector<int> states;
+  states.reserve(lines.size());
+  foreach (const QString &line, lines) {
+    state = highlightWithRules(rules, line, state);
+    states.append(state);
+  }
+  printf("QRegExp rules: %lld ms for %d lines\n", (long long)timer.elapsed(), lines.size());
+
+  SyntaxTokenizer syntaxTokenizer;
+  syntaxTokenizer.setWords(keywords, types);
+  syntaxTokenizer.setHighlightFunctions(true);
+  QVector<SyntaxTokenizer::Token> tokens;
+  int tokensCount = 0;
+  timer.start();
+  state = SyntaxTokenizer::NormalState;
+  QVector<int> tokenizerStates;
+  tokenizerStates.reserve(lines.size());
+  foreach (const QString &line, lines) {
+    state = syntaxTokenizer.tokenize(line, state, tokens);
+    tokensCount += tokens.size();
+    tokenizerStates.append(state);
+  }
+  printf("SyntaxTokenizer: %lld ms for %d lines, %d tokens\n", (long long)timer.elapsed(), lines.size(), tokensCount);
+  for (int i = 0 ; i < lines.size() ; i++) {
+    if (states.at(i) != tokenizerStates.at(i)) {
+      fprintf(stderr, "Different state %d and %d at the end of line %d: %s\n", states.at(i), tokenizerStates.at(i), i + 1,
+              qPrintable(lines.at(i)));
+      return 1;
+    }
+  }
+  return 0;
+}
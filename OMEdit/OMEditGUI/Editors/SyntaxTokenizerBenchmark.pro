@@ -0,0 +1,9 @@
+# Standalone benchmark of the syntax highlighting rules against the SyntaxTokenizer, see SyntaxTokenizerBenchmark.cpp.
+# Built and run by make -f Makefile.unix benchmark, or qmake SyntaxTokenizerBenchmark.pro && make && ./SyntaxTokenizerBenchmark 100000
+QT -= gui
+CONFIG += console
+CONFIG -= app_bundle
+TARGET = SyntaxTokenizerBenchmark
+SOURCES += SyntaxTokenizerBenchmark.cpp \
+  SyntaxTokenizer.cpp
+HEADERS += SyntaxTokenizer.h
@@ -44,6 +44,7 @@
 #include "Debugger/Locals/LocalsWidget.h"
 #include "Modeling/DocumentationWidget.h"
 #include "Plotting/VariablesWidget.h"
+#include "Plotting/ResultComparisonWidget.h"
 #include "Util/Helper.h"
 #include "Simulation/SimulationOutputWidget.h"
 #include "TLM/FetchInterfaceDataDialog.h"
@@ -267,6 +268,17 @@ void MainWindow::setUpMainWindow()
   mpVariablesDockWidget->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
   addDockWidget(Qt::RightDockWidgetArea, mpVariablesDockWidget);
   mpVariablesDockWidget->setWidget(mpVariablesWidget);
+  // create an object of ResultComparisonWidget
+  mpResultComparisonWidget = new ResultComparisonWidget(this);
+  // Create ResultComparisonWidget dock
+  mpResultComparisonDockWidget = new QDockWidget(tr("Result Comparison"), this);
+  mpResultComparisonDockWidget->setObjectName("ResultComparison");
+  mpResultComparisonDockWidget->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
+  addDockWidget(Qt::RightDockWidgetArea, mpResultComparisonDockWidget);
+  mpResultComparisonDockWidget->setWidget(mpResultComparisonWidget);
+  // put the result comparison dock widget next to the variables dock widget.
+  tabifyDockWidget(mpVariablesDockWidget, mpResultComparisonDockWidget);
+  mpResultComparisonDockWidget->hide();
   // set the corners for the dock widgets
   setCorner(Qt::TopLeftCorner, Qt::LeftDockWidgetArea);
   setCorner(Qt::BottomLeftCorner, Qt::LeftDockWidgetArea);
@@ -1117,22 +1129,17 @@ void MainWindow::PlotCallbackFunction(void *p, int externalWindow, const char* f
     VariablesTreeItem *pVariableTreeItem;
     VariablesTreeModel *pVariablesTreeModel = pMainWindow->getVariablesWidget()->getVariablesTreeModel();
     bool state = pVariablesTreeModel->blockSignals(true);
+    QModelIndexList indexes;
     foreach (QString variable, variablesList) {
       variable = fileInfo.fileName() + "." + variable;
       pVariableTreeItem = pVariablesTreeModel->findVariablesTreeItem(variable, pVariablesTreeModel->getRootVariablesTreeItem());
       if (pVariableTreeItem) {
         QModelIndex index = pVariablesTreeModel->variablesTreeItemIndex(pVariableTreeItem);
-        OMPlot::PlotCurve *pPlotCurve = 0;
-        foreach (OMPlot::PlotCurve *curve, pPlotWindow->getPlot()->getPlotCurvesList()) {
-          if (curve->getNameStructure().compare(pVariableTreeItem->getVariableName()) == 0) {
-            pPlotCurve = curve;
-            break;
-          }
-        }
         pVariablesTreeModel->setData(index, Qt::Checked, Qt::CheckStateRole);
-        pMainWindow->getVariablesWidget()->plotVariables(index, pPlotWindow->getCurveWidth(), pPlotWindow->getCurveStyle(), pPlotCurve);
+        indexes.append(index);
       }
     }
+    pMainWindow->getVariablesWidget()->plotVariables(indexes, pPlotWindow->getCurveWidth(), pPlotWindow->getCurveStyle(), pPlotWindow);
     // variables list is empty for plotAll
     if (strcmp(plotType, "plotall") == 0) {
       pVariableTreeItem = pVariablesTreeModel->findVariablesTreeItem(fileInfo.fileName(), pVariablesTreeModel->getRootVariablesTreeItem());
@@ -2304,6 +2311,10 @@ void MainWindow::documentationDockWidgetVisibilityChanged(bool visible)
  */
 void MainWindow::autoSave()
 {
+  // the auto save is tried again on the next timeout if a package is still being written or a class text is being merged.
+  if (mpLibraryWidget->isWritingFiles() || mpOMCProxy->isMergingText()) {
+    return;
+  }
   autoSaveHelper(mpLibraryWidget->getLibraryTreeModel()->getRootLibraryTreeItem());
 }
 
@@ -2879,6 +2890,7 @@ void MainWindow::createMenus()
   pViewWindowsMenu->addAction(mpLibraryDockWidget->toggleViewAction());
   pViewWindowsMenu->addAction(mpDocumentationDockWidget->toggleViewAction());
   pViewWindowsMenu->addAction(mpVariablesDockWidget->toggleViewAction());
+  pViewWindowsMenu->addAction(mpResultComparisonDockWidget->toggleViewAction());
   pViewWindowsMenu->addAction(mpMessagesDockWidget->toggleViewAction());
   pViewWindowsMenu->addAction(mpStackFramesDockWidget->toggleViewAction());
   pViewWindowsMenu->addAction(mpBreakpointsDockWidget->toggleViewAction());
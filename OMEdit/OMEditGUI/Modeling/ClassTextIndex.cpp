@@ -0,0 +1,479 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "ClassTextIndex.h"
+
+#include <QtAlgorithms>
+
+/*!
+ * \brief foldCase
+ * Returns the lower case code of the character. Modelica texts are mostly ASCII so it is done without QChar::toLower for them.
+ * \param character
+ * \return
+ */
+static inline quint32 foldCase(QChar character)
+{
+  ushort code = character.unicode();
+  if (code < 128) {
+    return (code >= 'A' && code <= 'Z') ? code + ('a' - 'A') : code;
+  }
+  return character.toLower().unicode();
+}
+
+/*!
+ * \brief appendLiteral
+ * Appends the literal to the literals if it is long enough to have a trigram and clears it.
+ * \param pLiterals
+ * \param pLiteral
+ */
+static void appendLiteral(QStringList *pLiterals, QString *pLiteral)
+{
+  if (pLiteral->size() >= 3) {
+    pLiterals->append(*pLiteral);
+  }
+  pLiteral->clear();
+}
+
+static bool postingsLessThan(const QVector<int> *pPostings1, const QVector<int> *pPostings2)
+{
+  return pPostings1->size() < pPostings2->size();
+}
+
+/*!
+ * \brief ClassTextIndex::ClassTextIndex
+ */
+ClassTextIndex::ClassTextIndex()
+{
+  mRemovedDocumentsCount = 0;
+}
+
+/*!
+ * \brief ClassTextIndex::setDocument
+ * Adds the document or replaces the document with the same key.
+ * \param key
+ * \param text
+ */
+void ClassTextIndex::setDocument(const QString &key, const QString &text)
+{
+  if (key.isEmpty()) {
+    return;
+  }
+  removeDocument(key);
+  Document document;
+  document.mKey = key;
+  document.mText = text;
+  int documentId = mDocuments.size();
+  mDocuments.append(document);
+  mDocumentIds.insert(key, documentId);
+  addPostings(documentId);
+}
+
+/*!
+ * \brief ClassTextIndex::removeDocument
+ * Removes the document with the key.
+ * The document is only marked as removed, the postings are compacted once half of the documents are removed.
+ * \param key
+ */
+void ClassTextIndex::removeDocument(const QString &key)
+{
+  int documentId = mDocumentIds.value(key, -1);
+  if (documentId < 0) {
+    return;
+  }
+  mDocumentIds.remove(key);
+  mDocuments[documentId].mKey.clear();
+  mDocuments[documentId].mText.clear();
+  mRemovedDocumentsCount++;
+  if (mRemovedDocumentsCount > 64 && mRemovedDocumentsCount > mDocumentIds.size()) {
+    compact();
+  }
+}
+
+/*!
+ * \brief ClassTextIndex::addDocuments
+ * Adds the documents of classTextIndex whose keys are not in this index.
+ * The postings are merged as they are so the trigrams are not computed again.
+ * \param classTextIndex
+ */
+void ClassTextIndex::addDocuments(const ClassTextIndex &classTextIndex)
+{
+  QVector<int> documentIds(classTextIndex.mDocuments.size(), -1);
+  for (int i = 0 ; i < classTextIndex.mDocuments.size() ; i++) {
+    const Document &document = classTextIndex.mDocuments.at(i);
+    if (!document.mKey.isEmpty() && !mDocumentIds.contains(document.mKey)) {
+      documentIds[i] = mDocuments.size();
+      mDocumentIds.insert(document.mKey, documentIds.at(i));
+      mDocuments.append(document);
+    }
+  }
+  // the new documents ids are greater than the existing ones so the postings stay sorted.
+  QHash<quint32, QVector<int> >::const_iterator iterator;
+  for (iterator = classTextIndex.mPostings.constBegin() ; iterator != classTextIndex.mPostings.constEnd() ; ++iterator) {
+    const QVector<int> &postings = iterator.value();
+    QVector<int> *pPostings = 0;
+    for (int i = 0 ; i < postings.size() ; i++) {
+      int documentId = documentIds.at(postings.at(i));
+      if (documentId >= 0) {
+        if (!pPostings) {
+          pPostings = &mPostings[iterator.key()];
+        }
+        pPostings->append(documentId);
+      }
+    }
+  }
+}
+
+/*!
+ * \brief ClassTextIndex::clear
+ * Removes all the documents.
+ */
+void ClassTextIndex::clear()
+{
+  mDocuments.clear();
+  mDocumentIds.clear();
+  mPostings.clear();
+  mRemovedDocumentsCount = 0;
+}
+
+/*!
+ * \brief ClassTextIndex::search
+ * Searches the regular expression in the documents and returns a match for every matching line.
+ * Only the documents containing the trigrams of the literals of the regular expression are searched.
+ * \param regExp
+ * \param maximumMatches - the maximum number of matches or -1 for all the matches.
+ * \return
+ */
+QList<ClassTextIndex::Match> ClassTextIndex::search(const QRegExp &regExp, int maximumMatches) const
+{
+  QList<Match> matches;
+  if (regExp.isEmpty() || !regExp.isValid()) {
+    return matches;
+  }
+  QRegExp searchRegExp(regExp);
+  bool fixedString = regExp.patternSyntax() == QRegExp::FixedString;
+  QVector<int> documentIds = getCandidateDocuments(regExp);
+  for (int i = 0 ; i < documentIds.size() ; i++) {
+    const Document &document = mDocuments.at(documentIds.at(i));
+    const QString &text = document.mText;
+    int line = 1;
+    int lineStart = 0;
+    int position = 0;
+    while (position <= text.size()) {
+      int index;
+      if (fixedString) {
+        index = text.indexOf(regExp.pattern(), position, regExp.caseSensitivity());
+      } else {
+        index = searchRegExp.indexIn(text, position);
+      }
+      if (index < 0) {
+        break;
+      }
+      int newLine = text.indexOf(QLatin1Char('\n'), lineStart);
+      while (newLine >= 0 && newLine < index) {
+        line++;
+        lineStart = newLine + 1;
+        newLine = text.indexOf(QLatin1Char('\n'), lineStart);
+      }
+      int lineEnd = newLine < 0 ? text.size() : newLine;
+      Match match;
+      match.mKey = document.mKey;
+      match.mLine = line;
+      match.mText = text.mid(lineStart, lineEnd - lineStart).trimmed();
+      matches.append(match);
+      if (maximumMatches >= 0 && matches.size() >= maximumMatches) {
+        return matches;
+      }
+      // one match per line
+      position = lineEnd + 1;
+    }
+  }
+  return matches;
+}
+
+/*!
+ * \brief ClassTextIndex::getLiterals
+ * Returns the literal parts of the pattern that every match must contain.
+ * The literals are only collected outside of the groups and a pattern with an alternation has no literals.
+ * \param regExp
+ * \return
+ */
+QStringList ClassTextIndex::getLiterals(const QRegExp &regExp)
+{
+  QStringList literals;
+  QString literal;
+  const QString pattern = regExp.pattern();
+  int size = pattern.size();
+  switch (regExp.patternSyntax()) {
+    case QRegExp::FixedString:
+      literal = pattern;
+      break;
+    case QRegExp::Wildcard:
+    case QRegExp::WildcardUnix:
+      for (int i = 0 ; i < size ; i++) {
+        QChar character = pattern.at(i);
+        if (character == QLatin1Char('*') || character == QLatin1Char('?')) {
+          appendLiteral(&literals, &literal);
+        } else if (character == QLatin1Char('[')) {
+          appendLiteral(&literals, &literal);
+          i++;
+          if (i < size && (pattern.at(i) == QLatin1Char('!') || pattern.at(i) == QLatin1Char('^'))) {
+            i++;
+          }
+          if (i < size && pattern.at(i) == QLatin1Char(']')) {
+            i++;
+          }
+          while (i < size && pattern.at(i) != QLatin1Char(']')) {
+            i++;
+          }
+        } else if (character == QLatin1Char('\\') && regExp.patternSyntax() == QRegExp::WildcardUnix && i + 1 < size) {
+          literal.append(pattern.at(++i));
+        } else {
+          literal.append(character);
+        }
+      }
+      break;
+    case QRegExp::RegExp:
+    case QRegExp::RegExp2:
+    {
+      int depth = 0;
+      for (int i = 0 ; i < size ; i++) {
+        QChar character = pattern.at(i);
+        if (character == QLatin1Char('\\')) {
+          if (++i >= size) {
+            break;
+          }
+          QChar escaped = pattern.at(i);
+          if (escaped.isLetterOrNumber()) {
+            // character classes, assertions, back references and character codes.
+            appendLiteral(&literals, &literal);
+            if (escaped == QLatin1Char('x')) {
+              while (i + 1 < size && QString("0123456789abcdefABCDEF").contains(pattern.at(i + 1))) {
+                i++;
+              }
+            } else if (escaped == QLatin1Char('0')) {
+              while (i + 1 < size && pattern.at(i + 1) >= QLatin1Char('0') && pattern.at(i + 1) <= QLatin1Char('7')) {
+                i++;
+              }
+            }
+          } else if (depth == 0) {
+            literal.append(escaped);
+          }
+        } else if (character == QLatin1Char('|')) {
+          return QStringList();
+        } else if (character == QLatin1Char('(')) {
+          appendLiteral(&literals, &literal);
+          depth++;
+        } else if (character == QLatin1Char(')')) {
+          appendLiteral(&literals, &literal);
+          depth = qMax(0, depth - 1);
+        } else if (character == QLatin1Char('[')) {
+          appendLiteral(&literals, &literal);
+          i++;
+          if (i < size && pattern.at(i) == QLatin1Char('^')) {
+            i++;
+          }
+          if (i < size && pattern.at(i) == QLatin1Char(']')) {
+            i++;
+          }
+          while (i < size && pattern.at(i) != QLatin1Char(']')) {
+            if (pattern.at(i) == QLatin1Char('\\')) {
+              i++;
+            }
+            i++;
+          }
+        } else if (character == QLatin1Char('*') || character == QLatin1Char('?') || character == QLatin1Char('{')) {
+          // the quantified character is optional.
+          literal.chop(1);
+          appendLiteral(&literals, &literal);
+          if (character == QLatin1Char('{')) {
+            while (i < size && pattern.at(i) != QLatin1Char('}')) {
+              i++;
+            }
+          }
+        } else if (character == QLatin1Char('+') || character == QLatin1Char('.') || character == QLatin1Char('^')
+                   || character == QLatin1Char('$')) {
+          appendLiteral(&literals, &literal);
+        } else if (depth == 0) {
+          literal.append(character);
+        }
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  appendLiteral(&literals, &literal);
+  return literals;
+}
+
+/*!
+ * \brief ClassTextIndex::getTrigrams
+ * Computes the sorted and unique trigrams of the case folded text.
+ * The three characters are packed in 32 bits, an overlap of non ASCII characters only adds candidates that are verified anyway.
+ * \param text
+ * \param pTrigrams
+ */
+void ClassTextIndex::getTrigrams(const QString &text, QVector<quint32> *pTrigrams)
+{
+  pTrigrams->clear();
+  if (text.size() < 3) {
+    return;
+  }
+  pTrigrams->reserve(text.size() - 2);
+  const QChar *pData = text.constData();
+  quint32 character1 = foldCase(pData[0]);
+  quint32 character2 = foldCase(pData[1]);
+  for (int i = 2 ; i < text.size() ; i++) {
+    quint32 character3 = foldCase(pData[i]);
+    pTrigrams->append((character1 << 20) ^ (character2 << 10) ^ character3);
+    character1 = character2;
+    character2 = character3;
+  }
+  qSort(pTrigrams->begin(), pTrigrams->end());
+  int size = 0;
+  for (int i = 0 ; i < pTrigrams->size() ; i++) {
+    if (size == 0 || pTrigrams->at(size - 1) != pTrigrams->at(i)) {
+      (*pTrigrams)[size++] = pTrigrams->at(i);
+    }
+  }
+  pTrigrams->resize(size);
+}
+
+/*!
+ * \brief ClassTextIndex::addPostings
+ * Adds the document to the postings of its trigrams.
+ * \param documentId
+ */
+void ClassTextIndex::addPostings(int documentId)
+{
+  QVector<quint32> trigrams;
+  getTrigrams(mDocuments.at(documentId).mText, &trigrams);
+  for (int i = 0 ; i < trigrams.size() ; i++) {
+    mPostings[trigrams.at(i)].append(documentId);
+  }
+}
+
+/*!
+ * \brief ClassTextIndex::getCandidateDocuments
+ * Returns the sorted ids of the documents containing all the trigrams of the literals of the regular expression.
+ * The postings are intersected starting with the shortest one.
+ * \param regExp
+ * \return
+ */
+QVector<int> ClassTextIndex::getCandidateDocuments(const QRegExp &regExp) const
+{
+  QVector<int> documentIds;
+  QList<const QVector<int>*> postingsList;
+  QVector<quint32> trigrams;
+  foreach (QString literal, getLiterals(regExp)) {
+    getTrigrams(literal, &trigrams);
+    for (int i = 0 ; i < trigrams.size() ; i++) {
+      QHash<quint32, QVector<int> >::const_iterator iterator = mPostings.constFind(trigrams.at(i));
+      if (iterator == mPostings.constEnd()) {
+        return documentIds;
+      }
+      postingsList.append(&iterator.value());
+    }
+  }
+  if (postingsList.isEmpty()) {
+    for (int i = 0 ; i < mDocuments.size() ; i++) {
+      if (!mDocuments.at(i).mKey.isEmpty()) {
+        documentIds.append(i);
+      }
+    }
+    return documentIds;
+  }
+  qSort(postingsList.begin(), postingsList.end(), postingsLessThan);
+  documentIds = *postingsList.at(0);
+  for (int i = 1 ; i < postingsList.size() && !documentIds.isEmpty() ; i++) {
+    const QVector<int> &postings = *postingsList.at(i);
+    int size = 0;
+    int j = 0;
+    for (int k = 0 ; k < documentIds.size() ; k++) {
+      while (j < postings.size() && postings.at(j) < documentIds.at(k)) {
+        j++;
+      }
+      if (j == postings.size()) {
+        break;
+      }
+      if (postings.at(j) == documentIds.at(k)) {
+        documentIds[size++] = documentIds.at(k);
+      }
+    }
+    documentIds.resize(size);
+  }
+  // skip the removed documents
+  int size = 0;
+  for (int i = 0 ; i < documentIds.size() ; i++) {
+    if (!mDocuments.at(documentIds.at(i)).mKey.isEmpty()) {
+      documentIds[size++] = documentIds.at(i);
+    }
+  }
+  documentIds.resize(size);
+  return documentIds;
+}
+
+/*!
+ * \brief ClassTextIndex::compact
+ * Drops the removed documents and renumbers the remaining ones in the postings.
+ */
+void ClassTextIndex::compact()
+{
+  QVector<int> documentIds(mDocuments.size(), -1);
+  QVector<Document> documents;
+  documents.reserve(mDocumentIds.size());
+  mDocumentIds.clear();
+  for (int i = 0 ; i < mDocuments.size() ; i++) {
+    if (!mDocuments.at(i).mKey.isEmpty()) {
+      documentIds[i] = documents.size();
+      mDocumentIds.insert(mDocuments.at(i).mKey, documents.size());
+      documents.append(mDocuments.at(i));
+    }
+  }
+  QHash<quint32, QVector<int> >::iterator iterator = mPostings.begin();
+  while (iterator != mPostings.end()) {
+    QVector<int> &postings = iterator.value();
+    int size = 0;
+    for (int i = 0 ; i < postings.size() ; i++) {
+      if (documentIds.at(postings.at(i)) >= 0) {
+        postings[size++] = documentIds.at(postings.at(i));
+      }
+    }
+    if (size == 0) {
+      iterator = mPostings.erase(iterator);
+    } else {
+      postings.resize(size);
+      ++iterator;
+    }
+  }
+  mDocuments = documents;
+  mRemovedDocumentsCount = 0;
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#ifndef CLASSTEXTINDEX_H
+#define CLASSTEXTINDEX_H
+
+#include <QHash>
+#include <QRegExp>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/*!
+ * \class ClassTextIndex
+ * \brief Trigram index of the Modelica texts used to search in the text of all the loaded classes.
+ * Each document is the text of a file, or of a class that is not saved yet, and is identified by a key i.e., the file name.
+ * The index maps every trigram of the case folded texts to the sorted list of the documents containing it.
+ * A search only verifies the documents that contain all the trigrams of the literal parts of the search pattern.
+ * Only uses QtCore so it can be built outside of the GUI thread.
+ */
+class ClassTextIndex
+{
+public:
+  typedef struct {
+    QString mKey;
+    int mLine;          /* the lines start at 1 like in OMC getClassInformation. */
+    QString mText;      /* the trimmed text of the line. */
+  } Match;
+
+  ClassTextIndex();
+  void setDocument(const QString &key, const QString &text);
+  void removeDocument(const QString &key);
+  void addDocuments(const ClassTextIndex &classTextIndex);
+  bool containsDocument(const QString &key) const {return mDocumentIds.contains(key);}
+  QStringList getDocumentKeys() const {return mDocumentIds.keys();}
+  int getDocumentsCount() const {return mDocumentIds.size();}
+  void clear();
+  QList<Match> search(const QRegExp &regExp, int maximumMatches = -1) const;
+  static QStringList getLiterals(const QRegExp &regExp);
+private:
+  typedef struct {
+    QString mKey;       /* empty for a removed document. */
+    QString mText;
+  } Document;
+
+  QVector<Document> mDocuments;
+  QHash<QString, int> mDocumentIds;
+  QHash<quint32, QVector<int> > mPostings;
+  int mRemovedDocumentsCount;
+
+  static void getTrigrams(const QString &text, QVector<quint32> *pTrigrams);
+  void addPostings(int documentId);
+  QVector<int> getCandidateDocuments(const QRegExp &regExp) const;
+  void compact();
+};
+
+#endif // CLASSTEXTINDEX_H
@@ -0,0 +1,230 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "FilesWriter.h"
+#include "Util/Utilities.h"
+
+#include <QFile>
+#include <QRunnable>
+#include <QTextStream>
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 1, 0))
+#include <QSaveFile>
+#endif
+
+/*!
+ * \class FilesWriterTask
+ * \brief Writes a range of the files of a FilesWriter.
+ * Each task writes into its own elements of the files vector so no locking is needed.
+ */
+class FilesWriterTask : public QRunnable
+{
+public:
+  FilesWriterTask(FilesWriter::File *pFiles, int count, FilesWriter::ByteOrderMark byteOrderMark, FilesWriter::LineEnding lineEnding,
+                  QAtomicInt *pWrittenFilesCount)
+  {
+    mpFiles = pFiles;
+    mCount = count;
+    mByteOrderMark = byteOrderMark;
+    mLineEnding = lineEnding;
+    mpWrittenFilesCount = pWrittenFilesCount;
+  }
+
+  void run()
+  {
+    for (int i = 0 ; i < mCount ; i++) {
+      FilesWriter::File *pFile = mpFiles + i;
+      pFile->mSaved = FilesWriter::writeFile(pFile->mFileName, pFile->mContents, mByteOrderMark, mLineEnding, &pFile->mErrorString);
+      mpWrittenFilesCount->fetchAndAddOrdered(1);
+    }
+  }
+private:
+  FilesWriter::File *mpFiles;
+  int mCount;
+  FilesWriter::ByteOrderMark mByteOrderMark;
+  FilesWriter::LineEnding mLineEnding;
+  QAtomicInt *mpWrittenFilesCount;
+};
+
+FilesWriter::FilesWriter(ByteOrderMark byteOrderMark, LineEnding lineEnding)
+  : mWrittenFilesCount(0)
+{
+  mByteOrderMark = byteOrderMark;
+  mLineEnding = lineEnding;
+}
+
+FilesWriter::~FilesWriter()
+{
+  mThreadPool.waitForDone();
+}
+
+/*!
+ * \brief FilesWriter::start
+ * Starts writing the files on the thread pool and returns immediately.\n
+ * The files vector must not be modified until FilesWriter::waitForDone() returns true.
+ * \param pFiles
+ */
+void FilesWriter::start(QVector<File> *pFiles)
+{
+  mWrittenFilesCount.fetchAndStoreOrdered(0);
+  if (pFiles->isEmpty()) {
+    return;
+  }
+  // detach the vector once here so that the tasks can write into its elements.
+  File *pFile = pFiles->data();
+  // a few tasks per thread balance the load without queuing one task per file.
+  int chunkSize = qMax(1, pFiles->size() / (qMax(1, mThreadPool.maxThreadCount()) * 4));
+  for (int i = 0 ; i < pFiles->size() ; i += chunkSize) {
+    mThreadPool.start(new FilesWriterTask(pFile + i, qMin(chunkSize, pFiles->size() - i), mByteOrderMark, mLineEnding,
+                                          &mWrittenFilesCount));
+  }
+}
+
+/*!
+ * \brief FilesWriter::waitForDone
+ * Waits at most msecs milliseconds for all the files to be written.
+ * \param msecs - -1 waits until all the files are written.
+ * \return true if all the files are written.
+ */
+bool FilesWriter::waitForDone(int msecs)
+{
+  return mThreadPool.waitForDone(msecs);
+}
+
+/*!
+ * \brief FilesWriter::getWrittenFilesCount
+ * Returns the number of files written so far, successfully or not.
+ * \return
+ */
+int FilesWriter::getWrittenFilesCount() const
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+  return mWrittenFilesCount.load();
+#else
+  return mWrittenFilesCount;
+#endif
+}
+
+/*!
+ * \brief FilesWriter::createFile
+ * Creates a file to write.
+ * \param fileName
+ * \param contents
+ * \return
+ */
+FilesWriter::File FilesWriter::createFile(const QString &fileName, const QString &contents)
+{
+  File file;
+  file.mFileName = fileName;
+  file.mContents = contents;
+  file.mSaved = false;
+  return file;
+}
+
+/*!
+ * \brief FilesWriter::writeFile
+ * Writes the contents to the file in UTF-8 with the line ending and the byte order mark settings.\n
+ * Can be called from any thread.
+ * \param fileName
+ * \param contents
+ * \param byteOrderMark
+ * \param lineEnding
+ * \param pErrorString - set to the error when the file can't be written.
+ * \return
+ */
+bool FilesWriter::writeFile(const QString &fileName, const QString &contents, ByteOrderMark byteOrderMark, LineEnding lineEnding,
+                            QString *pErrorString)
+{
+  // set the BOM settings
+  bool bom = false;
+  switch (byteOrderMark) {
+    case AddByteOrderMark:
+      bom = true;
+      break;
+    case KeepByteOrderMark:
+      bom = Utilities::detectBOM(fileName);
+      break;
+    case DeleteByteOrderMark:
+    default:
+      bom = false;
+      break;
+  }
+  // set the line ending format
+  QString newContents;
+  switch (lineEnding) {
+    case CRLFLineEnding: {
+      QString text = contents;
+      QTextStream crlfTextStream(&text, QIODevice::ReadOnly);
+      while (!crlfTextStream.atEnd()) {
+        newContents += crlfTextStream.readLine() + "\r\n";
+      }
+      break;
+    }
+    case LFLineEnding:
+    default:
+      newContents = contents;
+      newContents.replace(QLatin1String("\r\n"), QLatin1String("\n"));
+      break;
+  }
+  QByteArray data;
+  if (bom) {
+    data.append("\xEF\xBB\xBF");
+  }
+  data.append(newContents.toUtf8());
+  // open the file for writing
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 1, 0))
+  QSaveFile file(fileName);
+#else
+  QFile file(fileName);
+#endif
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    *pErrorString = file.errorString();
+    return false;
+  }
+  if (file.write(data) != data.size()) {
+    *pErrorString = file.errorString();
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 1, 0))
+    file.cancelWriting();
+#else
+    file.close();
+#endif
+    return false;
+  }
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 1, 0))
+  // replaces the original file with the temporary file.
+  if (!file.commit()) {
+    *pErrorString = file.errorString();
+    return false;
+  }
+#else
+  file.close();
+#endif
+  return true;
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#ifndef FILESWRITER_H
+#define FILESWRITER_H
+
+#include <QAtomicInt>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+/*!
+ * \class FilesWriter
+ * \brief Writes a set of files in parallel on its own thread pool.
+ * The contents of all the files are generated before writing so the workers never touch the LibraryTreeItems or OMC.
+ * Each file is written to a temporary file that replaces the original file when it is complete, so a failed save never leaves a
+ * truncated file behind. Only uses QtCore so it can be used by the benchmark.
+ */
+class FilesWriter
+{
+public:
+  enum ByteOrderMark {
+    AddByteOrderMark,
+    KeepByteOrderMark,
+    DeleteByteOrderMark
+  };
+  enum LineEnding {
+    CRLFLineEnding,
+    LFLineEnding
+  };
+  typedef struct {
+    QString mFileName;
+    QString mContents;
+    bool mSaved;
+    QString mErrorString;
+  } File;
+
+  FilesWriter(ByteOrderMark byteOrderMark, LineEnding lineEnding);
+  ~FilesWriter();
+  void start(QVector<File> *pFiles);
+  bool waitForDone(int msecs = -1);
+  int getWrittenFilesCount() const;
+  static File createFile(const QString &fileName, const QString &contents);
+  static bool writeFile(const QString &fileName, const QString &contents, ByteOrderMark byteOrderMark, LineEnding lineEnding,
+                        QString *pErrorString);
+private:
+  ByteOrderMark mByteOrderMark;
+  LineEnding mLineEnding;
+  QThreadPool mThreadPool;
+  QAtomicInt mWrittenFilesCount;
+};
+
+#endif // FILESWRITER_H
@@ -0,0 +1,156 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/* Compares saving a folder structure package serially and with the FilesWriter.
+ * Usage: FilesWriterBenchmark [number of files] [directory]
+ * A synthetic package of 5000 files by default is written in the directory (a folder in the temporary directory by default)
+ * once with a QTextStream per file like LibraryWidget::saveFile used to, and once in parallel with the FilesWriter.
+ * The dirty-only save is measured by writing again 1% of the files with the FilesWriter.
+ * Fails if a file can't be written or if a file written by the FilesWriter differs from the serial one.
+ */
+
+#include "FilesWriter.h"
+#include "Util/Utilities.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <stdio.h>
+
+/* Writes the file the way LibraryWidget::saveFile did before the FilesWriter. */
+static bool writeFileSerially(const FilesWriter::File &file)
+{
+  QFile outputFile(file.mFileName);
+  if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    return false;
+  }
+  QTextStream textStream(&outputFile);
+  textStream.setCodec("UTF-8");
+  textStream << file.mContents;
+  outputFile.close();
+  return true;
+}
+
+/* Utilities.cpp needs the whole OMEdit so the benchmark has its own Utilities::detectBOM for FilesWriter::KeepByteOrderMark. */
+bool Utilities::detectBOM(QString fileName)
+{
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  return file.read(3) == QByteArray("\xef\xbb\xbf");
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication application(argc, argv);
+  int count = argc > 1 ? QString::fromLocal8Bit(argv[1]).toInt() : 5000;
+  QString directory = argc > 2 ? QString::fromLocal8Bit(argv[2]) : QDir::tempPath() + "/FilesWriterBenchmark";
+  if (count <= 0) {
+    fprintf(stderr, "Usage: %s [number of files] [directory]\n", argv[0]);
+    return 1;
+  }
+  // a package of 100 classes per sub package
+  QVector<FilesWriter::File> files;
+  int packagesCount = (count + 99) / 100;
+  QString packageOrder;
+  for (int i = 0 ; i < packagesCount ; i++) {
+    QString packageDirectory = QString("%1/Library/Package%2").arg(directory).arg(i);
+    QDir().mkpath(packageDirectory);
+    packageOrder += QString("Package%1\n").arg(i);
+    QString classOrder;
+    for (int j = 0 ; j < 100 && files.size() < count ; j++) {
+      QString text = QString("within Library.Package%1;\nmodel Class%2 \"Synthetic class %2\"\n").arg(i).arg(j);
+      for (int k = 0 ; k < 50 ; k++) {
+        text += QString("  parameter Real k%1(unit = \"N/m\") = %2 \"Spring constant\";\n").arg(k).arg(k * 0.5);
+      }
+      text += QString("equation\n  der(x) = -k0 * x;\nend Class%1;\n").arg(j);
+      files.append(FilesWriter::createFile(QString("%1/Class%2.mo").arg(packageDirectory).arg(j), text));
+      classOrder += QString("Class%1\n").arg(j);
+    }
+    files.append(FilesWriter::createFile(QString("%1/package.order").arg(packageDirectory), classOrder));
+  }
+  files.append(FilesWriter::createFile(QString("%1/Library/package.order").arg(directory), packageOrder));
+
+  QElapsedTimer timer;
+  timer.start();
+  int failed = 0;
+  foreach (const FilesWriter::File &file, files) {
+    if (!writeFileSerially(file)) {
+      failed++;
+    }
+  }
+  printf("Serial QTextStream: %lld ms to write %d files, %d failed\n", (long long)timer.elapsed(), files.size(), failed);
+  if (failed > 0) {
+    return 1;
+  }
+  QVector<QByteArray> serialContents;
+  serialContents.reserve(files.size());
+  foreach (const FilesWriter::File &file, files) {
+    QFile serialFile(file.mFileName);
+    serialFile.open(QIODevice::ReadOnly);
+    serialContents.append(serialFile.readAll());
+  }
+
+  timer.start();
+  FilesWriter filesWriter(FilesWriter::DeleteByteOrderMark, FilesWriter::LFLineEnding);
+  filesWriter.start(&files);
+  filesWriter.waitForDone();
+  failed = 0;
+  foreach (const FilesWriter::File &file, files) {
+    if (!file.mSaved) {
+      failed++;
+    }
+  }
+  printf("FilesWriter: %lld ms to write %d files, %d failed\n", (long long)timer.elapsed(), files.size(), failed);
+  if (failed > 0) {
+    return 1;
+  }
+  for (int i = 0 ; i < files.size() ; i++) {
+    QFile writtenFile(files.at(i).mFileName);
+    writtenFile.open(QIODevice::ReadOnly);
+    if (writtenFile.readAll() != serialContents.at(i)) {
+      fprintf(stderr, "%s differs from the serially written file\n", qPrintable(files.at(i).mFileName));
+      return 1;
+    }
+  }
+
+  QVector<FilesWriter::File> dirtyFiles;
+  for (int i = 0 ; i < files.size() ; i += 100) {
+    dirtyFiles.append(files.at(i));
+  }
+  timer.start();
+  filesWriter.start(&dirtyFiles);
+  filesWriter.waitForDone();
+  printf("FilesWriter: %lld ms to write %d dirty files\n", (long long)timer.elapsed(), dirtyFiles.size());
+  return 0;
+}
@@ -0,0 +1,14 @@
+# Standalone benchmark of saving a folder structure package with the FilesWriter, see FilesWriterBenchmark.cpp.
+# Built and run by make -f Makefile.unix benchmark, or qmake FilesWriterBenchmark.pro && make && ./FilesWriterBenchmark 5000
+# FilesWriter.cpp includes Util/Utilities.h, which needs the widgets and xmlpatterns headers.
+QT += xmlpatterns
+greaterThan(QT_MAJOR_VERSION, 4) {
+  QT += widgets
+}
+INCLUDEPATH += ..
+CONFIG += console
+CONFIG -= app_bundle
+TARGET = FilesWriterBenchmark
+SOURCES += FilesWriterBenchmark.cpp \
+  FilesWriter.cpp
+HEADERS += FilesWriter.h
@@ -0,0 +1,154 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/* Compares the lookups of LibraryTreeModel::findLibraryTreeItem before and after the name structure hash.
+ * Usage: LibraryTreeModelBenchmark [number of classes] [number of lookups]
+ * A synthetic tree of 200000 classes (default) like Library3.Package12.Class7 is created with plain items
+ * since a LibraryTreeItem needs a running OMC. Random names are then looked up with the recursive scan
+ * of the whole tree and with the QMultiHash of the name structures, case sensitive and case insensitive.
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <stdio.h>
+#include <stdlib.h>
+
+class Item
+{
+public:
+  Item(const QString &nameStructure, Item *pParent) : mNameStructure(nameStructure), mpParent(pParent) {}
+  ~Item() {qDeleteAll(mChildren);}
+  QString mNameStructure;
+  Item *mpParent;
+  QList<Item*> mChildren;
+};
+
+static Item* findItem(const QString &name, Item *pItem, Qt::CaseSensitivity caseSensitivity)
+{
+  if (pItem->mNameStructure.compare(name, caseSensitivity) == 0) {
+    return pItem;
+  }
+  for (int i = pItem->mChildren.size(); --i >= 0; ) {
+    if (Item *item = findItem(name, pItem->mChildren.at(i), caseSensitivity)) {
+      return item;
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication application(argc, argv);
+  int count = argc > 1 ? atoi(argv[1]) : 200000;
+  int lookups = argc > 2 ? atoi(argv[2]) : 1000;
+  if (count <= 0 || lookups <= 0) {
+    fprintf(stderr, "Usage: %s [number of classes] [number of lookups]\n", argv[0]);
+    return 1;
+  }
+
+  Item root("", 0);
+  QMultiHash<QString, Item*> itemsHash;
+  QMultiHash<QString, Item*> caseFoldedItemsHash;
+  QStringList names;
+  int libraries = qMax(count / 10000, 1);
+  for (int i = 0 ; names.size() < count ; i++) {
+    Item *pLibrary = new Item(QString("Library%1").arg(i), &root);
+    root.mChildren.append(pLibrary);
+    names.append(pLibrary->mNameStructure);
+    for (int j = 0 ; j < 100 && names.size() < count ; j++) {
+      Item *pPackage = new Item(QString("%1.Package%2").arg(pLibrary->mNameStructure).arg(j), pLibrary);
+      pLibrary->mChildren.append(pPackage);
+      names.append(pPackage->mNameStructure);
+      for (int k = 0 ; k < count / (libraries * 100) && names.size() < count ; k++) {
+        Item *pClass = new Item(QString("%1.Class%2").arg(pPackage->mNameStructure).arg(k), pPackage);
+        pPackage->mChildren.append(pClass);
+        names.append(pClass->mNameStructure);
+      }
+    }
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  QList<Item*> items;
+  items.append(&root);
+  while (!items.isEmpty()) {
+    Item *pItem = items.takeLast();
+    itemsHash.insert(pItem->mNameStructure, pItem);
+    caseFoldedItemsHash.insert(pItem->mNameStructure.toCaseFolded(), pItem);
+    items.append(pItem->mChildren);
+  }
+  printf("%d classes, hash built in %lld ms\n", names.size(), (long long)timer.elapsed());
+
+  srand(1);
+  QStringList lookupNames;
+  for (int i = 0 ; i < lookups ; i++) {
+    lookupNames.append(names.at(rand() % names.size()));
+  }
+
+  timer.start();
+  foreach (const QString &name, lookupNames) {
+    if (!findItem(name, &root, Qt::CaseSensitive)) {
+      fprintf(stderr, "%s not found\n", qPrintable(name));
+      return 1;
+    }
+  }
+  printf("Recursive scan: %lld ms for %d lookups\n", (long long)timer.elapsed(), lookups);
+
+  timer.start();
+  foreach (const QString &name, lookupNames) {
+    if (!findItem(name.toLower(), &root, Qt::CaseInsensitive)) {
+      fprintf(stderr, "%s not found\n", qPrintable(name));
+      return 1;
+    }
+  }
+  printf("Recursive scan, case insensitive: %lld ms for %d lookups\n", (long long)timer.elapsed(), lookups);
+
+  timer.start();
+  foreach (const QString &name, lookupNames) {
+    if (itemsHash.value(name)->mNameStructure != name) {
+      fprintf(stderr, "%s not found\n", qPrintable(name));
+      return 1;
+    }
+  }
+  printf("Hash: %lld ms for %d lookups\n", (long long)timer.elapsed(), lookups);
+
+  timer.start();
+  foreach (const QString &name, lookupNames) {
+    if (caseFoldedItemsHash.value(name.toLower().toCaseFolded())->mNameStructure != name) {
+      fprintf(stderr, "%s not found\n", qPrintable(name));
+      return 1;
+    }
+  }
+  printf("Hash, case insensitive: %lld ms for %d lookups\n", (long long)timer.elapsed(), lookups);
+  return 0;
+}
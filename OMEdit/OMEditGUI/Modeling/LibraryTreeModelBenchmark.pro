@@ -0,0 +1,7 @@
+# Standalone benchmark of the LibraryTreeModel::findLibraryTreeItem lookups, see LibraryTreeModelBenchmark.cpp.
+# Built and run by make -f Makefile.unix benchmark, or qmake LibraryTreeModelBenchmark.pro && make && ./LibraryTreeModelBenchmark 200000
+QT -= gui
+CONFIG += console
+CONFIG -= app_bundle
+TARGET = LibraryTreeModelBenchmark
+SOURCES += LibraryTreeModelBenchmark.cpp
@@ -41,6 +41,8 @@
 #include "Simulation/SimulationOutputWidget.h"
 #include "ModelicaClassDialog.h"
 
+#include <QApplication>
+
 ItemDelegate::ItemDelegate(QObject *pParent, bool drawRichText, bool drawGrid)
   : QItemDelegate(pParent)
 {
@@ -931,12 +933,47 @@ LibraryTreeProxyModel::LibraryTreeProxyModel(LibraryWidget *pLibraryWidget, bool
 {
   mpLibraryWidget = pLibraryWidget;
   mShowOnlyModelica = showOnlyModelica;
+  mSearchInText = false;
+  mFilterCacheShowProtectedClasses = false;
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::setSearchInText
+ * Sets the LibraryTreeItems found by searching in the class text, see LibraryTreeModel::findLibraryTreeItemsInClassText.
+ * The filter is not invalidated here, it is done by QSortFilterProxyModel::setFilterRegExp.
+ * \param searchInText
+ * \param classes - the name structures of the matching classes along with their parents.
+ */
+void LibraryTreeProxyModel::setSearchInText(bool searchInText, const QSet<QString> &classes)
+{
+  mSearchInText = searchInText;
+  mSearchInTextClasses = classes;
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::setSourceModel
+ * Connects the source model signals that change the cached filter results.
+ * The signals are connected before QSortFilterProxyModel::setSourceModel so the cache is updated before the changed rows are filtered.
+ * \param pSourceModel
+ */
+void LibraryTreeProxyModel::setSourceModel(QAbstractItemModel *pSourceModel)
+{
+  clearFilterCache();
+  if (pSourceModel) {
+    connect(pSourceModel, SIGNAL(dataChanged(QModelIndex,QModelIndex)), SLOT(sourceDataChanged(QModelIndex,QModelIndex)));
+    connect(pSourceModel, SIGNAL(rowsInserted(QModelIndex,int,int)), SLOT(sourceRowsInserted(QModelIndex,int,int)));
+    connect(pSourceModel, SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)), SLOT(sourceRowsAboutToBeRemoved(QModelIndex,int,int)));
+    connect(pSourceModel, SIGNAL(modelReset()), SLOT(clearFilterCache()));
+    connect(pSourceModel, SIGNAL(layoutChanged()), SLOT(clearFilterCache()));
+  }
+  QSortFilterProxyModel::setSourceModel(pSourceModel);
 }
 
 /*!
  * \brief LibraryTreeProxyModel::filterAcceptsRow
- * Filters the LibraryTreeItems based on the filter reguler expression.
- * Also checks if LibraryTreeItem is protected and show/hide it based on Show Protected Classes settings value.
+ * Filters the LibraryTreeItems based on the filter reguler expression or on the LibraryTreeItems found in the class text.
+ * Also checks if LibraryTreeItem is protected and show/hide it based on Show Protected Classes settings value.\n
+ * The result of every LibraryTreeItem is cached, see LibraryTreeProxyModel::filterAcceptsLibraryTreeItem.
  * \param sourceRow
  * \param sourceParent
  * \return
@@ -946,32 +983,181 @@ bool LibraryTreeProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &s
   QModelIndex index = sourceModel()->index(sourceRow, 0, sourceParent);
   if (index.isValid()) {
     LibraryTreeItem *pLibraryTreeItem = static_cast<LibraryTreeItem*>(index.internalPointer());
+    if (!pLibraryTreeItem) {
+      return sourceModel()->data(index).toString().contains(filterRegExp());
+    }
     // if showOnlyModelica flag is enabled then filter out all other types of LibraryTreeItem e.g., MetaModel & Text.
-    if (mShowOnlyModelica && pLibraryTreeItem && pLibraryTreeItem->getLibraryType() != LibraryTreeItem::Modelica) {
+    if (mShowOnlyModelica && pLibraryTreeItem->getLibraryType() != LibraryTreeItem::Modelica) {
       return false;
     }
-    // if any of children matches the filter, then current index matches the filter as well
-    int rows = sourceModel()->rowCount(index);
-    for (int i = 0 ; i < rows ; ++i) {
-      if (filterAcceptsRow(i, index)) {
-        return true;
-      }
+    // the classes found in the class text already contain the parents of the matching classes.
+    if (mSearchInText) {
+      return mSearchInTextClasses.contains(pLibraryTreeItem->getNameStructure());
     }
-    // check current index itself
-    if (pLibraryTreeItem) {
-      if (pLibraryTreeItem->isProtected() && !OptionsDialog::instance()->getGeneralSettingsPage()->getShowProtectedClasses()) {
-        return false;
-      } else {
-        return pLibraryTreeItem->getNameStructure().contains(filterRegExp());
-      }
-    } else {
-      return sourceModel()->data(index).toString().contains(filterRegExp());
+    // the cached results are only valid for the filter and the Show Protected Classes settings value they are computed with.
+    bool showProtectedClasses = OptionsDialog::instance()->getGeneralSettingsPage()->getShowProtectedClasses();
+    if (mFilterCacheRegExp != filterRegExp() || mFilterCacheShowProtectedClasses != showProtectedClasses) {
+      mFilterCache.clear();
+      mFilterCacheRegExp = filterRegExp();
+      mFilterCacheShowProtectedClasses = showProtectedClasses;
     }
+    return filterAcceptsLibraryTreeItem(pLibraryTreeItem);
   } else {
     return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
   }
 }
 
+/*!
+ * \brief LibraryTreeProxyModel::filterAcceptsLibraryTreeItem
+ * Returns true if the LibraryTreeItem or any of its children matches the filter.\n
+ * The result is cached so the filter is matched once per LibraryTreeItem instead of once per row and per parent row.
+ * The children are only checked until one of them matches, the others are checked when their rows are filtered.
+ * \param pLibraryTreeItem
+ * \return
+ */
+bool LibraryTreeProxyModel::filterAcceptsLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem) const
+{
+  QHash<LibraryTreeItem*, bool>::const_iterator iterator = mFilterCache.constFind(pLibraryTreeItem);
+  if (iterator != mFilterCache.constEnd()) {
+    return iterator.value();
+  }
+  bool accept = false;
+  if (!(mShowOnlyModelica && pLibraryTreeItem->getLibraryType() != LibraryTreeItem::Modelica)) {
+    // if any of children matches the filter, then current item matches the filter as well
+    for (int i = 0 ; i < pLibraryTreeItem->childrenSize() && !accept ; i++) {
+      accept = filterAcceptsLibraryTreeItem(pLibraryTreeItem->childAt(i));
+    }
+    // check current item itself
+    if (!accept && (mFilterCacheShowProtectedClasses || !pLibraryTreeItem->isProtected())) {
+      accept = mFilterCacheRegExp.indexIn(pLibraryTreeItem->getNameStructure()) >= 0;
+    }
+  }
+  mFilterCache.insert(pLibraryTreeItem, accept);
+  return accept;
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::removeParentsFromFilterCache
+ * Removes the cached result of the LibraryTreeItem and of its parents.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeProxyModel::removeParentsFromFilterCache(LibraryTreeItem *pLibraryTreeItem)
+{
+  while (pLibraryTreeItem) {
+    mFilterCache.remove(pLibraryTreeItem);
+    pLibraryTreeItem = pLibraryTreeItem->parent();
+  }
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::removeChildrenFromFilterCache
+ * Removes the cached result of the LibraryTreeItem and of all its children.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeProxyModel::removeChildrenFromFilterCache(LibraryTreeItem *pLibraryTreeItem)
+{
+  mFilterCache.remove(pLibraryTreeItem);
+  for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
+    removeChildrenFromFilterCache(pLibraryTreeItem->childAt(i));
+  }
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::sourceDataChanged
+ * Removes the cached result of the changed LibraryTreeItems and of their parents since their names might have changed.
+ * \param topLeft
+ * \param bottomRight
+ */
+void LibraryTreeProxyModel::sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+  if (mFilterCache.isEmpty() || !topLeft.isValid() || !bottomRight.isValid()) {
+    return;
+  }
+  for (int row = topLeft.row() ; row <= bottomRight.row() ; row++) {
+    QModelIndex index = sourceModel()->index(row, 0, topLeft.parent());
+    if (index.isValid()) {
+      removeParentsFromFilterCache(static_cast<LibraryTreeItem*>(index.internalPointer()));
+    }
+  }
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::sourceRowsInserted
+ * Removes the cached result of the parents of the inserted LibraryTreeItems.
+ * \param parent
+ * \param first
+ * \param last
+ */
+void LibraryTreeProxyModel::sourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+  Q_UNUSED(first);
+  Q_UNUSED(last);
+  if (parent.isValid()) {
+    removeParentsFromFilterCache(static_cast<LibraryTreeItem*>(parent.internalPointer()));
+  }
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::sourceRowsAboutToBeRemoved
+ * Removes the cached result of the LibraryTreeItems about to be removed, and of their children and parents.
+ * The LibraryTreeItems are deleted afterwards so their addresses might be reused by new LibraryTreeItems.
+ * \param parent
+ * \param first
+ * \param last
+ */
+void LibraryTreeProxyModel::sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+  if (mFilterCache.isEmpty()) {
+    return;
+  }
+  for (int row = first ; row <= last ; row++) {
+    QModelIndex index = sourceModel()->index(row, 0, parent);
+    if (index.isValid()) {
+      removeChildrenFromFilterCache(static_cast<LibraryTreeItem*>(index.internalPointer()));
+    }
+  }
+  if (parent.isValid()) {
+    removeParentsFromFilterCache(static_cast<LibraryTreeItem*>(parent.internalPointer()));
+  }
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::clearFilterCache
+ * Clears the cached results.
+ */
+void LibraryTreeProxyModel::clearFilterCache()
+{
+  mFilterCache.clear();
+}
+
+/*!
+ * \brief ClassTextIndexBuilderThread::ClassTextIndexBuilderThread
+ * \param fileNames
+ * \param pParent
+ */
+ClassTextIndexBuilderThread::ClassTextIndexBuilderThread(const QStringList &fileNames, QObject *pParent)
+  : QThread(pParent), mFileNames(fileNames)
+{
+}
+
+/*!
+ * \brief ClassTextIndexBuilderThread::run
+ * Reads and indexes the files. A file that can't be read is indexed with an empty text so it is not read again.
+ * The documents are added to the LibraryTreeModel index in the GUI thread by LibraryTreeModel::classTextIndexBuilt.
+ */
+void ClassTextIndexBuilderThread::run()
+{
+  foreach (QString fileName, mFileNames) {
+    QFile file(fileName);
+    if (file.open(QIODevice::ReadOnly)) {
+      mClassTextIndex.setDocument(fileName, QString::fromUtf8(file.readAll()));
+      file.close();
+    } else {
+      mClassTextIndex.setDocument(fileName, QString());
+    }
+  }
+}
+
 /*!
  * \class LibraryTreeModel
  * \brief A model for Libraries Browser.
@@ -985,6 +1171,20 @@ LibraryTreeModel::LibraryTreeModel(LibraryWidget *pLibraryWidget)
 {
   mpLibraryWidget = pLibraryWidget;
   mpRootLibraryTreeItem = new LibraryTreeItem;
+  mpClassTextIndexBuilderThread = 0;
+}
+
+/*!
+ * \brief LibraryTreeModel::~LibraryTreeModel
+ * Waits for the running ClassTextIndexBuilderThread, if any.
+ */
+LibraryTreeModel::~LibraryTreeModel()
+{
+  if (mpClassTextIndexBuilderThread) {
+    disconnect(mpClassTextIndexBuilderThread, SIGNAL(finished()), this, SLOT(classTextIndexBuilt()));
+    mpClassTextIndexBuilderThread->wait();
+    delete mpClassTextIndexBuilderThread;
+  }
 }
 
 /*!
@@ -1122,7 +1322,9 @@ Qt::ItemFlags LibraryTreeModel::flags(const QModelIndex &index) const
 
 /*!
  * \brief LibraryTreeModel::findLibraryTreeItem
- * Finds the LibraryTreeItem based on the name and case sensitivity.
+ * Finds the LibraryTreeItem based on the name and case sensitivity.\n
+ * The items of the Libraries Browser are looked up in mLibraryTreeItemsHash/mCaseFoldedLibraryTreeItemsHash.
+ * If pLibraryTreeItem is given then only the items of its subtree are returned.
  * \param name
  * \param pLibraryTreeItem
  * \return
@@ -1136,9 +1338,25 @@ LibraryTreeItem* LibraryTreeModel::findLibraryTreeItem(const QString &name, Libr
   if (pLibraryTreeItem->getNameStructure().compare(name, caseSensitivity) == 0) {
     return pLibraryTreeItem;
   }
-  for (int i = pLibraryTreeItem->childrenSize(); --i >= 0; ) {
-    if (LibraryTreeItem *item = findLibraryTreeItem(name, pLibraryTreeItem->childAt(i), caseSensitivity)) {
-      return item;
+  // the items which are not in the Libraries Browser are not in the hash, search them the slow way.
+  if (!isLibraryTreeItemInHash(pLibraryTreeItem)) {
+    return findLibraryTreeItemHelper(name, pLibraryTreeItem, caseSensitivity);
+  }
+  QList<LibraryTreeItem*> libraryTreeItems;
+  if (caseSensitivity == Qt::CaseSensitive) {
+    libraryTreeItems = mLibraryTreeItemsHash.values(name);
+  } else {
+    libraryTreeItems = mCaseFoldedLibraryTreeItemsHash.values(name.toCaseFolded());
+  }
+  foreach (LibraryTreeItem *pFoundLibraryTreeItem, libraryTreeItems) {
+    if (pLibraryTreeItem == mpRootLibraryTreeItem) {
+      return pFoundLibraryTreeItem;
+    }
+    for (LibraryTreeItem *pParentLibraryTreeItem = pFoundLibraryTreeItem->parent() ; pParentLibraryTreeItem ;
+         pParentLibraryTreeItem = pParentLibraryTreeItem->parent()) {
+      if (pParentLibraryTreeItem == pLibraryTreeItem) {
+        return pFoundLibraryTreeItem;
+      }
     }
   }
   return 0;
@@ -1205,6 +1423,26 @@ LibraryTreeItem* LibraryTreeModel::findNonExistingLibraryTreeItem(const QString
   return 0;
 }
 
+/*!
+ * \brief LibraryTreeModel::updateLibraryTreeItemNameStructure
+ * Changes the name structure of the LibraryTreeItem and updates its entries in the hash.
+ * \param pLibraryTreeItem
+ * \param nameStructure
+ */
+void LibraryTreeModel::updateLibraryTreeItemNameStructure(LibraryTreeItem *pLibraryTreeItem, const QString &nameStructure)
+{
+  bool inHash = isLibraryTreeItemInHash(pLibraryTreeItem);
+  if (inHash) {
+    mLibraryTreeItemsHash.remove(pLibraryTreeItem->getNameStructure(), pLibraryTreeItem);
+    mCaseFoldedLibraryTreeItemsHash.remove(pLibraryTreeItem->getNameStructure().toCaseFolded(), pLibraryTreeItem);
+  }
+  pLibraryTreeItem->setNameStructure(nameStructure);
+  if (inHash) {
+    mLibraryTreeItemsHash.insert(nameStructure, pLibraryTreeItem);
+    mCaseFoldedLibraryTreeItemsHash.insert(nameStructure.toCaseFolded(), pLibraryTreeItem);
+  }
+}
+
 /*!
  * \brief LibraryTreeModel::libraryTreeItemIndex
  * Finds the QModelIndex attached to LibraryTreeItem.
@@ -1393,6 +1631,7 @@ void LibraryTreeModel::updateLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem)
  * \brief LibraryTreeModel::updateLibraryTreeItemClassText
  * Updates the class text of LibraryTreeItem
  * Uses OMCProxy::listFile() and OMCProxy::diffModelicaFileListings() to get the correct Modelica Text.
+ * For a class nested in a package saved in one file only the class is listed, see LibraryTreeModel::updateLibraryTreeItemClassTextIncrementally.
  * \param pLibraryTreeItem
  * \sa OMCProxy::listFile()
  * \sa OMCProxy::diffModelicaFileListings()
@@ -1408,11 +1647,16 @@ void LibraryTreeModel::updateLibraryTreeItemClassText(LibraryTreeItem *pLibraryT
     // we also mark the containing parent class unsaved because it is very important for saving of single file packages.
     pParentLibraryTreeItem->setIsSaved(false);
     updateLibraryTreeItem(pParentLibraryTreeItem);
+    if (pParentLibraryTreeItem != pLibraryTreeItem && updateLibraryTreeItemClassTextIncrementally(pLibraryTreeItem, pParentLibraryTreeItem)) {
+      updateLibraryTreeItemClassTextIndex(pParentLibraryTreeItem);
+      return;
+    }
     OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
     QString before = pParentLibraryTreeItem->getClassText(this);
     QString after = pOMCProxy->listFile(pParentLibraryTreeItem->getNameStructure());
     QString contents = pOMCProxy->diffModelicaFileListings(before, after);
     pParentLibraryTreeItem->setClassText(contents);
+    updateLibraryTreeItemClassTextIndex(pParentLibraryTreeItem);
     if (pParentLibraryTreeItem->getModelWidget()) {
       pParentLibraryTreeItem->getModelWidget()->setWindowTitle(QString(pParentLibraryTreeItem->getName()).append("*"));
       ModelicaEditor *pModelicaEditor = dynamic_cast<ModelicaEditor*>(pParentLibraryTreeItem->getModelWidget()->getEditor());
@@ -1447,6 +1691,7 @@ void LibraryTreeModel::updateLibraryTreeItemClassTextManually(LibraryTreeItem *p
   updateLibraryTreeItem(pParentLibraryTreeItem);
   OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
   pParentLibraryTreeItem->setClassText(contents);
+  updateLibraryTreeItemClassTextIndex(pParentLibraryTreeItem);
   if (pParentLibraryTreeItem->getModelWidget()) {
     pParentLibraryTreeItem->getModelWidget()->setWindowTitle(QString(pParentLibraryTreeItem->getName()).append("*"));
     ModelicaEditor *pModelicaEditor = dynamic_cast<ModelicaEditor*>(pParentLibraryTreeItem->getModelWidget()->getEditor());
@@ -1601,6 +1846,91 @@ LibraryTreeItem* LibraryTreeModel::getLibraryTreeItemFromFile(QString fileName,
   return getLibraryTreeItemFromFileHelper(mpRootLibraryTreeItem, fileName, lineNumber);
 }
 
+/*!
+ * \brief LibraryTreeModel::updateClassTextIndex
+ * Adds the loaded classes that are not indexed yet to the class text index and removes the unloaded ones.
+ * The files are read and indexed by a ClassTextIndexBuilderThread, only the text of the unsaved classes is indexed here.
+ * classTextIndexUpdated() is emitted once the thread has finished.
+ */
+void LibraryTreeModel::updateClassTextIndex()
+{
+  // the index is updated again once the running thread has finished.
+  if (mpClassTextIndexBuilderThread) {
+    return;
+  }
+  QHash<QString, LibraryTreeItem*> libraryTreeItems;
+  getClassTextIndexLibraryTreeItems(mpRootLibraryTreeItem, &libraryTreeItems);
+  foreach (QString key, mClassTextIndex.getDocumentKeys()) {
+    if (!libraryTreeItems.contains(key)) {
+      mClassTextIndex.removeDocument(key);
+    }
+  }
+  QStringList fileNames;
+  QHash<QString, LibraryTreeItem*>::const_iterator iterator;
+  for (iterator = libraryTreeItems.constBegin() ; iterator != libraryTreeItems.constEnd() ; ++iterator) {
+    if (mClassTextIndex.containsDocument(iterator.key())) {
+      continue;
+    }
+    LibraryTreeItem *pLibraryTreeItem = iterator.value();
+    if (pLibraryTreeItem->isSaved() && iterator.key().compare(pLibraryTreeItem->getFileName()) == 0) {
+      fileNames.append(pLibraryTreeItem->getFileName());
+    } else {
+      mClassTextIndex.setDocument(iterator.key(), pLibraryTreeItem->getClassText(this));
+    }
+  }
+  if (!fileNames.isEmpty()) {
+    mpClassTextIndexBuilderThread = new ClassTextIndexBuilderThread(fileNames, this);
+    connect(mpClassTextIndexBuilderThread, SIGNAL(finished()), SLOT(classTextIndexBuilt()));
+    mpClassTextIndexBuilderThread->start(QThread::LowPriority);
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::findLibraryTreeItemsInClassText
+ * Searches the class text index and returns the name structures of the innermost classes containing the matching lines along with
+ * their parents. The names are kept instead of the LibraryTreeItems so that an unloaded class doesn't leave a dangling result.\n
+ * A match in a hidden protected class is shown by its enclosing class.
+ * \param regExp
+ * \param pMatches - the matching lines with the name structure of their innermost class as key.
+ * \return
+ */
+QSet<QString> LibraryTreeModel::findLibraryTreeItemsInClassText(const QRegExp &regExp, QList<ClassTextIndex::Match> *pMatches)
+{
+  QSet<QString> classes;
+  QHash<QString, LibraryTreeItem*> fileLibraryTreeItems;
+  getClassTextIndexLibraryTreeItems(mpRootLibraryTreeItem, &fileLibraryTreeItems);
+  bool showProtectedClasses = OptionsDialog::instance()->getGeneralSettingsPage()->getShowProtectedClasses();
+  foreach (ClassTextIndex::Match match, mClassTextIndex.search(regExp)) {
+    LibraryTreeItem *pLibraryTreeItem = fileLibraryTreeItems.value(match.mKey, 0);
+    if (!pLibraryTreeItem) {
+      continue;
+    }
+    // find the innermost class of the file containing the line.
+    bool found = true;
+    while (found) {
+      found = false;
+      for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
+        LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->childAt(i);
+        if (pChildLibraryTreeItem->getLibraryType() == LibraryTreeItem::Modelica
+            && (showProtectedClasses || !pChildLibraryTreeItem->isProtected())
+            && pChildLibraryTreeItem->getFileName().compare(pLibraryTreeItem->getFileName()) == 0
+            && pChildLibraryTreeItem->inRange(match.mLine)) {
+          pLibraryTreeItem = pChildLibraryTreeItem;
+          found = true;
+          break;
+        }
+      }
+    }
+    match.mKey = pLibraryTreeItem->getNameStructure();
+    pMatches->append(match);
+    while (pLibraryTreeItem && pLibraryTreeItem != mpRootLibraryTreeItem && !classes.contains(pLibraryTreeItem->getNameStructure())) {
+      classes.insert(pLibraryTreeItem->getNameStructure());
+      pLibraryTreeItem = pLibraryTreeItem->parent();
+    }
+  }
+  return classes;
+}
+
 /*!
  * \brief LibraryTreeModel::showModelWidget
  * Shows the ModelWidget
@@ -1826,6 +2156,7 @@ bool LibraryTreeModel::unloadLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem,
     // remove the LibraryTreeItem from Libraries Browser
     row = pLibraryTreeItem->row();
     beginRemoveRows(libraryTreeItemIndex(pLibraryTreeItem), row, row);
+    removeLibraryTreeItemFromHash(pLibraryTreeItem);
     pLibraryTreeItem->parent()->removeChild(pLibraryTreeItem);
     endRemoveRows();
     if (pNextLibraryTreeItem) {
@@ -2164,6 +2495,160 @@ void LibraryTreeModel::updateChildLibraryTreeItemClassText(LibraryTreeItem *pLib
   }
 }
 
+/*!
+ * \brief LibraryTreeModel::updateLibraryTreeItemClassTextIncrementally
+ * Updates the class text of a class nested in a package saved in one file without listing and reloading the whole package.\n
+ * Only the lines of the class are diffed with OMCProxy::list() and spliced into the package text.
+ * Only the class is loaded into OMC again and only its lines are replaced in the editor of the package.
+ * The line numbers of the package and of the other classes of the file are shifted locally instead of reading them from OMC again.
+ * Returns false if the class can't be updated this way, e.g., it has nested classes in the same file or shares its lines with another class.
+ * \param pLibraryTreeItem
+ * \param pParentLibraryTreeItem - the containing file parent of pLibraryTreeItem.
+ * \return
+ */
+bool LibraryTreeModel::updateLibraryTreeItemClassTextIncrementally(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem)
+{
+  int lineNumberStart = pLibraryTreeItem->mClassInformation.lineNumberStart;
+  int lineNumberEnd = pLibraryTreeItem->mClassInformation.lineNumberEnd;
+  /* Without the preserve text indentation setting the class would be pretty-printed by OMCProxy::list() without the indentation
+   * of the package so use the whole package listing.
+   */
+  if (!OptionsDialog::instance()->getModelicaEditorPage()->getPreserveTextIndentationCheckBox()->isChecked()
+      || !pParentLibraryTreeItem->isFilePathValid() || lineNumberStart <= 1 || lineNumberEnd < lineNumberStart) {
+    return false;
+  }
+  // the line numbers of the nested classes are only known by OMC.
+  for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
+    if (pLibraryTreeItem->childAt(i)->isInPackageOneFile()) {
+      return false;
+    }
+  }
+  // we always replace whole lines so no other class should start or end on the lines of the class.
+  LibraryTreeItem *pContainingLibraryTreeItem = pLibraryTreeItem->parent();
+  for (int i = 0 ; i < pContainingLibraryTreeItem->childrenSize() ; i++) {
+    LibraryTreeItem *pChildLibraryTreeItem = pContainingLibraryTreeItem->childAt(i);
+    if (pChildLibraryTreeItem != pLibraryTreeItem && pChildLibraryTreeItem->isInPackageOneFile()
+        && pChildLibraryTreeItem->mClassInformation.lineNumberStart <= lineNumberEnd
+        && pChildLibraryTreeItem->mClassInformation.lineNumberEnd >= lineNumberStart) {
+      return false;
+    }
+  }
+  // find the lines of the class in the package text.
+  QString contents = pParentLibraryTreeItem->getClassText(this);
+  int startPosition = lineNumberStart == 1 ? 0 : -1;
+  int endPosition = -1;
+  int lineNumber = 1;
+  for (int i = 0 ; i < contents.size() && endPosition < 0 ; i++) {
+    if (contents.at(i) == QLatin1Char('\n')) {
+      lineNumber++;
+      if (lineNumber == lineNumberStart) {
+        startPosition = i + 1;
+      } else if (lineNumber == lineNumberEnd + 1) {
+        endPosition = i + 1;
+      }
+    }
+  }
+  if (endPosition < 0 && lineNumber == lineNumberEnd) {
+    endPosition = contents.size();
+  }
+  if (startPosition < 0 || endPosition < startPosition) {
+    return false;
+  }
+  QString before = contents.mid(startPosition, endPosition - startPosition);
+  OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
+  QString after = pOMCProxy->list(pLibraryTreeItem->getNameStructure());
+  /* OMCProxy::list() doesn't contain the element prefixes e.g., replaceable.
+   * The diff would drop them so use the whole package listing for such classes.
+   */
+  if (after.isEmpty() || before.trimmed().section(QRegExp("\\s+"), 0, 0) != after.trimmed().section(QRegExp("\\s+"), 0, 0)) {
+    return false;
+  }
+  QString classText = pOMCProxy->diffModelicaFileListings(before, after);
+  if (before.endsWith(QLatin1Char('\n')) && !classText.endsWith(QLatin1Char('\n'))) {
+    classText.append(QLatin1Char('\n'));
+  }
+  QString classTextBefore = contents.left(startPosition);
+  QString classTextAfter = contents.mid(endPosition);
+  contents = classTextBefore + classText + classTextAfter;
+  pParentLibraryTreeItem->setClassText(contents);
+  if (pParentLibraryTreeItem->getModelWidget()) {
+    pParentLibraryTreeItem->getModelWidget()->setWindowTitle(QString(pParentLibraryTreeItem->getName()).append("*"));
+    ModelicaEditor *pModelicaEditor = dynamic_cast<ModelicaEditor*>(pParentLibraryTreeItem->getModelWidget()->getEditor());
+    if (pModelicaEditor) {
+      pModelicaEditor->replaceLines(lineNumberStart, lineNumberEnd, classText, contents);
+    }
+  }
+  /* load only the edited class into its containing package so that the source information of OMC agrees with the editor.
+   * The empty lines after the within clause make OMC read the class on its lines in the file.
+   */
+  QString classString = QString("within %1;").arg(pContainingLibraryTreeItem->getNameStructure());
+  classString.append(QString(lineNumberStart - 1, QLatin1Char('\n'))).append(classText);
+  pOMCProxy->loadString(classString, pParentLibraryTreeItem->getFileName(), Helper::utf8, false, false);
+  pLibraryTreeItem->setClassInformation(pOMCProxy->getClassInformation(pLibraryTreeItem->getNameStructure()));
+  // update the edited class
+  int classLineNumberEnd = lineNumberStart + classText.count(QLatin1Char('\n')) - (classText.endsWith(QLatin1Char('\n')) ? 1 : 0);
+  pLibraryTreeItem->setClassTextBefore(classTextBefore);
+  pLibraryTreeItem->setClassText(classText);
+  pLibraryTreeItem->setClassTextAfter(classTextAfter);
+  if (pLibraryTreeItem->getModelWidget()) {
+    ModelicaEditor *pModelicaEditor = dynamic_cast<ModelicaEditor*>(pLibraryTreeItem->getModelWidget()->getEditor());
+    if (pModelicaEditor) {
+      pModelicaEditor->setPlainText(classText);
+    }
+  }
+  // shift the package and the other classes of the file since OMC only read the edited class again.
+  int lineNumberDifference = classLineNumberEnd - lineNumberEnd;
+  if (pParentLibraryTreeItem->mClassInformation.lineNumberEnd >= lineNumberEnd) {
+    pParentLibraryTreeItem->mClassInformation.lineNumberEnd += lineNumberDifference;
+  }
+  shiftChildLibraryTreeItemClassText(pParentLibraryTreeItem, pLibraryTreeItem, lineNumberEnd, lineNumberDifference, contents);
+  return true;
+}
+
+/*!
+ * \brief LibraryTreeModel::shiftChildLibraryTreeItemClassText
+ * Shifts the line numbers of the child classes saved in the same file after pEditedLibraryTreeItem is changed.\n
+ * The cached class text is cleared so that it is read again from the package text when needed.
+ * The classes opened in a ModelWidget are read immediately.
+ * \param pLibraryTreeItem
+ * \param pEditedLibraryTreeItem
+ * \param lineNumberEnd - the old end line of pEditedLibraryTreeItem.
+ * \param lineNumberDifference - the number of lines added to pEditedLibraryTreeItem.
+ * \param contents - the new package text.
+ */
+void LibraryTreeModel::shiftChildLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pEditedLibraryTreeItem,
+                                                          int lineNumberEnd, int lineNumberDifference, QString contents)
+{
+  for (int i = 0; i < pLibraryTreeItem->childrenSize(); i++) {
+    LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
+    if (pChildLibraryTreeItem == pEditedLibraryTreeItem || !pChildLibraryTreeItem->isInPackageOneFile()) {
+      continue;
+    }
+    if (pChildLibraryTreeItem->mClassInformation.lineNumberStart > lineNumberEnd) {
+      pChildLibraryTreeItem->mClassInformation.lineNumberStart += lineNumberDifference;
+      pChildLibraryTreeItem->mClassInformation.lineNumberEnd += lineNumberDifference;
+    } else if (pChildLibraryTreeItem->mClassInformation.lineNumberEnd >= lineNumberEnd) {
+      pChildLibraryTreeItem->mClassInformation.lineNumberEnd += lineNumberDifference;
+    }
+    pChildLibraryTreeItem->setClassTextBefore("");
+    pChildLibraryTreeItem->setClassText("");
+    pChildLibraryTreeItem->setClassTextAfter("");
+    if (pChildLibraryTreeItem->getModelWidget()) {
+      readLibraryTreeItemClassTextFromText(pChildLibraryTreeItem, contents);
+      ModelicaEditor *pModelicaEditor = dynamic_cast<ModelicaEditor*>(pChildLibraryTreeItem->getModelWidget()->getEditor());
+      if (pModelicaEditor) {
+        pModelicaEditor->setPlainText(pChildLibraryTreeItem->getClassText(this));
+        if (pModelicaEditor->isVisible()) {
+          pModelicaEditor->getPlainTextEdit()->getLineNumberArea()->update();
+        }
+      }
+    }
+    if (pChildLibraryTreeItem->childrenSize() > 0) {
+      shiftChildLibraryTreeItemClassText(pChildLibraryTreeItem, pEditedLibraryTreeItem, lineNumberEnd, lineNumberDifference, contents);
+    }
+  }
+}
+
 /*!
  * \brief LibraryTreeModel::readLibraryTreeItemClassTextFromText
  * Reads the contents of the Modelica class nested in another class.
@@ -2276,6 +2761,7 @@ LibraryTreeItem* LibraryTreeModel::createLibraryTreeItemImpl(QString name, Libra
       row = pParentLibraryTreeItem->childrenSize();
     }
     pParentLibraryTreeItem->insertChild(row, pLibraryTreeItem);
+    addLibraryTreeItemToHash(pLibraryTreeItem);
     if (load) {
       // create library tree items
       createLibraryTreeItems(pLibraryTreeItem);
@@ -2307,6 +2793,7 @@ void LibraryTreeModel::createNonExistingLibraryTreeItem(LibraryTreeItem *pLibrar
   QModelIndex index = libraryTreeItemIndex(pParentLibraryTreeItem);
   beginInsertRows(index, row, row);
   pParentLibraryTreeItem->insertChild(row, pLibraryTreeItem);
+  addLibraryTreeItemToHash(pLibraryTreeItem);
   endInsertRows();
   pLibraryTreeItem->setNonExisting(false);
 }
@@ -2354,9 +2841,73 @@ LibraryTreeItem* LibraryTreeModel::createLibraryTreeItemImpl(LibraryTreeItem::Li
     row = pParentLibraryTreeItem->childrenSize();
   }
   pParentLibraryTreeItem->insertChild(row, pLibraryTreeItem);
+  addLibraryTreeItemToHash(pLibraryTreeItem);
   return pLibraryTreeItem;
 }
 
+/*!
+ * \brief LibraryTreeModel::addLibraryTreeItemToHash
+ * Adds the LibraryTreeItem and its children to the hashes used by LibraryTreeModel::findLibraryTreeItem.
+ * Called whenever a LibraryTreeItem is added to the Libraries Browser.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::addLibraryTreeItemToHash(LibraryTreeItem *pLibraryTreeItem)
+{
+  mLibraryTreeItemsHash.insert(pLibraryTreeItem->getNameStructure(), pLibraryTreeItem);
+  mCaseFoldedLibraryTreeItemsHash.insert(pLibraryTreeItem->getNameStructure().toCaseFolded(), pLibraryTreeItem);
+  for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
+    addLibraryTreeItemToHash(pLibraryTreeItem->childAt(i));
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::removeLibraryTreeItemFromHash
+ * Removes the LibraryTreeItem and its children from the hashes used by LibraryTreeModel::findLibraryTreeItem.
+ * Called whenever a LibraryTreeItem is removed from the Libraries Browser.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::removeLibraryTreeItemFromHash(LibraryTreeItem *pLibraryTreeItem)
+{
+  mLibraryTreeItemsHash.remove(pLibraryTreeItem->getNameStructure(), pLibraryTreeItem);
+  mCaseFoldedLibraryTreeItemsHash.remove(pLibraryTreeItem->getNameStructure().toCaseFolded(), pLibraryTreeItem);
+  for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
+    removeLibraryTreeItemFromHash(pLibraryTreeItem->childAt(i));
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::isLibraryTreeItemInHash
+ * Returns true if the LibraryTreeItem is the root item or is in mLibraryTreeItemsHash.
+ * \param pLibraryTreeItem
+ * \return
+ */
+bool LibraryTreeModel::isLibraryTreeItemInHash(LibraryTreeItem *pLibraryTreeItem) const
+{
+  return pLibraryTreeItem == mpRootLibraryTreeItem || mLibraryTreeItemsHash.contains(pLibraryTreeItem->getNameStructure(), pLibraryTreeItem);
+}
+
+/*!
+ * \brief LibraryTreeModel::findLibraryTreeItemHelper
+ * Finds the LibraryTreeItem by searching the whole subtree of pLibraryTreeItem.
+ * \param name
+ * \param pLibraryTreeItem
+ * \param caseSensitivity
+ * \return
+ */
+LibraryTreeItem* LibraryTreeModel::findLibraryTreeItemHelper(const QString &name, LibraryTreeItem *pLibraryTreeItem,
+                                                             Qt::CaseSensitivity caseSensitivity) const
+{
+  if (pLibraryTreeItem->getNameStructure().compare(name, caseSensitivity) == 0) {
+    return pLibraryTreeItem;
+  }
+  for (int i = pLibraryTreeItem->childrenSize(); --i >= 0; ) {
+    if (LibraryTreeItem *item = findLibraryTreeItemHelper(name, pLibraryTreeItem->childAt(i), caseSensitivity)) {
+      return item;
+    }
+  }
+  return 0;
+}
+
 /*!
  * \brief LibraryTreeModel::unloadClassHelper
  * Helper function for unloading/deleting the LibraryTreeItem.
@@ -2385,6 +2936,7 @@ void LibraryTreeModel::unloadClassHelper(LibraryTreeItem *pLibraryTreeItem, Libr
   // notify the inherits classes
   pLibraryTreeItem->emitUnLoaded();
   addNonExistingLibraryTreeItem(pLibraryTreeItem);
+  removeLibraryTreeItemFromHash(pLibraryTreeItem);
   pParentLibraryTreeItem->removeChild(pLibraryTreeItem);
 }
 
@@ -2420,6 +2972,7 @@ void LibraryTreeModel::unloadFileHelper(LibraryTreeItem *pLibraryTreeItem, Libra
     }
     pLibraryTreeItem->getModelWidget()->deleteLater();
   }
+  removeLibraryTreeItemFromHash(pLibraryTreeItem);
   pParentLibraryTreeItem->removeChild(pLibraryTreeItem);
   pLibraryTreeItem->deleteLater();
 }
@@ -2456,6 +3009,7 @@ void LibraryTreeModel::deleteFileHelper(LibraryTreeItem *pLibraryTreeItem, Libra
     }
     pLibraryTreeItem->getModelWidget()->deleteLater();
   }
+  removeLibraryTreeItemFromHash(pLibraryTreeItem);
   pParentLibraryTreeItem->removeChild(pLibraryTreeItem);
   QFileInfo fileInfo(pLibraryTreeItem->getFileName());
   // delete the file/folder
@@ -2487,6 +3041,72 @@ void LibraryTreeModel::deleteFileChildren(LibraryTreeItem *pLibraryTreeItem)
   deleteFileHelper(pLibraryTreeItem, pLibraryTreeItem->parent());
 }
 
+/*!
+ * \brief LibraryTreeModel::getClassTextIndexKey
+ * Returns the key of the LibraryTreeItem text in the class text index i.e., the file name or the name structure if the class has no file.
+ * \param pLibraryTreeItem
+ * \return
+ */
+QString LibraryTreeModel::getClassTextIndexKey(LibraryTreeItem *pLibraryTreeItem) const
+{
+  // QFileInfo::isAbsolute doesn't access the file system unlike LibraryTreeItem::isFilePathValid.
+  if (QFileInfo(pLibraryTreeItem->getFileName()).isAbsolute()) {
+    return pLibraryTreeItem->getFileName();
+  } else {
+    return pLibraryTreeItem->getNameStructure();
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::getClassTextIndexLibraryTreeItems
+ * Collects the Modelica LibraryTreeItems that have their own file, see LibraryTreeModel::getContainingFileParentLibraryTreeItem.
+ * \param pLibraryTreeItem
+ * \param pLibraryTreeItems - the LibraryTreeItems by their key in the class text index.
+ */
+void LibraryTreeModel::getClassTextIndexLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem,
+                                                         QHash<QString, LibraryTreeItem*> *pLibraryTreeItems) const
+{
+  for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
+    LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->childAt(i);
+    if (pChildLibraryTreeItem->getLibraryType() != LibraryTreeItem::Modelica || pChildLibraryTreeItem->isNonExisting()) {
+      continue;
+    }
+    if (pLibraryTreeItem == mpRootLibraryTreeItem || pChildLibraryTreeItem->getFileName().compare(pLibraryTreeItem->getFileName()) != 0) {
+      pLibraryTreeItems->insert(getClassTextIndexKey(pChildLibraryTreeItem), pChildLibraryTreeItem);
+    }
+    getClassTextIndexLibraryTreeItems(pChildLibraryTreeItem, pLibraryTreeItems);
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::updateLibraryTreeItemClassTextIndex
+ * Indexes the edited text of the containing file LibraryTreeItem. Nothing is done until the index is used by a search.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::updateLibraryTreeItemClassTextIndex(LibraryTreeItem *pLibraryTreeItem)
+{
+  if (mClassTextIndex.getDocumentsCount() == 0 && !mpClassTextIndexBuilderThread) {
+    return;
+  }
+  mClassTextIndex.setDocument(getClassTextIndexKey(pLibraryTreeItem), pLibraryTreeItem->getClassText(this));
+}
+
+/*!
+ * \brief LibraryTreeModel::classTextIndexBuilt
+ * Slot activated when the ClassTextIndexBuilderThread has finished.\n
+ * Adds the indexed files to the class text index. The files edited in the meantime are already indexed and are kept.
+ */
+void LibraryTreeModel::classTextIndexBuilt()
+{
+  if (!mpClassTextIndexBuilderThread) {
+    return;
+  }
+  mClassTextIndex.addDocuments(mpClassTextIndexBuilderThread->getClassTextIndex());
+  mpClassTextIndexBuilderThread->deleteLater();
+  mpClassTextIndexBuilderThread = 0;
+  emit classTextIndexUpdated();
+}
+
 /*!
  * \brief LibraryTreeModel::supportedDropActions
  * \return
@@ -3345,17 +3965,21 @@ LibraryWidget::LibraryWidget(QWidget *pParent)
   : QWidget(pParent)
 {
   setMinimumWidth(175);
+  mWritingFiles = false;
   // tree search filters
   mpTreeSearchFilters = new TreeSearchFilters(this);
   mpTreeSearchFilters->getFilterTextBox()->setPlaceholderText(Helper::filterClasses);
   connect(mpTreeSearchFilters->getFilterTextBox(), SIGNAL(returnPressed()), SLOT(searchClasses()));
-  connect(mpTreeSearchFilters->getFilterTextBox(), SIGNAL(textEdited(QString)), SLOT(searchClasses()));
+  connect(mpTreeSearchFilters->getSearchTimer(), SIGNAL(timeout()), SLOT(searchClasses()));
   connect(mpTreeSearchFilters->getCaseSensitiveCheckBox(), SIGNAL(toggled(bool)), SLOT(searchClasses()));
   connect(mpTreeSearchFilters->getSyntaxComboBox(), SIGNAL(currentIndexChanged(int)), SLOT(searchClasses()));
+  connect(mpTreeSearchFilters->getSearchInTextCheckBox(), SIGNAL(toggled(bool)), SLOT(searchClasses()));
+  mpTreeSearchFilters->getSearchInTextCheckBox()->show();
   mpTreeSearchFilters->getExpandAllButton()->hide();
   mpTreeSearchFilters->getCollapseAllButton()->hide();
   // create tree view
   mpLibraryTreeModel = new LibraryTreeModel(this);
+  connect(mpLibraryTreeModel, SIGNAL(classTextIndexUpdated()), SLOT(searchClassesInText()));
   mpLibraryTreeProxyModel = new LibraryTreeProxyModel(this, false);
   mpLibraryTreeProxyModel->setDynamicSortFilter(true);
   mpLibraryTreeProxyModel->setSourceModel(mpLibraryTreeModel);
@@ -3363,12 +3987,26 @@ LibraryWidget::LibraryWidget(QWidget *pParent)
   mpLibraryTreeView->setModel(mpLibraryTreeProxyModel);
   connect(mpLibraryTreeModel, SIGNAL(rowsInserted(QModelIndex,int,int)), mpLibraryTreeProxyModel, SLOT(invalidate()));
   connect(mpLibraryTreeModel, SIGNAL(rowsRemoved(QModelIndex,int,int)), mpLibraryTreeProxyModel, SLOT(invalidate()));
+  // the lines found by searching in the class text
+  mpSearchInTextResultsLabel = new Label;
+  mpSearchInTextResultsLabel->hide();
+  mpSearchInTextResultsTreeWidget = new QTreeWidget;
+  mpSearchInTextResultsTreeWidget->setItemDelegate(new ItemDelegate(mpSearchInTextResultsTreeWidget));
+  mpSearchInTextResultsTreeWidget->setTextElideMode(Qt::ElideMiddle);
+  mpSearchInTextResultsTreeWidget->setIndentation(0);
+  mpSearchInTextResultsTreeWidget->setColumnCount(3);
+  mpSearchInTextResultsTreeWidget->setHeaderLabels(QStringList() << Helper::name << tr("Line") << tr("Text"));
+  mpSearchInTextResultsTreeWidget->setUniformRowHeights(true);
+  mpSearchInTextResultsTreeWidget->hide();
+  connect(mpSearchInTextResultsTreeWidget, SIGNAL(itemActivated(QTreeWidgetItem*,int)), SLOT(openSearchInTextResult(QTreeWidgetItem*)));
   // create the layout
   QGridLayout *pMainLayout = new QGridLayout;
   pMainLayout->setContentsMargins(0, 0, 0, 0);
   pMainLayout->setAlignment(Qt::AlignTop | Qt::AlignLeft);
   pMainLayout->addWidget(mpTreeSearchFilters, 0, 0);
   pMainLayout->addWidget(mpLibraryTreeView, 1, 0);
+  pMainLayout->addWidget(mpSearchInTextResultsLabel, 2, 0);
+  pMainLayout->addWidget(mpSearchInTextResultsTreeWidget, 3, 0);
   setLayout(pMainLayout);
 }
 
@@ -3697,53 +4335,13 @@ void LibraryWidget::parseAndLoadModelicaText(QString modelText)
  */
 bool LibraryWidget::saveFile(QString fileName, QString contents)
 {
-  // set the BOM settings
-  QComboBox *pBOMComboBox = OptionsDialog::instance()->getTextEditorPage()->getBOMComboBox();
-  Utilities::BomMode bomMode = (Utilities::BomMode)pBOMComboBox->itemData(pBOMComboBox->currentIndex()).toInt();
-  bool bom = false;
-  switch (bomMode) {
-    case Utilities::AlwaysAddBom:
-      bom = true;
-      break;
-    case Utilities::KeepBom:
-      bom = Utilities::detectBOM(fileName);
-      break;
-    case Utilities::AlwaysDeleteBom:
-    default:
-      bom = false;
-      break;
-  }
-  // set the line ending format
-  QString newContents;
-  QComboBox *pLineEndingComboBox = OptionsDialog::instance()->getTextEditorPage()->getLineEndingComboBox();
-  Utilities::LineEndingMode lineEndingMode = (Utilities::LineEndingMode)pLineEndingComboBox->itemData(pLineEndingComboBox->currentIndex()).toInt();
-  QTextStream crlfTextStream(&contents);
-  switch (lineEndingMode) {
-    case Utilities::CRLFLineEnding:
-      while (!crlfTextStream.atEnd()) {
-        newContents += crlfTextStream.readLine() + "\r\n";
-      }
-      break;
-    case Utilities::LFLineEnding:
-      newContents = contents;
-      newContents.replace(QLatin1String("\r\n"), QLatin1String("\n"));
-    default:
-      break;
-  }
-  // open the file for writing
-  QFile file(fileName);
-  if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-    QTextStream textStream(&file);
-    // set to UTF-8
-    textStream.setCodec(Helper::utf8.toStdString().data());
-    textStream.setGenerateByteOrderMark(bom);
-    textStream << newContents;
-    file.close();
+  QString errorString;
+  if (FilesWriter::writeFile(fileName, contents, getByteOrderMark(), getLineEnding(), &errorString)) {
     return true;
   } else {
     QString msg = GUIMessages::getMessage(GUIMessages::ERROR_OCCURRED)
         .arg(GUIMessages::getMessage(GUIMessages::UNABLE_TO_SAVE_FILE)
-             .arg(fileName).arg(file.errorString()));
+             .arg(fileName).arg(errorString));
     MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, msg, Helper::scriptingKind,
                                                           Helper::errorLevel));
     return false;
@@ -3758,6 +4356,12 @@ bool LibraryWidget::saveFile(QString fileName, QString contents)
  */
 bool LibraryWidget::saveLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem)
 {
+  /* the events are processed while the files of a package are written or a class text is merged.
+   * Don't start another save until they are done.
+   */
+  if (mWritingFiles || MainWindow::instance()->getOMCProxy()->isMergingText()) {
+    return false;
+  }
   bool result = false;
   MainWindow::instance()->getStatusBar()->showMessage(tr("Saving %1").arg(pLibraryTreeItem->getNameStructure()));
   MainWindow::instance()->showProgressBar();
@@ -3877,16 +4481,6 @@ bool LibraryWidget::saveModelicaLibraryTreeItemHelper(LibraryTreeItem *pLibraryT
     saveChildLibraryTreeItemsOneFile(pLibraryTreeItem);
   } else {
     result = saveModelicaLibraryTreeItemFolder(pLibraryTreeItem);
-    for (int i = 0; i < pLibraryTreeItem->childrenSize(); i++) {
-      // if any child is saved in package.mo then only mark it saved and update its information because it should be already saved.
-      LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
-      if (pLibraryTreeItem->getFileName().compare(pChildLibraryTreeItem->getFileName()) == 0) {
-        saveChildLibraryTreeItemsOneFileHelper(pChildLibraryTreeItem);
-        saveChildLibraryTreeItemsOneFile(pChildLibraryTreeItem);
-      } else {
-        saveModelicaLibraryTreeItemHelper(pChildLibraryTreeItem);
-      }
-    }
   }
   return result;
 }
@@ -3923,23 +4517,8 @@ bool LibraryWidget::saveModelicaLibraryTreeItemOneFile(LibraryTreeItem *pLibrary
     return false;
   }
   // save the class
-  QString contents;
-  if (pLibraryTreeItem->getModelWidget()->getEditor()) {
-    contents = pLibraryTreeItem->getModelWidget()->getEditor()->getPlainTextEdit()->toPlainText();
-  } else {
-    contents = pLibraryTreeItem->getClassText(mpLibraryTreeModel);
-  }
-  if (saveFile(fileName, contents)) {
-    /* mark the file as saved and update the labels. */
-    pLibraryTreeItem->setIsSaved(true);
-    pLibraryTreeItem->setFileName(fileName);
-    pLibraryTreeItem->mClassInformation.fileName = fileName;
-    MainWindow::instance()->getOMCProxy()->setSourceFile(pLibraryTreeItem->getNameStructure(), fileName);
-    if (pLibraryTreeItem->getModelWidget() && pLibraryTreeItem->getModelWidget()->isLoadedWidgetComponents()) {
-      pLibraryTreeItem->getModelWidget()->setWindowTitle(pLibraryTreeItem->getName());
-      pLibraryTreeItem->getModelWidget()->setModelFilePathLabel(fileName);
-    }
-    mpLibraryTreeModel->updateLibraryTreeItem(pLibraryTreeItem);
+  if (saveFile(fileName, getModelicaLibraryTreeItemContents(pLibraryTreeItem))) {
+    markModelicaLibraryTreeItemSaved(pLibraryTreeItem, fileName);
   } else {
     return false;
   }
@@ -3967,29 +4546,95 @@ void LibraryWidget::saveChildLibraryTreeItemsOneFile(LibraryTreeItem *pLibraryTr
  */
 void LibraryWidget::saveChildLibraryTreeItemsOneFileHelper(LibraryTreeItem *pLibraryTreeItem)
 {
-  pLibraryTreeItem->setIsSaved(true);
-  pLibraryTreeItem->setFileName(pLibraryTreeItem->parent()->getFileName());
-  pLibraryTreeItem->mClassInformation.fileName = pLibraryTreeItem->parent()->getFileName();
-  MainWindow::instance()->getOMCProxy()->setSourceFile(pLibraryTreeItem->getNameStructure(), pLibraryTreeItem->parent()->getFileName());
-  if (pLibraryTreeItem->getModelWidget() && pLibraryTreeItem->getModelWidget()->isLoadedWidgetComponents()) {
-    pLibraryTreeItem->getModelWidget()->setWindowTitle(pLibraryTreeItem->getName());
-    pLibraryTreeItem->getModelWidget()->setModelFilePathLabel(pLibraryTreeItem->parent()->getFileName());
+  QString fileName = pLibraryTreeItem->parent()->getFileName();
+  // nothing to update if the class is already saved in the file of its parent.
+  if (pLibraryTreeItem->isSaved() && pLibraryTreeItem->getFileName().compare(fileName) == 0) {
+    return;
   }
-  mpLibraryTreeModel->updateLibraryTreeItem(pLibraryTreeItem);
+  markModelicaLibraryTreeItemSaved(pLibraryTreeItem, fileName);
 }
 
 /*!
  * \brief LibraryWidget::saveModelicaLibraryTreeItemFolder
- * Saves a Modelica LibraryTreeItem in folder structure.
+ * Saves a Modelica LibraryTreeItem in folder structure.\n
+ * The files of the unsaved classes and the package.order files are collected first on the GUI thread.
+ * The files are then written in parallel by the FilesWriter and the classes are marked saved once their file is written.
  * \param pLibraryTreeItem
  * \return
  */
 bool LibraryWidget::saveModelicaLibraryTreeItemFolder(LibraryTreeItem *pLibraryTreeItem)
 {
-  if (!pLibraryTreeItem->isSaved()) {
+  QVector<FilesWriter::File> files;
+  QList<LibraryTreeItem*> libraryTreeItems;
+  bool result = collectModelicaLibraryTreeItemFolder(pLibraryTreeItem, pLibraryTreeItem->parent()->getFileName(), &files, &libraryTreeItems);
+  // write the files
+  if (!files.isEmpty()) {
+    MainWindow::instance()->getStatusBar()->showMessage(tr("Saving %1").arg(pLibraryTreeItem->getNameStructure()));
+    MainWindow::instance()->getProgressBar()->setRange(0, files.size());
+    MainWindow::instance()->getProgressBar()->setValue(0);
+    FilesWriter filesWriter(getByteOrderMark(), getLineEnding());
+    filesWriter.start(&files);
+    // the timers still fire while the events are processed so keep the auto save from saving the classes being written.
+    mWritingFiles = true;
+    while (!filesWriter.waitForDone(50)) {
+      MainWindow::instance()->getProgressBar()->setValue(filesWriter.getWrittenFilesCount());
+      QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    }
+    mWritingFiles = false;
+    MainWindow::instance()->getProgressBar()->setValue(files.size());
+  }
+  // mark the classes saved in the order they are collected i.e., a package before its classes.
+  for (int i = 0 ; i < files.size() ; i++) {
+    const FilesWriter::File &file = files.at(i);
+    if (!file.mSaved) {
+      QString msg = GUIMessages::getMessage(GUIMessages::ERROR_OCCURRED)
+          .arg(GUIMessages::getMessage(GUIMessages::UNABLE_TO_SAVE_FILE)
+               .arg(file.mFileName).arg(file.mErrorString));
+      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, msg, Helper::scriptingKind,
+                                                            Helper::errorLevel));
+      result = false;
+      continue;
+    }
+    LibraryTreeItem *pSavedLibraryTreeItem = libraryTreeItems.at(i);
+    if (!pSavedLibraryTreeItem) { // package.order file
+      continue;
+    }
+    markModelicaLibraryTreeItemSaved(pSavedLibraryTreeItem, file.mFileName);
+    if (pSavedLibraryTreeItem->getSaveContentsType() == LibraryTreeItem::SaveInOneFile) {
+      saveChildLibraryTreeItemsOneFile(pSavedLibraryTreeItem);
+    } else {
+      for (int j = 0; j < pSavedLibraryTreeItem->childrenSize(); j++) {
+        // if any child is saved in package.mo then only mark it saved and update its information because it is saved with its parent.
+        LibraryTreeItem *pChildLibraryTreeItem = pSavedLibraryTreeItem->child(j);
+        if (pSavedLibraryTreeItem->getFileName().compare(pChildLibraryTreeItem->getFileName()) == 0) {
+          saveChildLibraryTreeItemsOneFileHelper(pChildLibraryTreeItem);
+          saveChildLibraryTreeItemsOneFile(pChildLibraryTreeItem);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+/*!
+ * \brief LibraryWidget::collectModelicaLibraryTreeItemFolder
+ * Collects the files to write for a Modelica LibraryTreeItem saved in folder structure and its children.\n
+ * Only the unsaved classes are validated and written. The package.order file is only written when the package or one of its classes
+ * is unsaved.
+ * \param pLibraryTreeItem
+ * \param parentFileName - the file name of the parent once it is saved.
+ * \param pFiles
+ * \param pLibraryTreeItems - the class of each file, 0 for a package.order file.
+ * \return false if the package is not saved.
+ */
+bool LibraryWidget::collectModelicaLibraryTreeItemFolder(LibraryTreeItem *pLibraryTreeItem, QString parentFileName,
+                                                         QVector<FilesWriter::File> *pFiles, QList<LibraryTreeItem*> *pLibraryTreeItems)
+{
+  QString fileName = pLibraryTreeItem->getFileName();
+  bool saved = pLibraryTreeItem->isSaved();
+  if (!saved) {
     MainWindow::instance()->getStatusBar()->showMessage(tr("Saving %1").arg(pLibraryTreeItem->getNameStructure()));
     QString directoryName;
-    QString fileName;
     if (pLibraryTreeItem->isTopLevel() && !pLibraryTreeItem->isFilePathValid()) {
       QString name = pLibraryTreeItem->getName();
       directoryName = StringHandler::getSaveFolderName(this, tr("%1 - Save %2 %3 as Modelica Directorty").arg(Helper::applicationName)
@@ -4005,7 +4650,7 @@ bool LibraryWidget::saveModelicaLibraryTreeItemFolder(LibraryTreeItem *pLibraryT
       QFileInfo fileInfo(fileName);
       directoryName = fileInfo.absoluteDir().absolutePath();
     } else {
-      QFileInfo fileInfo(pLibraryTreeItem->parent()->getFileName());
+      QFileInfo fileInfo(parentFileName);
       directoryName = QString("%1/%2").arg(fileInfo.absoluteDir().absolutePath()).arg(pLibraryTreeItem->getName());
       fileName = QString("%1/package.mo").arg(directoryName);
     }
@@ -4017,30 +4662,77 @@ bool LibraryWidget::saveModelicaLibraryTreeItemFolder(LibraryTreeItem *pLibraryT
     if (!QDir().exists(directoryName)) {
       QDir().mkpath(directoryName);
     }
-    // save the class
-    QString contents;
-    if (pLibraryTreeItem->getModelWidget()->getEditor()) {
-      contents = pLibraryTreeItem->getModelWidget()->getEditor()->getPlainTextEdit()->toPlainText();
-    } else {
-      contents = pLibraryTreeItem->getClassText(mpLibraryTreeModel);
-    }
-    if (saveFile(fileName, contents)) {
-      /* mark the file as saved and update the labels. */
-      pLibraryTreeItem->setIsSaved(true);
-      pLibraryTreeItem->setFileName(fileName);
-      pLibraryTreeItem->mClassInformation.fileName = fileName;
-      MainWindow::instance()->getOMCProxy()->setSourceFile(pLibraryTreeItem->getNameStructure(), fileName);
-      if (pLibraryTreeItem->getModelWidget() && pLibraryTreeItem->getModelWidget()->isLoadedWidgetComponents()) {
-        pLibraryTreeItem->getModelWidget()->setWindowTitle(pLibraryTreeItem->getName());
-        pLibraryTreeItem->getModelWidget()->setModelFilePathLabel(fileName);
-      }
-      mpLibraryTreeModel->updateLibraryTreeItem(pLibraryTreeItem);
+    pFiles->append(FilesWriter::createFile(fileName, getModelicaLibraryTreeItemContents(pLibraryTreeItem)));
+    pLibraryTreeItems->append(pLibraryTreeItem);
+  }
+  bool childrenSaved = true;
+  for (int i = 0; i < pLibraryTreeItem->childrenSize(); i++) {
+    LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
+    if (!pChildLibraryTreeItem->isSaved()) {
+      childrenSaved = false;
+    }
+    // the classes saved in package.mo are written with it.
+    if (fileName.compare(pChildLibraryTreeItem->getFileName()) == 0) {
+      continue;
+    }
+    if (pChildLibraryTreeItem->getSaveContentsType() == LibraryTreeItem::SaveInOneFile) {
+      collectModelicaLibraryTreeItemOneFile(pChildLibraryTreeItem, fileName, pFiles, pLibraryTreeItems);
     } else {
-      return false;
+      collectModelicaLibraryTreeItemFolder(pChildLibraryTreeItem, fileName, pFiles, pLibraryTreeItems);
     }
   }
+  if (!saved || !childrenSaved) {
+    collectPackageOrderFile(pLibraryTreeItem, fileName, pFiles, pLibraryTreeItems);
+  }
+  return true;
+}
+
+/*!
+ * \brief LibraryWidget::collectModelicaLibraryTreeItemOneFile
+ * Collects the file to write for a Modelica LibraryTreeItem of a folder structure package that is saved in one file.
+ * \param pLibraryTreeItem
+ * \param parentFileName - the file name of the parent once it is saved.
+ * \param pFiles
+ * \param pLibraryTreeItems
+ * \return false if the class is not saved.
+ */
+bool LibraryWidget::collectModelicaLibraryTreeItemOneFile(LibraryTreeItem *pLibraryTreeItem, QString parentFileName,
+                                                          QVector<FilesWriter::File> *pFiles, QList<LibraryTreeItem*> *pLibraryTreeItems)
+{
+  if (pLibraryTreeItem->isSaved()) {
+    return true;
+  }
+  MainWindow::instance()->getStatusBar()->showMessage(tr("Saving %1").arg(pLibraryTreeItem->getNameStructure()));
+  QString fileName;
+  if (pLibraryTreeItem->isFilePathValid()) {
+    fileName = pLibraryTreeItem->getFileName();
+  } else {
+    QFileInfo fileInfo(parentFileName);
+    fileName = QString("%1/%2.mo").arg(fileInfo.absoluteDir().absolutePath()).arg(pLibraryTreeItem->getName());
+  }
+  /* if user has done some changes in the Modelica text view then save & validate it in the AST before saving it to file. */
+  if (pLibraryTreeItem->getModelWidget() && !pLibraryTreeItem->getModelWidget()->validateText(&pLibraryTreeItem)) {
+    return false;
+  }
+  pFiles->append(FilesWriter::createFile(fileName, getModelicaLibraryTreeItemContents(pLibraryTreeItem)));
+  pLibraryTreeItems->append(pLibraryTreeItem);
+  return true;
+}
+
+/*!
+ * \brief LibraryWidget::collectPackageOrderFile
+ * Collects the package.order file of a Modelica LibraryTreeItem saved in folder structure.\n
+ * Renames the files of the classes removed from the existing package.order file as class.bak-mo.
+ * \param pLibraryTreeItem
+ * \param fileName - the package.mo file of the LibraryTreeItem.
+ * \param pFiles
+ * \param pLibraryTreeItems
+ */
+void LibraryWidget::collectPackageOrderFile(LibraryTreeItem *pLibraryTreeItem, QString fileName, QVector<FilesWriter::File> *pFiles,
+                                            QList<LibraryTreeItem*> *pLibraryTreeItems)
+{
   // read the package.order file if it already exists and rename any removed classes as class.bak-mo
-  QFileInfo fileInfo(pLibraryTreeItem->getFileName());
+  QFileInfo fileInfo(fileName);
   QFile file(QString("%1/package.order").arg(fileInfo.absoluteDir().absolutePath()));
   if (file.open(QIODevice::ReadOnly)) {
     QTextStream textStream(&file);
@@ -4073,9 +4765,78 @@ bool LibraryWidget::saveModelicaLibraryTreeItemFolder(LibraryTreeItem *pLibraryT
   for (int i = 0; i < childClasses.size(); i++) {
     contents.append(childClasses.at(i)).append("\n");
   }
-  // create a new package.order file
-  saveFile(QString("%1/package.order").arg(fileInfo.absoluteDir().absolutePath()), contents);
-  return true;
+  pFiles->append(FilesWriter::createFile(QString("%1/package.order").arg(fileInfo.absoluteDir().absolutePath()), contents));
+  pLibraryTreeItems->append(0);
+}
+
+/*!
+ * \brief LibraryWidget::getModelicaLibraryTreeItemContents
+ * Returns the contents to save for a Modelica LibraryTreeItem.
+ * \param pLibraryTreeItem
+ * \return
+ */
+QString LibraryWidget::getModelicaLibraryTreeItemContents(LibraryTreeItem *pLibraryTreeItem)
+{
+  if (pLibraryTreeItem->getModelWidget() && pLibraryTreeItem->getModelWidget()->getEditor()) {
+    return pLibraryTreeItem->getModelWidget()->getEditor()->getPlainTextEdit()->toPlainText();
+  } else {
+    return pLibraryTreeItem->getClassText(mpLibraryTreeModel);
+  }
+}
+
+/*!
+ * \brief LibraryWidget::markModelicaLibraryTreeItemSaved
+ * Marks the Modelica LibraryTreeItem as saved in the file and updates the labels.
+ * \param pLibraryTreeItem
+ * \param fileName
+ */
+void LibraryWidget::markModelicaLibraryTreeItemSaved(LibraryTreeItem *pLibraryTreeItem, QString fileName)
+{
+  pLibraryTreeItem->setIsSaved(true);
+  pLibraryTreeItem->setFileName(fileName);
+  pLibraryTreeItem->mClassInformation.fileName = fileName;
+  MainWindow::instance()->getOMCProxy()->setSourceFile(pLibraryTreeItem->getNameStructure(), fileName);
+  if (pLibraryTreeItem->getModelWidget() && pLibraryTreeItem->getModelWidget()->isLoadedWidgetComponents()) {
+    pLibraryTreeItem->getModelWidget()->setWindowTitle(pLibraryTreeItem->getName());
+    pLibraryTreeItem->getModelWidget()->setModelFilePathLabel(fileName);
+  }
+  mpLibraryTreeModel->updateLibraryTreeItem(pLibraryTreeItem);
+}
+
+/*!
+ * \brief LibraryWidget::getByteOrderMark
+ * Returns the byte order mark setting of the text editor.
+ * \return
+ */
+FilesWriter::ByteOrderMark LibraryWidget::getByteOrderMark()
+{
+  QComboBox *pBOMComboBox = OptionsDialog::instance()->getTextEditorPage()->getBOMComboBox();
+  Utilities::BomMode bomMode = (Utilities::BomMode)pBOMComboBox->itemData(pBOMComboBox->currentIndex()).toInt();
+  switch (bomMode) {
+    case Utilities::AlwaysAddBom:
+      return FilesWriter::AddByteOrderMark;
+    case Utilities::KeepBom:
+      return FilesWriter::KeepByteOrderMark;
+    case Utilities::AlwaysDeleteBom:
+    default:
+      return FilesWriter::DeleteByteOrderMark;
+  }
+}
+
+/*!
+ * \brief LibraryWidget::getLineEnding
+ * Returns the line ending setting of the text editor.
+ * \return
+ */
+FilesWriter::LineEnding LibraryWidget::getLineEnding()
+{
+  QComboBox *pLineEndingComboBox = OptionsDialog::instance()->getTextEditorPage()->getLineEndingComboBox();
+  Utilities::LineEndingMode lineEndingMode = (Utilities::LineEndingMode)pLineEndingComboBox->itemData(pLineEndingComboBox->currentIndex()).toInt();
+  if (lineEndingMode == Utilities::CRLFLineEnding) {
+    return FilesWriter::CRLFLineEnding;
+  } else {
+    return FilesWriter::LFLineEnding;
+  }
 }
 
 /*!
@@ -4238,13 +4999,90 @@ bool LibraryWidget::saveTotalLibraryTreeItemHelper(LibraryTreeItem *pLibraryTree
 
 /*!
  * \brief LibraryWidget::searchClasses
- * Searches the classes in the Libraries Browser.
+ * Searches the classes in the Libraries Browser.\n
+ * If Search in Text is checked then the classes are searched in the class text index instead of by their names.
+ * The index is updated in the background so the search is done again once the index is updated, see LibraryWidget::searchClassesInText.
  */
 void LibraryWidget::searchClasses()
 {
+  mpTreeSearchFilters->getSearchTimer()->stop();
   QString searchText = mpTreeSearchFilters->getFilterTextBox()->text();
   QRegExp::PatternSyntax syntax = QRegExp::PatternSyntax(mpTreeSearchFilters->getSyntaxComboBox()->itemData(mpTreeSearchFilters->getSyntaxComboBox()->currentIndex()).toInt());
   Qt::CaseSensitivity caseSensitivity = mpTreeSearchFilters->getCaseSensitiveCheckBox()->isChecked() ? Qt::CaseSensitive: Qt::CaseInsensitive;
   QRegExp regExp(searchText, caseSensitivity, syntax);
+  if (mpTreeSearchFilters->getSearchInTextCheckBox()->isChecked() && !searchText.isEmpty()) {
+    mpLibraryTreeModel->updateClassTextIndex();
+    QList<ClassTextIndex::Match> matches;
+    mpLibraryTreeProxyModel->setSearchInText(true, mpLibraryTreeModel->findLibraryTreeItemsInClassText(regExp, &matches));
+    showSearchInTextResults(matches);
+  } else {
+    mpLibraryTreeProxyModel->setSearchInText(false);
+    mpSearchInTextResultsLabel->hide();
+    mpSearchInTextResultsTreeWidget->clear();
+    mpSearchInTextResultsTreeWidget->hide();
+  }
   mpLibraryTreeProxyModel->setFilterRegExp(regExp);
 }
+
+/*!
+ * \brief LibraryWidget::searchClassesInText
+ * Slot activated when the class text index is updated.\n
+ * Searches the classes again only if they are searched in the class text so that the filter by name is not applied again every time
+ * a class text changes.
+ */
+void LibraryWidget::searchClassesInText()
+{
+  if (mpTreeSearchFilters->getSearchInTextCheckBox()->isChecked() && !mpTreeSearchFilters->getFilterTextBox()->text().isEmpty()) {
+    searchClasses();
+  }
+}
+
+/*!
+ * \brief LibraryWidget::showSearchInTextResults
+ * Lists the lines found by searching in the class text.
+ * Only the first lines are listed so that a search for a common word doesn't create an item for every line of the libraries.
+ * \param matches - the matching lines with the name structure of their innermost class as key.
+ */
+void LibraryWidget::showSearchInTextResults(const QList<ClassTextIndex::Match> &matches)
+{
+  const int maximumResults = 1000;
+  mpSearchInTextResultsTreeWidget->clear();
+  QList<QTreeWidgetItem*> items;
+  for (int i = 0 ; i < matches.size() && i < maximumResults ; i++) {
+    const ClassTextIndex::Match &match = matches.at(i);
+    QTreeWidgetItem *pTreeWidgetItem = new QTreeWidgetItem(QStringList() << match.mKey << QString::number(match.mLine) << match.mText);
+    pTreeWidgetItem->setToolTip(0, match.mKey);
+    pTreeWidgetItem->setToolTip(2, match.mText);
+    items.append(pTreeWidgetItem);
+  }
+  mpSearchInTextResultsTreeWidget->addTopLevelItems(items);
+  if (matches.size() > maximumResults) {
+    mpSearchInTextResultsLabel->setText(tr("Showing %1 of %2 matching lines.").arg(maximumResults).arg(matches.size()));
+  } else {
+    mpSearchInTextResultsLabel->setText(tr("%1 matching lines.").arg(matches.size()));
+  }
+  mpSearchInTextResultsLabel->show();
+  mpSearchInTextResultsTreeWidget->show();
+}
+
+/*!
+ * \brief LibraryWidget::openSearchInTextResult
+ * Opens the class of the matching line in the text view at the line.
+ * \param pTreeWidgetItem
+ */
+void LibraryWidget::openSearchInTextResult(QTreeWidgetItem *pTreeWidgetItem)
+{
+  if (!pTreeWidgetItem) {
+    return;
+  }
+  // the class might be unloaded since the search.
+  LibraryTreeItem *pLibraryTreeItem = mpLibraryTreeModel->findLibraryTreeItem(pTreeWidgetItem->text(0));
+  if (!pLibraryTreeItem) {
+    return;
+  }
+  mpLibraryTreeModel->showModelWidget(pLibraryTreeItem);
+  if (pLibraryTreeItem->getModelWidget() && pLibraryTreeItem->getModelWidget()->getEditor()) {
+    pLibraryTreeItem->getModelWidget()->getTextViewToolButton()->setChecked(true);
+    pLibraryTreeItem->getModelWidget()->getEditor()->goToLineNumber(pTreeWidgetItem->text(1).toInt());
+  }
+}
@@ -37,10 +37,16 @@
 
 #include "OMC/OMCProxy.h"
 #include "Util/StringHandler.h"
+#include "Modeling/ClassTextIndex.h"
+#include "Modeling/FilesWriter.h"
 
 #include <QItemDelegate>
 #include <QTreeView>
+#include <QTreeWidget>
 #include <QSortFilterProxyModel>
+#include <QHash>
+#include <QSet>
+#include <QThread>
 
 class ItemDelegate : public QItemDelegate
 {
@@ -206,18 +212,51 @@ class LibraryTreeProxyModel : public QSortFilterProxyModel
   Q_OBJECT
 public:
   LibraryTreeProxyModel(LibraryWidget *pLibraryWidget, bool showOnlyModelica);
+  void setSearchInText(bool searchInText, const QSet<QString> &classes = QSet<QString>());
+  virtual void setSourceModel(QAbstractItemModel *pSourceModel);
 private:
   LibraryWidget *mpLibraryWidget;
   bool mShowOnlyModelica;
+  bool mSearchInText;
+  QSet<QString> mSearchInTextClasses;
+  mutable QHash<LibraryTreeItem*, bool> mFilterCache;
+  mutable QRegExp mFilterCacheRegExp;
+  mutable bool mFilterCacheShowProtectedClasses;
+  bool filterAcceptsLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem) const;
+  void removeParentsFromFilterCache(LibraryTreeItem *pLibraryTreeItem);
+  void removeChildrenFromFilterCache(LibraryTreeItem *pLibraryTreeItem);
+private slots:
+  void sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+  void sourceRowsInserted(const QModelIndex &parent, int first, int last);
+  void sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+  void clearFilterCache();
 protected:
   virtual bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const;
 };
 
+/*!
+ * \class ClassTextIndexBuilderThread
+ * \brief Reads the files of the loaded classes and indexes their text outside of the GUI thread.
+ */
+class ClassTextIndexBuilderThread : public QThread
+{
+  Q_OBJECT
+public:
+  ClassTextIndexBuilderThread(const QStringList &fileNames, QObject *pParent = 0);
+  const ClassTextIndex& getClassTextIndex() const {return mClassTextIndex;}
+protected:
+  void run();
+private:
+  QStringList mFileNames;
+  ClassTextIndex mClassTextIndex;
+};
+
 class LibraryTreeModel : public QAbstractItemModel
 {
   Q_OBJECT
 public:
   LibraryTreeModel(LibraryWidget *pLibraryWidget);
+  ~LibraryTreeModel();
   LibraryTreeItem* getRootLibraryTreeItem() {return mpRootLibraryTreeItem;}
   int columnCount(const QModelIndex &parent = QModelIndex()) const;
   int rowCount(const QModelIndex &parent = QModelIndex()) const;
@@ -232,6 +271,7 @@ public:
   LibraryTreeItem* findLibraryTreeItemOneLevel(const QString &name, LibraryTreeItem *pLibraryTreeItem = 0,
                                                Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive) const;
   LibraryTreeItem* findNonExistingLibraryTreeItem(const QString &name, Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive) const;
+  void updateLibraryTreeItemNameStructure(LibraryTreeItem *pLibraryTreeItem, const QString &nameStructure);
   QModelIndex libraryTreeItemIndex(const LibraryTreeItem *pLibraryTreeItem) const;
   void addModelicaLibraries();
   LibraryTreeItem* createLibraryTreeItem(QString name, LibraryTreeItem *pParentLibraryTreeItem, bool isSaved = true,
@@ -265,14 +305,27 @@ public:
   void generateVerificationScenarios(LibraryTreeItem *pLibraryTreeItem);
   QString getUniqueTopLevelItemName(QString name, int number = 1);
   void emitDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight) {emit dataChanged(topLeft, bottomRight);}
+  void updateClassTextIndex();
+  QSet<QString> findLibraryTreeItemsInClassText(const QRegExp &regExp, QList<ClassTextIndex::Match> *pMatches);
 private:
   LibraryWidget *mpLibraryWidget;
   LibraryTreeItem *mpRootLibraryTreeItem;
+  ClassTextIndex mClassTextIndex;
+  ClassTextIndexBuilderThread *mpClassTextIndexBuilderThread;
   QList<LibraryTreeItem*> mNonExistingLibraryTreeItemsList;
+  QMultiHash<QString, LibraryTreeItem*> mLibraryTreeItemsHash;
+  QMultiHash<QString, LibraryTreeItem*> mCaseFoldedLibraryTreeItemsHash;
+  void addLibraryTreeItemToHash(LibraryTreeItem *pLibraryTreeItem);
+  void removeLibraryTreeItemFromHash(LibraryTreeItem *pLibraryTreeItem);
+  bool isLibraryTreeItemInHash(LibraryTreeItem *pLibraryTreeItem) const;
+  LibraryTreeItem* findLibraryTreeItemHelper(const QString &name, LibraryTreeItem *pLibraryTreeItem, Qt::CaseSensitivity caseSensitivity) const;
   QModelIndex libraryTreeItemIndexHelper(const LibraryTreeItem *pLibraryTreeItem, const LibraryTreeItem *pParentLibraryTreeItem,
                                          const QModelIndex &parentIndex) const;
   LibraryTreeItem* getLibraryTreeItemFromFileHelper(LibraryTreeItem *pLibraryTreeItem, QString fileName, int lineNumber);
   void updateChildLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem, QString contents, QString fileName);
+  bool updateLibraryTreeItemClassTextIncrementally(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem);
+  void shiftChildLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pEditedLibraryTreeItem, int lineNumberEnd,
+                                          int lineNumberDifference, QString contents);
   void readLibraryTreeItemClassTextFromText(LibraryTreeItem *pLibraryTreeItem, QString contents);
   QString readLibraryTreeItemClassTextFromFile(LibraryTreeItem *pLibraryTreeItem);
   void createLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem);
@@ -289,8 +342,15 @@ private:
   void unloadFileChildren(LibraryTreeItem *pLibraryTreeItem);
   void deleteFileHelper(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem);
   void deleteFileChildren(LibraryTreeItem *pLibraryTreeItem);
+  QString getClassTextIndexKey(LibraryTreeItem *pLibraryTreeItem) const;
+  void getClassTextIndexLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem, QHash<QString, LibraryTreeItem*> *pLibraryTreeItems) const;
+  void updateLibraryTreeItemClassTextIndex(LibraryTreeItem *pLibraryTreeItem);
 protected:
   Qt::DropActions supportedDropActions() const;
+signals:
+  void classTextIndexUpdated();
+private slots:
+  void classTextIndexBuilt();
 };
 
 class LibraryTreeView : public QTreeView
@@ -400,17 +460,32 @@ public:
   void saveAsLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
   bool saveTotalLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
   void openLibraryTreeItem(QString nameStructure);
+  bool isWritingFiles() const {return mWritingFiles;}
 private:
   TreeSearchFilters *mpTreeSearchFilters;
   LibraryTreeModel *mpLibraryTreeModel;
   LibraryTreeProxyModel *mpLibraryTreeProxyModel;
   LibraryTreeView *mpLibraryTreeView;
+  Label *mpSearchInTextResultsLabel;
+  QTreeWidget *mpSearchInTextResultsTreeWidget;
+  bool mWritingFiles;
+  void showSearchInTextResults(const QList<ClassTextIndex::Match> &matches);
   bool saveModelicaLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
   bool saveModelicaLibraryTreeItemHelper(LibraryTreeItem *pLibraryTreeItem);
   bool saveModelicaLibraryTreeItemOneFile(LibraryTreeItem *pLibraryTreeItem);
   void saveChildLibraryTreeItemsOneFile(LibraryTreeItem *pLibraryTreeItem);
   void saveChildLibraryTreeItemsOneFileHelper(LibraryTreeItem *pLibraryTreeItem);
   bool saveModelicaLibraryTreeItemFolder(LibraryTreeItem *pLibraryTreeItem);
+  bool collectModelicaLibraryTreeItemFolder(LibraryTreeItem *pLibraryTreeItem, QString parentFileName, QVector<FilesWriter::File> *pFiles,
+                                            QList<LibraryTreeItem*> *pLibraryTreeItems);
+  bool collectModelicaLibraryTreeItemOneFile(LibraryTreeItem *pLibraryTreeItem, QString parentFileName, QVector<FilesWriter::File> *pFiles,
+                                             QList<LibraryTreeItem*> *pLibraryTreeItems);
+  void collectPackageOrderFile(LibraryTreeItem *pLibraryTreeItem, QString fileName, QVector<FilesWriter::File> *pFiles,
+                               QList<LibraryTreeItem*> *pLibraryTreeItems);
+  QString getModelicaLibraryTreeItemContents(LibraryTreeItem *pLibraryTreeItem);
+  void markModelicaLibraryTreeItemSaved(LibraryTreeItem *pLibraryTreeItem, QString fileName);
+  FilesWriter::ByteOrderMark getByteOrderMark();
+  FilesWriter::LineEnding getLineEnding();
   bool saveTextLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
   bool saveMetaModelLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
   bool saveAsMetaModelLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
@@ -418,6 +493,9 @@ private:
   bool saveTotalLibraryTreeItemHelper(LibraryTreeItem *pLibraryTreeItem);
 public slots:
   void searchClasses();
+private slots:
+  void searchClassesInText();
+  void openSearchInTextResult(QTreeWidgetItem *pTreeWidgetItem);
 };
 
 #endif // LIBRARYTREEWIDGET_H
@@ -3051,10 +3051,24 @@ bool ModelWidget::modelicaEditorTextChanged(LibraryTreeItem **pLibraryTreeItem)
   } else {
     stringToLoad = modelicaText;
   }
-  if (classNames.size() == 0) {
-    /* if the error is occured in P.M and package is saved in one file.
-     * then update the package contents with new invalid code because we open P when user clicks on the error message.
-     */
+  /* if no errors are found with the Modelica Text then load it in OMC */
+  QString className;
+  bool loaded = false;
+  if (classNames.size() > 0) {
+    className = classNames.at(0);
+    if (pParentLibraryTreeItem != mpLibraryTreeItem) {
+      // only use OMCProxy::loadString merge when LibraryTreeItem::SaveFolderStructure i.e., package.mo
+      loaded = pOMCProxy->loadString(stringToLoad, pParentLibraryTreeItem->getFileName(), Helper::utf8, pParentLibraryTreeItem->getSaveContentsType() == LibraryTreeItem::SaveFolderStructure);
+    } else {
+      // only use OMCProxy::loadString merge when LibraryTreeItem::SaveFolderStructure i.e., package.mo
+      loaded = pOMCProxy->loadString(stringToLoad, className, Helper::utf8, mpLibraryTreeItem->getSaveContentsType() == LibraryTreeItem::SaveFolderStructure);
+    }
+  }
+  /* The errors are found by ModelicaEditor::getClassNames or, since it only checks the outline of the text, by OMC while loading the text.
+   * if the error is occured in P.M and package is saved in one file.
+   * then update the package contents with new invalid code because we open P when user clicks on the error message.
+   */
+  if (!loaded) {
     if (mpLibraryTreeItem->isInPackageOneFile()) {
       pParentLibraryTreeItem->getModelWidget()->createModelWidgetComponents();
       ModelicaEditor *pModelicaEditor = dynamic_cast<ModelicaEditor*>(pParentLibraryTreeItem->getModelWidget()->getEditor());
@@ -3068,19 +3082,6 @@ bool ModelWidget::modelicaEditorTextChanged(LibraryTreeItem **pLibraryTreeItem)
     }
     return false;
   }
-  /* if no errors are found with the Modelica Text then load it in OMC */
-  QString className = classNames.at(0);
-  if (pParentLibraryTreeItem != mpLibraryTreeItem) {
-    // only use OMCProxy::loadString merge when LibraryTreeItem::SaveFolderStructure i.e., package.mo
-    if (!pOMCProxy->loadString(stringToLoad, pParentLibraryTreeItem->getFileName(), Helper::utf8, pParentLibraryTreeItem->getSaveContentsType() == LibraryTreeItem::SaveFolderStructure)) {
-      return false;
-    }
-  } else {
-    // only use OMCProxy::loadString merge when LibraryTreeItem::SaveFolderStructure i.e., package.mo
-    if (!pOMCProxy->loadString(stringToLoad, className, Helper::utf8, mpLibraryTreeItem->getSaveContentsType() == LibraryTreeItem::SaveFolderStructure)) {
-      return false;
-    }
-  }
   /* if user has changed the class contents then refresh it. */
   if (className.compare(mpLibraryTreeItem->getNameStructure()) == 0) {
     mpLibraryTreeItem->setClassInformation(pOMCProxy->getClassInformation(mpLibraryTreeItem->getNameStructure()));
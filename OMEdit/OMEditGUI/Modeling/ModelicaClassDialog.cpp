@@ -58,7 +58,7 @@ LibraryBrowseDialog::LibraryBrowseDialog(QString title, QLineEdit *pLineEdit, Li
   mpTreeSearchFilters = new TreeSearchFilters(this);
   mpTreeSearchFilters->getFilterTextBox()->setPlaceholderText(Helper::filterClasses);
   connect(mpTreeSearchFilters->getFilterTextBox(), SIGNAL(returnPressed()), SLOT(searchClasses()));
-  connect(mpTreeSearchFilters->getFilterTextBox(), SIGNAL(textEdited(QString)), SLOT(searchClasses()));
+  connect(mpTreeSearchFilters->getSearchTimer(), SIGNAL(timeout()), SLOT(searchClasses()));
   connect(mpTreeSearchFilters->getCaseSensitiveCheckBox(), SIGNAL(toggled(bool)), SLOT(searchClasses()));
   connect(mpTreeSearchFilters->getSyntaxComboBox(), SIGNAL(currentIndexChanged(int)), SLOT(searchClasses()));
   // create the tree
@@ -107,6 +107,7 @@ LibraryBrowseDialog::LibraryBrowseDialog(QString title, QLineEdit *pLineEdit, Li
  */
 void LibraryBrowseDialog::searchClasses()
 {
+  mpTreeSearchFilters->getSearchTimer()->stop();
   mpLibraryTreeView->selectionModel()->clearSelection();
   QString searchText = mpTreeSearchFilters->getFilterTextBox()->text();
   QRegExp::PatternSyntax syntax = QRegExp::PatternSyntax(mpTreeSearchFilters->getSyntaxComboBox()->itemData(mpTreeSearchFilters->getSyntaxComboBox()->currentIndex()).toInt());
@@ -1686,7 +1687,7 @@ void RenameItemDialog::updateChildrenPath(LibraryTreeItem *pLibraryTreeItem)
   for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
     LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
     QString newPath = QString("%1/%2").arg(pLibraryTreeItem->getFileName()).arg(pChildLibraryTreeItem->getName());
-    pChildLibraryTreeItem->setNameStructure(newPath);
+    MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->updateLibraryTreeItemNameStructure(pChildLibraryTreeItem, newPath);
     pChildLibraryTreeItem->setFileName(newPath);
     if (pChildLibraryTreeItem->getModelWidget()) {
       pChildLibraryTreeItem->getModelWidget()->setModelFilePathLabel(newPath);
@@ -1725,7 +1726,7 @@ void RenameItemDialog::renameItem()
     }
     if (QFile::rename(oldFileInfo.absoluteFilePath(), fileInfo.absoluteFilePath())) {
       mpLibraryTreeItem->setName(mpNameTextBox->text());
-      mpLibraryTreeItem->setNameStructure(fileInfo.absoluteFilePath());
+      MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->updateLibraryTreeItemNameStructure(mpLibraryTreeItem, fileInfo.absoluteFilePath());
       mpLibraryTreeItem->setFileName(fileInfo.absoluteFilePath());
       if (mpLibraryTreeItem->getModelWidget()) {
         mpLibraryTreeItem->getModelWidget()->setModelFilePathLabel(fileInfo.absoluteFilePath());
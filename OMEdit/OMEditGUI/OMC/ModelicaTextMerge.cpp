@@ -0,0 +1,415 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "ModelicaTextMerge.h"
+
+#include <QHash>
+
+/*!
+ * \brief ModelicaTextMerge::merge
+ * Merges the text listed by OMC with the original text.\n
+ * The tokens found in both texts are taken from the original text with their trivia. The tokens inserted by OMC are taken from the
+ * OMC listing. When OMC replaces some tokens, the inserted tokens keep the trivia around the replaced tokens.
+ * \param before - the original text.
+ * \param after - the text listed by OMC.
+ * \return the merged text.
+ */
+QString ModelicaTextMerge::merge(const QString &before, const QString &after)
+{
+  QVector<Token> beforeTokens = tokenize(before);
+  QVector<Token> afterTokens = tokenize(after);
+  // identify the tokens by their text
+  QHash<QString, int> tokenIds;
+  QVector<int> beforeTokenIds(beforeTokens.size());
+  for (int i = 0 ; i < beforeTokens.size() ; i++) {
+    QString tokenText = before.mid(beforeTokens.at(i).mPosition, beforeTokens.at(i).mLength);
+    beforeTokenIds[i] = tokenIds.value(tokenText, tokenIds.size());
+    if (beforeTokenIds.at(i) == tokenIds.size()) {
+      tokenIds.insert(tokenText, beforeTokenIds.at(i));
+    }
+  }
+  QVector<int> afterTokenIds(afterTokens.size());
+  for (int i = 0 ; i < afterTokens.size() ; i++) {
+    QString tokenText = after.mid(afterTokens.at(i).mPosition, afterTokens.at(i).mLength);
+    afterTokenIds[i] = tokenIds.value(tokenText, tokenIds.size());
+    if (afterTokenIds.at(i) == tokenIds.size()) {
+      tokenIds.insert(tokenText, afterTokenIds.at(i));
+    }
+  }
+  QVector<Operation> operations = diff(beforeTokenIds, afterTokenIds);
+  QString mergedText;
+  mergedText.reserve(qMax(before.size(), after.size()));
+  int beforeIndex = 0;
+  int afterIndex = 0;
+  int operationIndex = 0;
+  while (operationIndex < operations.size()) {
+    if (operations.at(operationIndex) == Equal) {
+      const Token &token = beforeTokens.at(beforeIndex);
+      mergedText.append(before.midRef(token.mLeadingTriviaPosition, token.mTrailingTriviaEnd - token.mLeadingTriviaPosition));
+      beforeIndex++;
+      afterIndex++;
+      operationIndex++;
+      continue;
+    }
+    // the deleted and inserted tokens until the next equal token
+    int deleted = 0;
+    int inserted = 0;
+    while (operationIndex < operations.size() && operations.at(operationIndex) != Equal) {
+      if (operations.at(operationIndex) == Delete) {
+        deleted++;
+      } else {
+        inserted++;
+      }
+      operationIndex++;
+    }
+    for (int i = 0 ; i < inserted ; i++) {
+      const Token &token = afterTokens.at(afterIndex + i);
+      if (i == 0 && deleted > 0) {
+        const Token &deletedToken = beforeTokens.at(beforeIndex);
+        mergedText.append(before.midRef(deletedToken.mLeadingTriviaPosition, deletedToken.mPosition - deletedToken.mLeadingTriviaPosition));
+      } else {
+        mergedText.append(after.midRef(token.mLeadingTriviaPosition, token.mPosition - token.mLeadingTriviaPosition));
+      }
+      mergedText.append(after.midRef(token.mPosition, token.mLength));
+      if (i == inserted - 1 && deleted > 0) {
+        const Token &deletedToken = beforeTokens.at(beforeIndex + deleted - 1);
+        int end = deletedToken.mPosition + deletedToken.mLength;
+        mergedText.append(before.midRef(end, deletedToken.mTrailingTriviaEnd - end));
+      } else {
+        int end = token.mPosition + token.mLength;
+        mergedText.append(after.midRef(end, token.mTrailingTriviaEnd - end));
+      }
+    }
+    beforeIndex += deleted;
+    afterIndex += inserted;
+  }
+  // the trivia after the last token
+  mergedText.append(before.midRef(beforeTokens.isEmpty() ? 0 : beforeTokens.last().mTrailingTriviaEnd));
+  return mergedText;
+}
+
+/*!
+ * \brief ModelicaTextMerge::tokenize
+ * Splits the Modelica text in tokens.\n
+ * The trivia of the text is shared between the tokens so that the text is the concatenation of the tokens with their trivia and the
+ * trivia after the last token.
+ * \param text
+ * \return
+ */
+QVector<ModelicaTextMerge::Token> ModelicaTextMerge::tokenize(const QString &text)
+{
+  static const char *operators[] = {"==", "<=", ">=", "<>", ":=", ".+", ".-", ".*", "./", ".^", 0};
+  QVector<Token> tokens;
+  const QChar *pText = text.unicode();
+  int size = text.size();
+  int leadingTriviaPosition = 0;
+  int position = skipTrivia(text, 0, false);
+  while (position < size) {
+    int start = position;
+    QChar character = pText[position];
+    if (character == QLatin1Char('"') || character == QLatin1Char('\'')) {
+      // strings and quoted identifiers
+      position++;
+      while (position < size && pText[position] != character) {
+        if (pText[position] == QLatin1Char('\\')) {
+          position++;
+        }
+        position++;
+      }
+      position = qMin(position + 1, size);
+    } else if (character.isLetter() || character == QLatin1Char('_')) {
+      while (position < size && (pText[position].isLetterOrNumber() || pText[position] == QLatin1Char('_'))) {
+        position++;
+      }
+    } else if (character.isDigit()) {
+      while (position < size && pText[position].isDigit()) {
+        position++;
+      }
+      if (position < size && pText[position] == QLatin1Char('.')) {
+        position++;
+        while (position < size && pText[position].isDigit()) {
+          position++;
+        }
+      }
+      if (position < size && (pText[position] == QLatin1Char('e') || pText[position] == QLatin1Char('E'))) {
+        int exponent = position + 1;
+        if (exponent < size && (pText[exponent] == QLatin1Char('+') || pText[exponent] == QLatin1Char('-'))) {
+          exponent++;
+        }
+        if (exponent < size && pText[exponent].isDigit()) {
+          position = exponent;
+          while (position < size && pText[position].isDigit()) {
+            position++;
+          }
+        }
+      }
+    } else {
+      position++;
+      for (int i = 0 ; position < size && operators[i] ; i++) {
+        if (character == QLatin1Char(operators[i][0]) && pText[position] == QLatin1Char(operators[i][1])) {
+          position++;
+          break;
+        }
+      }
+    }
+    Token token;
+    token.mLeadingTriviaPosition = leadingTriviaPosition;
+    token.mPosition = start;
+    token.mLength = position - start;
+    token.mTrailingTriviaEnd = skipTrivia(text, position, true);
+    tokens.append(token);
+    leadingTriviaPosition = token.mTrailingTriviaEnd;
+    position = skipTrivia(text, leadingTriviaPosition, false);
+  }
+  return tokens;
+}
+
+/*!
+ * \brief ModelicaTextMerge::diff
+ * Finds the shortest edit script from the first sequence to the second sequence with the linear space Myers diff.\n
+ * When the cost exceeds maximumCost the remaining differences are reported as deleted and inserted instead of being searched further.
+ * \param first
+ * \param second
+ * \param maximumCost - the maximum number of steps of the search.
+ * \return the operations, one for each element of the sequences.
+ */
+QVector<ModelicaTextMerge::Operation> ModelicaTextMerge::diff(const QVector<int> &first, const QVector<int> &second, qint64 maximumCost)
+{
+  QVector<Operation> operations;
+  operations.reserve(first.size() + second.size());
+  qint64 cost = maximumCost;
+  diff(first.constData(), first.size(), second.constData(), second.size(), &operations, &cost);
+  return operations;
+}
+
+/*!
+ * \brief ModelicaTextMerge::skipTrivia
+ * Skips the whitespace and the comments.
+ * \param text
+ * \param position
+ * \param trailing - stops after the end of the line if true.
+ * \return the position after the trivia.
+ */
+int ModelicaTextMerge::skipTrivia(const QString &text, int position, bool trailing)
+{
+  const QChar *pText = text.unicode();
+  int size = text.size();
+  while (position < size) {
+    QChar character = pText[position];
+    if (character == QLatin1Char('\n')) {
+      position++;
+      if (trailing) {
+        break;
+      }
+    } else if (character.isSpace()) {
+      position++;
+    } else if (character == QLatin1Char('/') && position + 1 < size && pText[position + 1] == QLatin1Char('/')) {
+      while (position < size && pText[position] != QLatin1Char('\n')) {
+        position++;
+      }
+    } else if (character == QLatin1Char('/') && position + 1 < size && pText[position + 1] == QLatin1Char('*')) {
+      int end = text.indexOf(QLatin1String("*/"), position + 2);
+      position = end < 0 ? size : end + 2;
+    } else {
+      break;
+    }
+  }
+  return position;
+}
+
+/*!
+ * \brief ModelicaTextMerge::diff
+ * Appends the operations of the sequences to pOperations.\n
+ * Strips the common prefix and suffix and splits the rest at the middle snake found by ModelicaTextMerge::bisect.
+ * \param pFirst
+ * \param firstSize
+ * \param pSecond
+ * \param secondSize
+ * \param pOperations
+ * \param pCost - the remaining cost.
+ */
+void ModelicaTextMerge::diff(const int *pFirst, int firstSize, const int *pSecond, int secondSize, QVector<Operation> *pOperations,
+                             qint64 *pCost)
+{
+  int prefix = 0;
+  while (prefix < firstSize && prefix < secondSize && pFirst[prefix] == pSecond[prefix]) {
+    prefix++;
+  }
+  int suffix = 0;
+  while (suffix < firstSize - prefix && suffix < secondSize - prefix
+         && pFirst[firstSize - suffix - 1] == pSecond[secondSize - suffix - 1]) {
+    suffix++;
+  }
+  for (int i = 0 ; i < prefix ; i++) {
+    pOperations->append(Equal);
+  }
+  const int *pFirstMiddle = pFirst + prefix;
+  int firstMiddleSize = firstSize - prefix - suffix;
+  const int *pSecondMiddle = pSecond + prefix;
+  int secondMiddleSize = secondSize - prefix - suffix;
+  int firstSplit = 0;
+  int secondSplit = 0;
+  if (firstMiddleSize > 0 && secondMiddleSize > 0
+      && bisect(pFirstMiddle, firstMiddleSize, pSecondMiddle, secondMiddleSize, &firstSplit, &secondSplit, pCost)
+      && (firstSplit > 0 || secondSplit > 0) && (firstSplit < firstMiddleSize || secondSplit < secondMiddleSize)) {
+    diff(pFirstMiddle, firstSplit, pSecondMiddle, secondSplit, pOperations, pCost);
+    diff(pFirstMiddle + firstSplit, firstMiddleSize - firstSplit, pSecondMiddle + secondSplit, secondMiddleSize - secondSplit,
+         pOperations, pCost);
+  } else {
+    for (int i = 0 ; i < firstMiddleSize ; i++) {
+      pOperations->append(Delete);
+    }
+    for (int i = 0 ; i < secondMiddleSize ; i++) {
+      pOperations->append(Insert);
+    }
+  }
+  for (int i = 0 ; i < suffix ; i++) {
+    pOperations->append(Equal);
+  }
+}
+
+/*!
+ * \brief ModelicaTextMerge::bisect
+ * Finds the middle snake of the shortest edit script by walking the edit graph from both ends at the same time.\n
+ * Only keeps the furthest reaching paths of the current step so the memory is linear in the size of the sequences.
+ * \param pFirst
+ * \param firstSize
+ * \param pSecond
+ * \param secondSize
+ * \param pFirstSplit - the split position in the first sequence.
+ * \param pSecondSplit - the split position in the second sequence.
+ * \param pCost - the remaining cost.
+ * \return false if the sequences have nothing in common or the cost is exceeded.
+ */
+bool ModelicaTextMerge::bisect(const int *pFirst, int firstSize, const int *pSecond, int secondSize, int *pFirstSplit, int *pSecondSplit,
+                               qint64 *pCost)
+{
+  int maximumD = (firstSize + secondSize + 1) / 2;
+  int vOffset = maximumD;
+  int vLength = 2 * maximumD + 2;
+  QVector<int> forward(vLength, -1);
+  QVector<int> reverse(vLength, -1);
+  forward[vOffset + 1] = 0;
+  reverse[vOffset + 1] = 0;
+  int delta = firstSize - secondSize;
+  // if the delta is odd the paths overlap when walking forward, otherwise when walking in reverse.
+  bool checkForward = (delta % 2 != 0);
+  int forwardStart = 0;
+  int forwardEnd = 0;
+  int reverseStart = 0;
+  int reverseEnd = 0;
+  for (int d = 0 ; d < maximumD ; d++) {
+    if (*pCost < 0) {
+      return false;
+    }
+    for (int k = -d + forwardStart ; k <= d - forwardEnd ; k += 2) {
+      int kOffset = vOffset + k;
+      int x;
+      if (k == -d || (k != d && forward.at(kOffset - 1) < forward.at(kOffset + 1))) {
+        x = forward.at(kOffset + 1);
+      } else {
+        x = forward.at(kOffset - 1) + 1;
+      }
+      int y = x - k;
+      int snakeStart = x;
+      while (x < firstSize && y < secondSize && pFirst[x] == pSecond[y]) {
+        x++;
+        y++;
+      }
+      *pCost -= x - snakeStart + 1;
+      forward[kOffset] = x;
+      if (x > firstSize) {
+        forwardEnd += 2;    // ran off the right of the graph
+      } else if (y > secondSize) {
+        forwardStart += 2;  // ran off the bottom of the graph
+      } else if (checkForward) {
+        int reverseOffset = vOffset + delta - k;
+        if (reverseOffset >= 0 && reverseOffset < vLength && reverse.at(reverseOffset) != -1) {
+          if (x >= firstSize - reverse.at(reverseOffset)) {
+            *pFirstSplit = x;
+            *pSecondSplit = y;
+            return true;
+          }
+        }
+      }
+    }
+    for (int k = -d + reverseStart ; k <= d - reverseEnd ; k += 2) {
+      int kOffset = vOffset + k;
+      int x;
+      if (k == -d || (k != d && reverse.at(kOffset - 1) < reverse.at(kOffset + 1))) {
+        x = reverse.at(kOffset + 1);
+      } else {
+        x = reverse.at(kOffset - 1) + 1;
+      }
+      int y = x - k;
+      int snakeStart = x;
+      while (x < firstSize && y < secondSize && pFirst[firstSize - x - 1] == pSecond[secondSize - y - 1]) {
+        x++;
+        y++;
+      }
+      *pCost -= x - snakeStart + 1;
+      reverse[kOffset] = x;
+      if (x > firstSize) {
+        reverseEnd += 2;    // ran off the left of the graph
+      } else if (y > secondSize) {
+        reverseStart += 2;  // ran off the top of the graph
+      } else if (!checkForward) {
+        int forwardOffset = vOffset + delta - k;
+        if (forwardOffset >= 0 && forwardOffset < vLength && forward.at(forwardOffset) != -1) {
+          int forwardX = forward.at(forwardOffset);
+          int forwardY = vOffset + forwardX - forwardOffset;
+          if (forwardX >= firstSize - x) {
+            *pFirstSplit = forwardX;
+            *pSecondSplit = forwardY;
+            return true;
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
+ModelicaTextMergeThread::ModelicaTextMergeThread(const QString &before, const QString &after)
+  : QThread()
+{
+  mBefore = before;
+  mAfter = after;
+}
+
+/*!
+ * \brief ModelicaTextMergeThread::run
+ * Merges the texts.
+ */
+void ModelicaTextMergeThread::run()
+{
+  mMergedText = ModelicaTextMerge::merge(mBefore, mAfter);
+}
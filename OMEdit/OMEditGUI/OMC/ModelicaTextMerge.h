@@ -0,0 +1,91 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#ifndef MODELICATEXTMERGE_H
+#define MODELICATEXTMERGE_H
+
+#include <QString>
+#include <QThread>
+#include <QVector>
+
+/*!
+ * \class ModelicaTextMerge
+ * \brief Merges the Modelica text listed by OMC with the original text of the user to preserve the formatting and the comments.
+ * Both texts are split in tokens. The whitespace and the comments are not tokens, they are kept as the trivia of the tokens.
+ * The token sequences are compared with the linear space Myers diff. The tokens found in both texts keep the original text and
+ * trivia, only the tokens changed by OMC get the text and trivia of the OMC listing.
+ * Replaces OMC diffModelicaFileListings so the texts don't have to be escaped and sent to OMC.
+ * Only uses QtCore so it can run outside of the GUI thread and be benchmarked without OMC.
+ */
+class ModelicaTextMerge
+{
+public:
+  enum Operation {
+    Equal,        /* the element is in both sequences. */
+    Delete,       /* the element is only in the first sequence. */
+    Insert        /* the element is only in the second sequence. */
+  };
+  typedef struct {
+    int mLeadingTriviaPosition;   /* the whitespace and the comments before the token on its own lines. */
+    int mPosition;
+    int mLength;
+    int mTrailingTriviaEnd;       /* the whitespace and the comments after the token up to the end of its line. */
+  } Token;
+
+  static QString merge(const QString &before, const QString &after);
+  static QVector<Token> tokenize(const QString &text);
+  static QVector<Operation> diff(const QVector<int> &first, const QVector<int> &second, qint64 maximumCost = 50000000);
+private:
+  static int skipTrivia(const QString &text, int position, bool trailing);
+  static void diff(const int *pFirst, int firstSize, const int *pSecond, int secondSize, QVector<Operation> *pOperations,
+                   qint64 *pCost);
+  static bool bisect(const int *pFirst, int firstSize, const int *pSecond, int secondSize, int *pFirstSplit, int *pSecondSplit,
+                     qint64 *pCost);
+};
+
+/*!
+ * \class ModelicaTextMergeThread
+ * \brief Runs ModelicaTextMerge::merge outside of the GUI thread.
+ */
+class ModelicaTextMergeThread : public QThread
+{
+public:
+  ModelicaTextMergeThread(const QString &before, const QString &after);
+  QString getMergedText() const {return mMergedText;}
+protected:
+  virtual void run();
+private:
+  QString mBefore;
+  QString mAfter;
+  QString mMergedText;
+};
+
+#endif // MODELICATEXTMERGE_H
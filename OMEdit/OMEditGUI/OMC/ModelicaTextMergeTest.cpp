@@ -0,0 +1,235 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+/* Compares ModelicaTextMerge with OMC diffModelicaFileListings on the files of a library e.g., the Modelica Standard Library.
+ * Usage: ModelicaTextMergeTest <omc> <directory of the library> [number of files]
+ * OMC loads the library and lists the top level class of each file with listFile, like OMEdit gets the text of a class after a
+ * change in the diagram view. A number of each listing is then changed, like a modified parameter value. OMC merges the file with
+ * both listings with diffModelicaFileListings and the results must be the same as the ones of ModelicaTextMerge::merge.
+ * The scripts of OMC and the listings are written in a folder of the temporary directory.
+ */
+
+#include "ModelicaTextMerge.h"
+#include "Editors/ModelicaOutlineParser.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QProcess>
+#include <QStringList>
+#include <stdio.h>
+
+typedef struct {
+  QString mFileName;
+  QString mClassName;
+  QString mListingFileName;
+  QString mChangedListingFileName;
+  QString mOMCFileName;
+  QString mChangedOMCFileName;
+} TestFile;
+
+static QString readFile(const QString &fileName)
+{
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return QString();
+  }
+  return QString::fromUtf8(file.readAll());
+}
+
+static bool writeFile(const QString &fileName, const QString &contents)
+{
+  QFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    return false;
+  }
+  file.write(contents.toUtf8());
+  return true;
+}
+
+/* Quotes a file name for an OMC script. */
+static QString quote(const QString &fileName)
+{
+  QString quoted = QDir::fromNativeSeparators(fileName);
+  quoted.replace("\\", "\\\\").replace("\"", "\\\"");
+  return QString("\"%1\"").arg(quoted);
+}
+
+/* Runs an OMC script, returns the elapsed milliseconds or -1 if OMC fails. */
+static qint64 runOMC(const QString &omc, const QString &scriptFileName, const QString &script)
+{
+  if (!writeFile(scriptFileName, script)) {
+    fprintf(stderr, "Can't write %s\n", qPrintable(scriptFileName));
+    return -1;
+  }
+  QElapsedTimer timer;
+  timer.start();
+  QProcess process;
+  process.setProcessChannelMode(QProcess::MergedChannels);
+  process.start(omc, QStringList() << scriptFileName);
+  if (!process.waitForFinished(-1) || process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0) {
+    fprintf(stderr, "%s %s failed\n%s\n", qPrintable(omc), qPrintable(scriptFileName), process.readAll().constData());
+    return -1;
+  }
+  return timer.elapsed();
+}
+
+/* Prints the first line that differs. */
+static void printDifference(const QString &fileName, const QString &expected, const QString &actual)
+{
+  QStringList expectedLines = expected.split(QLatin1Char('\n'));
+  QStringList actualLines = actual.split(QLatin1Char('\n'));
+  for (int i = 0 ; i < qMax(expectedLines.size(), actualLines.size()) ; i++) {
+    QString expectedLine = expectedLines.value(i);
+    QString actualLine = actualLines.value(i);
+    if (expectedLine != actualLine) {
+      printf("%s:%d differs from OMC\n  OMC:               %s\n  ModelicaTextMerge: %s\n", qPrintable(fileName), i + 1,
+             qPrintable(expectedLine), qPrintable(actualLine));
+      return;
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication application(argc, argv);
+  if (argc < 3) {
+    fprintf(stderr, "Usage: %s <omc> <directory of the library> [number of files]\n", argv[0]);
+    return 1;
+  }
+  QString omc = QString::fromLocal8Bit(argv[1]);
+  QString directory = QString::fromLocal8Bit(argv[2]);
+  int maximumFiles = argc > 3 ? QString::fromLocal8Bit(argv[3]).toInt() : 0;
+  QString workingDirectory = QDir::tempPath() + "/ModelicaTextMergeTest";
+  QDir().mkpath(workingDirectory);
+
+  // the top level class of each file
+  QStringList fileNames;
+  QDirIterator iterator(directory, QStringList() << "*.mo", QDir::Files, QDirIterator::Subdirectories);
+  while (iterator.hasNext()) {
+    fileNames.append(iterator.next());
+  }
+  fileNames.sort();
+  QList<TestFile> testFiles;
+  foreach (const QString &fileName, fileNames) {
+    ModelicaOutlineParser modelicaOutlineParser;
+    QStringList classNames;
+    if (modelicaOutlineParser.parse(readFile(fileName))) {
+      classNames = modelicaOutlineParser.getTopLevelClassNames();
+    }
+    if (classNames.size() != 1) {
+      printf("%s skipped, it doesn't define one class\n", qPrintable(fileName));
+      continue;
+    }
+    TestFile testFile;
+    QString prefix = QString("%1/%2").arg(workingDirectory).arg(testFiles.size());
+    testFile.mFileName = fileName;
+    testFile.mClassName = classNames.first();
+    testFile.mListingFileName = prefix + ".listing.mo";
+    testFile.mChangedListingFileName = prefix + ".changed.mo";
+    testFile.mOMCFileName = prefix + ".omc.mo";
+    testFile.mChangedOMCFileName = prefix + ".changed.omc.mo";
+    testFiles.append(testFile);
+    if (testFiles.size() == maximumFiles) {
+      break;
+    }
+  }
+
+  // list the classes with OMC
+  QString script = QString("loadFile(%1); getErrorString();\n").arg(quote(directory + "/package.mo"));
+  foreach (const TestFile &testFile, testFiles) {
+    script += QString("writeFile(%1, listFile(%2)); getErrorString();\n").arg(quote(testFile.mListingFileName), testFile.mClassName);
+  }
+  if (runOMC(omc, workingDirectory + "/listFiles.mos", script) < 0) {
+    return 1;
+  }
+
+  // change the first number after the middle of each listing
+  foreach (const TestFile &testFile, testFiles) {
+    QString listing = readFile(testFile.mListingFileName);
+    QVector<ModelicaTextMerge::Token> tokens = ModelicaTextMerge::tokenize(listing);
+    QString changedListing = listing;
+    for (int i = tokens.size() / 2 ; i < tokens.size() ; i++) {
+      if (listing.at(tokens.at(i).mPosition).isDigit()) {
+        changedListing = listing.left(tokens.at(i).mPosition) + "42" + listing.mid(tokens.at(i).mPosition + tokens.at(i).mLength);
+        break;
+      }
+    }
+    writeFile(testFile.mChangedListingFileName, changedListing);
+  }
+
+  // merge with OMC
+  script.clear();
+  foreach (const TestFile &testFile, testFiles) {
+    script += QString("writeFile(%1, diffModelicaFileListings(readFile(%2), readFile(%3), OpenModelica.Scripting.DiffFormat.plain));\n")
+        .arg(quote(testFile.mOMCFileName), quote(testFile.mFileName), quote(testFile.mListingFileName));
+    script += QString("writeFile(%1, diffModelicaFileListings(readFile(%2), readFile(%3), OpenModelica.Scripting.DiffFormat.plain));\n")
+        .arg(quote(testFile.mChangedOMCFileName), quote(testFile.mFileName), quote(testFile.mChangedListingFileName));
+  }
+  qint64 omcElapsed = runOMC(omc, workingDirectory + "/diffModelicaFileListings.mos", script);
+  if (omcElapsed < 0) {
+    return 1;
+  }
+
+  // merge with ModelicaTextMerge and compare
+  int failuresCount = 0;
+  int skippedCount = 0;
+  qint64 elapsed = 0;
+  foreach (const TestFile &testFile, testFiles) {
+    QString text = readFile(testFile.mFileName);
+    QString listing = readFile(testFile.mListingFileName);
+    if (listing.isEmpty()) {
+      printf("%s skipped, OMC has no listing of %s\n", qPrintable(testFile.mFileName), qPrintable(testFile.mClassName));
+      skippedCount++;
+      continue;
+    }
+    QString changedListing = readFile(testFile.mChangedListingFileName);
+    QElapsedTimer timer;
+    timer.start();
+    QString merged = ModelicaTextMerge::merge(text, listing);
+    QString changedMerged = ModelicaTextMerge::merge(text, changedListing);
+    elapsed += timer.elapsed();
+    QString omcMerged = readFile(testFile.mOMCFileName);
+    QString omcChangedMerged = readFile(testFile.mChangedOMCFileName);
+    if (merged != omcMerged) {
+      failuresCount++;
+      printDifference(testFile.mFileName, omcMerged, merged);
+    } else if (changedMerged != omcChangedMerged) {
+      failuresCount++;
+      printDifference(testFile.mFileName + " with a changed number", omcChangedMerged, changedMerged);
+    }
+  }
+  printf("%d files, %d skipped, %d differ from OMC. ModelicaTextMerge: %lld ms, OMC diffModelicaFileListings script: %lld ms\n",
+         testFiles.size(), skippedCount, failuresCount, (long long)elapsed, (long long)omcElapsed);
+  return failuresCount == 0 ? 0 : 1;
+}
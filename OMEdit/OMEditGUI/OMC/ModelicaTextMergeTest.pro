@@ -0,0 +1,12 @@
+# Compares ModelicaTextMerge with OMC diffModelicaFileListings on the Modelica Standard Library, see ModelicaTextMergeTest.cpp.
+# Built and run by make -f Makefile.unix test, or qmake ModelicaTextMergeTest.pro && make && ./ModelicaTextMergeTest omc /path/to/Modelica
+QT -= gui
+CONFIG += console
+CONFIG -= app_bundle
+TARGET = ModelicaTextMergeTest
+INCLUDEPATH += ..
+SOURCES += ModelicaTextMergeTest.cpp \
+  ModelicaTextMerge.cpp \
+  ../Editors/ModelicaOutlineParser.cpp
+HEADERS += ModelicaTextMerge.h \
+  ../Editors/ModelicaOutlineParser.h
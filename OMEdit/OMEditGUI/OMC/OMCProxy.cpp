@@ -54,6 +54,7 @@ void omc_Main_setWindowsPaths(threadData_t *threadData, void* _inOMHome);
 #include <iostream>
 
 #include "OMCProxy.h"
+#include "ModelicaTextMerge.h"
 #include "MainWindow.h"
 #include "Options/OptionsDialog.h"
 #include "Modeling/MessagesWidget.h"
@@ -61,6 +62,7 @@ void omc_Main_setWindowsPaths(threadData_t *threadData, void* _inOMHome);
 #include "omc_error.h"
 
 #include <QMessageBox>
+#include <QApplication>
 
 /*!
  * \class OMCProxy
@@ -71,7 +73,7 @@ void omc_Main_setWindowsPaths(threadData_t *threadData, void* _inOMHome);
  * \param pParent
  */
 OMCProxy::OMCProxy(QWidget *pParent)
-  : QObject(pParent), mHasInitialized(false), mResult(""), mTotalOMCCallsTime(0.0)
+  : QObject(pParent), mHasInitialized(false), mResult(""), mTotalOMCCallsTime(0.0), mMergingText(false)
 {
   mCurrentCommandIndex = -1;
   // OMC Commands Logger Widget
@@ -1630,23 +1632,41 @@ QString OMCProxy::listFile(QString className)
 
 /*!
  * \brief OMCProxy::diffModelicaFileListings
- * Creates diffs of two strings corresponding to Modelica files.
+ * Merges the text listed by OMC with the text before the change to preserve the indentation and the comments of the user.\n
+ * Uses OMC diffModelicaFileListings unless the experimental local merge is enabled in the Modelica editor options. Large texts are
+ * then merged in a ModelicaTextMergeThread while the GUI keeps repainting, the auto save waits until the merge is done.
  * \param before
  * \param after
  * \return
  */
 QString OMCProxy::diffModelicaFileListings(QString before, QString after)
 {
-  QString escapedBefore = StringHandler::escapeString(before);
-  QString escapedAfter = StringHandler::escapeString(after);
   QString result;
-  // only use the diffModelicaFileListings when preserve text indentation settings is true
-  if (OptionsDialog::instance()->getModelicaEditorPage()->getPreserveTextIndentationCheckBox()->isChecked()) {
-    sendCommand("diffModelicaFileListings(\"" + escapedBefore + "\", \"" + escapedAfter + "\", OpenModelica.Scripting.DiffFormat.plain)");
-    result = StringHandler::unparse(getResult());
-    printMessagesStringInternal();
-    if (result.isEmpty()) {
-      result = after; // use omc pretty-printing since diffModelicaFileListings() failed.
+  ModelicaEditorPage *pModelicaEditorPage = OptionsDialog::instance()->getModelicaEditorPage();
+  // only merge the texts when preserve text indentation settings is true
+  if (pModelicaEditorPage->getPreserveTextIndentationCheckBox()->isChecked()) {
+    if (pModelicaEditorPage->getMergeTextLocallyCheckBox()->isChecked() && !after.isEmpty()) {
+      if (before.size() + after.size() < 65536) {
+        result = ModelicaTextMerge::merge(before, after);
+      } else {
+        ModelicaTextMergeThread modelicaTextMergeThread(before, after);
+        mMergingText = true;
+        modelicaTextMergeThread.start();
+        while (!modelicaTextMergeThread.wait(50)) {
+          QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+        }
+        mMergingText = false;
+        result = modelicaTextMergeThread.getMergedText();
+      }
+    } else {
+      QString escapedBefore = StringHandler::escapeString(before);
+      QString escapedAfter = StringHandler::escapeString(after);
+      sendCommand("diffModelicaFileListings(\"" + escapedBefore + "\", \"" + escapedAfter + "\", OpenModelica.Scripting.DiffFormat.plain)");
+      result = StringHandler::unparse(getResult());
+      printMessagesStringInternal();
+      if (result.isEmpty()) {
+        result = after; // use omc pretty-printing since diffModelicaFileListings() failed.
+      }
     }
   } else {
     result = after;
@@ -2233,6 +2253,17 @@ bool OMCProxy::setCommandLineOptions(QString options)
   return result;
 }
 
+/*!
+ * \brief OMCProxy::getCommandLineOptions
+ * Returns the OMC flags that are currently set.
+ * \return the OMC flags as returned by getCommandLineOptions()
+ */
+QString OMCProxy::getCommandLineOptions()
+{
+  sendCommand("getCommandLineOptions()");
+  return getResult();
+}
+
 /*!
  * \brief OMCProxy::clearCommandLineOptions
  * Clears the OMC flags.
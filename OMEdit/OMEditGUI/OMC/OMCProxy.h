@@ -82,6 +82,7 @@ private:
   QList<UnitConverion> mUnitConversionList;
   QMap<QString, QList<QString> > mDerivedUnitsMap;
   OMCInterface *mpOMCInterface;
+  bool mMergingText;
 public:
   OMCProxy(QWidget *pParent = 0);
   ~OMCProxy();
@@ -92,6 +93,7 @@ public:
   void sendCommand(const QString expression);
   void setResult(QString value);
   QString getResult();
+  bool isMergingText() const {return mMergingText;}
   void exitApplication();
   void removeObjectRefFile();
   QString getErrorString(bool warningsAsErrors = false);
@@ -204,6 +206,7 @@ public:
   OMCInterface::getAvailableIndexReductionMethods_res getAvailableIndexReductionMethods();
   bool setIndexReductionMethod(QString method);
   bool setCommandLineOptions(QString options);
+  QString getCommandLineOptions();
   bool clearCommandLineOptions();
   QString makeDocumentationUriToFileName(QString documentation);
   QString uriToFilename(QString uri);
@@ -115,8 +115,11 @@ SOURCES += main.cpp \
   MainWindow.cpp \
   $$OPENMODELICAHOME/include/omc/scripting-API/OpenModelicaScriptingAPIQt.cpp \
   OMC/OMCProxy.cpp \
+  OMC/ModelicaTextMerge.cpp \
   Modeling/MessagesWidget.cpp \
   Modeling/LibraryTreeWidget.cpp \
+  Modeling/ClassTextIndex.cpp \
+  Modeling/FilesWriter.cpp \
   Modeling/Commands.cpp \
   Modeling/CoOrdinateSystem.cpp \
   Modeling/ModelWidgetContainer.cpp \
@@ -130,6 +133,8 @@ SOURCES += main.cpp \
   Editors/MetaModelEditor.cpp \
   Editors/MetaModelicaEditor.cpp \
   Editors/HTMLEditor.cpp \
+  Editors/SyntaxTokenizer.cpp \
+  Editors/ModelicaOutlineParser.cpp \
   Plotting/PlotWindowContainer.cpp \
   Component/Component.cpp \
   Annotations/ShapeAnnotation.cpp \
@@ -146,6 +151,8 @@ SOURCES += main.cpp \
   Simulation/SimulationDialog.cpp \
   Simulation/SimulationOutputWidget.cpp \
   Simulation/SimulationProcessThread.cpp \
+  Simulation/SimulationBuildCache.cpp \
+  Simulation/InitXmlIndex.cpp \
   Simulation/SimulationOutputHandler.cpp \
   TLM/FetchInterfaceDataDialog.cpp \
   TLM/FetchInterfaceDataThread.cpp \
@@ -155,11 +162,15 @@ SOURCES += main.cpp \
   FMI/ImportFMUDialog.cpp \
   FMI/ImportFMUModelDescriptionDialog.cpp \
   Plotting/VariablesWidget.cpp \
+  Plotting/ResultComparisonWidget.cpp \
   Options/NotificationsDialog.cpp \
   Annotations/ShapePropertiesDialog.cpp \
   TransformationalDebugger/OMDumpXML.cpp \
   TransformationalDebugger/diff_match_patch.cpp \
   TransformationalDebugger/TransformationsWidget.cpp \
+  TransformationalDebugger/ProfilingData.cpp \
+  TransformationalDebugger/DependencyGraph.cpp \
+  TransformationalDebugger/TVariablesTreeBuilder.cpp \
   Debugger/GDB/CommandFactory.cpp \
   Debugger/GDB/GDBAdapter.cpp \
   Debugger/StackFrames/StackFramesWidget.cpp \
@@ -180,8 +191,11 @@ HEADERS  += Util/Helper.h \
   MainWindow.h \
   $$OPENMODELICAHOME/include/omc/scripting-API/OpenModelicaScriptingAPIQt.h \
   OMC/OMCProxy.h \
+  OMC/ModelicaTextMerge.h \
   Modeling/MessagesWidget.h \
   Modeling/LibraryTreeWidget.h \
+  Modeling/ClassTextIndex.h \
+  Modeling/FilesWriter.h \
   Modeling/Commands.h \
   Modeling/CoOrdinateSystem.h \
   Modeling/ModelWidgetContainer.h \
@@ -195,6 +209,8 @@ HEADERS  += Util/Helper.h \
   Editors/MetaModelEditor.h \
   Editors/MetaModelicaEditor.h \
   Editors/HTMLEditor.h \
+  Editors/SyntaxTokenizer.h \
+  Editors/ModelicaOutlineParser.h \
   Plotting/PlotWindowContainer.h \
   Component/Component.h \
   Annotations/ShapeAnnotation.h \
@@ -212,6 +228,8 @@ HEADERS  += Util/Helper.h \
   Simulation/SimulationDialog.h \
   Simulation/SimulationOutputWidget.h \
   Simulation/SimulationProcessThread.h \
+  Simulation/SimulationBuildCache.h \
+  Simulation/InitXmlIndex.h \
   Simulation/SimulationOutputHandler.h \
   TLM/FetchInterfaceDataDialog.h \
   TLM/FetchInterfaceDataThread.h \
@@ -222,11 +240,15 @@ HEADERS  += Util/Helper.h \
   FMI/ImportFMUDialog.h \
   FMI/ImportFMUModelDescriptionDialog.h \
   Plotting/VariablesWidget.h \
+  Plotting/ResultComparisonWidget.h \
   Options/NotificationsDialog.h \
   Annotations/ShapePropertiesDialog.h \
   TransformationalDebugger/OMDumpXML.cpp \
   TransformationalDebugger/diff_match_patch.h \
   TransformationalDebugger/TransformationsWidget.h \
+  TransformationalDebugger/ProfilingData.h \
+  TransformationalDebugger/DependencyGraph.h \
+  TransformationalDebugger/TVariablesTreeBuilder.h \
   Debugger/GDB/CommandFactory.h \
   Debugger/GDB/GDBAdapter.h \
   Debugger/StackFrames/StackFramesWidget.h \
@@ -282,6 +304,21 @@ OTHER_FILES += Resources/css/stylesheet.qss \
   Debugger/Parser/GDBMIOutput.g \
   Debugger/Parser/GDBMIParser.h \
   Debugger/Parser/GDBMIParser.cpp \
+  Debugger/Parser/GDBMIOutputReader.cpp \
+  Debugger/Parser/GDBMIParserBenchmark.cpp \
+  TransformationalDebugger/TVariablesTreeBuilderBenchmark.cpp \
+  TransformationalDebugger/TVariablesTreeBuilderBenchmark.pro \
+  Modeling/LibraryTreeModelBenchmark.cpp \
+  Modeling/LibraryTreeModelBenchmark.pro \
+  Editors/SyntaxTokenizerBenchmark.cpp \
+  Editors/SyntaxTokenizerBenchmark.pro \
+  Modeling/FilesWriterBenchmark.cpp \
+  Modeling/FilesWriterBenchmark.pro \
+  TransformationalDebugger/DiffMatchPatchBenchmark.cpp \
+  TransformationalDebugger/DiffMatchPatchBenchmark.pro \
+  TransformationalDebugger/SampleEquationPairs.txt \
+  OMC/ModelicaTextMergeTest.cpp \
+  OMC/ModelicaTextMergeTest.pro \
   Debugger/Parser/main.cpp
 
 # Please read the warnings. They are like vegetables; good for you even if you hate them.
@@ -316,6 +316,9 @@ void OptionsDialog::readModelicaEditorSettings()
   if (mpSettings->contains("modelicaEditor/preserveTextIndentation")) {
     mpModelicaEditorPage->getPreserveTextIndentationCheckBox()->setChecked(mpSettings->value("modelicaEditor/preserveTextIndentation").toBool());
   }
+  if (mpSettings->contains("modelicaEditor/mergeTextLocally")) {
+    mpModelicaEditorPage->getMergeTextLocallyCheckBox()->setChecked(mpSettings->value("modelicaEditor/mergeTextLocally").toBool());
+  }
   if (mpSettings->contains("modelicaEditor/textRuleColor")) {
     mpModelicaEditorPage->setColor("Text", QColor(mpSettings->value("modelicaEditor/textRuleColor").toUInt()));
   }
@@ -513,6 +516,12 @@ void OptionsDialog::readSimulationSettings()
   if (mpSettings->contains("simulation/switchToPlottingPerspectiveAfterSimulation")) {
     mpSimulationPage->getSwitchToPlottingPerspectiveCheckBox()->setChecked(mpSettings->value("simulation/switchToPlottingPerspectiveAfterSimulation").toBool());
   }
+  if (mpSettings->contains("simulation/enableBuildCache")) {
+    mpSimulationPage->getEnableBuildCacheCheckBox()->setChecked(mpSettings->value("simulation/enableBuildCache").toBool());
+  }
+  if (mpSettings->contains("simulation/buildCacheSize")) {
+    mpSimulationPage->getBuildCacheSizeSpinBox()->setValue(mpSettings->value("simulation/buildCacheSize").toInt());
+  }
   if (mpSettings->contains("simulation/outputMode")) {
     mpSimulationPage->setOutputMode(mpSettings->value("simulation/outputMode").toString());
   }
@@ -676,6 +685,9 @@ void OptionsDialog::readDebuggerSettings()
   if (mpSettings->contains("algorithmicDebugger/GDBOutputLimit")) {
     mpDebuggerPage->getGDBOutputLimitSpinBox()->setValue(mpSettings->value("algorithmicDebugger/GDBOutputLimit").toInt());
   }
+  if (mpSettings->contains("algorithmicDebugger/localsPrefetchDepth")) {
+    mpDebuggerPage->getLocalsPrefetchDepthSpinBox()->setValue(mpSettings->value("algorithmicDebugger/localsPrefetchDepth").toInt());
+  }
   if (mpSettings->contains("algorithmicDebugger/displayCFrames")) {
     mpDebuggerPage->getDisplayCFramesCheckBox()->setChecked(mpSettings->value("algorithmicDebugger/displayCFrames").toBool());
   }
@@ -880,6 +892,7 @@ void OptionsDialog::saveTextEditorSettings()
 void OptionsDialog::saveModelicaEditorSettings()
 {
   mpSettings->setValue("modelicaEditor/preserveTextIndentation", mpModelicaEditorPage->getPreserveTextIndentationCheckBox()->isChecked());
+  mpSettings->setValue("modelicaEditor/mergeTextLocally", mpModelicaEditorPage->getMergeTextLocallyCheckBox()->isChecked());
   mpSettings->setValue("modelicaEditor/textRuleColor", mpModelicaEditorPage->getColor("Text").rgba());
   mpSettings->setValue("modelicaEditor/keywordRuleColor", mpModelicaEditorPage->getColor("Keyword").rgba());
   mpSettings->setValue("modelicaEditor/typeRuleColor", mpModelicaEditorPage->getColor("Type").rgba());
@@ -1003,6 +1016,8 @@ void OptionsDialog::saveSimulationSettings()
   // save class before simulation.
   mpSettings->setValue("simulation/saveClassBeforeSimulation", mpSimulationPage->getSaveClassBeforeSimulationCheckBox()->isChecked());
   mpSettings->setValue("simulation/switchToPlottingPerspectiveAfterSimulation", mpSimulationPage->getSwitchToPlottingPerspectiveCheckBox()->isChecked());
+  mpSettings->setValue("simulation/enableBuildCache", mpSimulationPage->getEnableBuildCacheCheckBox()->isChecked());
+  mpSettings->setValue("simulation/buildCacheSize", mpSimulationPage->getBuildCacheSizeSpinBox()->value());
   mpSettings->setValue("simulation/outputMode", mpSimulationPage->getOutputMode());
 }
 
@@ -1095,6 +1110,7 @@ void OptionsDialog::saveDebuggerSettings()
   mpSettings->setValue("GDBPath", mpDebuggerPage->getGDBPathForSettings());
   mpSettings->setValue("GDBCommandTimeout", mpDebuggerPage->getGDBCommandTimeoutSpinBox()->value());
   mpSettings->setValue("GDBOutputLimit", mpDebuggerPage->getGDBOutputLimitSpinBox()->value());
+  mpSettings->setValue("localsPrefetchDepth", mpDebuggerPage->getLocalsPrefetchDepthSpinBox()->value());
   mpSettings->setValue("displayCFrames", mpDebuggerPage->getDisplayCFramesCheckBox()->isChecked());
   mpSettings->setValue("displayUnknownFrames", mpDebuggerPage->getDisplayUnknownFramesCheckBox()->isChecked());
   MainWindow::instance()->getStackFramesWidget()->getStackFramesTreeWidget()->updateStackFrames();
@@ -2284,6 +2300,10 @@ ModelicaEditorPage::ModelicaEditorPage(OptionsDialog *pOptionsDialog)
   // preserve text indentation
   mpPreserveTextIndentationCheckBox = new QCheckBox(tr("Preserve Text Indentation"));
   mpPreserveTextIndentationCheckBox->setChecked(true);
+  // merge the text locally instead of OMC diffModelicaFileListings
+  mpMergeTextLocallyCheckBox = new QCheckBox(tr("Merge the Text without OMC (Experimental)"));
+  mpMergeTextLocallyCheckBox->setToolTip(tr("Preserves the text indentation with a faster merge inside OMEdit instead of OMC diffModelicaFileListings"));
+  connect(mpPreserveTextIndentationCheckBox, SIGNAL(toggled(bool)), mpMergeTextLocallyCheckBox, SLOT(setEnabled(bool)));
   // code colors widget
   mpCodeColorsWidget = new CodeColorsWidget(this);
   connect(mpCodeColorsWidget, SIGNAL(colorUpdated()), SIGNAL(updatePreview()));
@@ -2324,6 +2344,7 @@ ModelicaEditorPage::ModelicaEditorPage(OptionsDialog *pOptionsDialog)
   QVBoxLayout *pMainLayout = new QVBoxLayout;
   pMainLayout->setContentsMargins(0, 0, 0, 0);
   pMainLayout->addWidget(mpPreserveTextIndentationCheckBox);
+  pMainLayout->addWidget(mpMergeTextLocallyCheckBox);
   pMainLayout->addWidget(mpCodeColorsWidget);
   setLayout(pMainLayout);
 }
@@ -3204,6 +3225,17 @@ SimulationPage::SimulationPage(OptionsDialog *pOptionsDialog)
   /* switch to plotting perspective after simulation checkbox */
   mpSwitchToPlottingPerspectiveCheckBox = new QCheckBox(tr("Switch to plotting perspective after simulation"));
   mpSwitchToPlottingPerspectiveCheckBox->setChecked(true);
+  /* build cache checkbox */
+  mpEnableBuildCacheCheckBox = new QCheckBox(tr("Reuse compiled model when only the experiment settings are changed"));
+  mpEnableBuildCacheCheckBox->setToolTip(tr("Keeps the simulation executables in a cache keyed on the flattened model, OMC flags and compiler settings.\n"
+                                            "Changes in external libraries are not detected."));
+  mpEnableBuildCacheCheckBox->setChecked(true);
+  mpBuildCacheSizeLabel = new Label(tr("Build cache size:"));
+  mpBuildCacheSizeSpinBox = new QSpinBox;
+  mpBuildCacheSizeSpinBox->setRange(0, std::numeric_limits<int>::max());
+  mpBuildCacheSizeSpinBox->setSingleStep(100);
+  mpBuildCacheSizeSpinBox->setSuffix(" MB");
+  mpBuildCacheSizeSpinBox->setValue(500);
   // simulation output format
   mpOutputGroupBox = new QGroupBox(Helper::output);
   mpStructuredRadioButton = new QRadioButton(tr("Structured"));
@@ -3241,7 +3273,10 @@ SimulationPage::SimulationPage(OptionsDialog *pOptionsDialog)
   pSimulationLayout->addWidget(mpIgnoreSimulationFlagsAnnotationCheckBox, 6, 0, 1, 3);
   pSimulationLayout->addWidget(mpSaveClassBeforeSimulationCheckBox, 7, 0, 1, 3);
   pSimulationLayout->addWidget(mpSwitchToPlottingPerspectiveCheckBox, 8, 0, 1, 3);
-  pSimulationLayout->addWidget(mpOutputGroupBox, 9, 0, 1, 3);
+  pSimulationLayout->addWidget(mpEnableBuildCacheCheckBox, 9, 0, 1, 3);
+  pSimulationLayout->addWidget(mpBuildCacheSizeLabel, 10, 0);
+  pSimulationLayout->addWidget(mpBuildCacheSizeSpinBox, 10, 1, 1, 2);
+  pSimulationLayout->addWidget(mpOutputGroupBox, 11, 0, 1, 3);
   mpSimulationGroupBox->setLayout(pSimulationLayout);
   // set the layout
   QVBoxLayout *pLayout = new QVBoxLayout;
@@ -4007,6 +4042,12 @@ DebuggerPage::DebuggerPage(OptionsDialog *pOptionsDialog)
   mpGDBOutputLimitSpinBox->setSpecialValueText(Helper::unlimited);
   mpGDBOutputLimitSpinBox->setRange(0, std::numeric_limits<int>::max());
   mpGDBOutputLimitSpinBox->setSingleStep(10);
+  /* Locals prefetch depth */
+  mpLocalsPrefetchDepthLabel = new Label(tr("Locals Prefetch Depth:"));
+  mpLocalsPrefetchDepthLabel->setToolTip(tr("The levels of nested values retrieved along with the locals when GDB supports python."));
+  mpLocalsPrefetchDepthSpinBox = new QSpinBox;
+  mpLocalsPrefetchDepthSpinBox->setRange(0, 10);
+  mpLocalsPrefetchDepthSpinBox->setValue(1);
   // Display C Frames
   mpDisplayCFramesCheckBox = new QCheckBox(tr("Display C frames"));
   mpDisplayCFramesCheckBox->setChecked(true);
@@ -4031,10 +4072,12 @@ DebuggerPage::DebuggerPage(OptionsDialog *pOptionsDialog)
   pDebuggerLayout->addWidget(mpGDBCommandTimeoutSpinBox, 2, 1, 1, 2);
   pDebuggerLayout->addWidget(mpGDBOutputLimitLabel, 3, 0);
   pDebuggerLayout->addWidget(mpGDBOutputLimitSpinBox, 3, 1, 1, 2);
-  pDebuggerLayout->addWidget(mpDisplayCFramesCheckBox, 4, 0, 1, 2);
-  pDebuggerLayout->addWidget(mpDisplayUnknownFramesCheckBox, 5, 0, 1, 2);
-  pDebuggerLayout->addWidget(mpClearOutputOnNewRunCheckBox, 6, 0, 1, 2);
-  pDebuggerLayout->addWidget(mpClearLogOnNewRunCheckBox, 7, 0, 1, 2);
+  pDebuggerLayout->addWidget(mpLocalsPrefetchDepthLabel, 4, 0);
+  pDebuggerLayout->addWidget(mpLocalsPrefetchDepthSpinBox, 4, 1, 1, 2);
+  pDebuggerLayout->addWidget(mpDisplayCFramesCheckBox, 5, 0, 1, 2);
+  pDebuggerLayout->addWidget(mpDisplayUnknownFramesCheckBox, 6, 0, 1, 2);
+  pDebuggerLayout->addWidget(mpClearOutputOnNewRunCheckBox, 7, 0, 1, 2);
+  pDebuggerLayout->addWidget(mpClearLogOnNewRunCheckBox, 8, 0, 1, 2);
   mpAlgorithmicDebuggerGroupBox->setLayout(pDebuggerLayout);
   /* Transformational Debugger */
   mpTransformationalDebuggerGroupBox = new QGroupBox(Helper::transformationalDebugger);
@@ -380,12 +380,14 @@ public:
   ModelicaEditorPage(OptionsDialog *pOptionsDialog);
   OptionsDialog* getOptionsDialog() {return mpOptionsDialog;}
   QCheckBox *getPreserveTextIndentationCheckBox() {return mpPreserveTextIndentationCheckBox;}
+  QCheckBox *getMergeTextLocallyCheckBox() {return mpMergeTextLocallyCheckBox;}
   void setColor(QString item, QColor color);
   QColor getColor(QString item);
   void emitUpdatePreview() {emit updatePreview();}
 private:
   OptionsDialog *mpOptionsDialog;
   QCheckBox *mpPreserveTextIndentationCheckBox;
+  QCheckBox *mpMergeTextLocallyCheckBox;
   CodeColorsWidget *mpCodeColorsWidget;
 signals:
   void updatePreview();
@@ -559,6 +561,8 @@ public:
   QCheckBox* getIgnoreSimulationFlagsAnnotationCheckBox() {return mpIgnoreSimulationFlagsAnnotationCheckBox;}
   QCheckBox* getSaveClassBeforeSimulationCheckBox() {return mpSaveClassBeforeSimulationCheckBox;}
   QCheckBox* getSwitchToPlottingPerspectiveCheckBox() {return mpSwitchToPlottingPerspectiveCheckBox;}
+  QCheckBox* getEnableBuildCacheCheckBox() {return mpEnableBuildCacheCheckBox;}
+  QSpinBox* getBuildCacheSizeSpinBox() {return mpBuildCacheSizeSpinBox;}
   void setOutputMode(QString value);
   QString getOutputMode();
 private:
@@ -579,6 +583,9 @@ private:
   QCheckBox *mpIgnoreSimulationFlagsAnnotationCheckBox;
   QCheckBox *mpSaveClassBeforeSimulationCheckBox;
   QCheckBox *mpSwitchToPlottingPerspectiveCheckBox;
+  QCheckBox *mpEnableBuildCacheCheckBox;
+  Label *mpBuildCacheSizeLabel;
+  QSpinBox *mpBuildCacheSizeSpinBox;
   QGroupBox *mpOutputGroupBox;
   QRadioButton *mpStructuredRadioButton;
   QRadioButton *mpFormattedTextRadioButton;
@@ -783,6 +790,7 @@ public:
   QString getGDBPathForSettings() {return mpGDBPathTextBox->text();}
   QSpinBox* getGDBCommandTimeoutSpinBox() {return mpGDBCommandTimeoutSpinBox;}
   QSpinBox* getGDBOutputLimitSpinBox() {return mpGDBOutputLimitSpinBox;}
+  QSpinBox* getLocalsPrefetchDepthSpinBox() {return mpLocalsPrefetchDepthSpinBox;}
   QCheckBox* getDisplayCFramesCheckBox() {return mpDisplayCFramesCheckBox;}
   QCheckBox* getDisplayUnknownFramesCheckBox() {return mpDisplayUnknownFramesCheckBox;}
   QCheckBox* getClearOutputOnNewRunCheckBox() {return mpClearOutputOnNewRunCheckBox;}
@@ -799,6 +807,8 @@ private:
   QSpinBox *mpGDBCommandTimeoutSpinBox;
   Label *mpGDBOutputLimitLabel;
   QSpinBox *mpGDBOutputLimitSpinBox;
+  Label *mpLocalsPrefetchDepthLabel;
+  QSpinBox *mpLocalsPrefetchDepthSpinBox;
   QCheckBox *mpDisplayCFramesCheckBox;
   QCheckBox *mpDisplayUnknownFramesCheckBox;
   QCheckBox *mpClearOutputOnNewRunCheckBox;
@@ -0,0 +1,716 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+
+#include "ResultComparisonWidget.h"
+#include "MainWindow.h"
+#include "Modeling/MessagesWidget.h"
+#include "Plotting/PlotWindowContainer.h"
+#include "Util/Utilities.h"
+#include "Util/StringHandler.h"
+
+#include <QThreadPool>
+#include <QSet>
+#include <QRunnable>
+#include <QGridLayout>
+#include <QHeaderView>
+#include <QMenu>
+#include <QDoubleValidator>
+#include <QFileInfo>
+#include <limits>
+#include <cmath>
+#include <cstdlib>
+
+/*!
+ * \brief The number of variables that are read from the result files and compared at once.
+ * Only this many variables are kept in memory regardless of the size of the result file.
+ */
+#define RESULT_COMPARISON_BATCH_SIZE 512
+
+/*!
+ * \class ResultFileReader
+ * \brief Reads the variables of a MAT or CSV result file in batches.
+ */
+ResultFileReader::ResultFileReader()
+{
+  mIsMatFile = true;
+  mMatReaderOpen = false;
+  mpCSVData = 0;
+}
+
+ResultFileReader::~ResultFileReader()
+{
+  close();
+}
+
+/*!
+ * \brief ResultFileReader::open
+ * Opens the result file and reads the variable names.
+ * The variable names of a MAT file are ordered by their position in the data matrix so that batches can be read in blocks.
+ * \param fileName
+ * \param pErrorString
+ * \return
+ */
+bool ResultFileReader::open(QString fileName, QString *pErrorString)
+{
+  close();
+  mIsMatFile = !fileName.endsWith(".csv", Qt::CaseInsensitive);
+  if (mIsMatFile) {
+    const char *msg = omc_new_matlab4_reader(fileName.toStdString().c_str(), &mMatReader);
+    if (msg) {
+      *pErrorString = QString("%1: %2").arg(fileName).arg(msg);
+      return false;
+    }
+    mMatReaderOpen = true;
+    QMultiMap<int, QString> variablesMap;
+    for (uint32_t i = 0 ; i < mMatReader.nall ; i++) {
+      ModelicaMatVariable_t *pVariable = &mMatReader.allInfo[i];
+      // parameters first then the variables in the data matrix order.
+      variablesMap.insert(pVariable->isParam ? 0 : abs(pVariable->index), QString(pVariable->name));
+    }
+    mVariableNames = variablesMap.values();
+  } else {
+    mpCSVData = read_csv(fileName.toStdString().c_str());
+    if (!mpCSVData) {
+      *pErrorString = QObject::tr("Unable to read the result file %1.").arg(fileName);
+      return false;
+    }
+    for (int i = 0 ; i < mpCSVData->numvars ; i++) {
+      mVariableNames.append(QString(mpCSVData->variables[i]));
+    }
+  }
+  return true;
+}
+
+/*!
+ * \brief ResultFileReader::close
+ * Closes the result file.
+ */
+void ResultFileReader::close()
+{
+  if (mMatReaderOpen) {
+    omc_free_matlab4_reader(&mMatReader);
+    mMatReaderOpen = false;
+  }
+  if (mpCSVData) {
+    omc_free_csv_reader(mpCSVData);
+    mpCSVData = 0;
+  }
+  mVariableNames.clear();
+}
+
+int ResultFileReader::getNumberOfRows() const
+{
+  if (mMatReaderOpen) {
+    return mMatReader.nrows;
+  } else if (mpCSVData) {
+    return mpCSVData->numsteps;
+  }
+  return 0;
+}
+
+QVector<double> ResultFileReader::readTime()
+{
+  return readVariables(QStringList("time")).first();
+}
+
+/*!
+ * \brief ResultFileReader::readVariables
+ * Reads the values of the variables. Parameters are returned as a vector of size 1.
+ * An empty vector is returned for the variables that are not found.
+ * \param variables
+ * \return
+ */
+QList<QVector<double> > ResultFileReader::readVariables(const QStringList &variables)
+{
+  if (mIsMatFile) {
+    return readMatVariables(variables);
+  }
+  QList<QVector<double> > values;
+  foreach (QString variable, variables) {
+    QVector<double> variableValues;
+    double *pDataSet = mpCSVData ? read_csv_dataset(mpCSVData, variable.toStdString().c_str()) : 0;
+    if (pDataSet) {
+      variableValues.resize(mpCSVData->numsteps);
+      memcpy(variableValues.data(), pDataSet, mpCSVData->numsteps * sizeof(double));
+    }
+    values.append(variableValues);
+  }
+  return values;
+}
+
+/*!
+ * \brief ResultFileReader::readMatVariables
+ * Reads the variables from the data matrix of the MAT file.\n
+ * The data matrix is stored time step wise so reading a variable at a time means one seek per time step per variable.
+ * Instead the needed columns are grouped into runs and each run is read with a single read per time step.
+ * \param variables
+ * \return
+ */
+QList<QVector<double> > ResultFileReader::readMatVariables(const QStringList &variables)
+{
+  QList<QVector<double> > values;
+  if (!mMatReaderOpen) {
+    return values;
+  }
+  QVector<int> dataIndexes(variables.size(), 0);
+  QMap<int, bool> columns;
+  for (int i = 0 ; i < variables.size() ; i++) {
+    ModelicaMatVariable_t *pVariable = omc_matlab4_find_var(&mMatReader, variables.at(i).toStdString().c_str());
+    if (!pVariable) {
+      values.append(QVector<double>());
+    } else if (pVariable->isParam) {
+      double value;
+      omc_matlab4_val(&value, &mMatReader, pVariable, omc_matlab4_startTime(&mMatReader));
+      values.append(QVector<double>(1, value));
+    } else {
+      dataIndexes[i] = pVariable->index;
+      columns.insert(abs(pVariable->index), true);
+      values.append(QVector<double>(mMatReader.nrows));
+    }
+  }
+  if (columns.isEmpty()) {
+    return values;
+  }
+  // group the columns into runs. Small gaps are cheaper to read than to seek over.
+  QList<QPair<int, int> > runs;
+  foreach (int column, columns.keys()) {
+    if (!runs.isEmpty() && column - runs.last().second <= 64) {
+      runs.last().second = column;
+    } else {
+      runs.append(qMakePair(column, column));
+    }
+  }
+  size_t elementSize = mMatReader.doublePrecision ? sizeof(double) : sizeof(float);
+  QByteArray buffer;
+  for (uint32_t row = 0 ; row < mMatReader.nrows ; row++) {
+    for (int r = 0 ; r < runs.size() ; r++) {
+      int first = runs.at(r).first;
+      int width = runs.at(r).second - first + 1;
+      buffer.resize(width * elementSize);
+      fseek(mMatReader.file, mMatReader.var_offset + ((size_t)row * mMatReader.nvar + first - 1) * elementSize, SEEK_SET);
+      if (fread(buffer.data(), elementSize, width, mMatReader.file) != (size_t)width) {
+        buffer.fill(0);
+      }
+      for (int i = 0 ; i < dataIndexes.size() ; i++) {
+        int column = abs(dataIndexes.at(i));
+        if (column < first || column >= first + width) {
+          continue;
+        }
+        double value;
+        if (mMatReader.doublePrecision) {
+          value = reinterpret_cast<const double*>(buffer.constData())[column - first];
+        } else {
+          value = reinterpret_cast<const float*>(buffer.constData())[column - first];
+        }
+        values[i][row] = dataIndexes.at(i) < 0 ? -value : value;
+      }
+    }
+  }
+  return values;
+}
+
+/*!
+ * \class ResultComparisonTask
+ * \brief Compares a range of variables of a batch.
+ */
+class ResultComparisonTask : public QRunnable
+{
+public:
+  ResultComparisonTask(const QVector<double> *pReferenceTime, const QList<QVector<double> > *pReferenceValues,
+                       const QList<QVector<double> > *pActualValues, const QVector<int> *pIndexes, const QVector<double> *pWeights,
+                       const QStringList *pVariables, QVector<ResultComparison> *pResults, int start, int end, double relativeTolerance,
+                       double absoluteTolerance)
+    : mpReferenceTime(pReferenceTime), mpReferenceValues(pReferenceValues), mpActualValues(pActualValues), mpIndexes(pIndexes),
+      mpWeights(pWeights), mpVariables(pVariables), mpResults(pResults), mStart(start), mEnd(end), mRelativeTolerance(relativeTolerance),
+      mAbsoluteTolerance(absoluteTolerance)
+  {}
+  void run()
+  {
+    for (int i = mStart ; i < mEnd ; i++) {
+      ResultComparison resultComparison = ResultComparisonThread::compareVariable(*mpReferenceTime, mpReferenceValues->at(i),
+                                                                                  mpActualValues->at(i), *mpIndexes, *mpWeights,
+                                                                                  mRelativeTolerance, mAbsoluteTolerance);
+      resultComparison.mVariable = mpVariables->at(i);
+      (*mpResults)[i] = resultComparison;
+    }
+  }
+private:
+  const QVector<double> *mpReferenceTime;
+  const QList<QVector<double> > *mpReferenceValues;
+  const QList<QVector<double> > *mpActualValues;
+  const QVector<int> *mpIndexes;
+  const QVector<double> *mpWeights;
+  const QStringList *mpVariables;
+  QVector<ResultComparison> *mpResults;
+  int mStart;
+  int mEnd;
+  double mRelativeTolerance;
+  double mAbsoluteTolerance;
+};
+
+/*!
+ * \class ResultComparisonThread
+ * \brief Compares the variables of two result files.
+ */
+ResultComparisonThread::ResultComparisonThread(QString referenceFileName, QString actualFileName, double relativeTolerance,
+                                               double absoluteTolerance, QObject *pParent)
+  : QThread(pParent), mReferenceFileName(referenceFileName), mActualFileName(actualFileName), mRelativeTolerance(relativeTolerance),
+    mAbsoluteTolerance(absoluteTolerance), mCancelled(false)
+{
+}
+
+/*!
+ * \brief ResultComparisonThread::computeInterpolation
+ * Computes the indexes and weights to interpolate the actual values on the reference time grid.\n
+ * The interpolation is the same for all the variables so it is computed once.
+ * At events, i.e., repeated time points, the first reference point picks the left limit and the second one the right limit.
+ * \param referenceTime
+ * \param actualTime
+ * \param pIndexes
+ * \param pWeights
+ */
+void ResultComparisonThread::computeInterpolation(const QVector<double> &referenceTime, const QVector<double> &actualTime,
+                                                  QVector<int> *pIndexes, QVector<double> *pWeights)
+{
+  int n = referenceTime.size();
+  int m = actualTime.size();
+  pIndexes->resize(n);
+  pWeights->resize(n);
+  if (m < 2) {
+    pIndexes->fill(0);
+    pWeights->fill(0);
+    return;
+  }
+  int j = 0;
+  for (int k = 0 ; k < n ; k++) {
+    double t = referenceTime.at(k);
+    bool rightLimit = k > 0 && referenceTime.at(k - 1) == t;
+    while (j < m - 2 && actualTime.at(j + 1) < t) {
+      j++;
+    }
+    if (rightLimit) {
+      while (j < m - 2 && actualTime.at(j + 1) <= t) {
+        j++;
+      }
+    }
+    double t0 = actualTime.at(j);
+    double t1 = actualTime.at(j + 1);
+    double w;
+    if (t <= t0) {
+      w = 0;
+    } else if (t >= t1) {
+      w = 1;
+    } else {
+      w = (t - t0) / (t1 - t0);
+    }
+    (*pIndexes)[k] = j;
+    (*pWeights)[k] = w;
+  }
+}
+
+/*!
+ * \brief ResultComparisonThread::compareVariable
+ * Compares a variable against its reference.\n
+ * The loops are kept branch free so that the compiler can vectorize them.
+ * A point is outside the tolerance if |actual - reference| > absoluteTolerance + relativeTolerance * |reference|.
+ * \param referenceTime
+ * \param reference
+ * \param actual
+ * \param indexes
+ * \param weights
+ * \param relativeTolerance
+ * \param absoluteTolerance
+ * \return
+ */
+ResultComparison ResultComparisonThread::compareVariable(const QVector<double> &referenceTime, const QVector<double> &reference,
+                                                         const QVector<double> &actual, const QVector<int> &indexes,
+                                                         const QVector<double> &weights, double relativeTolerance,
+                                                         double absoluteTolerance)
+{
+  ResultComparison resultComparison;
+  resultComparison.mMaxAbsoluteError = 0;
+  resultComparison.mMaxRelativeError = 0;
+  resultComparison.mTimeOfMaxError = referenceTime.isEmpty() ? 0 : referenceTime.first();
+  resultComparison.mPointsOutsideTolerance = 0;
+  if (reference.isEmpty() || actual.isEmpty()) {
+    resultComparison.mMaxAbsoluteError = std::numeric_limits<double>::infinity();
+    resultComparison.mMaxRelativeError = std::numeric_limits<double>::infinity();
+    resultComparison.mPointsOutsideTolerance = referenceTime.size();
+    return resultComparison;
+  }
+  int n = referenceTime.size();
+  // expand the parameters to the time grid and interpolate the actual values
+  QVector<double> referenceValues(n), actualValues(n);
+  double *r = referenceValues.data();
+  double *a = actualValues.data();
+  if (reference.size() == 1) {
+    referenceValues.fill(reference.first());
+  } else {
+    memcpy(r, reference.constData(), qMin(n, reference.size()) * sizeof(double));
+  }
+  if (actual.size() == 1 || indexes.size() != n) {
+    actualValues.fill(actual.first());
+  } else {
+    const double *pActual = actual.constData();
+    const int *pIndexes = indexes.constData();
+    const double *pWeights = weights.constData();
+    for (int k = 0 ; k < n ; k++) {
+      a[k] = (1 - pWeights[k]) * pActual[pIndexes[k]] + pWeights[k] * pActual[pIndexes[k] + 1];
+    }
+  }
+  // compute the errors
+  double maxAbsoluteError = 0, maxRelativeError = 0;
+  int maxErrorIndex = 0, pointsOutsideTolerance = 0;
+  for (int k = 0 ; k < n ; k++) {
+    double absoluteError = std::fabs(a[k] - r[k]);
+    double scale = std::fabs(r[k]);
+    double relativeError = absoluteError / (scale > absoluteTolerance ? scale : absoluteTolerance);
+    pointsOutsideTolerance += absoluteError > absoluteTolerance + relativeTolerance * scale ? 1 : 0;
+    maxErrorIndex = relativeError > maxRelativeError ? k : maxErrorIndex;
+    maxRelativeError = relativeError > maxRelativeError ? relativeError : maxRelativeError;
+    maxAbsoluteError = absoluteError > maxAbsoluteError ? absoluteError : maxAbsoluteError;
+  }
+  resultComparison.mMaxAbsoluteError = maxAbsoluteError;
+  resultComparison.mMaxRelativeError = maxRelativeError;
+  resultComparison.mTimeOfMaxError = referenceTime.at(maxErrorIndex);
+  resultComparison.mPointsOutsideTolerance = pointsOutsideTolerance;
+  return resultComparison;
+}
+
+/*!
+ * \brief ResultComparisonThread::run
+ * Reads the variables common to both files in batches and compares each batch in parallel.
+ */
+void ResultComparisonThread::run()
+{
+  mResults.clear();
+  ResultFileReader referenceReader, actualReader;
+  if (!referenceReader.open(mReferenceFileName, &mErrorString) || !actualReader.open(mActualFileName, &mErrorString)) {
+    return;
+  }
+  QVector<double> referenceTime = referenceReader.readTime();
+  QVector<double> actualTime = actualReader.readTime();
+  if (referenceTime.isEmpty() || actualTime.isEmpty()) {
+    mErrorString = tr("The result files do not contain the time variable.");
+    return;
+  }
+  QVector<int> indexes;
+  QVector<double> weights;
+  computeInterpolation(referenceTime, actualTime, &indexes, &weights);
+  // only compare the variables that exist in both files
+  QStringList actualVariables = actualReader.getVariableNames();
+  QSet<QString> actualVariablesSet = QSet<QString>::fromList(actualVariables);
+  QStringList variables;
+  foreach (QString variable, referenceReader.getVariableNames()) {
+    if (variable.compare("time") != 0 && actualVariablesSet.contains(variable)) {
+      variables.append(variable);
+    }
+  }
+  QThreadPool threadPool;
+  for (int batchStart = 0 ; batchStart < variables.size() && !mCancelled ; batchStart += RESULT_COMPARISON_BATCH_SIZE) {
+    QStringList batchVariables = variables.mid(batchStart, RESULT_COMPARISON_BATCH_SIZE);
+    QList<QVector<double> > referenceValues = referenceReader.readVariables(batchVariables);
+    QList<QVector<double> > actualValues = actualReader.readVariables(batchVariables);
+    QVector<ResultComparison> batchResults(batchVariables.size());
+    int chunkSize = qMax(1, batchVariables.size() / qMax(1, threadPool.maxThreadCount()));
+    for (int start = 0 ; start < batchVariables.size() ; start += chunkSize) {
+      threadPool.start(new ResultComparisonTask(&referenceTime, &referenceValues, &actualValues, &indexes, &weights, &batchVariables,
+                                                &batchResults, start, qMin(start + chunkSize, batchVariables.size()),
+                                                mRelativeTolerance, mAbsoluteTolerance));
+    }
+    threadPool.waitForDone();
+    mResults.append(batchResults.toList());
+    emit progressChanged(qMin(batchStart + RESULT_COMPARISON_BATCH_SIZE, variables.size()), variables.size());
+  }
+}
+
+/*!
+ * \class ResultComparisonWidget
+ * \brief Compares a result file against a reference result file.
+ */
+/*!
+ * \brief ResultComparisonWidget::ResultComparisonWidget
+ * \param pParent
+ */
+ResultComparisonWidget::ResultComparisonWidget(QWidget *pParent)
+  : QWidget(pParent)
+{
+  // reference file
+  mpReferenceFileLabel = new Label(tr("Reference:"));
+  mpReferenceFileTextBox = new QLineEdit;
+  mpBrowseReferenceFileButton = new QPushButton(Helper::browse);
+  mpBrowseReferenceFileButton->setAutoDefault(false);
+  connect(mpBrowseReferenceFileButton, SIGNAL(clicked()), SLOT(browseReferenceFile()));
+  // actual file
+  mpActualFileLabel = new Label(tr("Actual:"));
+  mpActualFileTextBox = new QLineEdit;
+  mpBrowseActualFileButton = new QPushButton(Helper::browse);
+  mpBrowseActualFileButton->setAutoDefault(false);
+  connect(mpBrowseActualFileButton, SIGNAL(clicked()), SLOT(browseActualFile()));
+  // tolerances
+  QDoubleValidator *pDoubleValidator = new QDoubleValidator(this);
+  pDoubleValidator->setBottom(0);
+  mpRelativeToleranceLabel = new Label(tr("Relative Tolerance:"));
+  mpRelativeToleranceTextBox = new QLineEdit("1e-3");
+  mpRelativeToleranceTextBox->setValidator(pDoubleValidator);
+  mpAbsoluteToleranceLabel = new Label(tr("Absolute Tolerance:"));
+  mpAbsoluteToleranceTextBox = new QLineEdit("1e-6");
+  mpAbsoluteToleranceTextBox->setValidator(pDoubleValidator);
+  mpShowOnlyFailingCheckBox = new QCheckBox(tr("Show only variables outside tolerance"));
+  mpShowOnlyFailingCheckBox->setChecked(true);
+  connect(mpShowOnlyFailingCheckBox, SIGNAL(toggled(bool)), SLOT(comparisonFinished()));
+  mpCompareButton = new QPushButton(tr("Compare"));
+  connect(mpCompareButton, SIGNAL(clicked()), SLOT(compareResults()));
+  mpProgressBar = new QProgressBar;
+  mpProgressBar->setAlignment(Qt::AlignHCenter);
+  mpProgressBar->setRange(0, 1);
+  mpSummaryLabel = new Label;
+  // results
+  mpResultsTreeWidget = new QTreeWidget;
+  mpResultsTreeWidget->setObjectName("ResultComparisonTree");
+  mpResultsTreeWidget->setIndentation(0);
+  mpResultsTreeWidget->setColumnCount(5);
+  mpResultsTreeWidget->setTextElideMode(Qt::ElideMiddle);
+  mpResultsTreeWidget->setSortingEnabled(true);
+  mpResultsTreeWidget->setUniformRowHeights(true);
+  mpResultsTreeWidget->setContextMenuPolicy(Qt::CustomContextMenu);
+  QStringList headerLabels;
+  headerLabels << Helper::variables << tr("Max Relative Error") << tr("Max Absolute Error") << tr("Time of Max Error")
+               << tr("Points Outside Tolerance");
+  mpResultsTreeWidget->setHeaderLabels(headerLabels);
+  connect(mpResultsTreeWidget, SIGNAL(itemDoubleClicked(QTreeWidgetItem*,int)), SLOT(plotOverlay(QTreeWidgetItem*)));
+  connect(mpResultsTreeWidget, SIGNAL(customContextMenuRequested(QPoint)), SLOT(showContextMenu(QPoint)));
+  mpResultComparisonThread = 0;
+  // layout
+  QGridLayout *pMainLayout = new QGridLayout;
+  pMainLayout->setContentsMargins(1, 1, 1, 1);
+  pMainLayout->addWidget(mpReferenceFileLabel, 0, 0);
+  pMainLayout->addWidget(mpReferenceFileTextBox, 0, 1);
+  pMainLayout->addWidget(mpBrowseReferenceFileButton, 0, 2);
+  pMainLayout->addWidget(mpActualFileLabel, 1, 0);
+  pMainLayout->addWidget(mpActualFileTextBox, 1, 1);
+  pMainLayout->addWidget(mpBrowseActualFileButton, 1, 2);
+  pMainLayout->addWidget(mpRelativeToleranceLabel, 2, 0);
+  pMainLayout->addWidget(mpRelativeToleranceTextBox, 2, 1, 1, 2);
+  pMainLayout->addWidget(mpAbsoluteToleranceLabel, 3, 0);
+  pMainLayout->addWidget(mpAbsoluteToleranceTextBox, 3, 1, 1, 2);
+  pMainLayout->addWidget(mpShowOnlyFailingCheckBox, 4, 0, 1, 3);
+  pMainLayout->addWidget(mpProgressBar, 5, 0, 1, 2);
+  pMainLayout->addWidget(mpCompareButton, 5, 2);
+  pMainLayout->addWidget(mpSummaryLabel, 6, 0, 1, 3);
+  pMainLayout->addWidget(mpResultsTreeWidget, 7, 0, 1, 3);
+  setLayout(pMainLayout);
+}
+
+ResultComparisonWidget::~ResultComparisonWidget()
+{
+  if (mpResultComparisonThread && mpResultComparisonThread->isRunning()) {
+    mpResultComparisonThread->cancel();
+    mpResultComparisonThread->wait();
+  }
+}
+
+/*!
+ * \brief ResultComparisonWidget::showResults
+ * Shows the deviations sorted by the maximum relative error.
+ */
+void ResultComparisonWidget::showResults()
+{
+  mpResultsTreeWidget->clear();
+  mpResultsTreeWidget->setSortingEnabled(false);
+  int failingVariables = 0;
+  QList<QTreeWidgetItem*> items;
+  foreach (ResultComparison resultComparison, mResults) {
+    bool failing = resultComparison.mPointsOutsideTolerance > 0;
+    if (failing) {
+      failingVariables++;
+    }
+    if (mpShowOnlyFailingCheckBox->isChecked() && !failing) {
+      continue;
+    }
+    QTreeWidgetItem *pTreeWidgetItem = new QTreeWidgetItem;
+    pTreeWidgetItem->setText(0, resultComparison.mVariable);
+    pTreeWidgetItem->setToolTip(0, resultComparison.mVariable);
+    pTreeWidgetItem->setData(1, Qt::DisplayRole, resultComparison.mMaxRelativeError);
+    pTreeWidgetItem->setData(2, Qt::DisplayRole, resultComparison.mMaxAbsoluteError);
+    pTreeWidgetItem->setData(3, Qt::DisplayRole, resultComparison.mTimeOfMaxError);
+    pTreeWidgetItem->setData(4, Qt::DisplayRole, resultComparison.mPointsOutsideTolerance);
+    if (failing) {
+      pTreeWidgetItem->setForeground(0, QBrush(Qt::red));
+    }
+    items.append(pTreeWidgetItem);
+  }
+  mpResultsTreeWidget->addTopLevelItems(items);
+  mpResultsTreeWidget->setSortingEnabled(true);
+  mpResultsTreeWidget->sortByColumn(1, Qt::DescendingOrder);
+  QString summary = tr("%1 of %2 variables are outside the tolerance.").arg(failingVariables).arg(mResults.size());
+  if (mpResultComparisonThread && mpResultComparisonThread->isCancelled()) {
+    summary = tr("The comparison is cancelled. Only the compared variables are shown.") + " " + summary;
+  }
+  mpSummaryLabel->setText(summary);
+}
+
+void ResultComparisonWidget::browseReferenceFile()
+{
+  QString fileName = StringHandler::getOpenFileName(this, QString(Helper::applicationName).append(" - ").append(Helper::chooseFile),
+                                                    NULL, Helper::omResultFileTypes, NULL);
+  if (!fileName.isEmpty()) {
+    mpReferenceFileTextBox->setText(fileName);
+  }
+}
+
+void ResultComparisonWidget::browseActualFile()
+{
+  QString fileName = StringHandler::getOpenFileName(this, QString(Helper::applicationName).append(" - ").append(Helper::chooseFile),
+                                                    NULL, Helper::omResultFileTypes, NULL);
+  if (!fileName.isEmpty()) {
+    mpActualFileTextBox->setText(fileName);
+  }
+}
+
+/*!
+ * \brief ResultComparisonWidget::compareResults
+ * Starts the comparison in a separate thread. Clicking again cancels the running comparison.
+ */
+void ResultComparisonWidget::compareResults()
+{
+  if (mpResultComparisonThread && mpResultComparisonThread->isRunning()) {
+    mpResultComparisonThread->cancel();
+    return;
+  }
+  if (mpReferenceFileTextBox->text().isEmpty() || mpActualFileTextBox->text().isEmpty()) {
+    return;
+  }
+  if (mpResultComparisonThread) {
+    mpResultComparisonThread->deleteLater();
+  }
+  mpResultComparisonThread = new ResultComparisonThread(mpReferenceFileTextBox->text(), mpActualFileTextBox->text(),
+                                                        mpRelativeToleranceTextBox->text().toDouble(),
+                                                        mpAbsoluteToleranceTextBox->text().toDouble(), this);
+  connect(mpResultComparisonThread, SIGNAL(progressChanged(int,int)), SLOT(updateProgress(int,int)));
+  connect(mpResultComparisonThread, SIGNAL(finished()), SLOT(comparisonFinished()));
+  mResults.clear();
+  mpResultsTreeWidget->clear();
+  mpSummaryLabel->setText("");
+  mpProgressBar->setRange(0, 0);
+  mpCompareButton->setText(Helper::cancel);
+  mpResultComparisonThread->start();
+}
+
+void ResultComparisonWidget::updateProgress(int value, int maximum)
+{
+  mpProgressBar->setRange(0, maximum);
+  mpProgressBar->setValue(value);
+}
+
+/*!
+ * \brief ResultComparisonWidget::comparisonFinished
+ * Slot activated when the comparison thread is finished or when the filter checkbox is toggled.
+ */
+void ResultComparisonWidget::comparisonFinished()
+{
+  if (!mpResultComparisonThread || mpResultComparisonThread->isRunning()) {
+    return;
+  }
+  mpCompareButton->setText(tr("Compare"));
+  // a cancelled comparison keeps the progress it reached
+  if (!mpResultComparisonThread->isCancelled()) {
+    mpProgressBar->setRange(0, 1);
+    mpProgressBar->setValue(1);
+  } else if (mpProgressBar->maximum() == 0) {
+    mpProgressBar->setRange(0, 1);
+    mpProgressBar->setValue(0);
+  }
+  if (!mpResultComparisonThread->getErrorString().isEmpty()) {
+    MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                          mpResultComparisonThread->getErrorString(), Helper::scriptingKind,
+                                                          Helper::errorLevel));
+    return;
+  }
+  mResults = mpResultComparisonThread->getResults();
+  showResults();
+}
+
+void ResultComparisonWidget::showContextMenu(QPoint point)
+{
+  QTreeWidgetItem *pTreeWidgetItem = mpResultsTreeWidget->itemAt(point);
+  if (!pTreeWidgetItem) {
+    return;
+  }
+  QMenu menu(this);
+  // plot the variable under the cursor, it is not necessarily the current item. The results can be refreshed while the menu is open.
+  QString variable = pTreeWidgetItem->text(0);
+  QAction *pPlotOverlayAction = new QAction(tr("Plot Against Reference"), &menu);
+  menu.addAction(pPlotOverlayAction);
+  if (menu.exec(mpResultsTreeWidget->viewport()->mapToGlobal(point)) == pPlotOverlayAction) {
+    plotOverlay(variable);
+  }
+}
+
+/*!
+ * \brief ResultComparisonWidget::plotOverlay
+ * Plots the variable from both result files in a new plot window.
+ * \param variable
+ */
+void ResultComparisonWidget::plotOverlay(QString variable)
+{
+  PlotWindowContainer *pPlotWindowContainer = MainWindow::instance()->getPlotWindowContainer();
+  MainWindow::instance()->getPerspectiveTabBar()->setCurrentIndex(2);
+  try {
+    pPlotWindowContainer->addPlotWindow();
+    OMPlot::PlotWindow *pPlotWindow = pPlotWindowContainer->getCurrentWindow();
+    if (!pPlotWindow) {
+      return;
+    }
+    pPlotWindow->setWindowTitle(tr("Compare : %1").arg(variable));
+    foreach (QString fileName, QStringList() << mpReferenceFileTextBox->text() << mpActualFileTextBox->text()) {
+      pPlotWindow->initializeFile(fileName);
+      pPlotWindow->setVariablesList(QStringList(variable));
+      pPlotWindow->plot(0);
+    }
+    pPlotWindow->fitInView();
+  } catch (OMPlot::PlotException &e) {
+    MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, e.what(), Helper::scriptingKind,
+                                                          Helper::errorLevel));
+  }
+}
+
+/*!
+ * \brief ResultComparisonWidget::plotOverlay
+ * Slot activated when an item is double clicked.
+ * \param pTreeWidgetItem
+ */
+void ResultComparisonWidget::plotOverlay(QTreeWidgetItem *pTreeWidgetItem)
+{
+  if (pTreeWidgetItem) {
+    plotOverlay(pTreeWidgetItem->text(0));
+  }
+}
@@ -0,0 +1,153 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+
+#ifndef RESULTCOMPARISONWIDGET_H
+#define RESULTCOMPARISONWIDGET_H
+
+#include "util/read_matlab4.h"
+#include "util/read_csv.h"
+
+#include <QThread>
+#include <QVector>
+#include <QHash>
+#include <QTreeWidget>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QCheckBox>
+#include <QLineEdit>
+
+class Label;
+
+/*!
+ * \class ResultFileReader
+ * \brief Reads the variables of a MAT or CSV result file in batches.
+ */
+class ResultFileReader
+{
+public:
+  ResultFileReader();
+  ~ResultFileReader();
+  bool open(QString fileName, QString *pErrorString);
+  void close();
+  QStringList getVariableNames() const {return mVariableNames;}
+  int getNumberOfRows() const;
+  QVector<double> readTime();
+  QList<QVector<double> > readVariables(const QStringList &variables);
+private:
+  bool mIsMatFile;
+  ModelicaMatReader mMatReader;
+  bool mMatReaderOpen;
+  csv_data *mpCSVData;
+  QStringList mVariableNames;
+
+  QList<QVector<double> > readMatVariables(const QStringList &variables);
+};
+
+/*!
+ * \brief The ResultComparison struct
+ * Holds the deviation of one variable.
+ */
+struct ResultComparison
+{
+  QString mVariable;
+  double mMaxAbsoluteError;
+  double mMaxRelativeError;
+  double mTimeOfMaxError;
+  int mPointsOutsideTolerance;
+};
+
+class ResultComparisonThread : public QThread
+{
+  Q_OBJECT
+public:
+  ResultComparisonThread(QString referenceFileName, QString actualFileName, double relativeTolerance, double absoluteTolerance,
+                         QObject *pParent = 0);
+  void cancel() {mCancelled = true;}
+  bool isCancelled() const {return mCancelled;}
+  QList<ResultComparison> getResults() const {return mResults;}
+  QString getErrorString() const {return mErrorString;}
+  static void computeInterpolation(const QVector<double> &referenceTime, const QVector<double> &actualTime, QVector<int> *pIndexes,
+                                   QVector<double> *pWeights);
+  static ResultComparison compareVariable(const QVector<double> &referenceTime, const QVector<double> &reference,
+                                          const QVector<double> &actual, const QVector<int> &indexes, const QVector<double> &weights,
+                                          double relativeTolerance, double absoluteTolerance);
+protected:
+  virtual void run();
+private:
+  QString mReferenceFileName;
+  QString mActualFileName;
+  double mRelativeTolerance;
+  double mAbsoluteTolerance;
+  volatile bool mCancelled;
+  QList<ResultComparison> mResults;
+  QString mErrorString;
+signals:
+  void progressChanged(int, int);
+};
+
+class ResultComparisonWidget : public QWidget
+{
+  Q_OBJECT
+public:
+  ResultComparisonWidget(QWidget *pParent = 0);
+  ~ResultComparisonWidget();
+private:
+  Label *mpReferenceFileLabel;
+  QLineEdit *mpReferenceFileTextBox;
+  QPushButton *mpBrowseReferenceFileButton;
+  Label *mpActualFileLabel;
+  QLineEdit *mpActualFileTextBox;
+  QPushButton *mpBrowseActualFileButton;
+  Label *mpRelativeToleranceLabel;
+  QLineEdit *mpRelativeToleranceTextBox;
+  Label *mpAbsoluteToleranceLabel;
+  QLineEdit *mpAbsoluteToleranceTextBox;
+  QCheckBox *mpShowOnlyFailingCheckBox;
+  QPushButton *mpCompareButton;
+  QProgressBar *mpProgressBar;
+  Label *mpSummaryLabel;
+  QTreeWidget *mpResultsTreeWidget;
+  ResultComparisonThread *mpResultComparisonThread;
+  QList<ResultComparison> mResults;
+
+  void showResults();
+  void plotOverlay(QString variable);
+private slots:
+  void browseReferenceFile();
+  void browseActualFile();
+  void compareResults();
+  void updateProgress(int value, int maximum);
+  void comparisonFinished();
+  void showContextMenu(QPoint point);
+  void plotOverlay(QTreeWidgetItem *pTreeWidgetItem);
+};
+
+#endif // RESULTCOMPARISONWIDGET_H
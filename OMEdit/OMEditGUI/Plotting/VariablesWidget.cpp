@@ -37,11 +37,13 @@
 #include "OMC/OMCProxy.h"
 #include "Options/OptionsDialog.h"
 #include "Modeling/MessagesWidget.h"
-#include "util/read_matlab4.h"
 #include "Plotting/PlotWindowContainer.h"
 #include "Simulation/SimulationDialog.h"
 
 #include <QObject>
+#include <QTimer>
+#include <qwt_scale_map.h>
+#include <qwt_scale_widget.h>
 
 using namespace OMPlot;
 
@@ -80,6 +82,7 @@ VariablesTreeItem::VariablesTreeItem(const QVector<QVariant> &variableItemData,
   mToolTip = variableItemData[9].toString();
   mChecked = false;
   mEditable = false;
+  mHasPendingChildren = false;
 }
 
 VariablesTreeItem::~VariablesTreeItem()
@@ -176,7 +179,7 @@ QVariant VariablesTreeItem::data(int column, int role) const
         case Qt::ToolTipRole:
           return mToolTip;
         case Qt::CheckStateRole:
-          if (mChildren.size() == 0 && parent()->parent()) {  // do not show checkbox for top level items without children.
+          if (isLeaf() && parent()->parent()) {  // do not show checkbox for top level items without children.
             return isChecked() ? Qt::Checked : Qt::Unchecked;
            } else {
             return QVariant();
@@ -276,6 +279,12 @@ VariablesTreeModel::VariablesTreeModel(VariablesTreeView *pVariablesTreeView)
   headers << "" << "" << Helper::variables << Helper::variables << tr("Value") << tr("Unit") << tr("Display Unit") <<
              QStringList() << Helper::description << "";
   mpRootVariablesTreeItem = new VariablesTreeItem(headers, 0, true);
+  mMatReader.file = 0;
+}
+
+VariablesTreeModel::~VariablesTreeModel()
+{
+  closeResultFile();
 }
 
 int VariablesTreeModel::columnCount(const QModelIndex &parent) const
@@ -299,6 +308,46 @@ int VariablesTreeModel::rowCount(const QModelIndex &parent) const
   return pParentVariablesTreeItem->getChildren().size();
 }
 
+/*!
+ * \brief VariablesTreeModel::hasChildren
+ * Returns true if the item has children or pending children.
+ * \param parent
+ * \return
+ */
+bool VariablesTreeModel::hasChildren(const QModelIndex &parent) const
+{
+  if (parent.column() > 0) {
+    return false;
+  }
+  if (parent.isValid() && static_cast<VariablesTreeItem*>(parent.internalPointer())->hasPendingChildren()) {
+    return true;
+  }
+  return rowCount(parent) > 0;
+}
+
+/*!
+ * \brief VariablesTreeModel::canFetchMore
+ * Returns true if the children of the item are not created yet.
+ * \param parent
+ * \return
+ */
+bool VariablesTreeModel::canFetchMore(const QModelIndex &parent) const
+{
+  return parent.isValid() && static_cast<VariablesTreeItem*>(parent.internalPointer())->hasPendingChildren();
+}
+
+/*!
+ * \brief VariablesTreeModel::fetchMore
+ * Creates the children of the item when it is expanded.
+ * \param parent
+ */
+void VariablesTreeModel::fetchMore(const QModelIndex &parent)
+{
+  if (parent.isValid()) {
+    fetchChildren(static_cast<VariablesTreeItem*>(parent.internalPointer()));
+  }
+}
+
 QVariant VariablesTreeModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
   if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
@@ -385,9 +434,9 @@ Qt::ItemFlags VariablesTreeModel::flags(const QModelIndex &index) const
 
   Qt::ItemFlags flags = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
   VariablesTreeItem *pVariablesTreeItem = static_cast<VariablesTreeItem*>(index.internalPointer());
-  if (index.column() == 0 && pVariablesTreeItem && pVariablesTreeItem->getChildren().size() == 0 && pVariablesTreeItem->parent() != mpRootVariablesTreeItem) {
+  if (index.column() == 0 && pVariablesTreeItem && pVariablesTreeItem->isLeaf() && pVariablesTreeItem->parent() != mpRootVariablesTreeItem) {
     flags |= Qt::ItemIsUserCheckable;
-  } else if (index.column() == 1 && pVariablesTreeItem && pVariablesTreeItem->getChildren().size() == 0 && pVariablesTreeItem->isEditable()) {
+  } else if (index.column() == 1 && pVariablesTreeItem && pVariablesTreeItem->isLeaf() && pVariablesTreeItem->isEditable()) {
     flags |= Qt::ItemIsEditable;
   } else if (index.column() == 3) {
     flags |= Qt::ItemIsEditable;
@@ -396,93 +445,102 @@ Qt::ItemFlags VariablesTreeModel::flags(const QModelIndex &index) const
   return flags;
 }
 
-VariablesTreeItem* VariablesTreeModel::findVariablesTreeItem(const QString &name, VariablesTreeItem *root) const
+/*!
+ * \brief VariablesTreeModel::findVariablesTreeItem
+ * Finds the VariablesTreeItem by its variable name using the hash index.
+ * Creates the item and its parents if they are not created yet.
+ * \param name
+ * \param root - the item is only returned if it is root or one of its descendants.
+ * \return
+ */
+VariablesTreeItem* VariablesTreeModel::findVariablesTreeItem(const QString &name, VariablesTreeItem *root)
 {
-  if (root->getVariableName() == name)
-    return root;
-  for (int i = root->getChildren().size(); --i >= 0; )
-    if (VariablesTreeItem *item = findVariablesTreeItem(name, root->getChildren().at(i)))
-      return item;
+  VariablesTreeItem *pVariablesTreeItem = mVariablesTreeItemsHash.value(name, 0);
+  if (!pVariablesTreeItem && mVariableParentsHash.contains(name)) {
+    VariablesTreeItem *pParentVariablesTreeItem = findVariablesTreeItem(mVariableParentsHash.value(name), mpRootVariablesTreeItem);
+    if (pParentVariablesTreeItem) {
+      fetchChildren(pParentVariablesTreeItem);
+      pVariablesTreeItem = mVariablesTreeItemsHash.value(name, 0);
+    }
+  }
+  if (!pVariablesTreeItem) {
+    return (root && root->getVariableName() == name) ? root : 0;
+  }
+  if (root == mpRootVariablesTreeItem) {
+    return pVariablesTreeItem;
+  }
+  for (VariablesTreeItem *pParentVariablesTreeItem = pVariablesTreeItem ; pParentVariablesTreeItem ;
+       pParentVariablesTreeItem = pParentVariablesTreeItem->parent()) {
+    if (pParentVariablesTreeItem == root) {
+      return pVariablesTreeItem;
+    }
+  }
   return 0;
 }
 
+/*!
+ * \brief VariablesTreeModel::variablesTreeItemIndex
+ * Returns the model index of the VariablesTreeItem.
+ * \param pVariablesTreeItem
+ * \return
+ */
 QModelIndex VariablesTreeModel::variablesTreeItemIndex(const VariablesTreeItem *pVariablesTreeItem) const
 {
-  return variablesTreeItemIndexHelper(pVariablesTreeItem, mpRootVariablesTreeItem, QModelIndex());
-}
-
-QModelIndex VariablesTreeModel::variablesTreeItemIndexHelper(const VariablesTreeItem *pVariablesTreeItem,
-                                                             const VariablesTreeItem *pParentVariablesTreeItem,
-                                                             const QModelIndex &parentIndex) const
-{
-  if (pVariablesTreeItem == pParentVariablesTreeItem)
-    return parentIndex;
-  for (int i = pParentVariablesTreeItem->getChildren().size(); --i >= 0; ) {
-    const VariablesTreeItem *childItem = pParentVariablesTreeItem->getChildren().at(i);
-    QModelIndex childIndex = index(i, 0, parentIndex);
-    QModelIndex index = variablesTreeItemIndexHelper(pVariablesTreeItem, childItem, childIndex);
-    if (index.isValid())
-      return index;
+  if (!pVariablesTreeItem || pVariablesTreeItem == mpRootVariablesTreeItem) {
+    return QModelIndex();
   }
-  return QModelIndex();
+  return createIndex(pVariablesTreeItem->row(), 0, const_cast<VariablesTreeItem*>(pVariablesTreeItem));
 }
 
-void VariablesTreeModel::parseInitXml(QXmlStreamReader &xmlReader)
+/*!
+ * \brief VariablesTreeModel::setFilterRegExp
+ * Matches the regular expression against the names of all the variables, including the ones whose items are not created yet.
+ * The matching variables and their parents are kept so that the proxy model can filter without visiting the children of every row.
+ * The items of the matching variables are created so that they can be shown.
+ * \param regExp
+ */
+void VariablesTreeModel::setFilterRegExp(const QRegExp &regExp)
 {
-  mScalarVariablesList.clear();
-  /* We'll parse the XML until we reach end of it.*/
-  while(!xmlReader.atEnd() && !xmlReader.hasError())
-  {
-    /* Read next element.*/
-    QXmlStreamReader::TokenType token = xmlReader.readNext();
-    /* If token is just StartDocument, we'll go to next.*/
-    if(token == QXmlStreamReader::StartDocument)
-      continue;
-    /* If token is StartElement, we'll see if we can read it.*/
-    if(token == QXmlStreamReader::StartElement)
-    {
-      /* If it's named ScalarVariable, we'll dig the information from there.*/
-      if(xmlReader.name() == "ScalarVariable")
-      {
-        QHash<QString, QString> scalarVariable = parseScalarVariable(xmlReader);
-        mScalarVariablesList.insert(scalarVariable.value("name"),scalarVariable);
-      }
+  mFilterRegExp = regExp;
+  mMatchingVariables.clear();
+  if (mFilterRegExp.isEmpty()) {
+    return;
+  }
+  QRegExp resultTypeRegExp("(\\.mat|\\.plt|\\.csv|_res.mat|_res.plt|_res.csv)");
+  QHash<QString, QString>::const_iterator it;
+  for (it = mVariableParentsHash.constBegin() ; it != mVariableParentsHash.constEnd() ; ++it) {
+    if (QString(it.key()).remove(resultTypeRegExp).contains(mFilterRegExp)) {
+      addMatchingVariable(it.key());
     }
   }
-  xmlReader.clear();
+  foreach (QString variableName, mMatchingVariables) {
+    findVariablesTreeItem(variableName, mpRootVariablesTreeItem);
+  }
 }
 
-QHash<QString, QString> VariablesTreeModel::parseScalarVariable(QXmlStreamReader &xmlReader)
+/*!
+ * \brief VariablesTreeModel::removeVariablesTreeItemsFromHash
+ * Removes the VariablesTreeItem, its children and its pending children from the indexes and the matching variables.
+ * \param pVariablesTreeItem
+ */
+void VariablesTreeModel::removeVariablesTreeItemsFromHash(VariablesTreeItem *pVariablesTreeItem)
 {
-  QHash<QString, QString> scalarVariable;
-  /* Let's check that we're really getting a ScalarVariable. */
-  if(xmlReader.tokenType() != QXmlStreamReader::StartElement && xmlReader.name() == "ScalarVariable")
-    return scalarVariable;
-  /* Let's get the attributes for ScalarVariable */
-  QXmlStreamAttributes attributes = xmlReader.attributes();
-  /* Read the ScalarVariable attributes. */
-  scalarVariable["name"] = attributes.value("name").toString();
-  scalarVariable["description"] = attributes.value("description").toString();
-  scalarVariable["isValueChangeable"] = attributes.value("isValueChangeable").toString();
-  /* Read the next element i.e Real, Integer, Boolean etc. */
-  xmlReader.readNext();
-  while(!(xmlReader.tokenType() == QXmlStreamReader::EndElement && xmlReader.name() == "ScalarVariable"))
-  {
-    if(xmlReader.tokenType() == QXmlStreamReader::StartElement)
-    {
-      QXmlStreamAttributes attributes = xmlReader.attributes();
-      scalarVariable["start"] = attributes.value("start").toString();
-      scalarVariable["unit"] = attributes.value("unit").toString();
-      scalarVariable["displayUnit"] = attributes.value("displayUnit").toString();
-    }
-    xmlReader.readNext();
+  if (mVariablesTreeItemsHash.value(pVariablesTreeItem->getVariableName(), 0) == pVariablesTreeItem) {
+    mVariablesTreeItemsHash.remove(pVariablesTreeItem->getVariableName());
+  }
+  mVariableParentsHash.remove(pVariablesTreeItem->getVariableName());
+  mMatchingVariables.remove(pVariablesTreeItem->getVariableName());
+  removePendingChildren(pVariablesTreeItem->getVariableName());
+  foreach (VariablesTreeItem *pChildVariablesTreeItem, pVariablesTreeItem->getChildren()) {
+    removeVariablesTreeItemsFromHash(pChildVariablesTreeItem);
   }
-  return scalarVariable;
 }
 
 /*!
  * \brief VariablesTreeModel::insertVariablesItems
- * Inserts the variables in the Variables Browser.
+ * Inserts the variables in the Variables Browser.\n
+ * Only the result file item is created. The names of the variables are indexed by their parents and the VariablesTreeItems are
+ * created level by level when they are expanded, searched or looked up, see VariablesTreeModel::fetchChildren.
  * \param fileName
  * \param filePath
  * \param variablesList
@@ -494,47 +552,18 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
   QString toolTip = tr("Simulation Result File: %1\n%2: %3/%4").arg(fileName).arg(Helper::fileLocation).arg(filePath).arg(fileName);
   QRegExp resultTypeRegExp("(\\.mat|\\.plt|\\.csv|_res.mat|_res.plt|_res.csv)");
   QString text = QString(fileName).remove(resultTypeRegExp);
-  QModelIndex index = variablesTreeItemIndex(mpRootVariablesTreeItem);
   QVector<QVariant> Variabledata;
   Variabledata << filePath << fileName << fileName << text << "" << "" << "" << QStringList() << "" << toolTip;
 
   VariablesTreeItem *pTopVariablesTreeItem = new VariablesTreeItem(Variabledata, mpRootVariablesTreeItem, true);
   pTopVariablesTreeItem->setSimulationOptions(simulationOptions);
-  int row = rowCount();
-  beginInsertRows(index, row, row);
-  mpRootVariablesTreeItem->insertChild(row, pTopVariablesTreeItem);
-  endInsertRows();
-  /* open the model_init.xml file for reading */
-  if (simulationOptions.isValid()) {
-    QString initFileName = QString(simulationOptions.getOutputFileName()).append("_init.xml");
-    QFile initFile(QString(filePath).append(QDir::separator()).append(initFileName));
-    if (initFile.open(QIODevice::ReadOnly)) {
-      QXmlStreamReader initXmlReader(&initFile);
-      parseInitXml(initXmlReader);
-      initFile.close();
-    } else {
-      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                            GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(initFile.fileName())
-                                                            .arg(initFile.errorString()), Helper::scriptingKind, Helper::errorLevel));
-    }
-  }
-  /* open the .mat file */
-  ModelicaMatReader matReader;
-  matReader.file = 0;
-  const char *msg[] = {""};
-  if (fileName.endsWith(".mat")) {
-    //Read in mat file
-    if (0 != (msg[0] = omc_new_matlab4_reader(QString(filePath + "/" + fileName).toStdString().c_str(), &matReader))) {
-      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                            GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(fileName)
-                                                            .arg(QString(msg[0])), Helper::scriptingKind, Helper::errorLevel));
-    }
-  }
+  mVariablesTreeItemsHash.insert(pTopVariablesTreeItem->getVariableName(), pTopVariablesTreeItem);
+  mVariableParentsHash.insert(pTopVariablesTreeItem->getVariableName(), QString());
+  /* index the names of the variables by their parents in a single pass over the variables. */
   // remove time from variables list
   variablesList.removeOne("time");
   QStringList variables;
   foreach (QString plotVariable, variablesList) {
-    QString parentVariable;
     if (plotVariable.startsWith("der(")) {
       QString str = plotVariable;
       str.chop((str.lastIndexOf("der(")/4)+1);
@@ -547,107 +576,39 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
       variables = StringHandler::makeVariableParts(plotVariable);
     }
     int count = 1;
-    VariablesTreeItem *pParentVariablesTreeItem = 0;
+    QString parentVariableName = fileName;
     foreach (QString variable, variables) {
-      if (count == 1) { /* first loop iteration */
-        pParentVariablesTreeItem = pTopVariablesTreeItem;
-      }
-      QString findVariable;
-      /* if last item */
-      if (variables.size() == count && plotVariable.startsWith("der(")) {
-        findVariable = parentVariable.isEmpty() ? fileName + ".der(" + variable + ")" : fileName + "." + parentVariable + ".der(" + variable + ")";
-      } else if (variables.size() == count && plotVariable.startsWith("previous(")) {
-        findVariable = parentVariable.isEmpty() ? fileName + ".previous(" + variable + ")" : fileName + "." + parentVariable + ".previous(" + variable + ")";
-      } else {
-        findVariable = parentVariable.isEmpty() ? fileName + "." + variable : fileName + "." + parentVariable + "." + variable;
-      }
-      if ((pParentVariablesTreeItem = findVariablesTreeItem(findVariable, pParentVariablesTreeItem)) != NULL) {
-        if (count == 1) {
-          parentVariable = variable;
-        } else {
-          parentVariable += "." + variable;
-        }
-        count++;
-        continue;
-      }
-      /* If pParentVariablesTreeItem is 0 and it is first loop iteration then use pTopVariablesTreeItem as parent.
-       * If loop iteration is not first and pParentVariablesTreeItem is 0 then find the parent item.
-       */
-      if (!pParentVariablesTreeItem && count > 1) {
-        pParentVariablesTreeItem = findVariablesTreeItem(fileName + "." + parentVariable, pTopVariablesTreeItem);
-      } else {
-        pParentVariablesTreeItem = pTopVariablesTreeItem;
-      }
-      QModelIndex index = variablesTreeItemIndex(pParentVariablesTreeItem);
-      QVector<QVariant> variableData;
+      PendingVariablesTreeItem pendingVariablesTreeItem;
       /* if last item */
       if (variables.size() == count && plotVariable.startsWith("der(")) {
-        variableData << filePath << fileName << fileName + "." + plotVariable << "der(" + variable + ")";
+        pendingVariablesTreeItem.mVariableName = fileName + "." + plotVariable;
+        pendingVariablesTreeItem.mDisplayVariableName = "der(" + variable + ")";
       } else if (variables.size() == count && plotVariable.startsWith("previous(")) {
-        variableData << filePath << fileName << fileName + "." + plotVariable << "previous(" + variable + ")";
+        pendingVariablesTreeItem.mVariableName = fileName + "." + plotVariable;
+        pendingVariablesTreeItem.mDisplayVariableName = "previous(" + variable + ")";
       } else {
-        variableData << filePath << fileName << pParentVariablesTreeItem->getVariableName() + "." + variable << variable;
+        pendingVariablesTreeItem.mVariableName = parentVariableName + "." + variable;
+        pendingVariablesTreeItem.mDisplayVariableName = variable;
       }
-      /* find the variable in the xml file */
-      QString variableToFind = variableData[2].toString();
-      variableToFind.remove(QRegExp(pTopVariablesTreeItem->getVariableName() + "."));
-      /* get the variable information i.e value, unit, displayunit, description */
-      QString value, unit, displayUnit, description;
-      bool changeAble = false;
-      getVariableInformation(&matReader, variableToFind, &value, &changeAble, &unit, &displayUnit, &description);
-      variableData << StringHandler::unparse(QString("\"").append(value).append("\""));
-      /* set the variable unit */
-      variableData << StringHandler::unparse(QString("\"").append(unit).append("\""));
-      /* set the variable displayUnit */
-      variableData << StringHandler::unparse(QString("\"").append(displayUnit).append("\""));
-      /* set the variable displayUnits */
-      if (!variableData[5].toString().isEmpty()) {
-        QStringList displayUnits, displayUnitOptions;
-        displayUnits << variableData[5].toString();
-        if (!variableData[6].toString().isEmpty()) {
-          displayUnitOptions << variableData[6].toString();
-          /* convert value to displayUnit */
-          OMCInterface::convertUnits_res convertUnit = MainWindow::instance()->getOMCProxy()->convertUnits(variableData[5].toString(), variableData[6].toString());
-          if (convertUnit.unitsCompatible) {
-            bool ok = true;
-            qreal realValue = variableData[4].toDouble(&ok);
-            if (ok) {
-              realValue = Utilities::convertUnit(realValue, convertUnit.offset, convertUnit.scaleFactor);
-              variableData[4] = QString::number(realValue);
-            }
-          }
-        } else { /* use unit as displayUnit */
-          variableData[6] = variableData[5];
+      if (!mVariableParentsHash.contains(pendingVariablesTreeItem.mVariableName)) {
+        mVariableParentsHash.insert(pendingVariablesTreeItem.mVariableName, parentVariableName);
+        mPendingChildrenHash[parentVariableName].append(pendingVariablesTreeItem);
+        if (!mFilterRegExp.isEmpty() && QString(pendingVariablesTreeItem.mVariableName).remove(resultTypeRegExp).contains(mFilterRegExp)) {
+          addMatchingVariable(pendingVariablesTreeItem.mVariableName);
         }
-        displayUnits << displayUnitOptions;
-        variableData << displayUnits;
-      } else {
-        variableData << QStringList();
-      }
-      /* set the variable description */
-      variableData << StringHandler::unparse(QString("\"").append(description).append("\""));
-      /* construct tooltip text */
-      variableData << tr("File: %1/%2\nVariable: %3").arg(filePath).arg(fileName).arg(variableToFind);
-      VariablesTreeItem *pVariablesTreeItem = new VariablesTreeItem(variableData, pParentVariablesTreeItem);
-      pVariablesTreeItem->setEditable(changeAble);
-      int row = rowCount(index);
-      beginInsertRows(index, row, row);
-      pParentVariablesTreeItem->insertChild(row, pVariablesTreeItem);
-      endInsertRows();
-      if (count == 1) {
-        parentVariable = variable;
-      } else {
-        parentVariable += "." + variable;
       }
+      parentVariableName = pendingVariablesTreeItem.mVariableName;
       count++;
     }
   }
-  /* close the .mat file */
-  if (fileName.endsWith(".mat")) {
-    if (matReader.file) {
-      omc_free_matlab4_reader(&matReader);
-    }
-  }
+  pTopVariablesTreeItem->setHasPendingChildren(mPendingChildrenHash.contains(pTopVariablesTreeItem->getVariableName()));
+  /* open the result files once to report the errors. */
+  openResultFile(pTopVariablesTreeItem, true);
+  /* add the result file to the model with a single insert. */
+  int row = rowCount();
+  beginInsertRows(QModelIndex(), row, row);
+  mpRootVariablesTreeItem->insertChild(row, pTopVariablesTreeItem);
+  endInsertRows();
   mpVariablesTreeView->collapseAll();
   QModelIndex idx = variablesTreeItemIndex(pTopVariablesTreeItem);
   idx = mpVariablesTreeView->getVariablesWidget()->getVariableTreeProxyModel()->mapFromSource(idx);
@@ -661,6 +622,172 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
   MainWindow::instance()->enableReSimulationToolbar(MainWindow::instance()->getVariablesDockWidget()->isVisible());
 }
 
+/*!
+ * \brief VariablesTreeModel::fetchChildren
+ * Creates the pending children of the VariablesTreeItem.
+ * \param pParentVariablesTreeItem
+ */
+void VariablesTreeModel::fetchChildren(VariablesTreeItem *pParentVariablesTreeItem)
+{
+  if (!pParentVariablesTreeItem->hasPendingChildren()) {
+    return;
+  }
+  pParentVariablesTreeItem->setHasPendingChildren(false);
+  QList<PendingVariablesTreeItem> pendingVariablesTreeItems = mPendingChildrenHash.take(pParentVariablesTreeItem->getVariableName());
+  if (pendingVariablesTreeItems.isEmpty()) {
+    return;
+  }
+  VariablesTreeItem *pTopVariablesTreeItem = pParentVariablesTreeItem->rootParent();
+  openResultFile(pTopVariablesTreeItem, false);
+  QString filePath = pTopVariablesTreeItem->getFilePath();
+  QString fileName = pTopVariablesTreeItem->getFileName();
+  QList<VariablesTreeItem*> variablesTreeItems;
+  foreach (PendingVariablesTreeItem pendingVariablesTreeItem, pendingVariablesTreeItems) {
+    QVector<QVariant> variableData;
+    variableData << filePath << fileName << pendingVariablesTreeItem.mVariableName << pendingVariablesTreeItem.mDisplayVariableName;
+    /* find the variable in the xml file */
+    QString variableToFind = pendingVariablesTreeItem.mVariableName.mid(fileName.length() + 1);
+    /* get the variable information i.e value, unit, displayunit, description */
+    QString value, unit, displayUnit, description;
+    bool changeAble = false;
+    getVariableInformation(&mMatReader, variableToFind, &value, &changeAble, &unit, &displayUnit, &description);
+    variableData << StringHandler::unparse(QString("\"").append(value).append("\""));
+    /* set the variable unit */
+    variableData << StringHandler::unparse(QString("\"").append(unit).append("\""));
+    /* set the variable displayUnit */
+    variableData << StringHandler::unparse(QString("\"").append(displayUnit).append("\""));
+    /* set the variable displayUnits */
+    if (!variableData[5].toString().isEmpty()) {
+      QStringList displayUnits, displayUnitOptions;
+      displayUnits << variableData[5].toString();
+      if (!variableData[6].toString().isEmpty()) {
+        displayUnitOptions << variableData[6].toString();
+        /* convert value to displayUnit */
+        QString convertUnitsKey = variableData[5].toString() + "\n" + variableData[6].toString();
+        if (!mConvertUnitsCache.contains(convertUnitsKey)) {
+          mConvertUnitsCache.insert(convertUnitsKey, MainWindow::instance()->getOMCProxy()->convertUnits(variableData[5].toString(),
+                                                                                                       variableData[6].toString()));
+        }
+        OMCInterface::convertUnits_res convertUnit = mConvertUnitsCache.value(convertUnitsKey);
+        if (convertUnit.unitsCompatible) {
+          bool ok = true;
+          qreal realValue = variableData[4].toDouble(&ok);
+          if (ok) {
+            realValue = Utilities::convertUnit(realValue, convertUnit.offset, convertUnit.scaleFactor);
+            variableData[4] = QString::number(realValue);
+          }
+        }
+      } else { /* use unit as displayUnit */
+        variableData[6] = variableData[5];
+      }
+      displayUnits << displayUnitOptions;
+      variableData << displayUnits;
+    } else {
+      variableData << QStringList();
+    }
+    /* set the variable description */
+    variableData << StringHandler::unparse(QString("\"").append(description).append("\""));
+    /* construct tooltip text */
+    variableData << tr("File: %1/%2\nVariable: %3").arg(filePath).arg(fileName).arg(variableToFind);
+    VariablesTreeItem *pVariablesTreeItem = new VariablesTreeItem(variableData, pParentVariablesTreeItem);
+    pVariablesTreeItem->setEditable(changeAble);
+    pVariablesTreeItem->setHasPendingChildren(mPendingChildrenHash.contains(pVariablesTreeItem->getVariableName()));
+    mVariablesTreeItemsHash.insert(pVariablesTreeItem->getVariableName(), pVariablesTreeItem);
+    variablesTreeItems.append(pVariablesTreeItem);
+  }
+  int row = pParentVariablesTreeItem->getChildren().size();
+  beginInsertRows(variablesTreeItemIndex(pParentVariablesTreeItem), row, row + variablesTreeItems.size() - 1);
+  foreach (VariablesTreeItem *pVariablesTreeItem, variablesTreeItems) {
+    pParentVariablesTreeItem->insertChild(pParentVariablesTreeItem->getChildren().size(), pVariablesTreeItem);
+  }
+  endInsertRows();
+}
+
+/*!
+ * \brief VariablesTreeModel::openResultFile
+ * Opens the result file and the model_init.xml file of the result file item for reading the variables information.\n
+ * The files are kept open for the items created in the current event loop iteration only.
+ * The next simulation could not overwrite them on Windows otherwise.
+ * \param pTopVariablesTreeItem
+ * \param showErrors
+ */
+void VariablesTreeModel::openResultFile(VariablesTreeItem *pTopVariablesTreeItem, bool showErrors)
+{
+  QString filePath = pTopVariablesTreeItem->getFilePath();
+  QString fileName = pTopVariablesTreeItem->getFileName();
+  if (mOpenResultFile.compare(filePath + "/" + fileName) == 0) {
+    return;
+  }
+  closeResultFile();
+  mOpenResultFile = filePath + "/" + fileName;
+  /* open the model_init.xml file for reading */
+  SimulationOptions simulationOptions = pTopVariablesTreeItem->getSimulationOptions();
+  if (simulationOptions.isValid()) {
+    QString initFileName = QString(simulationOptions.getOutputFileName()).append("_init.xml");
+    QString initFilePath = QString(filePath).append(QDir::separator()).append(initFileName);
+    if (!mInitXmlIndex.open(initFilePath) && showErrors) {
+      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                            GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(initFilePath)
+                                                            .arg(mInitXmlIndex.errorString()), Helper::scriptingKind, Helper::errorLevel));
+    }
+  }
+  /* open the .mat file */
+  const char *msg[] = {""};
+  if (fileName.endsWith(".mat")) {
+    //Read in mat file
+    if (0 != (msg[0] = omc_new_matlab4_reader(QString(filePath + "/" + fileName).toStdString().c_str(), &mMatReader))) {
+      mMatReader.file = 0;
+      if (showErrors) {
+        MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                              GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(fileName)
+                                                              .arg(QString(msg[0])), Helper::scriptingKind, Helper::errorLevel));
+      }
+    }
+  }
+  QTimer::singleShot(0, this, SLOT(closeResultFile()));
+}
+
+/*!
+ * \brief VariablesTreeModel::closeResultFile
+ * Closes the result file and the model_init.xml file opened by VariablesTreeModel::openResultFile.
+ */
+void VariablesTreeModel::closeResultFile()
+{
+  mInitXmlIndex.close();
+  if (mMatReader.file) {
+    omc_free_matlab4_reader(&mMatReader);
+    mMatReader.file = 0;
+  }
+  mOpenResultFile.clear();
+}
+
+/*!
+ * \brief VariablesTreeModel::addMatchingVariable
+ * Adds the variable and its parents to the variables matching the filter.
+ * \param variableName
+ */
+void VariablesTreeModel::addMatchingVariable(QString variableName)
+{
+  while (!variableName.isEmpty() && !mMatchingVariables.contains(variableName)) {
+    mMatchingVariables.insert(variableName);
+    variableName = mVariableParentsHash.value(variableName);
+  }
+}
+
+/*!
+ * \brief VariablesTreeModel::removePendingChildren
+ * Removes the pending children of the variable and their pending children from the indexes.
+ * \param variableName
+ */
+void VariablesTreeModel::removePendingChildren(const QString &variableName)
+{
+  foreach (PendingVariablesTreeItem pendingVariablesTreeItem, mPendingChildrenHash.take(variableName)) {
+    mVariableParentsHash.remove(pendingVariablesTreeItem.mVariableName);
+    mMatchingVariables.remove(pendingVariablesTreeItem.mVariableName);
+    removePendingChildren(pendingVariablesTreeItem.mVariableName);
+  }
+}
+
 /*!
  * \brief VariablesTreeModel::removeVariableTreeItem
  * Removes the VariablesTreeItem.
@@ -671,9 +798,13 @@ bool VariablesTreeModel::removeVariableTreeItem(QString variable)
 {
   VariablesTreeItem *pVariablesTreeItem = findVariablesTreeItem(variable, mpRootVariablesTreeItem);
   if (pVariablesTreeItem) {
-    beginRemoveRows(variablesTreeItemIndex(pVariablesTreeItem), 0, pVariablesTreeItem->getChildren().size());
-    pVariablesTreeItem->removeChildren();
     VariablesTreeItem *pParentVariablesTreeItem = pVariablesTreeItem->parent();
+    int row = pVariablesTreeItem->row();
+    // the result file could be overwritten by the next simulation
+    closeResultFile();
+    beginRemoveRows(variablesTreeItemIndex(pParentVariablesTreeItem), row, row);
+    removeVariablesTreeItemsFromHash(pVariablesTreeItem);
+    pVariablesTreeItem->removeChildren();
     pParentVariablesTreeItem->removeChild(pVariablesTreeItem);
     delete pVariablesTreeItem;
     endRemoveRows();
@@ -692,25 +823,29 @@ void VariablesTreeModel::unCheckVariables(VariablesTreeItem *pVariablesTreeItem)
   }
 }
 
+/*!
+ * \brief VariablesTreeModel::plotAllVariables
+ * Plots all the variables of the VariablesTreeItem in one batch.
+ * \param pVariablesTreeItem
+ * \param pPlotWindow
+ */
 void VariablesTreeModel::plotAllVariables(VariablesTreeItem *pVariablesTreeItem, PlotWindow *pPlotWindow)
 {
-  QList<VariablesTreeItem*> variablesTreeItems = pVariablesTreeItem->getChildren();
-  if (variablesTreeItems.size() == 0) {
-    QModelIndex index = variablesTreeItemIndex(pVariablesTreeItem);
-    OMPlot::PlotCurve *pPlotCurve = 0;
-    foreach (OMPlot::PlotCurve *curve, pPlotWindow->getPlot()->getPlotCurvesList()) {
-      if (curve->getNameStructure().compare(pVariablesTreeItem->getVariableName()) == 0) {
-        pPlotCurve = curve;
-        break;
-      }
-    }
-    setData(index, Qt::Checked, Qt::CheckStateRole);
-    mpVariablesTreeView->getVariablesWidget()->plotVariables(index, pPlotWindow->getCurveWidth(), pPlotWindow->getCurveStyle(), pPlotCurve);
-  } else {
-    for (int i = 0 ; i < variablesTreeItems.size() ; i++) {
-      plotAllVariables(variablesTreeItems[i], pPlotWindow);
+  QModelIndexList indexes;
+  QList<VariablesTreeItem*> variablesTreeItems;
+  variablesTreeItems.append(pVariablesTreeItem);
+  while (!variablesTreeItems.isEmpty()) {
+    VariablesTreeItem *pChildVariablesTreeItem = variablesTreeItems.takeFirst();
+    fetchChildren(pChildVariablesTreeItem);
+    if (pChildVariablesTreeItem->getChildren().isEmpty()) {
+      QModelIndex index = variablesTreeItemIndex(pChildVariablesTreeItem);
+      setData(index, Qt::Checked, Qt::CheckStateRole);
+      indexes.append(index);
+    } else {
+      variablesTreeItems.append(pChildVariablesTreeItem->getChildren());
     }
   }
+  mpVariablesTreeView->getVariablesWidget()->plotVariables(indexes, pPlotWindow->getCurveWidth(), pPlotWindow->getCurveStyle(), pPlotWindow);
 }
 
 /*!
@@ -727,11 +862,11 @@ void VariablesTreeModel::plotAllVariables(VariablesTreeItem *pVariablesTreeItem,
 void VariablesTreeModel::getVariableInformation(ModelicaMatReader *pMatReader, QString variableToFind, QString *value, bool *changeAble,
                                                 QString *unit, QString *displayUnit, QString *description)
 {
-  QHash<QString, QString> hash = mScalarVariablesList.value(variableToFind);
-  if (hash["name"].compare(variableToFind) == 0) {
-    *changeAble = (hash["isValueChangeable"].compare("true") == 0) ? true : false;
+  int index = mInitXmlIndex.findVariable(variableToFind);
+  if (index >= 0) {
+    *changeAble = (mInitXmlIndex.variableAttribute(index, "isValueChangeable").compare("true") == 0) ? true : false;
     if (*changeAble) {
-      *value = hash["start"];
+      *value = mInitXmlIndex.typeAttribute(index, "start");
     } else { /* if the variable is not a tunable parameter then read the final value of the variable. Only mat result files are supported. */
       if ((pMatReader->file != NULL) && strcmp(pMatReader->fileName, "")) {
         *value = "";
@@ -745,9 +880,9 @@ void VariablesTreeModel::getVariableInformation(ModelicaMatReader *pMatReader, Q
         }
       }
     }
-    *unit = hash["unit"];
-    *displayUnit = hash["displayUnit"];
-    *description = hash["description"];
+    *unit = mInitXmlIndex.typeAttribute(index, "unit");
+    *displayUnit = mInitXmlIndex.typeAttribute(index, "displayUnit");
+    *description = mInitXmlIndex.variableAttribute(index, "description");
   }
 }
 
@@ -790,24 +925,9 @@ bool VariableTreeProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &
   if (!filterRegExp().isEmpty()) {
     QModelIndex index = sourceModel()->index(sourceRow, 0, sourceParent);
     if (index.isValid()) {
-      // if any of children matches the filter, then current index matches the filter as well
-      int rows = sourceModel()->rowCount(index);
-      for (int i = 0 ; i < rows ; ++i) {
-        if (filterAcceptsRow(i, index)) {
-          return true;
-        }
-      }
-      // check current index itself
+      // the matching variables and their parents are computed once by VariablesTreeModel::setFilterRegExp
       VariablesTreeItem *pVariablesTreeItem = static_cast<VariablesTreeItem*>(index.internalPointer());
-      if (pVariablesTreeItem) {
-        QString variableName = pVariablesTreeItem->getVariableName();
-        variableName.remove(QRegExp("(\\.mat|\\.plt|\\.csv|_res.mat|_res.plt|_res.csv)"));
-        return variableName.contains(filterRegExp());
-      } else {
-        return sourceModel()->data(index).toString().contains(filterRegExp());
-      }
-      QString key = sourceModel()->data(index, filterRole()).toString();
-      return key.contains(filterRegExp());
+      return static_cast<VariablesTreeModel*>(sourceModel())->isVariableMatching(pVariablesTreeItem->getVariableName());
     }
   }
   return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
@@ -913,8 +1033,6 @@ VariablesWidget::VariablesWidget(QWidget *pParent)
   setLayout(pMainLayout);
   connect(mpTreeSearchFilters->getExpandAllButton(), SIGNAL(clicked()), mpVariablesTreeView, SLOT(expandAll()));
   connect(mpTreeSearchFilters->getCollapseAllButton(), SIGNAL(clicked()), mpVariablesTreeView, SLOT(collapseAll()));
-  connect(mpVariablesTreeModel, SIGNAL(rowsInserted(QModelIndex,int,int)), mpVariableTreeProxyModel, SLOT(invalidate()));
-  connect(mpVariablesTreeModel, SIGNAL(rowsRemoved(QModelIndex,int,int)), mpVariableTreeProxyModel, SLOT(invalidate()));
   connect(mpVariablesTreeModel, SIGNAL(itemChecked(QModelIndex,qreal,int)), SLOT(plotVariables(QModelIndex,qreal,int)));
   connect(mpVariablesTreeModel, SIGNAL(unitChanged(QModelIndex)), SLOT(unitChanged(QModelIndex)));
   connect(mpVariablesTreeView, SIGNAL(customContextMenuRequested(QPoint)), SLOT(showContextMenu(QPoint)));
@@ -1079,13 +1197,12 @@ void VariablesWidget::updateVariablesTreeHelper(QMdiSubWindow *pSubWindow)
 /*!
  * \brief VariablesWidget::readVariablesAndUpdateXML
  * Reads the updated values
- * \sa VariablesWidget::findVariableAndUpdateValue()
+ * \sa InitXmlIndex::updateStartValues()
  * \param pVariablesTreeItem
  * \param outputFileName
- * \param variables
+ * \param variables - the values mapped to the variable names.
  */
-void VariablesWidget::readVariablesAndUpdateXML(VariablesTreeItem *pVariablesTreeItem, QString outputFileName,
-                                                QHash<QString, QHash<QString, QString> > *variables)
+void VariablesWidget::readVariablesAndUpdateXML(VariablesTreeItem *pVariablesTreeItem, QString outputFileName, QHash<QString, QString> *variables)
 {
   for (int i = 0 ; i < pVariablesTreeItem->getChildren().size() ; i++) {
     VariablesTreeItem *pChildVariablesTreeItem = pVariablesTreeItem->child(i);
@@ -1097,48 +1214,12 @@ void VariablesWidget::readVariablesAndUpdateXML(VariablesTreeItem *pVariablesTre
       QString value = pChildVariablesTreeItem->getValue(pChildVariablesTreeItem->getUnit(), MainWindow::instance()->getOMCProxy()).toString();
       QString variableToFind = pChildVariablesTreeItem->getVariableName();
       variableToFind.remove(QRegExp(outputFileName + "."));
-      QHash<QString, QString> hash;
-      hash["name"] = variableToFind;
-      hash["value"] = value;
-      variables->insert(variableToFind, hash);
+      variables->insert(variableToFind, value);
     }
     readVariablesAndUpdateXML(pChildVariablesTreeItem, outputFileName, variables);
   }
 }
 
-/*!
- * \brief VariablesWidget::findVariableAndUpdateValue
- * Writes the updated values in the init xml dom
- * \param xmlDocument
- * \param variables
- */
-void VariablesWidget::findVariableAndUpdateValue(QDomDocument xmlDocument, QHash<QString, QHash<QString, QString> > variables)
-{
-  /* if no variables are changed. */
-  if (variables.empty()) {
-    return;
-  }
-  /* update the variables */
-  int count = 0;
-  QDomNodeList scalarVariable = xmlDocument.elementsByTagName("ScalarVariable");
-  for (int i = 0; i < scalarVariable.size(); i++) {
-    if (count >= variables.size()) {
-      break;
-    }
-    QDomElement element = scalarVariable.at(i).toElement();
-    if (!element.isNull()) {
-      QHash<QString, QString> hash = variables.value(element.attribute("name"));
-      if (element.attribute("name").compare(hash["name"]) == 0) {
-        count++;
-        QDomElement el = scalarVariable.at(i).firstChild().toElement();
-        if (!el.isNull()) {
-          el.setAttribute("start", hash["value"]);
-        }
-      }
-    }
-  }
-}
-
 void VariablesWidget::reSimulate(bool showSetup)
 {
   QModelIndexList indexes = mpVariablesTreeView->selectionModel()->selectedIndexes();
@@ -1166,39 +1247,384 @@ void VariablesWidget::reSimulate(bool showSetup)
   }
 }
 
+/*!
+ * \brief VariablesWidget::updateInitXmlFile
+ * Writes the changed parameter values as start values in the _init.xml file.
+ * \param simulationOptions
+ */
 void VariablesWidget::updateInitXmlFile(SimulationOptions simulationOptions)
 {
+  VariablesTreeItem *pTopVariableTreeItem;
+  pTopVariableTreeItem = mpVariablesTreeModel->findVariablesTreeItem(simulationOptions.getResultFileName(),
+                                                                     mpVariablesTreeModel->getRootVariablesTreeItem());
+  if (!pTopVariableTreeItem) {
+    return;
+  }
+  QHash<QString, QString> variables;
+  readVariablesAndUpdateXML(pTopVariableTreeItem, simulationOptions.getResultFileName(), &variables);
   /* Update the _init.xml file with new values. */
-  /* open the model_init.xml file for writing */
   QString initFileName = QString(simulationOptions.getOutputFileName()).append("_init.xml");
-  QFile initFile(QString(simulationOptions.getWorkingDirectory()).append(QDir::separator()).append(initFileName));
-  QDomDocument initXmlDocument;
-  if (initFile.open(QIODevice::ReadOnly)) {
-    if (initXmlDocument.setContent(&initFile)) {
-      VariablesTreeItem *pTopVariableTreeItem;
-      pTopVariableTreeItem = mpVariablesTreeModel->findVariablesTreeItem(simulationOptions.getResultFileName(),
-                                                                         mpVariablesTreeModel->getRootVariablesTreeItem());
-      if (pTopVariableTreeItem) {
-        QHash<QString, QHash<QString, QString> > variables;
-        readVariablesAndUpdateXML(pTopVariableTreeItem, simulationOptions.getResultFileName(), &variables);
-        findVariableAndUpdateValue(initXmlDocument, variables);
+  QString initFilePath = QString(simulationOptions.getWorkingDirectory()).append(QDir::separator()).append(initFileName);
+  QString errorString;
+  if (!InitXmlIndex::updateStartValues(initFilePath, variables, &errorString)) {
+    MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                          GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(initFilePath)
+                                                          .arg(errorString), Helper::scriptingKind, Helper::errorLevel));
+  }
+}
+
+/*!
+ * \brief convertValues
+ * Applies the affine unit conversion to the values.
+ * Written as a plain loop over contiguous arrays so that the compiler can vectorize it.
+ * \param pValues
+ * \param pConvertedValues
+ * \param size
+ * \param offset
+ * \param scaleFactor
+ * \sa Utilities::convertUnit()
+ */
+static void convertValues(const double *pValues, double *pConvertedValues, int size, double offset, double scaleFactor)
+{
+  for (int i = 0 ; i < size ; i++) {
+    pConvertedValues[i] = (pValues[i] - offset) / scaleFactor;
+  }
+}
+
+/*!
+ * \brief convertPlotCurveValues
+ * Converts the x or y values of the curve.
+ * The values are converted into a new vector which replaces the values of the curve at once.
+ * \param pPlotCurve
+ * \param xAxis
+ * \param convertUnit
+ */
+static void convertPlotCurveValues(PlotCurve *pPlotCurve, bool xAxis, const OMCInterface::convertUnits_res &convertUnit)
+{
+  int size = pPlotCurve->getSize();
+  QVector<double> values(size);
+  if (xAxis) {
+    convertValues(pPlotCurve->getXAxisVector(), values.data(), size, convertUnit.offset, convertUnit.scaleFactor);
+    pPlotCurve->setXAxisVector(values);
+  } else {
+    convertValues(pPlotCurve->getYAxisVector(), values.data(), size, convertUnit.offset, convertUnit.scaleFactor);
+    pPlotCurve->setYAxisVector(values);
+  }
+}
+
+/*!
+ * \brief decimateMinMax
+ * Reduces the curve to at most four points per bucket i.e., the first, the minimum, the maximum and the last point.
+ * The extreme values and the steps are preserved so the decimated curve looks the same at screen resolution.
+ * \param pXValues
+ * \param pYValues
+ * \param size
+ * \param buckets
+ * \param pXDecimatedValues
+ * \param pYDecimatedValues
+ */
+static void decimateMinMax(const double *pXValues, const double *pYValues, int size, int buckets, QVector<double> *pXDecimatedValues,
+                           QVector<double> *pYDecimatedValues)
+{
+  pXDecimatedValues->reserve(buckets * 4);
+  pYDecimatedValues->reserve(buckets * 4);
+  for (int bucket = 0 ; bucket < buckets ; bucket++) {
+    int first = (qint64)size * bucket / buckets;
+    int last = (qint64)size * (bucket + 1) / buckets - 1;
+    if (last < first) {
+      continue;
+    }
+    int minimum = first, maximum = first;
+    for (int i = first + 1 ; i <= last ; i++) {
+      if (pYValues[i] < pYValues[minimum]) {
+        minimum = i;
+      }
+      if (pYValues[i] > pYValues[maximum]) {
+        maximum = i;
+      }
+    }
+    int points[4] = {first, qMin(minimum, maximum), qMax(minimum, maximum), last};
+    int previous = -1;
+    for (int i = 0 ; i < 4 ; i++) {
+      if (points[i] != previous) {
+        pXDecimatedValues->append(pXValues[points[i]]);
+        pYDecimatedValues->append(pYValues[points[i]]);
+        previous = points[i];
+      }
+    }
+  }
+}
+
+/*!
+ * \brief VariablesWidget::getPlotCurveBuckets
+ * Returns the number of buckets the curve is decimated to or 0 if the curve is drawn with all its points.
+ * The buckets are doubled each time the visible time range is halved so zooming in shows the points of the result.
+ * \param pPlotWindow
+ * \param pPlotCurve
+ * \return
+ */
+int VariablesWidget::getPlotCurveBuckets(PlotWindow *pPlotWindow, PlotCurve *pPlotCurve)
+{
+  int size = pPlotCurve->getSize();
+  if (pPlotWindow->getPlotType() != PlotWindow::PLOT || size < 2) {
+    return 0;
+  }
+  // use more buckets than pixels so that the decimated curve looks the same as the complete curve.
+  int buckets = qMax(pPlotWindow->getPlot()->canvas()->width(), 1024) * 2;
+  const QwtScaleMap xScaleMap = pPlotWindow->getPlot()->canvasMap(QwtPlot::xBottom);
+  double visibleWidth = qAbs(xScaleMap.s2() - xScaleMap.s1());
+  double dataWidth = qAbs(pPlotCurve->getXAxisVector()[size - 1] - pPlotCurve->getXAxisVector()[0]);
+  double zoomFactor = (visibleWidth > 0 && visibleWidth < dataWidth) ? dataWidth / visibleWidth : 1;
+  while (zoomFactor > 1 && (qint64)buckets * 4 < size) {
+    buckets *= 2;
+    zoomFactor /= 2;
+  }
+  return (qint64)buckets * 4 < size ? buckets : 0;
+}
+
+/*!
+ * \brief VariablesWidget::setPlotCurveData
+ * Sets the data of the curve that is drawn.
+ * The curves of long results are decimated to the resolution of the plot. The curve keeps its complete data for export and unit conversion.
+ * \param pPlotWindow
+ * \param pPlotCurve
+ */
+void VariablesWidget::setPlotCurveData(PlotWindow *pPlotWindow, PlotCurve *pPlotCurve)
+{
+  setPlotCurveData(pPlotWindow, pPlotCurve, getPlotCurveBuckets(pPlotWindow, pPlotCurve));
+}
+
+/*!
+ * \brief VariablesWidget::setPlotCurveData
+ * Sets the data of the curve decimated to the buckets.
+ * \param pPlotWindow
+ * \param pPlotCurve
+ * \param buckets - 0 sets the complete data.
+ */
+void VariablesWidget::setPlotCurveData(PlotWindow *pPlotWindow, PlotCurve *pPlotCurve, int buckets)
+{
+  if (buckets == 0) {
+    pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
+    if (mDecimatedPlotCurvesData.contains(pPlotWindow)) {
+      mDecimatedPlotCurvesData[pPlotWindow].remove(pPlotCurve);
+    }
+    return;
+  }
+  if (!mDecimatedPlotCurvesData.contains(pPlotWindow)) {
+    // decimate the curves again when the plot is zoomed, panned or resized and forget them with the plot window.
+    connect(pPlotWindow->getPlot()->getPlotZoomer(), SIGNAL(zoomed(QRectF)), SLOT(plotWindowScaleChanged()), Qt::UniqueConnection);
+    connect(pPlotWindow->getPlot()->axisWidget(QwtPlot::xBottom), SIGNAL(scaleDivChanged()), SLOT(plotWindowScaleChanged()),
+            Qt::UniqueConnection);
+    pPlotWindow->getPlot()->canvas()->installEventFilter(this);
+    connect(pPlotWindow, SIGNAL(destroyed(QObject*)), SLOT(plotWindowDestroyed(QObject*)), Qt::UniqueConnection);
+  }
+  // the curve doesn't copy the data so keep it until the curve data is set again.
+  DecimatedPlotCurveData &decimatedPlotCurveData = mDecimatedPlotCurvesData[pPlotWindow][pPlotCurve];
+  decimatedPlotCurveData.mBuckets = buckets;
+  decimatedPlotCurveData.mXValues.clear();
+  decimatedPlotCurveData.mYValues.clear();
+  decimateMinMax(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize(), buckets,
+                 &decimatedPlotCurveData.mXValues, &decimatedPlotCurveData.mYValues);
+  pPlotCurve->setData(decimatedPlotCurveData.mXValues.constData(), decimatedPlotCurveData.mYValues.constData(),
+                      decimatedPlotCurveData.mXValues.size());
+}
+
+/*!
+ * \brief VariablesWidget::eventFilter
+ * Decimates the curves of the plot window again when its canvas is resized.
+ * \param pObject
+ * \param pEvent
+ * \return
+ */
+bool VariablesWidget::eventFilter(QObject *pObject, QEvent *pEvent)
+{
+  if (pEvent->type() == QEvent::Resize) {
+    foreach (PlotWindow *pPlotWindow, mDecimatedPlotCurvesData.keys()) {
+      if (pPlotWindow->getPlot()->canvas() == pObject) {
+        updateDecimatedPlotCurvesLater(pPlotWindow);
+        break;
+      }
+    }
+  }
+  return QWidget::eventFilter(pObject, pEvent);
+}
+
+/*!
+ * \brief VariablesWidget::updateDecimatedPlotCurvesLater
+ * Decimates the curves of the plot window again once the control returns to the event loop.
+ * The signals of the plot are emitted while it is replotted so the curves are not updated right away.
+ * \param pPlotWindow
+ */
+void VariablesWidget::updateDecimatedPlotCurvesLater(PlotWindow *pPlotWindow)
+{
+  if (mPendingDecimatedPlotWindows.isEmpty()) {
+    QTimer::singleShot(0, this, SLOT(updateDecimatedPlotCurves()));
+  }
+  mPendingDecimatedPlotWindows.insert(pPlotWindow);
+}
+
+/*!
+ * \brief VariablesWidget::plotWindowScaleChanged
+ * Slot activated when the plot window is zoomed or its time axis is changed.
+ */
+void VariablesWidget::plotWindowScaleChanged()
+{
+  foreach (PlotWindow *pPlotWindow, mDecimatedPlotCurvesData.keys()) {
+    if (pPlotWindow->getPlot()->getPlotZoomer() == sender() || pPlotWindow->getPlot()->axisWidget(QwtPlot::xBottom) == sender()) {
+      updateDecimatedPlotCurvesLater(pPlotWindow);
+      break;
+    }
+  }
+}
+
+/*!
+ * \brief VariablesWidget::plotWindowDestroyed
+ * Removes the decimated data of the curves of the destroyed plot window.
+ * \param pObject
+ */
+void VariablesWidget::plotWindowDestroyed(QObject *pObject)
+{
+  // only the address is used since the plot window is already destroyed.
+  PlotWindow *pPlotWindow = static_cast<PlotWindow*>(pObject);
+  mDecimatedPlotCurvesData.remove(pPlotWindow);
+  mPendingDecimatedPlotWindows.remove(pPlotWindow);
+}
+
+/*!
+ * \brief VariablesWidget::updateDecimatedPlotCurves
+ * Decimates the curves of the pending plot windows to their current resolution.
+ * Removes the decimated data of the curves that are not plotted anymore.
+ */
+void VariablesWidget::updateDecimatedPlotCurves()
+{
+  foreach (PlotWindow *pPlotWindow, mPendingDecimatedPlotWindows) {
+    QHash<PlotCurve*, DecimatedPlotCurveData> &decimatedPlotCurvesData = mDecimatedPlotCurvesData[pPlotWindow];
+    QList<PlotCurve*> plotCurves = pPlotWindow->getPlot()->getPlotCurvesList();
+    foreach (PlotCurve *pPlotCurve, decimatedPlotCurvesData.keys()) {
+      if (!plotCurves.contains(pPlotCurve)) {
+        decimatedPlotCurvesData.remove(pPlotCurve);
       }
+    }
+    bool replot = false;
+    foreach (PlotCurve *pPlotCurve, plotCurves) {
+      int buckets = getPlotCurveBuckets(pPlotWindow, pPlotCurve);
+      int currentBuckets = decimatedPlotCurvesData.contains(pPlotCurve) ? decimatedPlotCurvesData[pPlotCurve].mBuckets : 0;
+      if (buckets != currentBuckets) {
+        setPlotCurveData(pPlotWindow, pPlotCurve, buckets);
+        replot = true;
+      }
+    }
+    if (replot) {
+      pPlotWindow->getPlot()->replot();
+    }
+  }
+  mPendingDecimatedPlotWindows.clear();
+}
+
+/*!
+ * \brief VariablesWidget::plotVariables
+ * Plots the variables in one batch.
+ * The variables are grouped by result file and unit so that each group is read with a single PlotWindow::plot call.
+ * The units are converted once per group and the plot is updated once at the end.
+ * \param indexes
+ * \param curveThickness
+ * \param curveStyle
+ * \param pPlotWindow
+ */
+void VariablesWidget::plotVariables(const QModelIndexList &indexes, qreal curveThickness, int curveStyle, PlotWindow *pPlotWindow)
+{
+  QHash<QString, PlotCurve*> plotCurves;
+  foreach (PlotCurve *pPlotCurve, pPlotWindow->getPlot()->getPlotCurvesList()) {
+    plotCurves.insert(pPlotCurve->getNameStructure(), pPlotCurve);
+  }
+  QStringList groups;
+  QHash<QString, QList<VariablesTreeItem*> > variablesTreeItemsGroups;
+  foreach (QModelIndex index, indexes) {
+    VariablesTreeItem *pVariablesTreeItem = static_cast<VariablesTreeItem*>(index.internalPointer());
+    if (!pVariablesTreeItem || !pVariablesTreeItem->isChecked()) {
+      continue;
+    }
+    // parametric plots and the curves that are already plotted are updated one by one.
+    if (pPlotWindow->getPlotType() != PlotWindow::PLOT || plotCurves.contains(pVariablesTreeItem->getVariableName())) {
+      plotVariables(index, curveThickness, curveStyle, plotCurves.value(pVariablesTreeItem->getVariableName(), 0), pPlotWindow);
+      continue;
+    }
+    QString group = QString("%1/%2\n%3\n%4").arg(pVariablesTreeItem->getFilePath()).arg(pVariablesTreeItem->getFileName())
+        .arg(pVariablesTreeItem->getUnit()).arg(pVariablesTreeItem->getDisplayUnit());
+    if (!variablesTreeItemsGroups.contains(group)) {
+      groups.append(group);
+    }
+    variablesTreeItemsGroups[group].append(pVariablesTreeItem);
+  }
+  if (groups.isEmpty()) {
+    return;
+  }
+  try {
+    OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
+    OMCInterface::convertUnits_res timeConvertUnit;
+    bool convertTime = false;
+    if (pPlotWindow->getTimeUnit().compare("s") != 0) {
+      timeConvertUnit = pOMCProxy->convertUnits("s", pPlotWindow->getTimeUnit());
+      convertTime = timeConvertUnit.unitsCompatible;
+    }
+    foreach (QString group, groups) {
+      QList<VariablesTreeItem*> variablesTreeItems = variablesTreeItemsGroups.value(group);
+      VariablesTreeItem *pFirstVariablesTreeItem = variablesTreeItems.first();
+      QStringList variables;
+      foreach (VariablesTreeItem *pVariablesTreeItem, variablesTreeItems) {
+        variables.append(pVariablesTreeItem->getPlotVariable());
+      }
+      pPlotWindow->initializeFile(QString(pFirstVariablesTreeItem->getFilePath()).append("/").append(pFirstVariablesTreeItem->getFileName()));
+      pPlotWindow->setCurveWidth(curveThickness);
+      pPlotWindow->setCurveStyle(curveStyle);
+      pPlotWindow->setVariablesList(variables);
+      pPlotWindow->setUnit(pFirstVariablesTreeItem->getUnit());
+      pPlotWindow->setDisplayUnit(pFirstVariablesTreeItem->getDisplayUnit());
+      pPlotWindow->plot(0);
+      plotCurves.clear();
+      foreach (PlotCurve *pPlotCurve, pPlotWindow->getPlot()->getPlotCurvesList()) {
+        plotCurves.insert(pPlotCurve->getNameStructure(), pPlotCurve);
+      }
+      bool convertDisplayUnit = pFirstVariablesTreeItem->getUnit().compare(pFirstVariablesTreeItem->getDisplayUnit()) != 0;
+      OMCInterface::convertUnits_res convertUnit;
+      if (convertDisplayUnit) {
+        convertUnit = pOMCProxy->convertUnits(pFirstVariablesTreeItem->getUnit(), pFirstVariablesTreeItem->getDisplayUnit());
+      }
+      foreach (VariablesTreeItem *pVariablesTreeItem, variablesTreeItems) {
+        PlotCurve *pPlotCurve = plotCurves.value(pVariablesTreeItem->getVariableName(), 0);
+        if (!pPlotCurve) {
+          continue;
+        }
+        /* Ticket:2250
+         * Update the value of Variables Browser display unit according to the display unit of already plotted curve.
+         */
+        pVariablesTreeItem->setData(3, pPlotCurve->getDisplayUnit(), Qt::EditRole);
+        QString value = pVariablesTreeItem->getValue(pVariablesTreeItem->getDisplayUnit(), pOMCProxy).toString();
+        pVariablesTreeItem->setData(1, value, Qt::EditRole);
+        if (convertDisplayUnit) {
+          if (convertUnit.unitsCompatible) {
+            convertPlotCurveValues(pPlotCurve, false, convertUnit);
+          } else {
+            pPlotCurve->setDisplayUnit(pVariablesTreeItem->getUnit());
+          }
+          pPlotCurve->setTitleLocal();
+        }
+        if (convertTime) {
+          convertPlotCurveValues(pPlotCurve, true, timeConvertUnit);
+        }
+        setPlotCurveData(pPlotWindow, pPlotCurve);
+      }
+    }
+    if (pPlotWindow->getAutoScaleButton()->isChecked()) {
+      pPlotWindow->fitInView();
     } else {
-      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                            tr("Unable to set the content of QDomDocument from file %1")
-                                                            .arg(initFile.fileName()), Helper::scriptingKind, Helper::errorLevel));
+      pPlotWindow->getPlot()->replot();
+      if (pPlotWindow->getPlot()->getPlotZoomer()->zoomStack().size() == 1) {
+        pPlotWindow->getPlot()->getPlotZoomer()->setZoomBase(false);
+      }
     }
-    initFile.close();
-    initFile.open(QIODevice::WriteOnly | QIODevice::Truncate);
-    QTextStream textStream(&initFile);
-    textStream.setCodec(Helper::utf8.toStdString().data());
-    textStream.setGenerateByteOrderMark(false);
-    textStream << initXmlDocument.toString();
-    initFile.close();
-  } else {
-    MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                          GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(initFile.fileName())
-                                                          .arg(initFile.errorString()), Helper::scriptingKind, Helper::errorLevel));
+  } catch (PlotException &e) {
+    QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::error), e.what(), Helper::ok);
   }
 }
 
@@ -1257,11 +1683,7 @@ void VariablesWidget::plotVariables(const QModelIndex &index, qreal curveThickne
           OMCInterface::convertUnits_res convertUnit = MainWindow::instance()->getOMCProxy()->convertUnits(pVariablesTreeItem->getUnit(),
                                                                                                  pVariablesTreeItem->getDisplayUnit());
           if (convertUnit.unitsCompatible) {
-            for (int i = 0 ; i < pPlotCurve->getYAxisData().size() ; i++) {
-              pPlotCurve->updateYAxisValue(i, Utilities::convertUnit(pPlotCurve->getYAxisData().at(i), convertUnit.offset, convertUnit.scaleFactor));
-            }
-            pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
-            pPlotWindow->getPlot()->replot();
+            convertPlotCurveValues(pPlotCurve, false, convertUnit);
           } else {
             pPlotCurve->setDisplayUnit(pVariablesTreeItem->getUnit());
           }
@@ -1271,13 +1693,10 @@ void VariablesWidget::plotVariables(const QModelIndex &index, qreal curveThickne
         if (pPlotWindow->getTimeUnit().compare("s") != 0) {
           OMCInterface::convertUnits_res convertUnit = MainWindow::instance()->getOMCProxy()->convertUnits("s", pPlotWindow->getTimeUnit());
           if (convertUnit.unitsCompatible) {
-            for (int i = 0 ; i < pPlotCurve->getXAxisData().size() ; i++) {
-              pPlotCurve->updateXAxisValue(i, Utilities::convertUnit(pPlotCurve->getXAxisData().at(i), convertUnit.offset, convertUnit.scaleFactor));
-            }
-            pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
-            pPlotWindow->getPlot()->replot();
+            convertPlotCurveValues(pPlotCurve, true, convertUnit);
           }
         }
+        setPlotCurveData(pPlotWindow, pPlotCurve);
         if (pPlotWindow->getAutoScaleButton()->isChecked()) {
           pPlotWindow->fitInView();
         } else {
@@ -1292,6 +1711,9 @@ void VariablesWidget::plotVariables(const QModelIndex &index, qreal curveThickne
           if (curveTitle.compare(pVariablesTreeItem->getVariableName()) == 0) {
             pPlotWindow->getPlot()->removeCurve(pPlotCurve);
             pPlotCurve->detach();
+            if (mDecimatedPlotCurvesData.contains(pPlotWindow)) {
+              mDecimatedPlotCurvesData[pPlotWindow].remove(pPlotCurve);
+            }
             if (pPlotWindow->getAutoScaleButton()->isChecked()) {
               pPlotWindow->fitInView();
             } else {
@@ -1466,10 +1888,8 @@ void VariablesWidget::unitChanged(const QModelIndex &index)
       foreach (PlotCurve *pPlotCurve, pPlotWindow->getPlot()->getPlotCurvesList()) {
         QString curveTitle = pPlotCurve->getNameStructure();
         if (curveTitle.compare(pVariablesTreeItem->getVariableName()) == 0) {
-          for (int i = 0 ; i < pPlotCurve->getYAxisData().size() ; i++) {
-            pPlotCurve->updateYAxisValue(i, Utilities::convertUnit(pPlotCurve->getYAxisData().at(i), convertUnit.offset, convertUnit.scaleFactor));
-          }
-          pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
+          convertPlotCurveValues(pPlotCurve, false, convertUnit);
+          setPlotCurveData(pPlotWindow, pPlotCurve);
           pPlotCurve->setDisplayUnit(pVariablesTreeItem->getDisplayUnit());
           pPlotCurve->setTitleLocal();
           pPlotWindow->getPlot()->replot();
@@ -1499,10 +1919,8 @@ void VariablesWidget::timeUnitChanged(QString unit)
     OMCInterface::convertUnits_res convertUnit = MainWindow::instance()->getOMCProxy()->convertUnits(pPlotWindow->getTimeUnit(), unit);
     if (convertUnit.unitsCompatible) {
       foreach (PlotCurve *pPlotCurve, pPlotWindow->getPlot()->getPlotCurvesList()) {
-        for (int i = 0 ; i < pPlotCurve->getXAxisData().size() ; i++) {
-          pPlotCurve->updateXAxisValue(i, Utilities::convertUnit(pPlotCurve->getXAxisData().at(i), convertUnit.offset, convertUnit.scaleFactor));
-        }
-        pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
+        convertPlotCurveValues(pPlotCurve, true, convertUnit);
+        setPlotCurveData(pPlotWindow, pPlotCurve);
       }
       pPlotWindow->setXLabel(QString("time [%1]").arg(unit));
       pPlotWindow->setTimeUnit(unit);
@@ -1567,6 +1985,7 @@ void VariablesWidget::findVariables()
   QRegExp::PatternSyntax syntax = QRegExp::PatternSyntax(mpTreeSearchFilters->getSyntaxComboBox()->itemData(mpTreeSearchFilters->getSyntaxComboBox()->currentIndex()).toInt());
   Qt::CaseSensitivity caseSensitivity = mpTreeSearchFilters->getCaseSensitiveCheckBox()->isChecked() ? Qt::CaseSensitive: Qt::CaseInsensitive;
   QRegExp regExp(findText, caseSensitivity, syntax);
+  mpVariablesTreeModel->setFilterRegExp(regExp);
   mpVariableTreeProxyModel->setFilterRegExp(regExp);
   /* expand all so that the filtered items can be seen. */
   if (!findText.isEmpty()) {
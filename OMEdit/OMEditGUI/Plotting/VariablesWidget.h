@@ -36,11 +36,14 @@
 #define VARIABLESWIDGET_H
 
 #include <QDomDocument>
+#include <QSet>
 
 #include "Simulation/SimulationOptions.h"
+#include "Simulation/InitXmlIndex.h"
+#include "OMC/OMCProxy.h"
+#include "util/read_matlab4.h"
 #include "PlotWindow.h"
 
-class OMCProxy;
 class TreeSearchFilters;
 class Label;
 
@@ -64,6 +67,9 @@ public:
   void setChecked(bool set) {mChecked = set;}
   bool isEditable() const {return mEditable;}
   void setEditable(bool set) {mEditable = set;}
+  bool hasPendingChildren() const {return mHasPendingChildren;}
+  void setHasPendingChildren(bool hasPendingChildren) {mHasPendingChildren = hasPendingChildren;}
+  bool isLeaf() const {return mChildren.isEmpty() && !mHasPendingChildren;}
   SimulationOptions getSimulationOptions() {return mSimulationOptions;}
   void setSimulationOptions(SimulationOptions simulationOptions) {mSimulationOptions = simulationOptions;}
   QIcon getVariableTreeItemIcon(QString name) const;
@@ -97,6 +103,7 @@ private:
   QString mToolTip;
   bool mChecked;
   bool mEditable;
+  bool mHasPendingChildren;
   SimulationOptions mSimulationOptions;
 };
 
@@ -106,21 +113,23 @@ class VariablesTreeModel : public QAbstractItemModel
   Q_OBJECT
 public:
   VariablesTreeModel(VariablesTreeView *pVariablesTreeView = 0);
+  ~VariablesTreeModel();
   VariablesTreeItem* getRootVariablesTreeItem() {return mpRootVariablesTreeItem;}
   int columnCount(const QModelIndex &parent = QModelIndex()) const;
   int rowCount(const QModelIndex &parent = QModelIndex()) const;
+  bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+  bool canFetchMore(const QModelIndex &parent) const;
+  void fetchMore(const QModelIndex &parent);
   QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
   QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
   QModelIndex parent(const QModelIndex & index) const;
   bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole);
   QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
   Qt::ItemFlags flags(const QModelIndex &index) const;
-  VariablesTreeItem* findVariablesTreeItem(const QString &name, VariablesTreeItem *root) const;
+  VariablesTreeItem* findVariablesTreeItem(const QString &name, VariablesTreeItem *root);
   QModelIndex variablesTreeItemIndex(const VariablesTreeItem *pVariablesTreeItem) const;
-  QModelIndex variablesTreeItemIndexHelper(const VariablesTreeItem *pVariablesTreeItem, const VariablesTreeItem *pParentVariablesTreeItem,
-                                           const QModelIndex &parentIndex) const;
-  void parseInitXml(QXmlStreamReader &xmlReader);
-  QHash<QString, QString> parseScalarVariable(QXmlStreamReader &xmlReader);
+  void setFilterRegExp(const QRegExp &regExp);
+  bool isVariableMatching(const QString &variableName) const {return mMatchingVariables.contains(variableName);}
   void insertVariablesItems(QString fileName, QString filePath, QStringList variablesList, SimulationOptions simulationOptions);
   bool removeVariableTreeItem(QString variable);
   void unCheckVariables(VariablesTreeItem *pVariablesTreeItem);
@@ -128,7 +137,25 @@ public:
 private:
   VariablesTreeView *mpVariablesTreeView;
   VariablesTreeItem *mpRootVariablesTreeItem;
-  QHash<QString, QHash<QString,QString> > mScalarVariablesList;
+  InitXmlIndex mInitXmlIndex;
+  typedef struct {
+    QString mVariableName;
+    QString mDisplayVariableName;
+  } PendingVariablesTreeItem;
+  QHash<QString, VariablesTreeItem*> mVariablesTreeItemsHash;
+  // the parent names of all the variables and the children not created yet, keyed by the variable names
+  QHash<QString, QString> mVariableParentsHash;
+  QHash<QString, QList<PendingVariablesTreeItem> > mPendingChildrenHash;
+  QRegExp mFilterRegExp;
+  QSet<QString> mMatchingVariables;
+  QString mOpenResultFile;
+  ModelicaMatReader mMatReader;
+  QHash<QString, OMCInterface::convertUnits_res> mConvertUnitsCache;
+  void fetchChildren(VariablesTreeItem *pParentVariablesTreeItem);
+  void openResultFile(VariablesTreeItem *pTopVariablesTreeItem, bool showErrors);
+  void addMatchingVariable(QString variableName);
+  void removePendingChildren(const QString &variableName);
+  void removeVariablesTreeItemsFromHash(VariablesTreeItem *pVariablesTreeItem);
   void getVariableInformation(ModelicaMatReader *pMatReader, QString variableToFind, QString *value, bool *changeAble, QString *unit,
                               QString *displayUnit, QString *description);
 signals:
@@ -137,6 +164,8 @@ signals:
   void variableTreeItemRemoved(QString variable);
 public slots:
   void removeVariableTreeItem();
+private slots:
+  void closeResultFile();
 };
 
 class VariableTreeProxyModel : public QSortFilterProxyModel
@@ -174,11 +203,13 @@ public:
   void insertVariablesItemsToTree(QString fileName, QString filePath, QStringList variablesList, SimulationOptions simulationOptions);
   void variablesUpdated();
   void updateVariablesTreeHelper(QMdiSubWindow *pSubWindow);
-  void readVariablesAndUpdateXML(VariablesTreeItem *pVariablesTreeItem, QString outputFileName,
-                                 QHash<QString, QHash<QString, QString> > *variables);
-  void findVariableAndUpdateValue(QDomDocument xmlDocument, QHash<QString, QHash<QString, QString> > variables);
+  void readVariablesAndUpdateXML(VariablesTreeItem *pVariablesTreeItem, QString outputFileName, QHash<QString, QString> *variables);
   void reSimulate(bool showSetup);
   void updateInitXmlFile(SimulationOptions simulationOptions);
+  void plotVariables(const QModelIndexList &indexes, qreal curveThickness, int curveStyle, OMPlot::PlotWindow *pPlotWindow);
+  void setPlotCurveData(OMPlot::PlotWindow *pPlotWindow, OMPlot::PlotCurve *pPlotCurve);
+protected:
+  virtual bool eventFilter(QObject *pObject, QEvent *pEvent);
 private:
   TreeSearchFilters *mpTreeSearchFilters;
   Label *mpSimulationTimeLabel;
@@ -189,6 +220,17 @@ private:
   QList<QStringList> mPlotParametricVariables;
   QString mFileName;
   QMdiSubWindow *mpLastActiveSubWindow;
+  typedef struct {
+    int mBuckets;
+    QVector<double> mXValues;
+    QVector<double> mYValues;
+  } DecimatedPlotCurveData;
+  // the decimated data of the curves keyed by their plot windows so that it is removed with the plot windows.
+  QHash<OMPlot::PlotWindow*, QHash<OMPlot::PlotCurve*, DecimatedPlotCurveData> > mDecimatedPlotCurvesData;
+  QSet<OMPlot::PlotWindow*> mPendingDecimatedPlotWindows;
+  int getPlotCurveBuckets(OMPlot::PlotWindow *pPlotWindow, OMPlot::PlotCurve *pPlotCurve);
+  void setPlotCurveData(OMPlot::PlotWindow *pPlotWindow, OMPlot::PlotCurve *pPlotCurve, int buckets);
+  void updateDecimatedPlotCurvesLater(OMPlot::PlotWindow *pPlotWindow);
 public slots:
   void plotVariables(const QModelIndex &index, qreal curveThickness, int curveStyle, OMPlot::PlotCurve *pPlotCurve = 0,
                      OMPlot::PlotWindow *pPlotWindow = 0);
@@ -199,6 +241,10 @@ public slots:
   void findVariables();
   void directReSimulate();
   void showReSimulateSetup();
+private slots:
+  void plotWindowScaleChanged();
+  void plotWindowDestroyed(QObject *pObject);
+  void updateDecimatedPlotCurves();
 };
 
 #endif // VARIABLESWIDGET_H
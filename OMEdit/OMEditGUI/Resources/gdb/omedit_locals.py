@@ -0,0 +1,145 @@
+# This file is part of OpenModelica.
+#
+# Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+# c/o Linkopings universitet, Department of Computer and Information Science,
+# SE-58183 Linkoping, Sweden.
+#
+# All rights reserved.
+#
+# THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+# THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+# ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+# OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+#
+# See the full OSMC Public License conditions for more details.
+#
+# Batched retrieval of MetaModelica values for the OMEdit Locals Browser.
+# GDBAdapter sources this file when GDB starts. Each function evaluates the same runtime helpers that the
+# single value commands of CommandFactory use i.e., getTypeOfAny, anyString, mmc_gdb_arrayLength, listLength,
+# isOptionNone and getMetaTypeElement, but for a whole list of variables in one GDB command.
+# The result is written to the console stream as a GDB/MI list,
+#   omc_locals=[{name="..",displayName="..",type="..",modelicaType="..",value="..",size="..",children=[..]},..]
+# size is the result of the children size helper and children is only there if the children were retrieved.
+
+import re
+import gdb
+
+# CommandFactory::metaType
+OMEDIT_RECORD_METATYPE = 0
+OMEDIT_LIST_METATYPE = 1
+OMEDIT_OPTION_METATYPE = 2
+OMEDIT_TUPLE_METATYPE = 3
+OMEDIT_ARRAY_METATYPE = 4
+# Children of larger values are only retrieved when the value is expanded.
+OMEDIT_PREFETCH_LIMIT = 100
+
+omedit_element_re = re.compile(r'(\w+)="((?:[^"\\]|\\.)*)"')
+
+
+def omedit_quote(value):
+  value = value.replace('\\', '\\\\').replace('"', '\\"')
+  return '"' + value.replace('\n', '\\n').replace('\r', '\\r').replace('\t', '\\t') + '"'
+
+
+def omedit_string(expression):
+  return gdb.parse_and_eval(expression).string()
+
+
+def omedit_int(expression):
+  return int(gdb.parse_and_eval(expression))
+
+
+def omedit_modelica_type(name, type, inRecord):
+  if type in ('modelica_metatype', 'modelica_string', 'replaceable type Any', '', 'value has been optimized out'):
+    return omedit_string('(char*)getTypeOfAny(%s, %d)' % (name, 1 if inRecord else 0))
+  return {'modelica_boolean': 'Boolean', 'modelica_integer': 'Integer', 'modelica_real': 'Real'}.get(type, type)
+
+
+# LocalsTreeItem::retrieveValue
+def omedit_value(name, modelicaType):
+  if modelicaType in ('Boolean', 'Integer', 'Real'):
+    return str(gdb.parse_and_eval(name))
+  elif modelicaType == 'String':
+    return omedit_string('(char*)anyString(%s)' % name)
+  return modelicaType
+
+
+# ModelicaValue::retrieveChildrenSize
+def omedit_children_size(name, modelicaType):
+  if modelicaType.startswith('record'):
+    return omedit_int('(int)mmc_gdb_arrayLength(%s)' % name)
+  elif modelicaType.startswith('list'):
+    return omedit_int('(int)listLength(%s)' % name)
+  elif modelicaType.startswith('Option'):
+    return omedit_int('(int)isOptionNone(%s)' % name)
+  elif modelicaType.startswith('tuple') or modelicaType.startswith('Array'):
+    return omedit_int('(int)mmc_gdb_arrayLength(%s)' % name)
+  return None
+
+
+# ModelicaValue::retrieveChildren
+def omedit_children_indexes(modelicaType, size):
+  if modelicaType.startswith('record'):
+    return OMEDIT_RECORD_METATYPE, range(2, size + 1)
+  elif modelicaType.startswith('list'):
+    return OMEDIT_LIST_METATYPE, range(1, size + 1)
+  elif modelicaType.startswith('Option'):
+    return OMEDIT_OPTION_METATYPE, range(1, 2) if size != 1 else []
+  elif modelicaType.startswith('tuple'):
+    return OMEDIT_TUPLE_METATYPE, range(1, size + 1)
+  elif modelicaType.startswith('Array'):
+    return OMEDIT_ARRAY_METATYPE, range(1, size + 1)
+  return None, []
+
+
+def omedit_children(name, modelicaType, size, depth):
+  metaType, indexes = omedit_children_indexes(modelicaType, size)
+  inRecord = metaType == OMEDIT_RECORD_METATYPE
+  children = []
+  for index in indexes:
+    element = omedit_string('(char*)getMetaTypeElement(%s, %d, %d)' % (name, index, metaType))
+    fields = dict((key, re.sub(r'\\(.)', r'\1', value)) for key, value in omedit_element_re.findall(element))
+    children.append(omedit_local(fields.get('name', ''), fields.get('displayName', ''), fields.get('type', ''), inRecord, depth))
+  return children
+
+
+def omedit_local(name, displayName, type, inRecord, depth, prefetchLimit=OMEDIT_PREFETCH_LIMIT):
+  fields = [('name', name), ('displayName', displayName), ('type', type)]
+  children = None
+  try:
+    modelicaType = omedit_modelica_type(name, type, inRecord)
+  except gdb.error as e:
+    # e.g., value has been optimized out. Shown as the type like getTypeOfAnyCB does.
+    return '{' + ','.join('%s=%s' % (key, omedit_quote(value)) for key, value in fields + [('modelicaType', str(e))]) + '}'
+  fields.append(('modelicaType', modelicaType))
+  try:
+    fields.append(('value', omedit_value(name, modelicaType)))
+    size = omedit_children_size(name, modelicaType)
+    if size is not None:
+      fields.append(('size', str(size)))
+      if depth > 0 and (prefetchLimit is None or size <= prefetchLimit):
+        children = omedit_children(name, modelicaType, size, depth - 1)
+  except gdb.error:
+    pass
+  local = ','.join('%s=%s' % (key, omedit_quote(value)) for key, value in fields)
+  if children is not None:
+    local += ',children=[' + ','.join(children) + ']'
+  return '{' + local + '}'
+
+
+def omedit_write(locals):
+  gdb.write('omc_locals=[' + ','.join(locals) + ']\n')
+
+
+# CommandFactory::retrieveLocals
+def omedit_locals(locals, depth):
+  omedit_write([omedit_local(name, displayName, type, False, depth) for name, displayName, type in locals])
+
+
+# CommandFactory::retrieveLocalChildren
+def omedit_local_children(name, modelicaType, depth):
+  try:
+    children = omedit_children(name, modelicaType, omedit_children_size(name, modelicaType), depth)
+  except gdb.error:
+    children = []
+  omedit_write(children)
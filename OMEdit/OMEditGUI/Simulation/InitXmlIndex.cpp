@@ -0,0 +1,458 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+
+#include "InitXmlIndex.h"
+
+#include <QObject>
+#include <QtAlgorithms>
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 1, 0))
+#include <QSaveFile>
+#endif
+
+#include <climits>
+
+/*!
+ * \class InitXmlIndex
+ * \brief An index of the ScalarVariable elements of the model _init.xml file.
+ */
+InitXmlIndex::InitXmlIndex()
+  : mpData(0), mSize(0)
+{
+}
+
+InitXmlIndex::~InitXmlIndex()
+{
+  close();
+}
+
+/*!
+ * \brief InitXmlIndex::open
+ * Maps the file into memory and indexes the ScalarVariable elements.
+ * Falls back to reading the file if it can't be mapped.
+ * \param fileName
+ * \return
+ */
+bool InitXmlIndex::open(const QString &fileName)
+{
+  close();
+  mFile.setFileName(fileName);
+  if (!mFile.open(QIODevice::ReadOnly)) {
+    mErrorString = mFile.errorString();
+    return false;
+  }
+  if (mFile.size() > INT_MAX) {
+    mErrorString = QObject::tr("The file is too large.");
+    mFile.close();
+    return false;
+  }
+  mSize = mFile.size();
+  uchar *pData = mSize > 0 ? mFile.map(0, mSize) : 0;
+  if (pData) {
+    mpData = reinterpret_cast<const char*>(pData);
+  } else {
+    mBuffer = mFile.readAll();
+    mSize = mBuffer.size();
+    mpData = mBuffer.constData();
+  }
+  buildIndex();
+  return true;
+}
+
+/*!
+ * \brief InitXmlIndex::close
+ * Releases the mapped file and clears the index.
+ */
+void InitXmlIndex::close()
+{
+  if (mFile.isOpen()) {
+    if (mpData && mpData != mBuffer.constData()) {
+      mFile.unmap(reinterpret_cast<uchar*>(const_cast<char*>(mpData)));
+    }
+    mFile.close();
+  }
+  mBuffer.clear();
+  mpData = 0;
+  mSize = 0;
+  mScalarVariables.clear();
+  mScalarVariablesHash.clear();
+}
+
+/*!
+ * \brief InitXmlIndex::variableAttribute
+ * Returns the attribute of the ScalarVariable element e.g., name, description, isValueChangeable.
+ * \param index
+ * \param attribute
+ * \return
+ */
+QString InitXmlIndex::variableAttribute(int index, const QByteArray &attribute) const
+{
+  if (index < 0 || index >= mScalarVariables.size()) {
+    return "";
+  }
+  const ScalarVariable &scalarVariable = mScalarVariables.at(index);
+  return this->attribute(scalarVariable.mOffset, scalarVariable.mLength, attribute);
+}
+
+/*!
+ * \brief InitXmlIndex::typeAttribute
+ * Returns the attribute of the type element i.e., Real, Integer, Boolean etc. of the ScalarVariable e.g., start, unit, displayUnit.
+ * \param index
+ * \param attribute
+ * \return
+ */
+QString InitXmlIndex::typeAttribute(int index, const QByteArray &attribute) const
+{
+  if (index < 0 || index >= mScalarVariables.size() || mScalarVariables.at(index).mTypeOffset < 0) {
+    return "";
+  }
+  const ScalarVariable &scalarVariable = mScalarVariables.at(index);
+  return this->attribute(scalarVariable.mTypeOffset, scalarVariable.mTypeLength, attribute);
+}
+
+typedef struct {
+  int mOffset;
+  int mLength;
+  QByteArray mText;
+} InitXmlPatch;
+
+static bool initXmlPatchLessThan(const InitXmlPatch &patch1, const InitXmlPatch &patch2)
+{
+  return patch1.mOffset < patch2.mOffset;
+}
+
+/*!
+ * \brief InitXmlIndex::updateStartValues
+ * Sets the start attribute of the variables.
+ * Only the changed start attributes are rewritten, the rest of the file is copied as it is.
+ * The file is left untouched if none of the values are changed.
+ * \param fileName
+ * \param startValues - the start values mapped to the variable names.
+ * \param pErrorString
+ * \return
+ */
+bool InitXmlIndex::updateStartValues(const QString &fileName, const QHash<QString, QString> &startValues, QString *pErrorString)
+{
+  if (startValues.isEmpty()) {
+    return true;
+  }
+  InitXmlIndex initXmlIndex;
+  if (!initXmlIndex.open(fileName)) {
+    *pErrorString = initXmlIndex.errorString();
+    return false;
+  }
+  QList<InitXmlPatch> patches;
+  QHash<QString, QString>::const_iterator it;
+  for (it = startValues.constBegin() ; it != startValues.constEnd() ; ++it) {
+    int index = initXmlIndex.findVariable(it.key());
+    if (index < 0 || initXmlIndex.mScalarVariables.at(index).mTypeOffset < 0) {
+      continue;
+    }
+    const ScalarVariable &scalarVariable = initXmlIndex.mScalarVariables.at(index);
+    InitXmlPatch patch;
+    int valueOffset, valueLength;
+    if (initXmlIndex.findAttribute(scalarVariable.mTypeOffset, scalarVariable.mTypeLength, "start", &valueOffset, &valueLength)) {
+      if (decode(initXmlIndex.mpData + valueOffset, valueLength).compare(it.value()) == 0) {
+        continue;
+      }
+      patch.mOffset = valueOffset;
+      patch.mLength = valueLength;
+      patch.mText = encode(it.value());
+    } else {
+      // add the start attribute before > or />
+      patch.mOffset = scalarVariable.mTypeOffset + scalarVariable.mTypeLength - 1;
+      if (initXmlIndex.mpData[patch.mOffset - 1] == '/') {
+        patch.mOffset--;
+      }
+      patch.mLength = 0;
+      patch.mText = " start=\"" + encode(it.value()) + "\"";
+    }
+    patches.append(patch);
+  }
+  if (patches.isEmpty()) {
+    return true;
+  }
+  qSort(patches.begin(), patches.end(), initXmlPatchLessThan);
+  // write the patched file next to the original file and then replace it.
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 1, 0))
+  QSaveFile temporaryFile(fileName);
+#else
+  QFile temporaryFile(fileName + ".tmp");
+#endif
+  if (!temporaryFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    *pErrorString = temporaryFile.errorString();
+    return false;
+  }
+  int offset = 0;
+  bool success = true;
+  foreach (const InitXmlPatch &patch, patches) {
+    success = success && temporaryFile.write(initXmlIndex.mpData + offset, patch.mOffset - offset) == patch.mOffset - offset;
+    success = success && temporaryFile.write(patch.mText) == patch.mText.size();
+    offset = patch.mOffset + patch.mLength;
+  }
+  success = success && temporaryFile.write(initXmlIndex.mpData + offset, initXmlIndex.mSize - offset) == initXmlIndex.mSize - offset;
+  // unmap the original file before it is replaced
+  initXmlIndex.close();
+  if (!success) {
+    *pErrorString = temporaryFile.errorString();
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 1, 0))
+    temporaryFile.cancelWriting();
+#else
+    temporaryFile.close();
+    temporaryFile.remove();
+#endif
+    return false;
+  }
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 1, 0))
+  // replaces the original file with the temporary file in one step so the file is never missing.
+  if (!temporaryFile.commit()) {
+    *pErrorString = temporaryFile.errorString();
+    return false;
+  }
+#else
+  temporaryFile.close();
+  QFile::remove(fileName);
+  if (!temporaryFile.rename(fileName)) {
+    *pErrorString = temporaryFile.errorString();
+    return false;
+  }
+#endif
+  return true;
+}
+
+/*!
+ * \brief InitXmlIndex::buildIndex
+ * Stores the offsets of the ScalarVariable start tags and of their first child element.
+ */
+void InitXmlIndex::buildIndex()
+{
+  static const QByteArray scalarVariableTag = "<ScalarVariable";
+  const QByteArray data = QByteArray::fromRawData(mpData, mSize);
+  int position = 0;
+  while ((position = data.indexOf(scalarVariableTag, position)) != -1) {
+    int nameEnd = position + scalarVariableTag.size();
+    if (nameEnd >= mSize) {
+      break;
+    }
+    // skip elements like ScalarVariables
+    char c = mpData[nameEnd];
+    if (!(c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '>' || c == '/')) {
+      position = nameEnd;
+      continue;
+    }
+    int tagEnd = findTagEnd(nameEnd);
+    if (tagEnd == -1) {
+      break;
+    }
+    ScalarVariable scalarVariable;
+    scalarVariable.mOffset = position;
+    scalarVariable.mLength = tagEnd - position + 1;
+    scalarVariable.mTypeOffset = -1;
+    scalarVariable.mTypeLength = 0;
+    position = tagEnd + 1;
+    if (mpData[tagEnd - 1] != '/') {
+      int childPosition = position;
+      while ((childPosition = data.indexOf('<', childPosition)) != -1 && childPosition + 1 < mSize) {
+        if (mpData[childPosition + 1] == '!') { // skip comments
+          childPosition = data.indexOf("-->", childPosition);
+          if (childPosition == -1) {
+            break;
+          }
+          continue;
+        } else if (mpData[childPosition + 1] != '/') {
+          int childTagEnd = findTagEnd(childPosition + 1);
+          if (childTagEnd != -1) {
+            scalarVariable.mTypeOffset = childPosition;
+            scalarVariable.mTypeLength = childTagEnd - childPosition + 1;
+            position = childTagEnd + 1;
+          }
+        }
+        break;
+      }
+    }
+    mScalarVariablesHash.insert(attribute(scalarVariable.mOffset, scalarVariable.mLength, "name"), mScalarVariables.size());
+    mScalarVariables.append(scalarVariable);
+  }
+}
+
+/*!
+ * \brief InitXmlIndex::findTagEnd
+ * Returns the position of > that ends the tag. Skips the quoted attribute values.
+ * \param from
+ * \return
+ */
+int InitXmlIndex::findTagEnd(int from) const
+{
+  char quote = 0;
+  for (int i = from ; i < mSize ; i++) {
+    char c = mpData[i];
+    if (quote) {
+      if (c == quote) {
+        quote = 0;
+      }
+    } else if (c == '"' || c == '\'') {
+      quote = c;
+    } else if (c == '>') {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/*!
+ * \brief InitXmlIndex::findAttribute
+ * Finds the attribute value in the tag.
+ * \param offset - the position of the tag.
+ * \param length - the length of the tag.
+ * \param attribute
+ * \param pValueOffset - the position of the attribute value without quotes.
+ * \param pValueLength - the length of the attribute value.
+ * \return
+ */
+bool InitXmlIndex::findAttribute(int offset, int length, const QByteArray &attribute, int *pValueOffset, int *pValueLength) const
+{
+  const char *pTag = mpData + offset;
+  int i = 1;
+  // skip the element name
+  while (i < length && pTag[i] != ' ' && pTag[i] != '\t' && pTag[i] != '\n' && pTag[i] != '\r' && pTag[i] != '>' && pTag[i] != '/') {
+    i++;
+  }
+  while (i < length) {
+    while (i < length && (pTag[i] == ' ' || pTag[i] == '\t' || pTag[i] == '\n' || pTag[i] == '\r')) {
+      i++;
+    }
+    if (i >= length || pTag[i] == '>' || pTag[i] == '/') {
+      return false;
+    }
+    int nameStart = i;
+    while (i < length && pTag[i] != '=' && pTag[i] != ' ' && pTag[i] != '\t' && pTag[i] != '\n' && pTag[i] != '\r') {
+      i++;
+    }
+    int nameLength = i - nameStart;
+    while (i < length && pTag[i] != '"' && pTag[i] != '\'') {
+      i++;
+    }
+    if (i >= length) {
+      return false;
+    }
+    char quote = pTag[i++];
+    int valueStart = i;
+    while (i < length && pTag[i] != quote) {
+      i++;
+    }
+    if (nameLength == attribute.size() && qstrncmp(pTag + nameStart, attribute.constData(), nameLength) == 0) {
+      *pValueOffset = offset + valueStart;
+      *pValueLength = i - valueStart;
+      return true;
+    }
+    i++;
+  }
+  return false;
+}
+
+/*!
+ * \brief InitXmlIndex::attribute
+ * Returns the decoded attribute value of the tag.
+ * \param offset
+ * \param length
+ * \param attribute
+ * \return
+ */
+QString InitXmlIndex::attribute(int offset, int length, const QByteArray &attribute) const
+{
+  int valueOffset, valueLength;
+  if (findAttribute(offset, length, attribute, &valueOffset, &valueLength)) {
+    return decode(mpData + valueOffset, valueLength);
+  }
+  return "";
+}
+
+/*!
+ * \brief InitXmlIndex::decode
+ * Decodes the UTF-8 attribute value and replaces the entity and character references.
+ * \param pValue
+ * \param length
+ * \return
+ */
+QString InitXmlIndex::decode(const char *pValue, int length)
+{
+  QString value = QString::fromUtf8(pValue, length);
+  if (!value.contains('&')) {
+    return value;
+  }
+  QString decodedValue;
+  decodedValue.reserve(value.size());
+  for (int i = 0 ; i < value.size() ; i++) {
+    int end;
+    if (value.at(i) == '&' && (end = value.indexOf(';', i)) != -1) {
+      QString entity = value.mid(i + 1, end - i - 1);
+      bool ok = true;
+      if (entity == "amp") {
+        decodedValue.append('&');
+      } else if (entity == "lt") {
+        decodedValue.append('<');
+      } else if (entity == "gt") {
+        decodedValue.append('>');
+      } else if (entity == "quot") {
+        decodedValue.append('"');
+      } else if (entity == "apos") {
+        decodedValue.append('\'');
+      } else if (entity.startsWith("#x")) {
+        decodedValue.append(QChar(entity.mid(2).toUInt(&ok, 16)));
+      } else if (entity.startsWith("#")) {
+        decodedValue.append(QChar(entity.mid(1).toUInt(&ok, 10)));
+      } else {
+        ok = false;
+      }
+      if (ok) {
+        i = end;
+        continue;
+      }
+    }
+    decodedValue.append(value.at(i));
+  }
+  return decodedValue;
+}
+
+/*!
+ * \brief InitXmlIndex::encode
+ * Encodes the value as a UTF-8 attribute value.
+ * \param value
+ * \return
+ */
+QByteArray InitXmlIndex::encode(const QString &value)
+{
+  QByteArray encodedValue = value.toUtf8();
+  encodedValue.replace('&', "&amp;");
+  encodedValue.replace('<', "&lt;");
+  encodedValue.replace('>', "&gt;");
+  encodedValue.replace('"', "&quot;");
+  return encodedValue;
+}
@@ -0,0 +1,82 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+
+#ifndef INITXMLINDEX_H
+#define INITXMLINDEX_H
+
+#include <QFile>
+#include <QHash>
+#include <QVector>
+
+/*!
+ * \class InitXmlIndex
+ * \brief An index of the ScalarVariable elements of the model _init.xml file.
+ * The file is mapped into memory and only the offsets of each ScalarVariable start tag and of its type element (Real, Integer etc.)
+ * are stored. The attributes are parsed on demand.
+ */
+class InitXmlIndex
+{
+public:
+  InitXmlIndex();
+  ~InitXmlIndex();
+  bool open(const QString &fileName);
+  void close();
+  bool isOpen() const {return mpData != 0;}
+  QString errorString() const {return mErrorString;}
+  int count() const {return mScalarVariables.size();}
+  int findVariable(const QString &name) const {return mScalarVariablesHash.value(name, -1);}
+  QString variableAttribute(int index, const QByteArray &attribute) const;
+  QString typeAttribute(int index, const QByteArray &attribute) const;
+  static bool updateStartValues(const QString &fileName, const QHash<QString, QString> &startValues, QString *pErrorString);
+private:
+  typedef struct {
+    int mOffset;
+    int mLength;
+    int mTypeOffset;
+    int mTypeLength;
+  } ScalarVariable;
+
+  QFile mFile;
+  QByteArray mBuffer;
+  const char *mpData;
+  int mSize;
+  QVector<ScalarVariable> mScalarVariables;
+  QHash<QString, int> mScalarVariablesHash;
+  QString mErrorString;
+  void buildIndex();
+  int findTagEnd(int from) const;
+  bool findAttribute(int offset, int length, const QByteArray &attribute, int *pValueOffset, int *pValueLength) const;
+  QString attribute(int offset, int length, const QByteArray &attribute) const;
+  static QString decode(const char *pValue, int length);
+  static QByteArray encode(const QString &value);
+};
+
+#endif // INITXMLINDEX_H
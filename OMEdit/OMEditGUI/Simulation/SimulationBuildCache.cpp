@@ -0,0 +1,221 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+
+#include "SimulationBuildCache.h"
+#include "Util/Utilities.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+
+/*!
+ * \brief SimulationBuildCache::cacheDirectory
+ * Returns the directory where the cached builds are stored.
+ * \return
+ */
+QString SimulationBuildCache::cacheDirectory()
+{
+  QString path = Utilities::tempDirectory() + "/buildcache/";
+  path = path.replace("//", "/");
+  if (!QDir().exists(path)) {
+    QDir().mkpath(path);
+  }
+  return path;
+}
+
+/*!
+ * \brief SimulationBuildCache::buildKey
+ * Creates the cache key from the model sources, OMC flags and the compiler settings.
+ * \param modelSources - the text of the loaded classes and the files of the system libraries.
+ * \param omcFlags - the OMC flags used for translation.
+ * \param compilerSettings - target language, target compiler, cflags etc.
+ * \return the hex encoded hash.
+ */
+QString SimulationBuildCache::buildKey(QString modelSources, QString omcFlags, QStringList compilerSettings)
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(modelSources.toUtf8());
+  hash.addData("\n");
+  hash.addData(omcFlags.toUtf8());
+  foreach (QString compilerSetting, compilerSettings) {
+    hash.addData("\n");
+    hash.addData(compilerSetting.toUtf8());
+  }
+  return QString(hash.result().toHex());
+}
+
+/*!
+ * \brief SimulationBuildCache::restore
+ * Copies the cached executable and _init.xml to the working directory.
+ * \param key
+ * \param workingDirectory
+ * \param outputFileName
+ * \return true if the build is found in the cache.
+ */
+bool SimulationBuildCache::restore(QString key, QString workingDirectory, QString outputFileName)
+{
+  if (key.isEmpty()) {
+    return false;
+  }
+  QString entryPath = cacheDirectory() + key;
+  QStringList fileNames = cachedFileNames(outputFileName);
+  // the executable and the _init.xml must be in the cache.
+  if (!QFile::exists(entryPath + "/" + fileNames.at(0)) || !QFile::exists(entryPath + "/" + fileNames.at(1))) {
+    return false;
+  }
+  foreach (QString fileName, fileNames) {
+    QString cachedFile = entryPath + "/" + fileName;
+    if (!QFile::exists(cachedFile)) {
+      continue;
+    }
+    QString workingFile = workingDirectory + "/" + fileName;
+    if (QFile::exists(workingFile) && !QFile::remove(workingFile)) {
+      return false;
+    }
+    if (!QFile::copy(cachedFile, workingFile)) {
+      return false;
+    }
+    QFile::setPermissions(workingFile, QFile::permissions(cachedFile));
+  }
+  touch(entryPath);
+  return true;
+}
+
+/*!
+ * \brief SimulationBuildCache::store
+ * Copies the executable and _init.xml from the working directory to the cache and evicts the least recently used builds.
+ * \param key
+ * \param workingDirectory
+ * \param outputFileName
+ * \param maximumSize - the maximum size of the cache in bytes.
+ */
+void SimulationBuildCache::store(QString key, QString workingDirectory, QString outputFileName, qint64 maximumSize)
+{
+  if (key.isEmpty()) {
+    return;
+  }
+  QString entryPath = cacheDirectory() + key;
+  removeEntry(entryPath);
+  QDir().mkpath(entryPath);
+  foreach (QString fileName, cachedFileNames(outputFileName)) {
+    QString workingFile = workingDirectory + "/" + fileName;
+    if (QFile::exists(workingFile)) {
+      QFile::copy(workingFile, entryPath + "/" + fileName);
+    }
+  }
+  touch(entryPath);
+  evict(maximumSize);
+}
+
+/*!
+ * \brief SimulationBuildCache::evict
+ * Removes the least recently used builds until the cache fits in maximumSize.
+ * \param maximumSize - the maximum size of the cache in bytes.
+ */
+void SimulationBuildCache::evict(qint64 maximumSize)
+{
+  QDir cacheDir(cacheDirectory());
+  QMultiMap<QDateTime, QPair<QString, qint64> > entries;
+  qint64 totalSize = 0;
+  foreach (QFileInfo entryInfo, cacheDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+    qint64 entrySize = 0;
+    foreach (QFileInfo fileInfo, QDir(entryInfo.absoluteFilePath()).entryInfoList(QDir::Files | QDir::Hidden)) {
+      entrySize += fileInfo.size();
+    }
+    QFileInfo stampInfo(entryInfo.absoluteFilePath() + "/.lastused");
+    entries.insert(stampInfo.exists() ? stampInfo.lastModified() : entryInfo.lastModified(),
+                   qMakePair(entryInfo.absoluteFilePath(), entrySize));
+    totalSize += entrySize;
+  }
+  // QMultiMap is sorted by the time so the oldest entries come first.
+  QMultiMap<QDateTime, QPair<QString, qint64> >::const_iterator it = entries.constBegin();
+  while (totalSize > maximumSize && it != entries.constEnd()) {
+    if (removeEntry(it.value().first)) {
+      totalSize -= it.value().second;
+    }
+    ++it;
+  }
+}
+
+/*!
+ * \brief SimulationBuildCache::cachedFileNames
+ * Returns the names of the files that make up a build. The executable and _init.xml are always the first two entries.
+ * \param outputFileName
+ * \return
+ */
+QStringList SimulationBuildCache::cachedFileNames(QString outputFileName)
+{
+  QStringList fileNames;
+#ifdef WIN32
+  fileNames << outputFileName + ".exe";
+#else
+  fileNames << outputFileName;
+#endif
+  fileNames << outputFileName + "_init.xml"
+            << outputFileName + "_info.json"
+            << outputFileName + "_visual.xml";
+  return fileNames;
+}
+
+/*!
+ * \brief SimulationBuildCache::touch
+ * Marks the cache entry as recently used.
+ * \param entryPath
+ */
+void SimulationBuildCache::touch(QString entryPath)
+{
+  QFile stampFile(entryPath + "/.lastused");
+  if (stampFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    stampFile.write(QDateTime::currentDateTime().toString(Qt::ISODate).toUtf8());
+    stampFile.close();
+  }
+}
+
+/*!
+ * \brief SimulationBuildCache::removeEntry
+ * Removes the cache entry directory. The entries are flat so no recursion is needed.
+ * \param entryPath
+ * \return true on success.
+ */
+bool SimulationBuildCache::removeEntry(QString entryPath)
+{
+  QDir entryDir(entryPath);
+  if (!entryDir.exists()) {
+    return true;
+  }
+  foreach (QString fileName, entryDir.entryList(QDir::Files | QDir::Hidden)) {
+    entryDir.remove(fileName);
+  }
+  return QDir().rmdir(entryPath);
+}
@@ -0,0 +1,58 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+
+#ifndef SIMULATIONBUILDCACHE_H
+#define SIMULATIONBUILDCACHE_H
+
+#include <QString>
+#include <QStringList>
+
+/*!
+ * \class SimulationBuildCache
+ * \brief Caches the compiled simulation executables.
+ * The executable and its _init.xml are stored in a directory named after a hash of the model sources, the OMC flags and the
+ * compiler settings. A later simulation with the same key can reuse them and only run the executable with the new simulation flags.
+ */
+class SimulationBuildCache
+{
+public:
+  static QString cacheDirectory();
+  static QString buildKey(QString modelSources, QString omcFlags, QStringList compilerSettings);
+  static bool restore(QString key, QString workingDirectory, QString outputFileName);
+  static void store(QString key, QString workingDirectory, QString outputFileName, qint64 maximumSize);
+  static void evict(qint64 maximumSize);
+private:
+  static QStringList cachedFileNames(QString outputFileName);
+  static void touch(QString entryPath);
+  static bool removeEntry(QString entryPath);
+};
+
+#endif // SIMULATIONBUILDCACHE_H
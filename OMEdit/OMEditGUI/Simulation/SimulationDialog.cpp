@@ -42,11 +42,13 @@
 #include "Plotting/PlotWindowContainer.h"
 #include "Modeling/Commands.h"
 #include "SimulationProcessThread.h"
+#include "SimulationBuildCache.h"
 #if !defined(WITHOUT_OSG)
 #include "Animation/AnimationWindow.h"
 #endif
 
 #include <QDebug>
+#include <QDirIterator>
 #include <limits>
 
 /*!
@@ -794,11 +796,15 @@ void SimulationDialog::initializeFields(bool isReSimulate, SimulationOptions sim
 
 /*!
  * \brief SimulationDialog::translateModel
- * Sends the translateModel command to OMC.
+ * Sends the translateModel command to OMC.\n
+ * If the build cache is enabled and the model is already compiled from the same sources with the same OMC flags and compiler settings
+ * then the translation
+ * is skipped and the cached executable is used.
  * \param simulationParameters
+ * \param simulationOptions
  * \return
  */
-bool SimulationDialog::translateModel(QString simulationParameters)
+bool SimulationDialog::translateModel(QString simulationParameters, SimulationOptions &simulationOptions)
 {
   // check reset messages number before simulation option
   if (OptionsDialog::instance()->getMessagesPage()->getResetMessagesNumberBeforeSimulationCheckBox()->isChecked()) {
@@ -820,12 +826,145 @@ bool SimulationDialog::translateModel(QString simulationParameters)
     MainWindow::instance()->getOMCProxy()->setCommandLineOptions("-d=visxml");
   }
 #endif
+  // check if the model is already compiled
+  if (isBuildCacheUsable(simulationOptions)) {
+    OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
+    QString modelSources = getBuildCacheModelSources();
+    if (!modelSources.isEmpty()) {
+      SimulationPage *pSimulationPage = OptionsDialog::instance()->getSimulationPage();
+      QStringList compilerSettings;
+      compilerSettings << Helper::OpenModelicaVersion << mClassName << pSimulationPage->getTargetLanguageComboBox()->currentText()
+                       << pSimulationPage->getTargetCompilerComboBox()->currentText() << simulationOptions.getCflags()
+                       << simulationOptions.getOutputFileName();
+      QString buildCacheKey = SimulationBuildCache::buildKey(modelSources, pOMCProxy->getCommandLineOptions(), compilerSettings);
+      simulationOptions.setBuildCacheKey(buildCacheKey);
+      // the simulation thread stores the build in the cache so pass the size limit along instead of reading the options from it.
+      simulationOptions.setBuildCacheSize((qint64)pSimulationPage->getBuildCacheSizeSpinBox()->value() * 1024 * 1024);
+      if (SimulationBuildCache::restore(buildCacheKey, simulationOptions.getWorkingDirectory(), simulationOptions.getOutputFileName())) {
+        simulationOptions.setBuildCacheHit(true);
+        // reset simulation setting
+        OptionsDialog::instance()->saveSimulationSettings();
+        return true;
+      }
+    }
+  }
   bool result = MainWindow::instance()->getOMCProxy()->translateModel(mClassName, simulationParameters);
   // reset simulation setting
   OptionsDialog::instance()->saveSimulationSettings();
   return result;
 }
 
+/*!
+ * \brief SimulationDialog::isBuildCacheUsable
+ * Returns true if the compiled model can be reused from the build cache.\n
+ * The algorithmic debugger needs the generated sources along with the executable so it always rebuilds.
+ * \param simulationOptions
+ * \return
+ */
+bool SimulationDialog::isBuildCacheUsable(SimulationOptions simulationOptions)
+{
+  SimulationPage *pSimulationPage = OptionsDialog::instance()->getSimulationPage();
+  if (!pSimulationPage->getEnableBuildCacheCheckBox()->isChecked() || simulationOptions.getLaunchAlgorithmicDebugger()) {
+    return false;
+  }
+  QString targetLanguage = pSimulationPage->getTargetLanguageComboBox()->currentText();
+  QString targetCompiler = pSimulationPage->getTargetCompilerComboBox()->currentText();
+  return ((targetLanguage.compare("C") == 0) || (targetLanguage.compare("Cpp") == 0)) &&
+      (targetCompiler.compare("vxworks69") != 0) && (targetCompiler.compare("debugrt") != 0);
+}
+
+/*!
+ * \brief SimulationDialog::getBuildCacheModelSources
+ * Returns the sources of the loaded classes that the build cache key is made of.\n
+ * Flattening the model only to look it up in the cache would double the translation time on every cache miss. Instead the
+ * read-only system libraries are identified by their files and the other loaded classes by their text as listed by OMC.
+ * The files of the external functions and the loaded resources are added, see SimulationDialog::getBuildCacheExternalFiles.
+ * \return
+ */
+QString SimulationDialog::getBuildCacheModelSources()
+{
+  OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
+  LibraryTreeItem *pRootLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->getRootLibraryTreeItem();
+  QString modelSources;
+  for (int i = 0 ; i < pRootLibraryTreeItem->childrenSize() ; i++) {
+    LibraryTreeItem *pLibraryTreeItem = pRootLibraryTreeItem->childAt(i);
+    if (pLibraryTreeItem->getLibraryType() != LibraryTreeItem::Modelica || pLibraryTreeItem->isNonExisting()) {
+      continue;
+    }
+    modelSources.append(pLibraryTreeItem->getNameStructure()).append("\n");
+    if (pLibraryTreeItem->isSystemLibrary()) {
+      QFileInfo fileInfo(pLibraryTreeItem->getFileName());
+      modelSources.append(fileInfo.absoluteFilePath()).append("\n").append(fileInfo.lastModified().toString(Qt::ISODate))
+          .append("\n").append(QString::number(fileInfo.size())).append("\n");
+      modelSources.append(getBuildCacheExternalFiles(pLibraryTreeItem, ""));
+    } else {
+      QString classText = pOMCProxy->list(pLibraryTreeItem->getNameStructure());
+      if (classText.isEmpty()) {
+        return "";
+      }
+      modelSources.append(classText).append("\n");
+      modelSources.append(getBuildCacheExternalFiles(pLibraryTreeItem, classText));
+    }
+  }
+  return modelSources;
+}
+
+/*!
+ * \brief SimulationDialog::getBuildCacheExternalFiles
+ * Returns the paths, the modification times and the sizes of the files used by the external functions and the loaded resources
+ * of a top level class. These files are not part of the class text but are compiled or read by the simulation.\n
+ * The default Include and Library directories of the class are always listed.
+ * The files and directories named by URIs in the class text are listed as well, e.g., in the IncludeDirectory and LibraryDirectory
+ * annotations or in loadResource. The Include and Library annotations name files in these directories.
+ * \param pLibraryTreeItem - the top level class.
+ * \param classText - the text of the class, empty for the system libraries which are identified by their files.
+ * \return
+ */
+QString SimulationDialog::getBuildCacheExternalFiles(LibraryTreeItem *pLibraryTreeItem, const QString &classText)
+{
+  QString resourcesDirectory = QFileInfo(pLibraryTreeItem->getFileName()).absolutePath() + "/Resources";
+  QStringList paths;
+  paths << resourcesDirectory + "/Include" << resourcesDirectory + "/Library";
+  // the URIs and the absolute paths in the Include annotations and in loadResource.
+  QRegExp uriRegExp("\"(modelica://[^\"]+|file://[^\"]+)\"");
+  int index = 0;
+  while ((index = uriRegExp.indexIn(classText, index)) != -1) {
+    QString fileName = MainWindow::instance()->getOMCProxy()->uriToFilename(uriRegExp.cap(1));
+    if (!fileName.isEmpty()) {
+      paths << fileName;
+    }
+    index += uriRegExp.matchedLength();
+  }
+  QRegExp pathRegExp("(?:#include\\s*\\\\\"|loadResource\\s*\\(\\s*\")([^\"\\\\]+)");
+  index = 0;
+  while ((index = pathRegExp.indexIn(classText, index)) != -1) {
+    if (QFileInfo(pathRegExp.cap(1)).isAbsolute()) {
+      paths << pathRegExp.cap(1);
+    }
+    index += pathRegExp.matchedLength();
+  }
+  QString externalFiles;
+  paths.removeDuplicates();
+  foreach (QString path, paths) {
+    QFileInfo pathFileInfo(path);
+    QFileInfoList fileInfoList;
+    if (pathFileInfo.isDir()) {
+      QDirIterator dirIterator(pathFileInfo.absoluteFilePath(), QDir::Files, QDirIterator::Subdirectories);
+      while (dirIterator.hasNext()) {
+        dirIterator.next();
+        fileInfoList.append(dirIterator.fileInfo());
+      }
+    } else if (pathFileInfo.exists()) {
+      fileInfoList.append(pathFileInfo);
+    }
+    foreach (QFileInfo fileInfo, fileInfoList) {
+      externalFiles.append(fileInfo.absoluteFilePath()).append("\n").append(fileInfo.lastModified().toString(Qt::ISODate))
+          .append("\n").append(QString::number(fileInfo.size())).append("\n");
+    }
+  }
+  return externalFiles;
+}
+
 SimulationOptions SimulationDialog::createSimulationOptions()
 {
   SimulationOptions simulationOptions;
@@ -1218,7 +1357,7 @@ void SimulationDialog::performSimulation()
   MainWindow::instance()->getStatusBar()->showMessage(tr("Translating %1.").arg(mClassName));
   MainWindow::instance()->getProgressBar()->setRange(0, 0);
   MainWindow::instance()->showProgressBar();
-  bool isTranslationSuccessful = mIsReSimulate ? true : translateModel(simulationParameters);
+  bool isTranslationSuccessful = mIsReSimulate ? true : translateModel(simulationParameters, simulationOptions);
   // hide the progress bar
   MainWindow::instance()->hideProgressBar();
   MainWindow::instance()->getStatusBar()->clearMessage();
@@ -204,7 +204,10 @@ private:
   void setUpForm();
   bool validate();
   void initializeFields(bool isReSimulate, SimulationOptions simulationOptions);
-  bool translateModel(QString simulationParameters);
+  bool translateModel(QString simulationParameters, SimulationOptions &simulationOptions);
+  bool isBuildCacheUsable(SimulationOptions simulationOptions);
+  QString getBuildCacheModelSources();
+  QString getBuildCacheExternalFiles(LibraryTreeItem *pLibraryTreeItem, const QString &classText);
   SimulationOptions createSimulationOptions();
   void createAndShowSimulationOutputWidget(SimulationOptions simulationOptions);
   void showSimulationOutputWidget(SimulationOutputWidget *pSimulationOutputWidget);
@@ -88,6 +88,9 @@ public:
     setReSimulate(false);
     setWorkingDirectory("");
     setFileName("");
+    setBuildCacheKey("");
+    setBuildCacheHit(false);
+    setBuildCacheSize(0);
   }
 
   void setClassName(QString className) {mClassName = className;}
@@ -184,6 +187,12 @@ public:
   QString getWorkingDirectory() const {return mWorkingDirectory;}
   void setFileName(QString fileName) {mFileName = fileName;}
   QString getFileName() const {return mFileName;}
+  void setBuildCacheKey(QString buildCacheKey) {mBuildCacheKey = buildCacheKey;}
+  QString getBuildCacheKey() const {return mBuildCacheKey;}
+  void setBuildCacheHit(bool buildCacheHit) {mBuildCacheHit = buildCacheHit;}
+  bool isBuildCacheHit() const {return mBuildCacheHit;}
+  void setBuildCacheSize(qint64 buildCacheSize) {mBuildCacheSize = buildCacheSize;}
+  qint64 getBuildCacheSize() const {return mBuildCacheSize;}
 private:
   QString mClassName;
   QString mStartTime;
@@ -232,6 +241,9 @@ private:
   bool mReSimulate;
   QString mWorkingDirectory;
   QString mFileName;
+  QString mBuildCacheKey;
+  bool mBuildCacheHit;
+  qint64 mBuildCacheSize;
 };
 
 #endif // SIMULATIONOPTIONS_H
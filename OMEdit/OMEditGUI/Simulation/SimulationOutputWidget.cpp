@@ -325,10 +325,8 @@ SimulationOutputWidget::~SimulationOutputWidget()
 
 void SimulationOutputWidget::addGeneratedFileTab(QString fileName)
 {
-  QFile file(fileName);
   QFileInfo fileInfo(fileName);
-  if (file.exists()) {
-    file.open(QIODevice::ReadOnly);
+  if (fileInfo.exists()) {
     BaseEditor *pEditor;
     if (Utilities::isCFile(fileInfo.suffix())) {
       pEditor = new CEditor(MainWindow::instance());
@@ -337,9 +335,9 @@ void SimulationOutputWidget::addGeneratedFileTab(QString fileName)
     } else {
       pEditor = new TextEditor(MainWindow::instance());
     }
-    pEditor->getPlainTextEdit()->setPlainText(QString(file.readAll()));
+    // the generated files can be huge so load them in chunks.
+    pEditor->loadFile(fileName);
     mpGeneratedFilesTabWidget->addTab(pEditor, fileInfo.fileName());
-    file.close();
   }
 }
 
@@ -570,11 +568,7 @@ void SimulationOutputWidget::openTransformationBrowser(QUrl url)
 #else /* Qt4 */
     int equationIndex = url.queryItemValue("index").toInt();
 #endif
-    QTreeWidgetItem *pTreeWidgetItem = pTransformationsWidget->findEquationTreeItem(equationIndex);
-    if (pTreeWidgetItem) {
-      pTransformationsWidget->getEquationsTreeWidget()->clearSelection();
-      pTransformationsWidget->getEquationsTreeWidget()->setCurrentItem(pTreeWidgetItem);
-    }
+    pTransformationsWidget->selectEquation(equationIndex);
     pTransformationsWidget->fetchEquationData(equationIndex);
   } else {
     /* TODO: Display error-message */
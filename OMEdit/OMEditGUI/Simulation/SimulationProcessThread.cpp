@@ -33,6 +33,7 @@
 
 #include "SimulationProcessThread.h"
 #include "Options/OptionsDialog.h"
+#include "SimulationBuildCache.h"
 
 #include <QTcpSocket>
 #include <QTcpServer>
@@ -51,10 +52,13 @@ SimulationProcessThread::SimulationProcessThread(SimulationOutputWidget *pSimula
 
 void SimulationProcessThread::run()
 {
-  if (!mpSimulationOutputWidget->getSimulationOptions().isReSimulate()) {
-    compileModel();
-  } else {
+  SimulationOptions simulationOptions = mpSimulationOutputWidget->getSimulationOptions();
+  if (simulationOptions.isReSimulate()) {
     runSimulationExecutable();
+  } else if (simulationOptions.isBuildCacheHit()) {
+    useCachedBuild();
+  } else {
+    compileModel();
   }
   exec();
 }
@@ -98,6 +102,23 @@ void SimulationProcessThread::compileModel()
 #endif
 }
 
+/*!
+ * \brief SimulationProcessThread::useCachedBuild
+ * Reports the build cache hit in the compilation tab and runs the cached executable.
+ */
+void SimulationProcessThread::useCachedBuild()
+{
+  SimulationOptions simulationOptions = mpSimulationOutputWidget->getSimulationOptions();
+  qRegisterMetaType<QProcess::ExitStatus>("QProcess::ExitStatus");
+  emit sendCompilationStarted();
+  emit sendCompilationOutput(tr("Model is unchanged. Reusing the cached build %1 from %2.\n")
+                             .arg(simulationOptions.getBuildCacheKey()).arg(SimulationBuildCache::cacheDirectory()), Qt::blue);
+  emit sendCompilationFinished(0, QProcess::NormalExit);
+  if (!simulationOptions.getBuildOnly() && !simulationOptions.getLaunchAlgorithmicDebugger()) {
+    runSimulationExecutable();
+  }
+}
+
 void SimulationProcessThread::runSimulationExecutable()
 {
   mpSimulationProcess = new QProcess;
@@ -167,9 +188,14 @@ void SimulationProcessThread::compilationProcessFinished(int exitCode, QProcess:
   QString exitCodeStr = tr("Compilation process failed. Exited with code %1.").arg(exitCode);
   if (exitStatus == QProcess::NormalExit && exitCode == 0) {
     emit sendCompilationOutput(tr("Compilation process finished successfully."), Qt::blue);
+    SimulationOptions simulationOptions = mpSimulationOutputWidget->getSimulationOptions();
+    // add the executable to the build cache
+    if (!simulationOptions.getBuildCacheKey().isEmpty()) {
+      SimulationBuildCache::store(simulationOptions.getBuildCacheKey(), simulationOptions.getWorkingDirectory(),
+                                  simulationOptions.getOutputFileName(), simulationOptions.getBuildCacheSize());
+    }
     emit sendCompilationFinished(exitCode, exitStatus);
     // if not build only and launch the algorithmic debugger is false then run the simulation process.
-    SimulationOptions simulationOptions = mpSimulationOutputWidget->getSimulationOptions();
     if (!simulationOptions.getBuildOnly() && !simulationOptions.getLaunchAlgorithmicDebugger()) {
       runSimulationExecutable();
     }
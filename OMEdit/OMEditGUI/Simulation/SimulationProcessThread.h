@@ -61,6 +61,7 @@ private:
   QProcess::ExitStatus mSimulationProcessExitStatus;
 
   void compileModel();
+  void useCachedBuild();
   void runSimulationExecutable();
 private slots:
   void compilationProcessStarted();
@@ -0,0 +1,310 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "DependencyGraph.h"
+#include "OMDumpXML.h"
+
+#include <QBitArray>
+
+/*!
+ * \class DependencyGraph
+ * \brief The dependencies between the equations and the variables of the transformational debugger.
+ */
+DependencyGraph::DependencyGraph()
+  : mEquationsCount(0)
+{
+}
+
+/*!
+ * \brief DependencyGraph::build
+ * Builds the graph from the defines and the uses of the equations.
+ * The equations are stored at their index so the position of an equation in the list is its id.
+ * \param equations
+ */
+void DependencyGraph::build(const QList<OMEquation*> &equations)
+{
+  clear();
+  mEquationsCount = equations.size();
+  mDefinesOffsets.reserve(mEquationsCount + 1);
+  mUsesOffsets.reserve(mEquationsCount + 1);
+  mDefinesOffsets.append(0);
+  mUsesOffsets.append(0);
+  for (int i = 0 ; i < mEquationsCount ; i++) {
+    OMEquation *pEquation = equations[i];
+    if (pEquation) {
+      foreach (const QString &name, pEquation->defines) {
+        mDefines.append(internVariable(name));
+      }
+      foreach (const QString &name, pEquation->depends) {
+        mUses.append(internVariable(name));
+      }
+    }
+    mDefinesOffsets.append(mDefines.size());
+    mUsesOffsets.append(mUses.size());
+  }
+  transpose(mDefinesOffsets, mDefines, variablesCount(), &mDefinedInOffsets, &mDefinedIn);
+  transpose(mUsesOffsets, mUses, variablesCount(), &mUsedInOffsets, &mUsedIn);
+  computeStronglyConnectedBlocks();
+}
+
+/*!
+ * \brief DependencyGraph::clear
+ */
+void DependencyGraph::clear()
+{
+  mEquationsCount = 0;
+  mVariableIds.clear();
+  mVariableNames.clear();
+  mDefinesOffsets.clear();
+  mDefines.clear();
+  mUsesOffsets.clear();
+  mUses.clear();
+  mDefinedInOffsets.clear();
+  mDefinedIn.clear();
+  mUsedInOffsets.clear();
+  mUsedIn.clear();
+  mBlocks.clear();
+  mBlockSizes.clear();
+}
+
+/*!
+ * \brief DependencyGraph::influences
+ * Finds the equations and the variables the variable depends on, directly or indirectly,
+ * by following the defining equations and the variables they use.
+ * The nearest dependencies come first.
+ * \param variable
+ * \param pEquations
+ * \param pVariables
+ */
+void DependencyGraph::influences(int variable, QVector<int> *pEquations, QVector<int> *pVariables) const
+{
+  pEquations->clear();
+  if (pVariables) {
+    pVariables->clear();
+  }
+  if (variable < 0 || variable >= variablesCount()) {
+    return;
+  }
+  QBitArray visitedEquations(mEquationsCount);
+  QBitArray visitedVariables(variablesCount());
+  QVector<int> queue;
+  queue.append(variable);
+  visitedVariables.setBit(variable);
+  for (int head = 0 ; head < queue.size() ; head++) {
+    Range definedIn = definedInEquations(queue[head]);
+    for (const int *pEquation = definedIn.begin() ; pEquation != definedIn.end() ; ++pEquation) {
+      if (visitedEquations.testBit(*pEquation)) {
+        continue;
+      }
+      visitedEquations.setBit(*pEquation);
+      pEquations->append(*pEquation);
+      Range uses = usedVariables(*pEquation);
+      for (const int *pVariable = uses.begin() ; pVariable != uses.end() ; ++pVariable) {
+        if (!visitedVariables.testBit(*pVariable)) {
+          visitedVariables.setBit(*pVariable);
+          queue.append(*pVariable);
+          if (pVariables) {
+            pVariables->append(*pVariable);
+          }
+        }
+      }
+    }
+  }
+}
+
+/*!
+ * \brief DependencyGraph::stronglyConnectedBlock
+ * Returns the id of the strongly connected block of the equation, -1 if the equation is unknown.
+ * \param equation
+ * \return
+ */
+int DependencyGraph::stronglyConnectedBlock(int equation) const
+{
+  if (equation < 0 || equation >= mBlocks.size()) {
+    return -1;
+  }
+  return mBlocks.at(equation);
+}
+
+/*!
+ * \brief DependencyGraph::stronglyConnectedBlockSize
+ * Returns the number of equations of the strongly connected block of the equation.
+ * A block of more than one equation is an algebraic loop.
+ * \param equation
+ * \return
+ */
+int DependencyGraph::stronglyConnectedBlockSize(int equation) const
+{
+  int block = stronglyConnectedBlock(equation);
+  return block < 0 ? 0 : mBlockSizes.at(block);
+}
+
+int DependencyGraph::internVariable(const QString &name)
+{
+  QHash<QString, int>::const_iterator iterator = mVariableIds.constFind(name);
+  if (iterator != mVariableIds.constEnd()) {
+    return iterator.value();
+  }
+  int variable = mVariableNames.size();
+  mVariableIds.insert(name, variable);
+  mVariableNames.append(name);
+  return variable;
+}
+
+DependencyGraph::Range DependencyGraph::equationRange(const QVector<int> &offsets, const QVector<int> &targets, int equation) const
+{
+  if (equation < 0 || equation >= mEquationsCount) {
+    return Range();
+  }
+  return Range(targets.constData() + offsets.at(equation), targets.constData() + offsets.at(equation + 1));
+}
+
+DependencyGraph::Range DependencyGraph::variableRange(const QVector<int> &offsets, const QVector<int> &targets, int variable) const
+{
+  if (variable < 0 || variable >= variablesCount()) {
+    return Range();
+  }
+  return Range(targets.constData() + offsets.at(variable), targets.constData() + offsets.at(variable + 1));
+}
+
+/*!
+ * \brief DependencyGraph::transpose
+ * Reverses the edges of a relation stored in compressed sparse rows with a counting sort.
+ * The sources of each target stay in ascending order.
+ * \param offsets
+ * \param targets
+ * \param targetsCount
+ * \param pOffsets
+ * \param pTargets
+ */
+void DependencyGraph::transpose(const QVector<int> &offsets, const QVector<int> &targets, int targetsCount, QVector<int> *pOffsets,
+                                QVector<int> *pTargets)
+{
+  pOffsets->fill(0, targetsCount + 1);
+  foreach (int target, targets) {
+    (*pOffsets)[target + 1]++;
+  }
+  for (int i = 0 ; i < targetsCount ; i++) {
+    (*pOffsets)[i + 1] += (*pOffsets)[i];
+  }
+  QVector<int> positions = *pOffsets;
+  pTargets->resize(targets.size());
+  for (int source = 0 ; source < offsets.size() - 1 ; source++) {
+    for (int i = offsets.at(source) ; i < offsets.at(source + 1) ; i++) {
+      (*pTargets)[positions[targets.at(i)]++] = source;
+    }
+  }
+}
+
+/*!
+ * \brief DependencyGraph::computeStronglyConnectedBlocks
+ * Finds the strongly connected blocks of the equations with Tarjan's algorithm.
+ * An equation depends on the equations defining the variables it uses.
+ * The algorithm is iterative so that long chains of equations don't overflow the stack.
+ */
+void DependencyGraph::computeStronglyConnectedBlocks()
+{
+  /* the successors of each equation are the equations using the variables it defines */
+  QVector<int> successorsOffsets;
+  QVector<int> successors;
+  successorsOffsets.reserve(mEquationsCount + 1);
+  successorsOffsets.append(0);
+  for (int equation = 0 ; equation < mEquationsCount ; equation++) {
+    Range defines = definedVariables(equation);
+    for (const int *pVariable = defines.begin() ; pVariable != defines.end() ; ++pVariable) {
+      Range usedIn = usedInEquations(*pVariable);
+      for (const int *pEquation = usedIn.begin() ; pEquation != usedIn.end() ; ++pEquation) {
+        successors.append(*pEquation);
+      }
+    }
+    successorsOffsets.append(successors.size());
+  }
+
+  mBlocks.fill(-1, mEquationsCount);
+  QVector<int> indexes(mEquationsCount, -1);
+  QVector<int> lowLinks(mEquationsCount, 0);
+  QVector<int> edgePositions(mEquationsCount, 0);
+  QBitArray onStack(mEquationsCount);
+  QVector<int> stack;
+  QVector<int> callStack;
+  int counter = 0;
+  for (int root = 0 ; root < mEquationsCount ; root++) {
+    if (indexes[root] >= 0) {
+      continue;
+    }
+    callStack.append(root);
+    while (!callStack.isEmpty()) {
+      int equation = callStack.last();
+      if (indexes[equation] < 0) {
+        indexes[equation] = counter;
+        lowLinks[equation] = counter;
+        counter++;
+        edgePositions[equation] = successorsOffsets[equation];
+        stack.append(equation);
+        onStack.setBit(equation);
+      }
+      /* visit the next unvisited successor */
+      bool descended = false;
+      while (edgePositions[equation] < successorsOffsets[equation + 1]) {
+        int successor = successors[edgePositions[equation]++];
+        if (indexes[successor] < 0) {
+          callStack.append(successor);
+          descended = true;
+          break;
+        } else if (onStack.testBit(successor)) {
+          lowLinks[equation] = qMin(lowLinks[equation], indexes[successor]);
+        }
+      }
+      if (descended) {
+        continue;
+      }
+      callStack.resize(callStack.size() - 1);
+      if (!callStack.isEmpty()) {
+        int parent = callStack.last();
+        lowLinks[parent] = qMin(lowLinks[parent], lowLinks[equation]);
+      }
+      /* the equation is the root of a block, pop the block */
+      if (lowLinks[equation] == indexes[equation]) {
+        int block = mBlockSizes.size();
+        int size = 0;
+        int member;
+        do {
+          member = stack.last();
+          stack.resize(stack.size() - 1);
+          onStack.clearBit(member);
+          mBlocks[member] = block;
+          size++;
+        } while (member != equation);
+        mBlockSizes.append(size);
+      }
+    }
+  }
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#ifndef DEPENDENCYGRAPH_H
+#define DEPENDENCYGRAPH_H
+
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+struct OMEquation;
+
+/*!
+ * \class DependencyGraph
+ * \brief The dependencies between the equations and the variables of the transformational debugger.
+ * The variable names are interned to integer ids and the edges are stored in compressed sparse rows,
+ * one array of offsets and one array of targets per relation. The equations are identified by their index.
+ */
+class DependencyGraph
+{
+public:
+  /*!
+   * \class DependencyGraph::Range
+   * \brief The targets of a node, a range of one of the adjacency arrays.
+   */
+  class Range
+  {
+  public:
+    Range(const int *pBegin = 0, const int *pEnd = 0) : mpBegin(pBegin), mpEnd(pEnd) {}
+    const int* begin() const {return mpBegin;}
+    const int* end() const {return mpEnd;}
+    int size() const {return mpEnd - mpBegin;}
+    bool isEmpty() const {return mpBegin == mpEnd;}
+    int at(int i) const {return mpBegin[i];}
+  private:
+    const int *mpBegin;
+    const int *mpEnd;
+  };
+
+  DependencyGraph();
+  void build(const QList<OMEquation*> &equations);
+  void clear();
+  int variablesCount() const {return mVariableNames.size();}
+  int equationsCount() const {return mEquationsCount;}
+  int variableId(const QString &name) const {return mVariableIds.value(name, -1);}
+  const QString& variableName(int variable) const {return mVariableNames.at(variable);}
+  Range definedVariables(int equation) const {return equationRange(mDefinesOffsets, mDefines, equation);}
+  Range usedVariables(int equation) const {return equationRange(mUsesOffsets, mUses, equation);}
+  Range definedInEquations(int variable) const {return variableRange(mDefinedInOffsets, mDefinedIn, variable);}
+  Range usedInEquations(int variable) const {return variableRange(mUsedInOffsets, mUsedIn, variable);}
+  void influences(int variable, QVector<int> *pEquations, QVector<int> *pVariables = 0) const;
+  int stronglyConnectedBlock(int equation) const;
+  int stronglyConnectedBlockSize(int equation) const;
+private:
+  int mEquationsCount;
+  QHash<QString, int> mVariableIds;
+  QStringList mVariableNames;
+  QVector<int> mDefinesOffsets;
+  QVector<int> mDefines;
+  QVector<int> mUsesOffsets;
+  QVector<int> mUses;
+  QVector<int> mDefinedInOffsets;
+  QVector<int> mDefinedIn;
+  QVector<int> mUsedInOffsets;
+  QVector<int> mUsedIn;
+  QVector<int> mBlocks;
+  QVector<int> mBlockSizes;
+
+  int internVariable(const QString &name);
+  Range equationRange(const QVector<int> &offsets, const QVector<int> &targets, int equation) const;
+  Range variableRange(const QVector<int> &offsets, const QVector<int> &targets, int variable) const;
+  static void transpose(const QVector<int> &offsets, const QVector<int> &targets, int targetsCount, QVector<int> *pOffsets,
+                        QVector<int> *pTargets);
+  void computeStronglyConnectedBlocks();
+};
+
+#endif // DEPENDENCYGRAPH_H
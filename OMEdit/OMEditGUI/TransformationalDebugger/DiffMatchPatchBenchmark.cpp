@@ -0,0 +1,174 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/* Times the diff of the equations shown in the operations of the transformational debugger, see OMOperation::diffHtml.
+ * Usage: DiffMatchPatchBenchmark [model_info.json | file of equation pairs]
+ * The "before-after" operations of an _info.json file (Qt 5) or the pairs of lines of a text file are diffed. Without a file,
+ * residual equations of 10 to 5000 terms and their simplified forms are generated.
+ * Each pair is diffed like OMOperation::diffHtml with the previous settings (line prepass only, 1 second timeout) and with the
+ * token prepass and the 0.1 second timeout. The Levenshtein distance of the diffs shows the quality of the diffs.
+ * make benchmark runs it on SampleEquationPairs.txt, a few equations before and after the OMC operations of the
+ * Modelica.Mechanics and Modelica.Electrical examples. Fails if a diff doesn't give back both equations.
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringList>
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#endif
+#include <stdio.h>
+
+#include "diff_match_patch.h"
+
+typedef struct {
+  QString mBefore;
+  QString mAfter;
+} EquationPair;
+
+/* Reads the "before-after" operations of the equations of an _info.json file. */
+static void readInfoJson(const QByteArray &data, QList<EquationPair> *pEquationPairs)
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+  QJsonArray equations = QJsonDocument::fromJson(data).object().value("equations").toArray();
+  foreach (const QJsonValue &equation, equations) {
+    foreach (const QJsonValue &operation, equation.toObject().value("ops").toArray()) {
+      QJsonArray operationData = operation.toObject().value("data").toArray();
+      if (operation.toObject().value("op").toString().startsWith("before-after") && operationData.size() > 1) {
+        EquationPair equationPair;
+        equationPair.mBefore = operationData.at(0).toString().trimmed();
+        equationPair.mAfter = operationData.at(1).toString().trimmed();
+        pEquationPairs->append(equationPair);
+      }
+    }
+  }
+#else
+  Q_UNUSED(data);
+  Q_UNUSED(pEquationPairs);
+  fprintf(stderr, "Reading _info.json files needs Qt 5.\n");
+#endif
+}
+
+/* A residual equation of terms like a1.b[1].x * (a1.c[1].y - 1.0) and its form with the 1.0 * factors simplified. */
+static EquationPair generateEquationPair(int terms)
+{
+  EquationPair equationPair;
+  equationPair.mBefore = "0.0 = ";
+  equationPair.mAfter = "0.0 = ";
+  for (int i = 0 ; i < terms ; i++) {
+    QString sign = i > 0 ? " + " : "";
+    QString term = QString("a%1.b[%2].x * (a%1.c[%3].y - %4)").arg(i % 7).arg(i).arg(i % 13).arg(i * 0.25);
+    equationPair.mBefore += sign + (i % 3 == 0 ? "1.0 * " : "") + term;
+    equationPair.mAfter += sign + (i % 5 == 0 ? QString("der(a%1.b[%2].x)").arg(i % 7).arg(i) : term);
+  }
+  return equationPair;
+}
+
+/* Diffs the pairs like OMOperation::diffHtml, returns the elapsed milliseconds or -1 if a diff is wrong. */
+static qint64 diffEquationPairs(const QList<EquationPair> &equationPairs, bool tokenMode, float timeout, int *pLevenshtein)
+{
+  QElapsedTimer timer;
+  timer.start();
+  *pLevenshtein = 0;
+  bool correct = true;
+  foreach (const EquationPair &equationPair, equationPairs) {
+    diff_match_patch dmp;
+    dmp.Diff_EditCost = 6;
+    dmp.Diff_TokenMode = tokenMode;
+    dmp.Diff_Timeout = timeout;
+    QList<Diff> diffs = dmp.diff_main(equationPair.mBefore, equationPair.mAfter);
+    dmp.diff_cleanupSemanticLossless(diffs);
+    dmp.diff_prettyHtml(diffs);
+    *pLevenshtein += dmp.diff_levenshtein(diffs);
+    if (dmp.diff_text1(diffs) != equationPair.mBefore || dmp.diff_text2(diffs) != equationPair.mAfter) {
+      fprintf(stderr, "Wrong diff of\n%s\n%s\n", qPrintable(equationPair.mBefore), qPrintable(equationPair.mAfter));
+      correct = false;
+    }
+  }
+  return correct ? timer.elapsed() : -1;
+}
+
+static bool benchmark(const QString &name, const QList<EquationPair> &equationPairs)
+{
+  int characters = 0;
+  foreach (const EquationPair &equationPair, equationPairs) {
+    characters += equationPair.mBefore.size() + equationPair.mAfter.size();
+  }
+  int lineLevenshtein, tokenLevenshtein;
+  qint64 lineElapsed = diffEquationPairs(equationPairs, false, 1.0f, &lineLevenshtein);
+  qint64 tokenElapsed = diffEquationPairs(equationPairs, true, 0.1f, &tokenLevenshtein);
+  printf("%s: %d pairs, %d characters; line prepass %lld ms, distance %d; token prepass %lld ms, distance %d\n",
+         name.toLocal8Bit().constData(), equationPairs.size(), characters, (long long)lineElapsed, lineLevenshtein,
+         (long long)tokenElapsed, tokenLevenshtein);
+  return lineElapsed >= 0 && tokenElapsed >= 0;
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication application(argc, argv);
+  if (argc > 1) {
+    QString fileName = QString::fromLocal8Bit(argv[1]);
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+      fprintf(stderr, "Usage: %s [model_info.json | file of equation pairs]\n", argv[0]);
+      return 1;
+    }
+    QList<EquationPair> equationPairs;
+    if (fileName.endsWith(".json")) {
+      readInfoJson(file.readAll(), &equationPairs);
+    } else {
+      QStringList lines = QString::fromUtf8(file.readAll()).split(QLatin1Char('\n'));
+      for (int i = 0 ; i + 1 < lines.size() ; i += 2) {
+        EquationPair equationPair;
+        equationPair.mBefore = lines.at(i);
+        equationPair.mAfter = lines.at(i + 1);
+        equationPairs.append(equationPair);
+      }
+    }
+    if (equationPairs.isEmpty() || !benchmark(fileName, equationPairs)) {
+      return 1;
+    }
+  } else {
+    int terms[] = {10, 100, 1000, 5000};
+    for (int i = 0 ; i < 4 ; i++) {
+      QList<EquationPair> equationPairs;
+      for (int j = 0 ; j < qMax(1, 1000 / terms[i]) ; j++) {
+        equationPairs.append(generateEquationPair(terms[i]));
+      }
+      if (!benchmark(QString("%1 terms").arg(terms[i]), equationPairs)) {
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
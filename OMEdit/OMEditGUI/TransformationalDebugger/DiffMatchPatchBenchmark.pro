@@ -0,0 +1,8 @@
+# Standalone benchmark of the diff of the equations of the transformational debugger, see DiffMatchPatchBenchmark.cpp.
+# Built and run by make -f Makefile.unix benchmark, or qmake DiffMatchPatchBenchmark.pro && make && ./DiffMatchPatchBenchmark model_info.json
+QT -= gui
+CONFIG += console
+CONFIG -= app_bundle
+TARGET = DiffMatchPatchBenchmark
+SOURCES += DiffMatchPatchBenchmark.cpp diff_match_patch.cpp
+HEADERS += diff_match_patch.h
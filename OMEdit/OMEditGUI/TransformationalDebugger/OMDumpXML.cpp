@@ -57,6 +57,9 @@ QString OMOperation::diffHtml(QString &before, QString &after)
 {
   diff_match_patch dmp;
   dmp.Diff_EditCost = 6;
+  // diff the long equations token by token first and give up on the huge ones after 0.1 second
+  dmp.Diff_TokenMode = true;
+  dmp.Diff_Timeout = 0.1f;
   QList<Diff> diffs = dmp.diff_main(before,after);
   dmp.diff_cleanupSemanticLossless(diffs);
   return dmp.diff_prettyHtml(diffs);
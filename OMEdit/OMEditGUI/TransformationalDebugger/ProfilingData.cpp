@@ -0,0 +1,329 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "ProfilingData.h"
+
+#include <QObject>
+
+#include <algorithm>
+#include <climits>
+
+/*!
+ * \class ProfilingData
+ * \brief The per step profiling data of the model _prof.realdata and _prof.intdata files.
+ */
+ProfilingData::ProfilingData()
+  : mStepsCount(0), mBlocksCount(0)
+{
+  mRealData.mpFile = 0;
+  mRealData.mpData = 0;
+  mRealData.mRowSize = 0;
+  mIntData.mpFile = 0;
+  mIntData.mpData = 0;
+  mIntData.mRowSize = 0;
+}
+
+ProfilingData::~ProfilingData()
+{
+  close();
+}
+
+/*!
+ * \brief ProfilingData::open
+ * Maps the profiling data files into memory and computes the statistics of all the blocks.
+ * The _prof.intdata file is optional, without it the number of calls are not available.
+ * \param realFileName
+ * \param intFileName
+ * \param blocksCount - the number of functions and profile blocks.
+ * \return
+ */
+bool ProfilingData::open(const QString &realFileName, const QString &intFileName, int blocksCount)
+{
+  close();
+  mErrorString.clear();
+  if (blocksCount <= 0) {
+    return false;
+  }
+  qint64 stepsCount;
+  if (!openDataFile(mRealData, realFileName, (blocksCount + 2) * (int)sizeof(double), &stepsCount)) {
+    return false;
+  }
+  qint64 intStepsCount;
+  if (!openDataFile(mIntData, intFileName, (blocksCount + 1) * (int)sizeof(quint32), &intStepsCount) || intStepsCount != stepsCount) {
+    closeDataFile(mIntData);
+  }
+  if (stepsCount <= 0 || stepsCount > INT_MAX) {
+    mErrorString = QObject::tr("The profiling data file %1 doesn't match the profile blocks.").arg(realFileName);
+    close();
+    return false;
+  }
+  mErrorString.clear();
+  mStepsCount = stepsCount;
+  mBlocksCount = blocksCount;
+  computeStatistics();
+  return true;
+}
+
+/*!
+ * \brief ProfilingData::close
+ * Releases the mapped files and clears the statistics.
+ */
+void ProfilingData::close()
+{
+  closeDataFile(mRealData);
+  closeDataFile(mIntData);
+  mStepsCount = 0;
+  mBlocksCount = 0;
+  mBlockStatistics.clear();
+}
+
+/*!
+ * \brief ProfilingData::times
+ * Returns the simulation time of each step.
+ * \return
+ */
+QVector<double> ProfilingData::times() const
+{
+  QVector<double> values(mStepsCount);
+  for (int step = 0 ; step < mStepsCount ; step++) {
+    values[step] = reinterpret_cast<const double*>(mRealData.mpData + (qint64)step * mRealData.mRowSize)[0];
+  }
+  return values;
+}
+
+/*!
+ * \brief ProfilingData::blockTimes
+ * Returns the time spent in the block in each step.
+ * \param block
+ * \return
+ */
+QVector<double> ProfilingData::blockTimes(int block) const
+{
+  QVector<double> values;
+  if (block < 0 || block >= mBlocksCount) {
+    return values;
+  }
+  values.resize(mStepsCount);
+  for (int step = 0 ; step < mStepsCount ; step++) {
+    values[step] = reinterpret_cast<const double*>(mRealData.mpData + (qint64)step * mRealData.mRowSize)[block + 2];
+  }
+  return values;
+}
+
+/*!
+ * \brief ProfilingData::blockCalls
+ * Returns the number of calls of the block in each step.
+ * \param block
+ * \return
+ */
+QVector<quint32> ProfilingData::blockCalls(int block) const
+{
+  QVector<quint32> values;
+  if (!hasCalls() || block < 0 || block >= mBlocksCount) {
+    return values;
+  }
+  values.resize(mStepsCount);
+  for (int step = 0 ; step < mStepsCount ; step++) {
+    values[step] = reinterpret_cast<const quint32*>(mIntData.mpData + (qint64)step * mIntData.mRowSize)[block + 1];
+  }
+  return values;
+}
+
+/*!
+ * \brief ProfilingData::blockPercentiles
+ * Computes the distribution of the time spent in the block over the steps in which the block is called.
+ * \param block
+ * \return
+ */
+ProfilingData::BlockPercentiles ProfilingData::blockPercentiles(int block) const
+{
+  BlockPercentiles percentiles = {0, 0, 0, 0, 0, 0};
+  QVector<double> times = blockTimes(block);
+  QVector<quint32> calls = blockCalls(block);
+  int count = 0;
+  for (int step = 0 ; step < times.size() ; step++) {
+    if (calls.isEmpty() ? times[step] > 0 : calls[step] > 0) {
+      times[count++] = times[step];
+    }
+  }
+  if (count == 0) {
+    return percentiles;
+  }
+  times.resize(count);
+  double total = 0;
+  for (int i = 0 ; i < count ; i++) {
+    total += times[i];
+  }
+  percentiles.mMean = total / count;
+  percentiles.mCalledSteps = count;
+  /* nearest rank percentiles, each nth_element call partitions the range of the next one */
+  double *pBegin = times.data();
+  int median = (count - 1) / 2;
+  int percentile90 = qMax(median, (int)((count - 1) * 0.9));
+  int percentile99 = qMax(percentile90, (int)((count - 1) * 0.99));
+  std::nth_element(pBegin, pBegin + median, pBegin + count);
+  percentiles.mMedian = pBegin[median];
+  std::nth_element(pBegin + median, pBegin + percentile90, pBegin + count);
+  percentiles.mPercentile90 = pBegin[percentile90];
+  std::nth_element(pBegin + percentile90, pBegin + percentile99, pBegin + count);
+  percentiles.mPercentile99 = pBegin[percentile99];
+  percentiles.mMax = *std::max_element(pBegin + percentile99, pBegin + count);
+  return percentiles;
+}
+
+/*!
+ * \class BlockTotalTimeGreaterThan
+ * \brief Orders the blocks by their total time, the costliest first.
+ */
+class BlockTotalTimeGreaterThan
+{
+public:
+  BlockTotalTimeGreaterThan(const QVector<ProfilingData::BlockStatistics> &blockStatistics) : mBlockStatistics(blockStatistics) {}
+  bool operator()(int left, int right) const
+  {
+    return mBlockStatistics[left].mTotalTime > mBlockStatistics[right].mTotalTime;
+  }
+private:
+  const QVector<ProfilingData::BlockStatistics> &mBlockStatistics;
+};
+
+/*!
+ * \brief ProfilingData::costliestBlocks
+ * Returns the blocks with the largest total time, the costliest first.
+ * \param count
+ * \param firstBlock - the blocks before it are skipped e.g., the functions.
+ * \return
+ */
+QVector<int> ProfilingData::costliestBlocks(int count, int firstBlock) const
+{
+  QVector<int> blocks;
+  for (int block = qMax(firstBlock, 0) ; block < mBlocksCount ; block++) {
+    if (mBlockStatistics[block].mTotalTime > 0) {
+      blocks.append(block);
+    }
+  }
+  count = qMin(count, blocks.size());
+  std::partial_sort(blocks.begin(), blocks.begin() + count, blocks.end(), BlockTotalTimeGreaterThan(mBlockStatistics));
+  blocks.resize(count);
+  return blocks;
+}
+
+/*!
+ * \brief ProfilingData::openDataFile
+ * Maps the data file into memory.
+ * \param dataFile
+ * \param fileName
+ * \param rowSize
+ * \param pRowsCount - the number of complete rows of the file.
+ * \return
+ */
+bool ProfilingData::openDataFile(DataFile &dataFile, const QString &fileName, int rowSize, qint64 *pRowsCount)
+{
+  *pRowsCount = 0;
+  dataFile.mpFile = new QFile(fileName);
+  if (!dataFile.mpFile->open(QIODevice::ReadOnly)) {
+    mErrorString = dataFile.mpFile->errorString();
+    closeDataFile(dataFile);
+    return false;
+  }
+  qint64 size = dataFile.mpFile->size();
+  dataFile.mpData = size > 0 ? dataFile.mpFile->map(0, size) : 0;
+  if (!dataFile.mpData) {
+    mErrorString = QObject::tr("Unable to map the profiling data file %1 into memory. %2").arg(fileName, dataFile.mpFile->errorString());
+    closeDataFile(dataFile);
+    return false;
+  }
+  dataFile.mRowSize = rowSize;
+  *pRowsCount = size / rowSize;
+  return true;
+}
+
+/*!
+ * \brief ProfilingData::closeDataFile
+ * Unmaps and closes the data file.
+ * \param dataFile
+ */
+void ProfilingData::closeDataFile(DataFile &dataFile)
+{
+  if (dataFile.mpFile) {
+    if (dataFile.mpData) {
+      dataFile.mpFile->unmap(const_cast<uchar*>(dataFile.mpData));
+    }
+    dataFile.mpFile->close();
+    delete dataFile.mpFile;
+  }
+  dataFile.mpFile = 0;
+  dataFile.mpData = 0;
+  dataFile.mRowSize = 0;
+}
+
+/*!
+ * \brief ProfilingData::computeStatistics
+ * Computes the statistics of all the blocks in a single pass over the rows.
+ * The rows are contiguous so the inner loops over the blocks run over plain arrays, one per statistic, which the compiler can vectorize.
+ */
+void ProfilingData::computeStatistics()
+{
+  QVector<double> totalTimes(mBlocksCount, 0.0);
+  QVector<double> maxTimes(mBlocksCount, 0.0);
+  QVector<quint64> calls(mBlocksCount, 0);
+  QVector<int> calledSteps(mBlocksCount, 0);
+  double *pTotalTimes = totalTimes.data();
+  double *pMaxTimes = maxTimes.data();
+  quint64 *pCalls = calls.data();
+  int *pCalledSteps = calledSteps.data();
+  for (int step = 0 ; step < mStepsCount ; step++) {
+    const double *pTimes = reinterpret_cast<const double*>(mRealData.mpData + (qint64)step * mRealData.mRowSize) + 2;
+    for (int block = 0 ; block < mBlocksCount ; block++) {
+      pTotalTimes[block] += pTimes[block];
+      pMaxTimes[block] = pTimes[block] > pMaxTimes[block] ? pTimes[block] : pMaxTimes[block];
+    }
+    if (hasCalls()) {
+      const quint32 *pStepCalls = reinterpret_cast<const quint32*>(mIntData.mpData + (qint64)step * mIntData.mRowSize) + 1;
+      for (int block = 0 ; block < mBlocksCount ; block++) {
+        pCalls[block] += pStepCalls[block];
+        pCalledSteps[block] += pStepCalls[block] > 0 ? 1 : 0;
+      }
+    } else {
+      for (int block = 0 ; block < mBlocksCount ; block++) {
+        pCalledSteps[block] += pTimes[block] > 0 ? 1 : 0;
+      }
+    }
+  }
+  mBlockStatistics.resize(mBlocksCount);
+  for (int block = 0 ; block < mBlocksCount ; block++) {
+    BlockStatistics &blockStatistics = mBlockStatistics[block];
+    blockStatistics.mTotalTime = totalTimes[block];
+    blockStatistics.mMaxTime = maxTimes[block];
+    blockStatistics.mCalls = calls[block];
+    blockStatistics.mCalledSteps = calledSteps[block];
+  }
+}
@@ -0,0 +1,96 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#ifndef PROFILINGDATA_H
+#define PROFILINGDATA_H
+
+#include <QFile>
+#include <QVector>
+
+/*!
+ * \class ProfilingData
+ * \brief The per step profiling data of the model _prof.realdata and _prof.intdata files.
+ * Each step is a row of the file. A row of _prof.realdata holds the simulation time, the step time and the time of each profile block.
+ * A row of _prof.intdata holds the step number and the number of calls of each profile block.
+ * The files are mapped into memory and read on demand, only the statistics of the blocks are kept.
+ */
+class ProfilingData
+{
+public:
+  typedef struct {
+    double mTotalTime;
+    double mMaxTime;
+    quint64 mCalls;
+    int mCalledSteps;
+  } BlockStatistics;
+  typedef struct {
+    double mMean;
+    double mMedian;
+    double mPercentile90;
+    double mPercentile99;
+    double mMax;
+    int mCalledSteps;
+  } BlockPercentiles;
+
+  ProfilingData();
+  ~ProfilingData();
+  bool open(const QString &realFileName, const QString &intFileName, int blocksCount);
+  void close();
+  bool isOpen() const {return mStepsCount > 0;}
+  bool hasCalls() const {return mIntData.mpData != 0;}
+  QString errorString() const {return mErrorString;}
+  int stepsCount() const {return mStepsCount;}
+  int blocksCount() const {return mBlocksCount;}
+  QVector<double> times() const;
+  QVector<double> blockTimes(int block) const;
+  QVector<quint32> blockCalls(int block) const;
+  const BlockStatistics& blockStatistics(int block) const {return mBlockStatistics.at(block);}
+  BlockPercentiles blockPercentiles(int block) const;
+  QVector<int> costliestBlocks(int count, int firstBlock = 0) const;
+private:
+  typedef struct {
+    QFile *mpFile;
+    const uchar *mpData;
+    int mRowSize;
+  } DataFile;
+
+  DataFile mRealData;
+  DataFile mIntData;
+  int mStepsCount;
+  int mBlocksCount;
+  QVector<BlockStatistics> mBlockStatistics;
+  QString mErrorString;
+  bool openDataFile(DataFile &dataFile, const QString &fileName, int rowSize, qint64 *pRowsCount);
+  void closeDataFile(DataFile &dataFile);
+  void computeStatistics();
+};
+
+#endif // PROFILINGDATA_H
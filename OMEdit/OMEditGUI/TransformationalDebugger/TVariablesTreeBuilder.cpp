@@ -0,0 +1,153 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "TVariablesTreeBuilder.h"
+
+#include <QHash>
+#include <QtAlgorithms>
+
+/*!
+ * \class VariableNameLessThan
+ * \brief Orders the variables by name.
+ */
+class VariableNameLessThan
+{
+public:
+  VariableNameLessThan(const QVector<TVariablesTreeBuilder::Variable> &variables) : mVariables(variables) {}
+  bool operator()(int left, int right) const
+  {
+    return mVariables.at(left).mName < mVariables.at(right).mName;
+  }
+private:
+  const QVector<TVariablesTreeBuilder::Variable> &mVariables;
+};
+
+/*!
+ * \brief TVariablesTreeBuilder::build
+ * Builds the nodes of the variables tree in one pass over the sorted variable names.
+ * The nodes are looked up by their name in a hash so each name part is handled in constant time.
+ * A node is created before its children, Node::mParent is -1 for the top level nodes and
+ * Node::mVariable is the variable whose comment and source location are shown in the node.
+ * The states derivatives der(a.b.x) are shown as der(x) under a.b.
+ * \param variables
+ * \return
+ */
+QVector<TVariablesTreeBuilder::Node> TVariablesTreeBuilder::build(const QVector<Variable> &variables)
+{
+  QVector<int> order(variables.size());
+  for (int i = 0 ; i < order.size() ; i++) {
+    order[i] = i;
+  }
+  qSort(order.begin(), order.end(), VariableNameLessThan(variables));
+
+  QVector<Node> nodes;
+  QHash<QString, int> nodesHash;
+  nodesHash.reserve(variables.size() * 2);
+  foreach (int variableIndex, order) {
+    const QString &name = variables.at(variableIndex).mName;
+    if (name.startsWith("$PRE.") || name.startsWith("$res")) {
+      continue;
+    }
+    bool isDerivative = name.startsWith("der(");
+    QStringList parts;
+    if (isDerivative) {
+      QString str = name;
+      str.chop((str.lastIndexOf("der(") / 4) + 1);
+      parts = makeVariableParts(str.mid(str.lastIndexOf("der(") + 4));
+    } else {
+      parts = makeVariableParts(name);
+    }
+    int parent = -1;
+    QString path;
+    for (int i = 0 ; i < parts.size() ; i++) {
+      const QString &part = parts.at(i);
+      bool isDerivativeNode = isDerivative && i == parts.size() - 1;
+      QString nodeName;
+      if (isDerivativeNode) {
+        nodeName = path.isEmpty() ? "der(" + part + ")" : path + ".der(" + part + ")";
+      } else {
+        nodeName = path.isEmpty() ? part : path + "." + part;
+      }
+      int node = nodesHash.value(nodeName, -1);
+      if (node < 0) {
+        Node newNode;
+        newNode.mParent = parent;
+        newNode.mVariable = variableIndex;
+        if (isDerivativeNode) {
+          newNode.mName = name;
+          newNode.mDisplayName = "der(" + part + ")";
+        } else {
+          newNode.mName = nodeName;
+          newNode.mDisplayName = part;
+        }
+        node = nodes.size();
+        nodes.append(newNode);
+        nodesHash.insert(newNode.mName, node);
+      }
+      parent = node;
+      path = path.isEmpty() ? part : path + "." + part;
+    }
+  }
+  return nodes;
+}
+
+/*!
+ * \brief TVariablesTreeBuilder::makeVariableParts
+ * Splits the variable name at the dots which are not inside array subscripts e.g., a.b[x.y].c gives a, b[x.y] and c.
+ * Same as StringHandler::makeVariableParts without the regular expression.
+ * \param variable
+ * \return
+ */
+QStringList TVariablesTreeBuilder::makeVariableParts(const QString &variable)
+{
+  QStringList parts;
+  const QChar *pData = variable.constData();
+  int size = variable.size();
+  int depth = 0;
+  int start = 0;
+  for (int i = 0 ; i < size ; i++) {
+    ushort c = pData[i].unicode();
+    if (c == '[') {
+      depth++;
+    } else if (c == ']') {
+      depth = qMax(depth - 1, 0);
+    } else if (c == '.' && depth == 0) {
+      if (i > start) {
+        parts.append(variable.mid(start, i - start));
+      }
+      start = i + 1;
+    }
+  }
+  if (size > start) {
+    parts.append(variable.mid(start));
+  }
+  return parts;
+}
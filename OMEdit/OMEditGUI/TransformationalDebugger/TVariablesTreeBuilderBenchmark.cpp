@@ -0,0 +1,96 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/* Times TVariablesTreeBuilder::build on generated variable names.
+ * Usage: TVariablesTreeBuilderBenchmark [number of variables]
+ * The default is 1000000 variables like a1.b2.c3[4].x and their derivatives.
+ * The names are also split with the regular expression of StringHandler::makeVariableParts to check and compare TVariablesTreeBuilder::makeVariableParts.
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRegExp>
+#include <QStringList>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "TVariablesTreeBuilder.h"
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication application(argc, argv);
+  int count = argc > 1 ? atoi(argv[1]) : 1000000;
+  if (count <= 0) {
+    fprintf(stderr, "Usage: %s [number of variables]\n", argv[0]);
+    return 1;
+  }
+
+  QVector<TVariablesTreeBuilder::Variable> variables;
+  variables.reserve(count);
+  srand(1);
+  for (int i = 0 ; variables.size() < count ; i++) {
+    TVariablesTreeBuilder::Variable variable;
+    variable.mName = QString("a%1.b%2.c%3[%4].x%5").arg(i % 10).arg((i / 10) % 100).arg(rand() % 50).arg(i % 7 + 1).arg(i);
+    variable.mComment = "comment";
+    variable.mLineStart = i;
+    variable.mFile = "Model.mo";
+    variables.append(variable);
+    if (i % 4 == 0 && variables.size() < count) {
+      variable.mName = "der(" + variable.mName + ")";
+      variables.append(variable);
+    }
+  }
+  printf("%d variables\n", variables.size());
+
+  QElapsedTimer timer;
+  QRegExp regExp("\\.(?![^\\[\\]]*\\])");
+  int regExpParts = 0;
+  timer.start();
+  foreach (const TVariablesTreeBuilder::Variable &variable, variables) {
+    regExpParts += variable.mName.split(regExp, QString::SkipEmptyParts).size();
+  }
+  printf("QRegExp split: %lld ms\n", (long long)timer.elapsed());
+
+  int parts = 0;
+  timer.start();
+  foreach (const TVariablesTreeBuilder::Variable &variable, variables) {
+    parts += TVariablesTreeBuilder::makeVariableParts(variable.mName).size();
+  }
+  printf("TVariablesTreeBuilder::makeVariableParts: %lld ms\n", (long long)timer.elapsed());
+  if (parts != regExpParts) {
+    fprintf(stderr, "Different number of parts %d and %d\n", parts, regExpParts);
+    return 1;
+  }
+
+  timer.start();
+  QVector<TVariablesTreeBuilder::Node> nodes = TVariablesTreeBuilder::build(variables);
+  printf("TVariablesTreeBuilder::build: %lld ms, %d nodes\n", (long long)timer.elapsed(), nodes.size());
+  return 0;
+}
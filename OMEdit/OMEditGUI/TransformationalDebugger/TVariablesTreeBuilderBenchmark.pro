@@ -0,0 +1,8 @@
+# Standalone benchmark of TVariablesTreeBuilder, see TVariablesTreeBuilderBenchmark.cpp.
+# Built and run by make -f Makefile.unix benchmark, or qmake TVariablesTreeBuilderBenchmark.pro && make && ./TVariablesTreeBuilderBenchmark 1000000
+QT -= gui
+CONFIG += console
+CONFIG -= app_bundle
+TARGET = TVariablesTreeBuilderBenchmark
+SOURCES += TVariablesTreeBuilderBenchmark.cpp TVariablesTreeBuilder.cpp
+HEADERS += TVariablesTreeBuilder.h
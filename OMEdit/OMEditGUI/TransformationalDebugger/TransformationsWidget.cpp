@@ -38,12 +38,15 @@
 #include "Modeling/LibraryTreeWidget.h"
 #include "Editors/TransformationsEditor.h"
 #include "Editors/ModelicaEditor.h"
+#include "Modeling/MessagesWidget.h"
 #include <qjson/parser.h>
+#include <qjson/streamreader.h>
 
 #include <QStatusBar>
 #include <QGridLayout>
 #include <QVBoxLayout>
 #include <QMessageBox>
+#include <QHeaderView>
 
 /*!
   \class TVariablesTreeItem
@@ -162,6 +165,38 @@ TVariablesTreeItem* TVariablesTreeItem::parent()
   return mpParentTVariablesTreeItem;
 }
 
+TVariablesTreeBuilderThread::TVariablesTreeBuilderThread(const QVector<TVariablesTreeBuilder::Variable> &variables,
+                                                         TVariablesTreeItem *pRootTVariablesTreeItem, QObject *pParent)
+  : QThread(pParent), mVariables(variables), mpRootTVariablesTreeItem(pRootTVariablesTreeItem)
+{
+}
+
+/*!
+ * \brief TVariablesTreeBuilderThread::run
+ * Creates the TVariablesTreeItems from the nodes of TVariablesTreeBuilder::build.
+ * The items are not added to the root item here, it is done in the GUI thread by TVariablesTreeModel::tVariablesTreeBuilt.
+ */
+void TVariablesTreeBuilderThread::run()
+{
+  QVector<TVariablesTreeBuilder::Node> nodes = TVariablesTreeBuilder::build(mVariables);
+  QVector<TVariablesTreeItem*> items(nodes.size());
+  for (int i = 0 ; i < nodes.size() ; i++) {
+    const TVariablesTreeBuilder::Node &node = nodes.at(i);
+    const TVariablesTreeBuilder::Variable &variable = mVariables.at(node.mVariable);
+    QVector<QVariant> tVariableData;
+    tVariableData << node.mName << node.mDisplayName << variable.mComment << variable.mLineStart << variable.mFile;
+    if (node.mParent < 0) {
+      items[i] = new TVariablesTreeItem(tVariableData, mpRootTVariablesTreeItem);
+      mTopLevelItems.append(items[i]);
+    } else {
+      TVariablesTreeItem *pParentTVariablesTreeItem = items.at(node.mParent);
+      items[i] = new TVariablesTreeItem(tVariableData, pParentTVariablesTreeItem);
+      pParentTVariablesTreeItem->insertChild(pParentTVariablesTreeItem->getChildren().size(), items[i]);
+    }
+  }
+  mVariables.clear();
+}
+
 TVariablesTreeModel::TVariablesTreeModel(TVariablesTreeView *pTVariablesTreeView)
   : QAbstractItemModel(pTVariablesTreeView)
 {
@@ -169,6 +204,13 @@ TVariablesTreeModel::TVariablesTreeModel(TVariablesTreeView *pTVariablesTreeView
   QVector<QVariant> headers;
   headers << "" << Helper::variables << tr("Comment") << tr("Line") << Helper::fileLocation;
   mpRootTVariablesTreeItem = new TVariablesTreeItem(headers, 0, true);
+  mpTVariablesTreeBuilderThread = 0;
+}
+
+TVariablesTreeModel::~TVariablesTreeModel()
+{
+  discardTVariablesTreeBuilderThread();
+  delete mpRootTVariablesTreeItem;
 }
 
 int TVariablesTreeModel::columnCount(const QModelIndex &parent) const
@@ -286,85 +328,75 @@ QModelIndex TVariablesTreeModel::tVariablesTreeItemIndexHelper(const TVariablesT
   return QModelIndex();
 }
 
-void TVariablesTreeModel::insertTVariablesItems(QHashIterator<QString, OMVariable> variables)
+/*!
+ * \brief TVariablesTreeModel::insertTVariablesItems
+ * Starts building the variables tree in a TVariablesTreeBuilderThread.
+ * The items are added to the model in one go once the thread has finished, see TVariablesTreeModel::tVariablesTreeBuilt.
+ * \param variables
+ */
+void TVariablesTreeModel::insertTVariablesItems(const QHash<QString, OMVariable> &variables)
 {
-  while (variables.hasNext())
-  {
-    variables.next();
-    const OMVariable &variable = variables.value();
-    if (variable.name.startsWith("$PRE.") || variable.name.startsWith("$res"))
-      continue;
-
-    QStringList tVariables;
-    QString parentTVariable;
-    if (variable.name.startsWith("der(")) {
-      QString str = variable.name;
-      str.chop((str.lastIndexOf("der(")/4)+1);
-      tVariables = StringHandler::makeVariableParts(str.mid(str.lastIndexOf("der(") + 4));
-    } else {
-      tVariables = StringHandler::makeVariableParts(variable.name);
-    }
-    int count = 1;
-    TVariablesTreeItem *pParentTVariablesTreeItem = 0;
-    foreach (QString tVariable, tVariables) {
-      if (count == 1) /* first loop iteration */ {
-        pParentTVariablesTreeItem = mpRootTVariablesTreeItem;
-      }
-      QString findVariable;
-      /* if last item */
-      if (tVariables.size() == count && variable.name.startsWith("der(")) {
-        findVariable = parentTVariable.isEmpty() ? "der(" + tVariable + ")" : parentTVariable + ".der(" + tVariable + ")";
-      } else {
-        findVariable = parentTVariable.isEmpty() ? tVariable : parentTVariable + "." + tVariable;
-      }
-      if ((pParentTVariablesTreeItem = findTVariablesTreeItem(findVariable, pParentTVariablesTreeItem))) {
-        if (count == 1) {
-          parentTVariable = tVariable;
-        } else {
-          parentTVariable += "." + tVariable;
-        }
-        count++;
-        continue;
-      }
-      /*
-        If pParentTVariablesTreeItem is 0 and it is first loop iteration then use mpRootTVariablesTreeItem as parent.
-        If loop iteration is not first and pParentTVariablesTreeItem is 0 then find the parent item.
-        */
-      if (!pParentTVariablesTreeItem && count > 1) {
-        pParentTVariablesTreeItem = findTVariablesTreeItem(parentTVariable, mpRootTVariablesTreeItem);
-      } else {
-        pParentTVariablesTreeItem = mpRootTVariablesTreeItem;
-      }
-      QModelIndex index = tVariablesTreeItemIndex(pParentTVariablesTreeItem);
-      QVector<QVariant> tVariableData;
-      QString parentVarName = pParentTVariablesTreeItem->getVariableName();
-      parentVarName = parentVarName.isEmpty() ? parentVarName : parentVarName.append(".");
-      /* if last item */
-      if (tVariables.size() == count && variable.name.startsWith("der(")) {
-        tVariableData << variable.name << "der(" + tVariable + ")" << variable.comment << variable.info.lineStart << variable.info.file;
-      } else {
-        tVariableData << parentVarName + tVariable << tVariable << variable.comment << variable.info.lineStart << variable.info.file;
-      }
-      TVariablesTreeItem *pTVariablesTreeItem = new TVariablesTreeItem(tVariableData, pParentTVariablesTreeItem);
-      int row = rowCount(index);
-      beginInsertRows(index, row, row);
-      pParentTVariablesTreeItem->insertChild(row, pTVariablesTreeItem);
-      endInsertRows();
-      if (count == 1) {
-        parentTVariable = tVariable;
-      } else {
-        parentTVariable += "." + tVariable;
-      }
-      count++;
-    }
+  discardTVariablesTreeBuilderThread();
+  QVector<TVariablesTreeBuilder::Variable> tVariables;
+  tVariables.reserve(variables.size());
+  QHash<QString, OMVariable>::const_iterator iterator;
+  for (iterator = variables.constBegin() ; iterator != variables.constEnd() ; ++iterator) {
+    const OMVariable &variable = iterator.value();
+    TVariablesTreeBuilder::Variable tVariable;
+    tVariable.mName = variable.name;
+    tVariable.mComment = variable.comment;
+    tVariable.mLineStart = variable.info.lineStart;
+    tVariable.mFile = variable.info.file;
+    tVariables.append(tVariable);
   }
+  mpTVariablesTreeBuilderThread = new TVariablesTreeBuilderThread(tVariables, mpRootTVariablesTreeItem, this);
+  connect(mpTVariablesTreeBuilderThread, SIGNAL(finished()), SLOT(tVariablesTreeBuilt()));
+  mpTVariablesTreeBuilderThread->start();
 }
 
 void TVariablesTreeModel::clearTVariablesTreeItems()
 {
-  beginRemoveRows(tVariablesTreeItemIndex(mpRootTVariablesTreeItem), 0, mpRootTVariablesTreeItem->getChildren().size());
+  discardTVariablesTreeBuilderThread();
+  beginResetModel();
   mpRootTVariablesTreeItem->removeChildren();
-  endRemoveRows();
+  endResetModel();
+}
+
+/*!
+ * \brief TVariablesTreeModel::discardTVariablesTreeBuilderThread
+ * Waits for the running TVariablesTreeBuilderThread, if any, and deletes the items it has built.
+ */
+void TVariablesTreeModel::discardTVariablesTreeBuilderThread()
+{
+  if (!mpTVariablesTreeBuilderThread) {
+    return;
+  }
+  disconnect(mpTVariablesTreeBuilderThread, SIGNAL(finished()), this, SLOT(tVariablesTreeBuilt()));
+  mpTVariablesTreeBuilderThread->wait();
+  qDeleteAll(mpTVariablesTreeBuilderThread->getTopLevelItems());
+  delete mpTVariablesTreeBuilderThread;
+  mpTVariablesTreeBuilderThread = 0;
+}
+
+/*!
+ * \brief TVariablesTreeModel::tVariablesTreeBuilt
+ * Slot activated when the TVariablesTreeBuilderThread has finished.\n
+ * Adds the top level items to the root item with a single model reset.
+ */
+void TVariablesTreeModel::tVariablesTreeBuilt()
+{
+  if (!mpTVariablesTreeBuilderThread) {
+    return;
+  }
+  QList<TVariablesTreeItem*> topLevelItems = mpTVariablesTreeBuilderThread->getTopLevelItems();
+  beginResetModel();
+  mpRootTVariablesTreeItem->removeChildren();
+  for (int i = 0 ; i < topLevelItems.size() ; i++) {
+    mpRootTVariablesTreeItem->insertChild(i, topLevelItems.at(i));
+  }
+  endResetModel();
+  mpTVariablesTreeBuilderThread->deleteLater();
+  mpTVariablesTreeBuilderThread = 0;
 }
 
 TVariableTreeProxyModel::TVariableTreeProxyModel(QObject *parent)
@@ -443,16 +475,424 @@ EquationTreeWidget::EquationTreeWidget(TransformationsWidget *pTransformationWid
   connect(this, SIGNAL(itemDoubleClicked(QTreeWidgetItem*,int)), mpTransformationWidget, SLOT(fetchEquationData(QTreeWidgetItem*,int)));
 }
 
+/*!
+ * \class EquationTreeModel
+ * \brief A model of the equations browser.
+ * The model doesn't create any item for the equations. The rows are computed from the equation indexes,
+ * the nested equations are stored as one compact children array with offsets per equation.
+ * The model index internal pointer is the OMEquation.
+ */
+/*!
+ * \brief EquationTreeModel::EquationTreeModel
+ * \param pParent
+ */
+EquationTreeModel::EquationTreeModel(QObject *pParent)
+  : QAbstractItemModel(pParent), mpDependencyGraph(0), mSortColumn(0), mSortOrder(Qt::AscendingOrder)
+{
+}
+
+int EquationTreeModel::columnCount(const QModelIndex &parent) const
+{
+  Q_UNUSED(parent);
+  return 7;
+}
+
+int EquationTreeModel::rowCount(const QModelIndex &parent) const
+{
+  if (parent.column() > 0) {
+    return 0;
+  }
+  if (!parent.isValid()) {
+    return mTopLevelEquations.size();
+  }
+  int equationIndex = static_cast<OMEquation*>(parent.internalPointer())->index;
+  return mChildrenOffsets[equationIndex + 1] - mChildrenOffsets[equationIndex];
+}
+
+QVariant EquationTreeModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+    switch (section) {
+      case 0:
+        return Helper::index;
+      case 1:
+        return Helper::type;
+      case 2:
+        return Helper::equation;
+      case 3:
+        return Helper::executionCount;
+      case 4:
+        return Helper::executionMaxTime;
+      case 5:
+        return Helper::executionTime;
+      case 6:
+        return Helper::executionFraction;
+      default:
+        break;
+    }
+  }
+  return QVariant();
+}
+
+QModelIndex EquationTreeModel::index(int row, int column, const QModelIndex &parent) const
+{
+  if (!hasIndex(row, column, parent)) {
+    return QModelIndex();
+  }
+  int equationIndex;
+  if (!parent.isValid()) {
+    equationIndex = mTopLevelEquations[row];
+  } else {
+    equationIndex = mChildren[mChildrenOffsets[static_cast<OMEquation*>(parent.internalPointer())->index] + row];
+  }
+  return createIndex(row, column, mEquations[equationIndex]);
+}
+
+QModelIndex EquationTreeModel::parent(const QModelIndex &index) const
+{
+  if (!index.isValid()) {
+    return QModelIndex();
+  }
+  int parentIndex = mParents[static_cast<OMEquation*>(index.internalPointer())->index];
+  if (parentIndex <= 0) {
+    return QModelIndex();
+  }
+  return createIndex(mRows[parentIndex], 0, mEquations[parentIndex]);
+}
+
+QVariant EquationTreeModel::data(const QModelIndex &index, int role) const
+{
+  if (!index.isValid()) {
+    return QVariant();
+  }
+  OMEquation *pEquation = static_cast<OMEquation*>(index.internalPointer());
+  bool profiled = pEquation->profileBlock >= 0;
+  /* the equations of an algebraic loop form a strongly connected block */
+  int blockSize = mpDependencyGraph ? mpDependencyGraph->stronglyConnectedBlockSize(pEquation->index) : 0;
+  switch (role) {
+    case Qt::DisplayRole:
+      switch (index.column()) {
+        case 0:
+          return QString::number(pEquation->index);
+        case 1:
+          return pEquation->section;
+        case 2:
+          return pEquation->toString();
+        case 3:
+          return profiled ? QString::number(pEquation->ncall) : QString();
+        case 4:
+          return profiled ? QString::number(pEquation->maxTime, 'g', 3) : QString();
+        case 5:
+          return profiled ? QString::number(pEquation->time, 'g', 3) : QString();
+        case 6:
+          return profiled ? QString::number(100 * pEquation->fraction, 'g', 3) + "%" : QString();
+        default:
+          return QVariant();
+      }
+    case Qt::ToolTipRole:
+      switch (index.column()) {
+        case 0:
+          if (blockSize > 1) {
+            return tr("%1, in a strongly connected block of %2 equations").arg(pEquation->index).arg(blockSize);
+          }
+          return QString::number(pEquation->index);
+        case 1:
+          return pEquation->section;
+        case 2:
+          return "<html><div style=\"margin:3px;\">" +
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+              pEquation->toString().toHtmlEscaped()
+#else /* Qt4 */
+              Qt::escape(pEquation->toString())
+#endif
+              + "</div></html>";
+        case 4:
+          return tr("Maximum execution time in a single step");
+        case 5:
+          return tr("Total time excluding the overhead of measuring.");
+        case 6:
+          return tr("Fraction of time, 100% is the total time of all non-child equations.");
+        default:
+          return QVariant();
+      }
+    case Qt::BackgroundRole:
+      return blockSize > 1 ? QVariant(QColor(255, 240, 200)) : QVariant();
+    default:
+      return QVariant();
+  }
+}
+
+Qt::ItemFlags EquationTreeModel::flags(const QModelIndex &index) const
+{
+  if (!index.isValid()) {
+    return 0;
+  }
+  return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+/*!
+ * \class EquationLessThan
+ * \brief Compares the equations by the precomputed keys of the sort column.
+ */
+class EquationLessThan
+{
+public:
+  EquationLessThan(const QVector<double> &numericKeys, const QVector<QString> &textKeys, Qt::SortOrder order)
+    : mNumericKeys(numericKeys), mTextKeys(textKeys), mOrder(order) {}
+  bool operator()(int left, int right) const
+  {
+    if (mOrder == Qt::DescendingOrder) {
+      qSwap(left, right);
+    }
+    if (!mTextKeys.isEmpty()) {
+      return mTextKeys[left] < mTextKeys[right];
+    }
+    return mNumericKeys[left] < mNumericKeys[right];
+  }
+private:
+  const QVector<double> &mNumericKeys;
+  const QVector<QString> &mTextKeys;
+  Qt::SortOrder mOrder;
+};
+
+/*!
+ * \brief EquationTreeModel::sort
+ * Sorts the top level equations and the nested equations of each equation.
+ * The keys of the sort column are computed once for all the equations.
+ * \param column
+ * \param order
+ */
+void EquationTreeModel::sort(int column, Qt::SortOrder order)
+{
+  if (column < 0 || column >= columnCount() || (column == mSortColumn && order == mSortOrder)) {
+    return;
+  }
+  emit layoutAboutToBeChanged();
+  QVector<double> numericKeys;
+  QVector<QString> textKeys;
+  if (column == 1 || column == 2) {
+    textKeys.resize(mEquations.size());
+  } else {
+    numericKeys.resize(mEquations.size());
+  }
+  for (int i = 1 ; i < mEquations.size() ; i++) {
+    OMEquation *pEquation = mEquations[i];
+    bool profiled = pEquation->profileBlock >= 0;
+    switch (column) {
+      case 1:
+        textKeys[i] = pEquation->section;
+        break;
+      case 2:
+        textKeys[i] = pEquation->toString();
+        break;
+      case 3:
+        numericKeys[i] = profiled ? pEquation->ncall : -1;
+        break;
+      case 4:
+        numericKeys[i] = profiled ? pEquation->maxTime : -1;
+        break;
+      case 5:
+        numericKeys[i] = profiled ? pEquation->time : -1;
+        break;
+      case 6:
+        numericKeys[i] = profiled ? pEquation->fraction : -1;
+        break;
+      default:
+        numericKeys[i] = pEquation->index;
+        break;
+    }
+  }
+  EquationLessThan lessThan(numericKeys, textKeys, order);
+  qStableSort(mTopLevelEquations.begin(), mTopLevelEquations.end(), lessThan);
+  for (int i = 1 ; i < mEquations.size() ; i++) {
+    qStableSort(mChildren.begin() + mChildrenOffsets[i], mChildren.begin() + mChildrenOffsets[i + 1], lessThan);
+  }
+  updateRows();
+  mSortColumn = column;
+  mSortOrder = order;
+  // update the persistent indexes e.g., the selection of the view.
+  QModelIndexList oldIndexes = persistentIndexList();
+  QModelIndexList newIndexes;
+  foreach (QModelIndex oldIndex, oldIndexes) {
+    newIndexes.append(equationModelIndex(static_cast<OMEquation*>(oldIndex.internalPointer())->index, oldIndex.column()));
+  }
+  changePersistentIndexList(oldIndexes, newIndexes);
+  emit layoutChanged();
+}
+
+/*!
+ * \brief EquationTreeModel::equationModelIndex
+ * Returns the model index of the equation.
+ * \param equationIndex
+ * \param column
+ * \return
+ */
+QModelIndex EquationTreeModel::equationModelIndex(int equationIndex, int column) const
+{
+  if (equationIndex <= 0 || equationIndex >= mEquations.size() || mParents[equationIndex] < 0) {
+    return QModelIndex();
+  }
+  return createIndex(mRows[equationIndex], column, mEquations[equationIndex]);
+}
+
+/*!
+ * \brief EquationTreeModel::insertEquations
+ * Builds the equations tree from the parent and nested equation indexes.
+ * The equations without parent are the top level rows. A nested equation is only shown at its first position.
+ * \param equations
+ */
+void EquationTreeModel::insertEquations(const QList<OMEquation*> &equations)
+{
+  beginResetModel();
+  mEquations = equations;
+  int count = mEquations.size();
+  mTopLevelEquations.clear();
+  mChildren.clear();
+  mChildrenOffsets.fill(0, count + 1);
+  mParents.fill(-1, count);
+  mRows.fill(-1, count);
+  for (int i = 1 ; i < count ; i++) {
+    if (!mEquations[i]->parent) {
+      mParents[i] = 0;
+      mTopLevelEquations.append(i);
+    }
+  }
+  for (int i = 1 ; i < count ; i++) {
+    mChildrenOffsets[i] = mChildren.size();
+    foreach (int nestedIndex, mEquations[i]->eqs) {
+      if (nestedIndex > 0 && nestedIndex < count && mParents[nestedIndex] < 0) {
+        mParents[nestedIndex] = i;
+        mChildren.append(nestedIndex);
+      }
+    }
+  }
+  mChildrenOffsets[count] = mChildren.size();
+  updateRows();
+  mSortColumn = 0;
+  mSortOrder = Qt::AscendingOrder;
+  endResetModel();
+}
+
+/*!
+ * \brief EquationTreeModel::clearEquations
+ * Removes all the equations.
+ */
+void EquationTreeModel::clearEquations()
+{
+  beginResetModel();
+  mEquations.clear();
+  mTopLevelEquations.clear();
+  mChildrenOffsets.clear();
+  mChildren.clear();
+  mParents.clear();
+  mRows.clear();
+  endResetModel();
+}
+
+/*!
+ * \brief EquationTreeModel::updateRows
+ * Updates the row of each equation within its parent.
+ */
+void EquationTreeModel::updateRows()
+{
+  for (int row = 0 ; row < mTopLevelEquations.size() ; row++) {
+    mRows[mTopLevelEquations[row]] = row;
+  }
+  for (int i = 1 ; i < mEquations.size() ; i++) {
+    for (int j = mChildrenOffsets[i] ; j < mChildrenOffsets[i + 1] ; j++) {
+      mRows[mChildren[j]] = j - mChildrenOffsets[i];
+    }
+  }
+}
+
+/*!
+ * \class EquationTreeView
+ * \brief A tree view of the equations browser.
+ */
+/*!
+ * \brief EquationTreeView::EquationTreeView
+ * \param pTransformationsWidget
+ */
+EquationTreeView::EquationTreeView(TransformationsWidget *pTransformationsWidget)
+  : QTreeView(pTransformationsWidget), mpTransformationsWidget(pTransformationsWidget)
+{
+  setItemDelegate(new ItemDelegate(this));
+  setIndentation(Helper::treeIndentation);
+  setTextElideMode(Qt::ElideMiddle);
+  setExpandsOnDoubleClick(false);
+  setUniformRowHeights(true);
+  connect(this, SIGNAL(doubleClicked(QModelIndex)), mpTransformationsWidget, SLOT(fetchEquationData(QModelIndex)));
+}
+
+/*!
+ * \class ProfilingPlotWidget
+ * \brief Plots the time spent in a profile block in each step.
+ * Uses an OMPlot::PlotWindow so the plot can be zoomed, panned and exported like the other plots.
+ */
+/*!
+ * \brief ProfilingPlotWidget::ProfilingPlotWidget
+ * \param pParent
+ */
+ProfilingPlotWidget::ProfilingPlotWidget(QWidget *pParent)
+  : QWidget(pParent)
+{
+  mpPlotWindow = new OMPlot::PlotWindow(QStringList(), this);
+  mpPlotWindow->setPlotType(OMPlot::PlotWindow::PLOT);
+  mpPlotWindow->setTitle("");
+  mpPlotWindow->setLegendPosition("none");
+  mpPlotWindow->setAutoScale(true);
+  mpPlotWindow->setXLabel(tr("time [s]"));
+  mpPlotWindow->getPlot()->setAxisTitle(QwtPlot::yLeft, tr("time per step [s]"));
+  mpPlotWindow->setMinimumHeight(200);
+  /* the curve is not read from a result file so it is a plain qwt curve.
+   * It is kept out of the legend since the legend menu only handles the OMPlot curves.
+   */
+  mpPlotCurve = new QwtPlotCurve;
+  mpPlotCurve->setItemAttribute(QwtPlotItem::Legend, false);
+  mpPlotCurve->setPaintAttribute(QwtPlotCurve::FilterPoints);
+  mpPlotCurve->attach(mpPlotWindow->getPlot());
+  QVBoxLayout *pMainLayout = new QVBoxLayout;
+  pMainLayout->setContentsMargins(0, 0, 0, 0);
+  pMainLayout->addWidget(mpPlotWindow);
+  setLayout(pMainLayout);
+}
+
+/*!
+ * \brief ProfilingPlotWidget::setData
+ * \param times - the simulation time of each step.
+ * \param values - the time spent in the block in each step.
+ */
+void ProfilingPlotWidget::setData(const QVector<double> &times, const QVector<double> &values)
+{
+  mpPlotCurve->setSamples(times.constData(), values.constData(), qMin(times.size(), values.size()));
+  mpPlotWindow->fitInView();
+}
+
+/*!
+ * \brief ProfilingPlotWidget::clear
+ * Removes the samples of the curve.
+ */
+void ProfilingPlotWidget::clear()
+{
+  mpPlotCurve->setSamples(QVector<QPointF>());
+  mpPlotWindow->getPlot()->replot();
+}
+
 TransformationsWidget::TransformationsWidget(QString infoJSONFullFileName, QWidget *pParent)
   : QWidget(pParent), mInfoJSONFullFileName(infoJSONFullFileName)
 {
   if (!mInfoJSONFullFileName.endsWith("_info.json")) {
     mProfJSONFullFileName = "";
     mProfilingDataRealFileName = "";
+    mProfilingDataIntFileName = "";
   } else {
     mProfJSONFullFileName = infoJSONFullFileName.left(infoJSONFullFileName.size() - 9) + "prof.json";
     mProfilingDataRealFileName = infoJSONFullFileName.left(infoJSONFullFileName.size() - 9) + "prof.realdata";
+    mProfilingDataIntFileName = infoJSONFullFileName.left(infoJSONFullFileName.size() - 9) + "prof.intdata";
   }
+  profilingNumSteps = 0;
+  mProfilingFunctionsCount = 0;
+  mCurrentVariable = -1;
   setWindowIcon(QIcon(":/Resources/icons/equational-debugger.svg"));
   setWindowTitle(QString(Helper::applicationName).append(" - ").append(Helper::transformationalDebugger));
   QToolButton *pReloadToolButton = new QToolButton;
@@ -499,14 +939,17 @@ TransformationsWidget::TransformationsWidget(QString infoJSONFullFileName, QWidg
   QFrame *pVariablesFrame = new QFrame;
   pVariablesFrame->setLayout(pVariablesGridLayout);
   /* Defined in tree widget */
-  Label *pDefinedInLabel = new Label(tr("Defined In Equations"));
-  pDefinedInLabel->setObjectName("LabelWithBorder");
+  mpDefinedInLabel = new Label(tr("Defined In Equations"));
+  mpDefinedInLabel->setObjectName("LabelWithBorder");
   mpDefinedInEquationsTreeWidget = new EquationTreeWidget(this);
+  mpInfluencingEquationsCheckBox = new QCheckBox(tr("Show all the equations the variable depends on"));
+  connect(mpInfluencingEquationsCheckBox, SIGNAL(toggled(bool)), SLOT(showInfluencingEquations(bool)));
   QGridLayout *pDefinedInGridLayout = new QGridLayout;
   pDefinedInGridLayout->setSpacing(1);
   pDefinedInGridLayout->setContentsMargins(0, 0, 0, 0);
-  pDefinedInGridLayout->addWidget(pDefinedInLabel, 0, 0);
+  pDefinedInGridLayout->addWidget(mpDefinedInLabel, 0, 0);
   pDefinedInGridLayout->addWidget(mpDefinedInEquationsTreeWidget, 1, 0);
+  pDefinedInGridLayout->addWidget(mpInfluencingEquationsCheckBox, 2, 0);
   QFrame *pDefinedInFrame = new QFrame;
   pDefinedInFrame->setLayout(pDefinedInGridLayout);
   /* Used in tree widget  */
@@ -539,14 +982,25 @@ TransformationsWidget::TransformationsWidget(QString infoJSONFullFileName, QWidg
   /* Equations Heading */
   Label *pEquationsBrowserLabel = new Label(tr("Equations Browser"));
   pEquationsBrowserLabel->setObjectName("LabelWithBorder");
-  /* Equations tree widget */
-  mpEquationsTreeWidget = new EquationTreeWidget(this);
-  mpEquationsTreeWidget->setIndentation(Helper::treeIndentation);
+  /* Equations tree view */
+  mpEquationsTreeView = new EquationTreeView(this);
+  mpEquationTreeModel = new EquationTreeModel(mpEquationsTreeView);
+  mpEquationTreeModel->setDependencyGraph(&mDependencyGraph);
+  mpEquationsTreeView->setModel(mpEquationTreeModel);
+  mpEquationsTreeView->setSortingEnabled(true);
+  mpEquationsTreeView->sortByColumn(0, Qt::AscendingOrder);
+  mpEquationsTreeView->setColumnWidth(0, 55);
+  mpEquationsTreeView->setColumnWidth(1, 60);
+  mpEquationsTreeView->setColumnWidth(2, 200);
+  mpEquationsTreeView->setColumnWidth(3, 55);
+  mpEquationsTreeView->setColumnWidth(4, 80);
+  mpEquationsTreeView->setColumnWidth(5, 80);
+  mpEquationsTreeView->setColumnWidth(6, 60);
   QGridLayout *pEquationsGridLayout = new QGridLayout;
   pEquationsGridLayout->setSpacing(1);
   pEquationsGridLayout->setContentsMargins(0, 0, 0, 0);
   pEquationsGridLayout->addWidget(pEquationsBrowserLabel, 0, 0);
-  pEquationsGridLayout->addWidget(mpEquationsTreeWidget, 1, 0);
+  pEquationsGridLayout->addWidget(mpEquationsTreeView, 1, 0);
   QFrame *pEquationsFrame = new QFrame;
   pEquationsFrame->setLayout(pEquationsGridLayout);
   /* defines tree widget */
@@ -603,6 +1057,26 @@ TransformationsWidget::TransformationsWidget(QString infoJSONFullFileName, QWidg
   pEquationOperationsGridLayout->addWidget(mpEquationOperationsTreeWidget, 1, 0);
   QFrame *pEquationOperationsFrame = new QFrame;
   pEquationOperationsFrame->setLayout(pEquationOperationsGridLayout);
+  /* profiling data */
+  Label *pProfilingLabel = new Label(tr("Profiling"));
+  pProfilingLabel->setObjectName("LabelWithBorder");
+  mpProfilingPlotWidget = new ProfilingPlotWidget;
+  mpProfilingStatisticsLabel = new Label;
+  Label *pCostliestEquationsLabel = new Label(tr("Costliest Equations"));
+  pCostliestEquationsLabel->setObjectName("LabelWithBorder");
+  mpCostliestEquationsTreeWidget = new EquationTreeWidget(this);
+  mpCostliestEquationsTreeWidget->sortByColumn(5, Qt::DescendingOrder);
+  QGridLayout *pProfilingGridLayout = new QGridLayout;
+  pProfilingGridLayout->setSpacing(1);
+  pProfilingGridLayout->setContentsMargins(0, 0, 0, 0);
+  pProfilingGridLayout->addWidget(pProfilingLabel, 0, 0);
+  pProfilingGridLayout->addWidget(mpProfilingPlotWidget, 1, 0);
+  pProfilingGridLayout->addWidget(mpProfilingStatisticsLabel, 2, 0);
+  pProfilingGridLayout->addWidget(pCostliestEquationsLabel, 3, 0);
+  pProfilingGridLayout->addWidget(mpCostliestEquationsTreeWidget, 4, 0);
+  mpProfilingFrame = new QFrame;
+  mpProfilingFrame->setLayout(pProfilingGridLayout);
+  mpProfilingFrame->hide();
   /* TSourceEditor */
   Label *pTSourceEditorBrowserLabel = new Label(tr("Source Browser"));
   pTSourceEditorBrowserLabel->setObjectName("LabelWithBorder");
@@ -676,6 +1150,7 @@ TransformationsWidget::TransformationsWidget(QString infoJSONFullFileName, QWidg
   mpEquationsNestedVerticalSplitter->setContentsMargins(0, 0, 0, 0);
   mpEquationsNestedVerticalSplitter->addWidget(mpEquationsNestedHorizontalSplitter);
   mpEquationsNestedVerticalSplitter->addWidget(pEquationOperationsFrame);
+  mpEquationsNestedVerticalSplitter->addWidget(mpProfilingFrame);
   /* equations horizontal splitter */
   mpEquationsHorizontalSplitter = new QSplitter;
   mpEquationsHorizontalSplitter->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -789,8 +1264,12 @@ static void variantToSource(QVariantMap var, OMInfo &info, QStringList &types, Q
   }
 }
 
-static OMEquation* getOMEquation(QList<OMEquation*> equations, int index)
+static OMEquation* getOMEquation(const QList<OMEquation*> &equations, int index)
 {
+  /* the equations are stored at their index */
+  if (index > 0 && index < equations.size() && equations[index]->index == index) {
+    return equations[index];
+  }
   for (int i = 1 ; i < equations.size() ; i++) {
     if (equations[i]->index == index) {
       return equations[i];
@@ -799,82 +1278,255 @@ static OMEquation* getOMEquation(QList<OMEquation*> equations, int index)
   return NULL;
 }
 
+/*!
+ * \class JsonMemberHandler
+ * \brief Reads the members of a JSON document without building the whole document.
+ * Each element of a top level array or object member e.g., each equation of "equations", is built as a small QVariant and passed to
+ * element() as soon as it is read. The scalar top level members are passed to member().
+ */
+class JsonMemberHandler : public QJson::StreamHandler
+{
+public:
+  bool startObject() {return startContainer(true);}
+  bool key(const QString &key) {
+    mNodes.last().key = key;
+    return true;
+  }
+  bool endObject() {return endContainer();}
+  bool startArray() {return startContainer(false);}
+  bool endArray() {return endContainer();}
+  bool value(const QVariant &value) {return addValue(value);}
+protected:
+  virtual bool member(const QString &name, const QVariant &value) {
+    Q_UNUSED(name);
+    Q_UNUSED(value);
+    return true;
+  }
+  virtual bool element(const QString &member, const QString &key, const QVariant &value) = 0;
+private:
+  struct Node {
+    bool isObject;
+    QString key;
+    QVariantMap map;
+    QVariantList list;
+  };
+  QList<Node> mNodes;
+
+  bool startContainer(bool isObject) {
+    Node node;
+    node.isObject = isObject;
+    mNodes.append(node);
+    return true;
+  }
+  bool endContainer() {
+    Node node = mNodes.takeLast();
+    /* the document and its members are not built */
+    if (mNodes.size() < 2) {
+      return true;
+    }
+    return addValue(node.isObject ? QVariant(node.map) : QVariant(node.list));
+  }
+  bool addValue(const QVariant &value) {
+    switch (mNodes.size()) {
+      case 0:
+        return true;
+      case 1:
+        return member(mNodes[0].key, value);
+      case 2:
+        return element(mNodes[0].key, mNodes[1].key, value);
+      default:
+        Node &node = mNodes.last();
+        if (node.isObject) {
+          node.map.insert(node.key, value);
+        } else {
+          node.list.append(value);
+        }
+        return true;
+    }
+  }
+};
+
+/*!
+ * \class InfoJsonHandler
+ * \brief Fills the variables and the equations from the _info.json file.
+ */
+class InfoJsonHandler : public JsonMemberHandler
+{
+public:
+  InfoJsonHandler(QHash<QString,OMVariable> &variables, QList<OMEquation*> &equations)
+    : hasOperationsEnabled(false), mVariables(variables), mEquations(equations), mEquationsCount(0) {}
+  bool hasOperationsEnabled;
+  QString mErrorString;
+  /* the equations referenced as parents but not read */
+  bool hasMissingEquations() const {return mEquations.size() > mEquationsCount;}
+protected:
+  bool element(const QString &member, const QString &key, const QVariant &value) {
+    if (member == "variables") {
+      readVariable(key, value.toMap());
+    } else if (member == "equations") {
+      return readEquation(value.toMap());
+    }
+    return true;
+  }
+private:
+  QHash<QString,OMVariable> &mVariables;
+  QList<OMEquation*> &mEquations;
+  int mEquationsCount;
+
+  /* the parents can be read after their children */
+  OMEquation* getEquation(int index) {
+    while (mEquations.size() <= index) {
+      mEquations << new OMEquation();
+    }
+    return mEquations[index];
+  }
+  void readVariable(const QString &name, const QVariantMap &value) {
+    /* update in place, the equations may have been read already */
+    OMVariable &var = mVariables[name];
+    var.name = name;
+    var.comment = value["comment"].toString();
+    variantToSource(value["source"].toMap(), var.info, var.types, var.ops);
+    if (!hasOperationsEnabled && var.ops.size() > 0) {
+      hasOperationsEnabled = true;
+    }
+  }
+  bool readEquation(const QVariantMap &veq) {
+    int i = mEquationsCount++;
+    if (veq["eqIndex"].toInt() != i) {
+      mErrorString = QString("got index ") + veq["eqIndex"].toString() + QString(" expected ") + QString::number(i);
+      return false;
+    }
+    OMEquation *eq = getEquation(i);
+    eq->section = veq["section"].toString();
+    eq->index = i;
+    eq->profileBlock = -1;
+    if (veq.find("parent") != veq.end()) {
+      eq->parent = veq["parent"].toInt();
+      getEquation(eq->parent)->eqs << eq->index;
+    } else {
+      eq->parent = 0;
+    }
+    if (veq.find("defines") != veq.end()) {
+      eq->defines = variantListToStringList(veq["defines"].toList());
+      foreach (QString v, eq->defines) {
+        mVariables[v].definedIn << eq->index;
+      }
+    }
+    if (veq.find("uses") != veq.end()) {
+      eq->depends = variantListToStringList(veq["uses"].toList());
+      foreach (QString v, eq->depends) {
+        mVariables[v].usedIn << eq->index;
+      }
+    }
+    eq->text = variantListToStringList(veq["equation"].toList());
+    eq->tag = veq["tag"].toString();
+    if (veq.find("display") != veq.end()) {
+      eq->display = veq["display"].toString();
+    } else {
+      eq->display = eq->tag;
+    }
+    variantToSource(veq["source"].toMap(), eq->info, eq->types, eq->ops);
+    if (!hasOperationsEnabled && eq->ops.size() > 0) {
+      hasOperationsEnabled = true;
+    }
+    return true;
+  }
+};
+
+/*!
+ * \class ProfilingJsonHandler
+ * \brief Reads the profile blocks of the _prof.json file.
+ * The totals can be written after the blocks so the blocks are kept in a compact form and applied by apply().
+ */
+class ProfilingJsonHandler : public JsonMemberHandler
+{
+public:
+  ProfilingJsonHandler() : mTotalStepsTime(0), mNumSteps(0), mFunctionsCount(0) {}
+  int numSteps() const {return mNumSteps;}
+  int functionsCount() const {return mFunctionsCount;}
+  int blocksCount() const {return mFunctionsCount + mProfileBlocks.size();}
+  void apply(QList<OMEquation*> &equations) const {
+    for (int i = 0 ; i < mProfileBlocks.size() ; i++) {
+      const ProfileBlock &block = mProfileBlocks[i];
+      if (block.id < 0 || block.id >= equations.size()) {
+        continue;
+      }
+      OMEquation *eq = equations[block.id];
+      eq->ncall = block.ncall;
+      eq->maxTime = block.maxTime;
+      eq->time = block.time;
+      eq->fraction = block.time / mTotalStepsTime;
+      eq->profileBlock = i + mFunctionsCount;
+    }
+  }
+protected:
+  bool member(const QString &name, const QVariant &value) {
+    if (name == "totalTimeProfileBlocks") {
+      mTotalStepsTime = value.toDouble();
+    } else if (name == "numStep") {
+      mNumSteps = value.toInt();
+    }
+    return true;
+  }
+  bool element(const QString &member, const QString &key, const QVariant &value) {
+    Q_UNUSED(key);
+    if (member == "functions") {
+      mFunctionsCount++;
+    } else if (member == "profileBlocks") {
+      QVariantMap eq = value.toMap();
+      ProfileBlock block;
+      block.id = eq["id"].toInt();
+      block.ncall = eq["ncall"].toInt();
+      block.time = eq["time"].toDouble();
+      block.maxTime = eq["maxTime"].toDouble();
+      mProfileBlocks.append(block);
+    }
+    return true;
+  }
+private:
+  struct ProfileBlock {
+    int id, ncall;
+    double time, maxTime;
+  };
+  QVector<ProfileBlock> mProfileBlocks;
+  double mTotalStepsTime;
+  int mNumSteps;
+  int mFunctionsCount;
+};
+
 void TransformationsWidget::loadTransformations()
 {
   QFile file(mInfoJSONFullFileName);
   mEquations.clear();
   mVariables.clear();
   hasOperationsEnabled = false;
+  mProfilingData.close();
+  mProfileBlockEquations.clear();
+  mProfilingFunctionsCount = 0;
+  mDependencyGraph.clear();
+  mCurrentVariable = -1;
   if (mInfoJSONFullFileName.endsWith(".json")) {
-    QJson::Parser parser;
-    bool ok;
-    QVariantMap result;
-    result = parser.parse(&file, &ok).toMap();
+    /* stream the file, the info files of large models don't fit in memory as a QVariant */
+    QJson::StreamReader reader;
+    InfoJsonHandler handler(mVariables, mEquations);
+    bool ok = reader.parse(&file, &handler);
+    if (ok && handler.hasMissingEquations()) {
+      handler.mErrorString = QString("missing equation ") + QString::number(mEquations.size() - 1);
+      ok = false;
+    }
     if (!ok) {
-      QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::parsingFailedJson), Helper::parsingFailedJson + ": " + mInfoJSONFullFileName, Helper::ok);
+      QString errorString = handler.mErrorString.isEmpty() ? reader.errorString() : handler.mErrorString;
+      QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::parsingFailedJson), Helper::parsingFailedJson + ": " + mInfoJSONFullFileName + ": " + errorString, Helper::ok);
       return;
     }
-    QVariantMap vars = result["variables"].toMap();
-    QVariantList eqs = result["equations"].toList();
-    for(QVariantMap::const_iterator iter = vars.begin(); iter != vars.end(); ++iter) {
-      QVariantMap value = iter.value().toMap();
-      OMVariable *var = new OMVariable();
-      var->name = iter.key();
-      var->comment = value["comment"].toString();
-      variantToSource(value["source"].toMap(), var->info, var->types, var->ops);
-      if (!hasOperationsEnabled && var->ops.size() > 0) {
-        hasOperationsEnabled = true;
-      }
-      mVariables[iter.key()] = *var;
-    }
+    hasOperationsEnabled = handler.hasOperationsEnabled;
+    mDependencyGraph.build(mEquations);
     mpTVariablesTreeModel->insertTVariablesItems(mVariables);
-    for (int i=0; i<eqs.size(); i++) {
-      mEquations << new OMEquation();
-    }
-    for (int i=0; i<eqs.size(); i++) {
-      QVariantMap veq = eqs[i].toMap();
-      OMEquation *eq = mEquations[i];
-      eq->section = veq["section"].toString();
-      if (veq["eqIndex"].toInt() != i) {
-        QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::parsingFailedJson), Helper::parsingFailedJson + QString(": got index ") + veq["eqIndex"].toString() + QString(" expected ") + QString::number(i), Helper::ok);
-        return;
-      }
-      eq->index = i;
-      eq->profileBlock = -1;
-      if (veq.find("parent") != veq.end()) {
-        eq->parent = veq["parent"].toInt();
-        mEquations[eq->parent]->eqs << eq->index;
-      } else {
-        eq->parent = 0;
-      }
-      if (veq.find("defines") != veq.end()) {
-        eq->defines = variantListToStringList(veq["defines"].toList());
-        foreach (QString v, eq->defines) {
-          mVariables[v].definedIn << eq->index;
-        }
-      }
-      if (veq.find("uses") != veq.end()) {
-        eq->depends = variantListToStringList(veq["uses"].toList());
-        foreach (QString v, eq->depends) {
-          mVariables[v].usedIn << eq->index;
-        }
-      }
-      eq->text = variantListToStringList(veq["equation"].toList());
-      eq->tag = veq["tag"].toString();
-      if (veq.find("display") != veq.end()) {
-        eq->display = veq["display"].toString();
-      } else {
-        eq->display = eq->tag;
-      }
-      variantToSource(veq["source"].toMap(), eq->info, eq->types, eq->ops);
-      if (!hasOperationsEnabled && eq->ops.size() > 0) {
-        hasOperationsEnabled = true;
-      }
-    }
     parseProfiling(mProfJSONFullFileName);
     fetchEquations();
   } else {
     mpInfoXMLFileHandler = new MyHandler(file,mVariables,mEquations);
+    mDependencyGraph.build(mEquations);
     mpTVariablesTreeModel->insertTVariablesItems(mVariables);
     /* load equations */
     parseProfiling(mProfJSONFullFileName);
@@ -883,40 +1535,60 @@ void TransformationsWidget::loadTransformations()
   }
 }
 
-void TransformationsWidget::fetchDefinedInEquations(const OMVariable &variable)
+/*!
+ * \brief addEquationItems
+ * Adds the equations to the tree in one go so that the tree is sorted once.
+ * \param pEquationTreeWidget
+ * \param equations
+ * \param pBegin
+ * \param pEnd
+ */
+static void addEquationItems(EquationTreeWidget *pEquationTreeWidget, const QList<OMEquation*> &equations, const int *pBegin, const int *pEnd)
+{
+  QList<QTreeWidgetItem*> items;
+  for (const int *pIndex = pBegin ; pIndex != pEnd ; ++pIndex) {
+    OMEquation *equation = getOMEquation(equations, *pIndex);
+    if (!equation) {
+      continue;
+    }
+    QStringList values;
+    values << QString::number(*pIndex) << equation->section << equation->toString();
+    QTreeWidgetItem *pEquationTreeItem = new IntegerTreeWidgetItem(values, pEquationTreeWidget);
+    pEquationTreeItem->setToolTip(0, values[0]);
+    pEquationTreeItem->setToolTip(1, values[1]);
+    pEquationTreeItem->setToolTip(2, values[2]);
+    items.append(pEquationTreeItem);
+  }
+  pEquationTreeWidget->addTopLevelItems(items);
+}
+
+/*!
+ * \brief TransformationsWidget::fetchDefinedInEquations
+ * Shows the equations defining the variable or, if requested, all the equations the variable depends on.
+ * \param variable - the id of the variable in the dependency graph.
+ */
+void TransformationsWidget::fetchDefinedInEquations(int variable)
 {
   /* Clear the defined in tree. */
   clearTreeWidgetItems(mpDefinedInEquationsTreeWidget);
   /* add defined in equations */
-  for (int i=0; i<variable.definedIn.size(); i++)
-  {
-    OMEquation *equation = getOMEquation(mEquations, variable.definedIn[i]);
-    QStringList values;
-    values << QString::number(variable.definedIn[i]) << equation->section << equation->toString();
-    QTreeWidgetItem *pDefinedInTreeItem = new IntegerTreeWidgetItem(values, mpDefinedInEquationsTreeWidget);
-    pDefinedInTreeItem->setToolTip(0, values[0]);
-    pDefinedInTreeItem->setToolTip(1, values[1]);
-    pDefinedInTreeItem->setToolTip(2, values[2]);
-    mpDefinedInEquationsTreeWidget->addTopLevelItem(pDefinedInTreeItem);
+  if (mpInfluencingEquationsCheckBox->isChecked()) {
+    QVector<int> equations;
+    mDependencyGraph.influences(variable, &equations);
+    addEquationItems(mpDefinedInEquationsTreeWidget, mEquations, equations.constData(), equations.constData() + equations.size());
+  } else {
+    DependencyGraph::Range definedIn = mDependencyGraph.definedInEquations(variable);
+    addEquationItems(mpDefinedInEquationsTreeWidget, mEquations, definedIn.begin(), definedIn.end());
   }
 }
 
-void TransformationsWidget::fetchUsedInEquations(const OMVariable &variable)
+void TransformationsWidget::fetchUsedInEquations(int variable)
 {
   /* Clear the used in tree. */
   clearTreeWidgetItems(mpUsedInEquationsTreeWidget);
   /* add used in equations */
-  foreach (int index, variable.usedIn)
-  {
-    OMEquation *equation = getOMEquation(mEquations, index);
-    QStringList values;
-    values << QString::number(index) << equation->section << equation->toString();
-    QTreeWidgetItem *pUsedInTreeItem = new IntegerTreeWidgetItem(values, mpUsedInEquationsTreeWidget);
-    pUsedInTreeItem->setToolTip(0, values[0]);
-    pUsedInTreeItem->setToolTip(1, values[1]);
-    pUsedInTreeItem->setToolTip(2, values[2]);
-    mpUsedInEquationsTreeWidget->addTopLevelItem(pUsedInTreeItem);
-  }
+  DependencyGraph::Range usedIn = mDependencyGraph.usedInEquations(variable);
+  addEquationItems(mpUsedInEquationsTreeWidget, mEquations, usedIn.begin(), usedIn.end());
 }
 
 void TransformationsWidget::fetchOperations(const OMVariable &variable)
@@ -944,79 +1616,37 @@ void TransformationsWidget::fetchOperations(const OMVariable &variable)
   mpVariableOperationsTreeWidget->resizeColumnToContents(0);
 }
 
-QTreeWidgetItem* TransformationsWidget::makeEquationTreeWidgetItem(int equationIndex, int allowChild)
-{
-  OMEquation *equation = mEquations[equationIndex];
-  if (!allowChild && equation->parent) {
-    return NULL; // Only output equations in one position
-  }
-  QStringList values;
-  values << QString::number(equation->index)
-         << equation->section
-         << equation->toString();
-  if (equation->profileBlock >= 0) {
-    values << QString::number(equation->ncall)
-         << QString::number(equation->maxTime, 'g', 3)
-         << QString::number(equation->time, 'g', 3)
-         << QString::number(100 * equation->fraction, 'g', 3) + "%";
-  }
-
-  QTreeWidgetItem *pEquationTreeItem = new IntegerTreeWidgetItem(values, mpEquationsTreeWidget);
-  pEquationTreeItem->setToolTip(0, values[0]);
-  pEquationTreeItem->setToolTip(1, values[1]);
-  pEquationTreeItem->setToolTip(2, "<html><div style=\"margin:3px;\">" +
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-  QString(values[2]).toHtmlEscaped()
-#else /* Qt4 */
-  Qt::escape(values[2])
-#endif
-  + "</div></html>");
-  pEquationTreeItem->setToolTip(4, "Maximum execution time in a single step");
-  pEquationTreeItem->setToolTip(5, "Total time excluding the overhead of measuring.");
-  pEquationTreeItem->setToolTip(6, "Fraction of time, 100% is the total time of all non-child equations.");
-  return pEquationTreeItem;
-}
-
+/*!
+ * \brief TransformationsWidget::fetchEquations
+ * Shows the equations in the equations browser.
+ */
 void TransformationsWidget::fetchEquations()
 {
-  for (int i = 1 ; i < mEquations.size() ; i++)
-  {
-    QTreeWidgetItem *pEquationTreeItem = makeEquationTreeWidgetItem(i,0);
-    if (pEquationTreeItem) {
-      mpEquationsTreeWidget->addTopLevelItem(pEquationTreeItem);
-      fetchNestedEquations(pEquationTreeItem, i);
-    }
+  mpEquationTreeModel->insertEquations(mEquations);
+  /* with profiling the costliest equations come first, unless the user has chosen another order */
+  QHeaderView *pHeaderView = mpEquationsTreeView->header();
+  if (!mProfileBlockEquations.isEmpty() && pHeaderView->sortIndicatorSection() == 0 && pHeaderView->sortIndicatorOrder() == Qt::AscendingOrder) {
+    pHeaderView->setSortIndicator(5, Qt::DescendingOrder);
   }
+  mpEquationsTreeView->sortByColumn(pHeaderView->sortIndicatorSection(), pHeaderView->sortIndicatorOrder());
+  fetchCostliestEquations();
 }
 
-void TransformationsWidget::fetchNestedEquations(QTreeWidgetItem *pParentTreeWidgetItem, int index)
-{
-  foreach (int nestedIndex, mEquations[index]->eqs)
-  {
-    // OMEquation *nestedEquation = mpInfoXMLFileHandler->equations[nestedIndex];
-    QTreeWidgetItem *pNestedEquationTreeItem = makeEquationTreeWidgetItem(nestedIndex,1);
-    if (pNestedEquationTreeItem) {
-      pParentTreeWidgetItem->addChild(pNestedEquationTreeItem);
-      fetchNestedEquations(pNestedEquationTreeItem, nestedIndex);
-    }
-  }
-}
-
-QTreeWidgetItem* TransformationsWidget::findEquationTreeItem(int equationIndex)
+/*!
+ * \brief TransformationsWidget::selectEquation
+ * Selects the equation in the equations browser.
+ * \param equationIndex
+ */
+void TransformationsWidget::selectEquation(int equationIndex)
 {
-  QTreeWidgetItemIterator it(mpEquationsTreeWidget);
-  while (*it)
-  {
-    QTreeWidgetItem *pEquationTreeItem = dynamic_cast<QTreeWidgetItem*>(*it);
-    if (pEquationTreeItem->text(0).toInt() == equationIndex)
-      return pEquationTreeItem;
-    ++it;
+  QModelIndex index = mpEquationTreeModel->equationModelIndex(equationIndex);
+  if (index.isValid()) {
+    mpEquationsTreeView->clearSelection();
+    mpEquationsTreeView->setCurrentIndex(index);
+    mpEquationsTreeView->scrollTo(index);
   }
-  return 0;
 }
 
-#include <qwt_plot.h>
-
 void TransformationsWidget::fetchEquationData(int equationIndex)
 {
   OMEquation *equation = getOMEquation(mEquations, equationIndex);
@@ -1026,39 +1656,8 @@ void TransformationsWidget::fetchEquationData(int equationIndex)
   fetchDepends(equation);
   /* fetch operations */
   fetchOperations(equation);
-
-  /* TODO: This data is correct. Add this to some widget thingy somewhere.
-   * Maybe a small one that you can click to enlarge.
-   * Also add the count one (Model_prof.intdata)
-   */
-#if 0
-  if (equation->profileBlock >= 0) {
-    QFile file(mProfilingDataRealFileName);
-    if (file.open(QIODevice::ReadOnly)) {
-
-      QwtPlot *w;
-      long c1;
-      w = new QwtPlot();
-
-      size_t rowSize = sizeof(double) * profilingNumSteps;
-      file.seek(0);
-      QByteArray datax = file.read(rowSize);
-      file.seek((equation->profileBlock+2) * rowSize);
-      QByteArray datay = file.read(rowSize);
-      double *x = (double*)datax.data();
-      double *y = (double*)datay.data();
-
-      QwtPlotCurve *curve = new QwtPlotCurve("Curve 1");
-
-      curve->setData(x, y, profilingNumSteps);
-      curve->attach(w);
-      w->replot();
-      w->show();
-    }
-  } else {
-    qDebug() << equation->profileBlock;
-  }
-#endif
+  /* fetch profiling data */
+  fetchProfilingData(equation);
 
   if (!equation->info.isValid)
     return;
@@ -1138,13 +1737,7 @@ void TransformationsWidget::fetchOperations(OMEquation *equation)
 
 void TransformationsWidget::clearTreeWidgetItems(QTreeWidget *pTreeWidget)
 {
-  int i = 0;
-  while(i < pTreeWidget->topLevelItemCount())
-  {
-    qDeleteAll(pTreeWidget->topLevelItem(i)->takeChildren());
-    delete pTreeWidget->topLevelItem(i);
-    i = 0;   //Restart iteration
-  }
+  pTreeWidget->clear();
 }
 
 void TransformationsWidget::reloadTransformations()
@@ -1169,20 +1762,23 @@ void TransformationsWidget::reloadTransformations()
   mpTreeSearchFilters->getCaseSensitiveCheckBox()->blockSignals(signalsState);
   mpTVariableTreeProxyModel->setFilterRegExp(QRegExp());
   /* clear equations tree */
-  clearTreeWidgetItems(mpEquationsTreeWidget);
+  mpEquationTreeModel->clearEquations();
   /* clear defines in tree */
   clearTreeWidgetItems(mpDefinesVariableTreeWidget);
   /* clear depends tree */
   clearTreeWidgetItems(mpDependsVariableTreeWidget);
   /* clear equation operations tree */
   clearTreeWidgetItems(mpEquationOperationsTreeWidget);
+  /* clear profiling data */
+  clearTreeWidgetItems(mpCostliestEquationsTreeWidget);
+  mpProfilingPlotWidget->clear();
+  mpProfilingStatisticsLabel->clear();
+  mpProfilingFrame->hide();
   /* clear TSourceEditor */
   mpTSourceEditorFileLabel->setText("");
   mpTSourceEditorFileLabel->hide();
   mpTransformationsEditor->getPlainTextEdit()->clear();
   mpTSourceEditorInfoBar->hide();
-  /* Clear the equations tree. */
-  clearTreeWidgetItems(mpEquationsTreeWidget);
   /* initialize all fields again */
   loadTransformations();
 }
@@ -1214,10 +1810,11 @@ void TransformationsWidget::fetchVariableData(const QModelIndex &index)
     return;
 
   const OMVariable &variable = mVariables[pTVariableTreeItem->getVariableName()];
+  mCurrentVariable = mDependencyGraph.variableId(pTVariableTreeItem->getVariableName());
   /* fetch defined in equations */
-  fetchDefinedInEquations(variable);
+  fetchDefinedInEquations(mCurrentVariable);
   /* fetch used in equations */
-  fetchUsedInEquations(variable);
+  fetchUsedInEquations(mCurrentVariable);
   /* fetch operations */
   fetchOperations(variable);
 
@@ -1236,6 +1833,19 @@ void TransformationsWidget::fetchVariableData(const QModelIndex &index)
   }
 }
 
+/*!
+ * \brief TransformationsWidget::showInfluencingEquations
+ * Switches the defined in equations between the defining equations and all the equations the variable depends on.
+ * \param show
+ */
+void TransformationsWidget::showInfluencingEquations(bool show)
+{
+  mpDefinedInLabel->setText(show ? tr("Influencing Equations") : tr("Defined In Equations"));
+  if (mCurrentVariable >= 0) {
+    fetchDefinedInEquations(mCurrentVariable);
+  }
+}
+
 void TransformationsWidget::fetchEquationData(QTreeWidgetItem *pEquationTreeItem, int column)
 {
   Q_UNUSED(column);
@@ -1243,20 +1853,23 @@ void TransformationsWidget::fetchEquationData(QTreeWidgetItem *pEquationTreeItem
     return;
 
   int equationIndex = pEquationTreeItem->text(0).toInt();
-  /* if the sender is mpEquationsTreeWidget then there is no need to select the item. */
-  EquationTreeWidget *pSender = qobject_cast<EquationTreeWidget*>(sender());
-  if (pSender != mpEquationsTreeWidget)
-  {
-    QTreeWidgetItem *pTreeWidgetItem = findEquationTreeItem(equationIndex);
-    if (pTreeWidgetItem)
-    {
-      mpEquationsTreeWidget->clearSelection();
-      mpEquationsTreeWidget->setCurrentItem(pTreeWidgetItem);
-    }
-  }
+  selectEquation(equationIndex);
   fetchEquationData(equationIndex);
 }
 
+/*!
+ * \brief TransformationsWidget::fetchEquationData
+ * Slot activated when an equation of the equations browser is double clicked.
+ * \param index
+ */
+void TransformationsWidget::fetchEquationData(const QModelIndex &index)
+{
+  if (!index.isValid()) {
+    return;
+  }
+  fetchEquationData(static_cast<OMEquation*>(index.internalPointer())->index);
+}
+
 void TransformationsWidget::parseProfiling(QString fileName)
 {
   QFile *file = new QFile(fileName);
@@ -1264,22 +1877,97 @@ void TransformationsWidget::parseProfiling(QString fileName)
     delete file;
     return;
   }
-  QJson::Parser parser;
-  bool ok;
-  QVariantMap result = parser.parse(file, &ok).toMap();
-  double totalStepsTime = result["totalTimeProfileBlocks"].toDouble();
-  QVariantList functions = result["functions"].toList();
-  QVariantList list = result["profileBlocks"].toList();
-  profilingNumSteps = result["numStep"].toInt() + 1; // Initialization is not a step, but part of the file
-  for (int i=0; i<list.size(); i++) {
-    QVariantMap eq = list[i].toMap();
-    long id = eq["id"].toInt();
-    double time = eq["time"].toDouble();
-    mEquations[id]->ncall = eq["ncall"].toInt();
-    mEquations[id]->maxTime = eq["maxTime"].toDouble();
-    mEquations[id]->time = time;
-    mEquations[id]->fraction = time / totalStepsTime;
-    mEquations[id]->profileBlock = i + functions.size();
-  }
+  QJson::StreamReader reader;
+  ProfilingJsonHandler handler;
+  reader.parse(file, &handler);
+  profilingNumSteps = handler.numSteps() + 1; // Initialization is not a step, but part of the file
+  handler.apply(mEquations);
   delete file;
+  /* map the profile blocks to the equations */
+  mProfilingFunctionsCount = handler.functionsCount();
+  mProfileBlockEquations.fill(-1, handler.blocksCount());
+  for (int i = 1 ; i < mEquations.size() ; i++) {
+    int profileBlock = mEquations[i]->profileBlock;
+    if (profileBlock >= 0 && profileBlock < mProfileBlockEquations.size()) {
+      mProfileBlockEquations[profileBlock] = mEquations[i]->index;
+    }
+  }
+  /* the per step data is mapped into memory and read on demand */
+  if (!QFile::exists(mProfilingDataRealFileName)) {
+    return;
+  }
+  if (!mProfilingData.open(mProfilingDataRealFileName, mProfilingDataIntFileName, handler.blocksCount())) {
+    MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, mProfilingData.errorString(),
+                                                          Helper::scriptingKind, Helper::warningLevel));
+  } else if (mProfilingData.stepsCount() != profilingNumSteps) {
+    MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                          tr("The profiling data file %1 has %2 steps, expected %3.")
+                                                          .arg(mProfilingDataRealFileName).arg(mProfilingData.stepsCount()).arg(profilingNumSteps),
+                                                          Helper::scriptingKind, Helper::warningLevel));
+  }
+}
+
+/*!
+ * \brief TransformationsWidget::fetchCostliestEquations
+ * Lists the equations with the largest total time measured in the profiling data.
+ */
+void TransformationsWidget::fetchCostliestEquations()
+{
+  clearTreeWidgetItems(mpCostliestEquationsTreeWidget);
+  mpProfilingPlotWidget->clear();
+  mpProfilingStatisticsLabel->clear();
+  mpProfilingFrame->setVisible(mProfilingData.isOpen());
+  if (!mProfilingData.isOpen()) {
+    return;
+  }
+  double totalTime = 0;
+  for (int block = mProfilingFunctionsCount ; block < mProfilingData.blocksCount() ; block++) {
+    if (mProfileBlockEquations[block] >= 0 && getOMEquation(mEquations, mProfileBlockEquations[block])->parent == 0) {
+      totalTime += mProfilingData.blockStatistics(block).mTotalTime;
+    }
+  }
+  QVector<int> blocks = mProfilingData.costliestBlocks(20, mProfilingFunctionsCount);
+  foreach (int block, blocks) {
+    OMEquation *equation = mProfileBlockEquations[block] >= 0 ? getOMEquation(mEquations, mProfileBlockEquations[block]) : 0;
+    if (!equation) {
+      continue;
+    }
+    const ProfilingData::BlockStatistics &blockStatistics = mProfilingData.blockStatistics(block);
+    QStringList values;
+    values << QString::number(equation->index) << equation->section << equation->toString()
+           << (mProfilingData.hasCalls() ? QString::number(blockStatistics.mCalls) : QString())
+           << QString::number(blockStatistics.mMaxTime, 'g', 3) << QString::number(blockStatistics.mTotalTime, 'g', 3)
+           << (totalTime > 0 ? QString::number(100 * blockStatistics.mTotalTime / totalTime, 'g', 3) + "%" : QString());
+    QTreeWidgetItem *pCostliestEquationTreeItem = new IntegerTreeWidgetItem(values, mpCostliestEquationsTreeWidget);
+    pCostliestEquationTreeItem->setToolTip(0, values[0]);
+    pCostliestEquationTreeItem->setToolTip(1, values[1]);
+    pCostliestEquationTreeItem->setToolTip(2, values[2]);
+    mpCostliestEquationsTreeWidget->addTopLevelItem(pCostliestEquationTreeItem);
+  }
+}
+
+/*!
+ * \brief TransformationsWidget::fetchProfilingData
+ * Plots the time spent in the equation in each step and shows its distribution.
+ * \param equation
+ */
+void TransformationsWidget::fetchProfilingData(OMEquation *equation)
+{
+  mpProfilingPlotWidget->clear();
+  mpProfilingStatisticsLabel->clear();
+  if (!mProfilingData.isOpen() || equation->profileBlock < 0 || equation->profileBlock >= mProfilingData.blocksCount()) {
+    return;
+  }
+  mpProfilingPlotWidget->setData(mProfilingData.times(), mProfilingData.blockTimes(equation->profileBlock));
+  const ProfilingData::BlockStatistics &blockStatistics = mProfilingData.blockStatistics(equation->profileBlock);
+  ProfilingData::BlockPercentiles percentiles = mProfilingData.blockPercentiles(equation->profileBlock);
+  QString statistics = tr("Equation %1 is called in %2 of %3 steps").arg(equation->index).arg(percentiles.mCalledSteps)
+      .arg(mProfilingData.stepsCount());
+  if (mProfilingData.hasCalls()) {
+    statistics.append(tr(", %1 calls").arg(blockStatistics.mCalls));
+  }
+  statistics.append(tr(".\nTime per step: mean %1, median %2, 90th percentile %3, 99th percentile %4, max %5.")
+                    .arg(percentiles.mMean, 0, 'g', 3).arg(percentiles.mMedian, 0, 'g', 3).arg(percentiles.mPercentile90, 0, 'g', 3)
+                    .arg(percentiles.mPercentile99, 0, 'g', 3).arg(percentiles.mMax, 0, 'g', 3));
+  mpProfilingStatisticsLabel->setText(statistics);
 }
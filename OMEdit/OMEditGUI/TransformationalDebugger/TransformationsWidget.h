@@ -39,8 +39,16 @@
 #include <QSortFilterProxyModel>
 #include <QTreeWidget>
 #include <QSplitter>
+#include <QCheckBox>
+#include <QThread>
 
 #include "OMDumpXML.h"
+#include "ProfilingData.h"
+#include "DependencyGraph.h"
+#include "TVariablesTreeBuilder.h"
+#include "PlotWindow.h"
+
+#include <qwt_plot_curve.h>
 
 class TransformationsWidget;
 class TVariablesTreeView;
@@ -75,11 +83,31 @@ private:
   QString mLineNumber;
 };
 
+/*!
+ * \class TVariablesTreeBuilderThread
+ * \brief Builds the items of the variables browser outside of the GUI thread.
+ */
+class TVariablesTreeBuilderThread : public QThread
+{
+  Q_OBJECT
+public:
+  TVariablesTreeBuilderThread(const QVector<TVariablesTreeBuilder::Variable> &variables, TVariablesTreeItem *pRootTVariablesTreeItem,
+                              QObject *pParent = 0);
+  QList<TVariablesTreeItem*> getTopLevelItems() const {return mTopLevelItems;}
+protected:
+  void run();
+private:
+  QVector<TVariablesTreeBuilder::Variable> mVariables;
+  TVariablesTreeItem *mpRootTVariablesTreeItem;
+  QList<TVariablesTreeItem*> mTopLevelItems;
+};
+
 class TVariablesTreeModel : public QAbstractItemModel
 {
   Q_OBJECT
 public:
   TVariablesTreeModel(TVariablesTreeView *pTVariablesTreeView);
+  ~TVariablesTreeModel();
   TVariablesTreeItem* getRootTVariablesTreeItem() {return mpRootTVariablesTreeItem;}
   int columnCount(const QModelIndex &parent = QModelIndex()) const;
   int rowCount(const QModelIndex &parent = QModelIndex()) const;
@@ -92,12 +120,17 @@ public:
   QModelIndex tVariablesTreeItemIndex(const TVariablesTreeItem *pTVariablesTreeItem) const;
   QModelIndex tVariablesTreeItemIndexHelper(const TVariablesTreeItem *pTVariablesTreeItem, const TVariablesTreeItem *pParentTVariablesTreeItem,
                                            const QModelIndex &parentIndex) const;
-  void insertTVariablesItems(QHashIterator<QString, OMVariable> variables);
+  void insertTVariablesItems(const QHash<QString, OMVariable> &variables);
   void clearTVariablesTreeItems();
 private:
   TVariablesTreeView *mpTVariablesTreeView;
   TVariablesTreeItem *mpRootTVariablesTreeItem;
   QHash<QString, QHash<QString,QString> > mScalarVariablesList;
+  TVariablesTreeBuilderThread *mpTVariablesTreeBuilderThread;
+
+  void discardTVariablesTreeBuilderThread();
+private slots:
+  void tVariablesTreeBuilt();
 };
 
 class TVariableTreeProxyModel : public QSortFilterProxyModel
@@ -152,6 +185,62 @@ private:
   TransformationsWidget *mpTransformationWidget;
 };
 
+class EquationTreeModel : public QAbstractItemModel
+{
+  Q_OBJECT
+public:
+  EquationTreeModel(QObject *pParent = 0);
+  int columnCount(const QModelIndex &parent = QModelIndex()) const;
+  int rowCount(const QModelIndex &parent = QModelIndex()) const;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+  QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
+  QModelIndex parent(const QModelIndex & index) const;
+  QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
+  Qt::ItemFlags flags(const QModelIndex &index) const;
+  void sort(int column, Qt::SortOrder order = Qt::AscendingOrder);
+  QModelIndex equationModelIndex(int equationIndex, int column = 0) const;
+  void insertEquations(const QList<OMEquation*> &equations);
+  void clearEquations();
+  void setDependencyGraph(const DependencyGraph *pDependencyGraph) {mpDependencyGraph = pDependencyGraph;}
+private:
+  QList<OMEquation*> mEquations;
+  const DependencyGraph *mpDependencyGraph;
+  QVector<int> mTopLevelEquations;
+  QVector<int> mChildrenOffsets;
+  QVector<int> mChildren;
+  QVector<int> mParents;
+  QVector<int> mRows;
+  int mSortColumn;
+  Qt::SortOrder mSortOrder;
+
+  void updateRows();
+};
+
+class EquationTreeView : public QTreeView
+{
+  Q_OBJECT
+public:
+  EquationTreeView(TransformationsWidget *pTransformationsWidget);
+private:
+  TransformationsWidget *mpTransformationsWidget;
+};
+
+/*!
+ * \class ProfilingPlotWidget
+ * \brief Plots the time spent in a profile block in each step.
+ */
+class ProfilingPlotWidget : public QWidget
+{
+  Q_OBJECT
+public:
+  ProfilingPlotWidget(QWidget *pParent = 0);
+  void setData(const QVector<double> &times, const QVector<double> &values);
+  void clear();
+private:
+  OMPlot::PlotWindow *mpPlotWindow;
+  QwtPlotCurve *mpPlotCurve;
+};
+
 class InfoBar;
 class TransformationsEditor;
 class TransformationsWidget : public QWidget
@@ -160,7 +249,7 @@ class TransformationsWidget : public QWidget
 public:
   TransformationsWidget(QString infoJSONFullFileName, QWidget *pParent = 0);
   MyHandler* getInfoXMLFileHandler() {return mpInfoXMLFileHandler;}
-  QTreeWidget* getEquationsTreeWidget() {return mpEquationsTreeWidget;}
+  EquationTreeView* getEquationsTreeView() {return mpEquationsTreeView;}
   InfoBar* getTSourceEditorInfoBar() {return mpTSourceEditorInfoBar;}
   QSplitter* getVariablesNestedHorizontalSplitter() {return mpVariablesNestedHorizontalSplitter;}
   QSplitter* getVariablesNestedVerticalSplitter() {return mpVariablesNestedVerticalSplitter;}
@@ -171,32 +260,43 @@ public:
   QSplitter* getTransformationsVerticalSplitter() {return mpTransformationsVerticalSplitter;}
   QSplitter* getTransformationsHorizontalSplitter() {return mpTransformationsHorizontalSplitter;}
   void loadTransformations();
-  void fetchDefinedInEquations(const OMVariable &variable);
-  void fetchUsedInEquations(const OMVariable &variable);
+  void fetchDefinedInEquations(int variable);
+  void fetchUsedInEquations(int variable);
   void fetchOperations(const OMVariable &variable);
   void fetchEquations();
-  void fetchNestedEquations(QTreeWidgetItem *pParentTreeWidgetItem, int index);
-  QTreeWidgetItem* findEquationTreeItem(int equationIndex);
+  void selectEquation(int equationIndex);
   void fetchEquationData(int equationIndex);
   void fetchDefines(OMEquation *equation);
   void fetchDepends(OMEquation *equation);
   void fetchOperations(OMEquation *equation);
+  void fetchProfilingData(OMEquation *equation);
+  void fetchCostliestEquations();
   void clearTreeWidgetItems(QTreeWidget *pTreeWidget);
 private:
-  QString mInfoJSONFullFileName, mProfJSONFullFileName, mProfilingDataRealFileName;
+  QString mInfoJSONFullFileName, mProfJSONFullFileName, mProfilingDataRealFileName, mProfilingDataIntFileName;
   int profilingNumSteps;
+  ProfilingData mProfilingData;
+  int mProfilingFunctionsCount;
+  QVector<int> mProfileBlockEquations;
   MyHandler *mpInfoXMLFileHandler;
   TreeSearchFilters *mpTreeSearchFilters;
   TVariablesTreeView *mpTVariablesTreeView;
   TVariablesTreeModel *mpTVariablesTreeModel;
   TVariableTreeProxyModel *mpTVariableTreeProxyModel;
+  Label *mpDefinedInLabel;
   EquationTreeWidget *mpDefinedInEquationsTreeWidget;
+  QCheckBox *mpInfluencingEquationsCheckBox;
   EquationTreeWidget *mpUsedInEquationsTreeWidget;
   QTreeWidget *mpVariableOperationsTreeWidget;
-  EquationTreeWidget *mpEquationsTreeWidget;
+  EquationTreeView *mpEquationsTreeView;
+  EquationTreeModel *mpEquationTreeModel;
   QTreeWidget *mpDefinesVariableTreeWidget;
   QTreeWidget *mpDependsVariableTreeWidget;
   QTreeWidget *mpEquationOperationsTreeWidget;
+  QFrame *mpProfilingFrame;
+  ProfilingPlotWidget *mpProfilingPlotWidget;
+  Label *mpProfilingStatisticsLabel;
+  EquationTreeWidget *mpCostliestEquationsTreeWidget;
   Label *mpTSourceEditorFileLabel;
   InfoBar *mpTSourceEditorInfoBar;
   TransformationsEditor *mpTransformationsEditor;
@@ -210,15 +310,18 @@ private:
   QSplitter *mpTransformationsHorizontalSplitter;
   QHash<QString,OMVariable> mVariables;
   QList<OMEquation*> mEquations;
+  DependencyGraph mDependencyGraph;
+  int mCurrentVariable;
   bool hasOperationsEnabled;
 
   void parseProfiling(QString fileName);
-  QTreeWidgetItem* makeEquationTreeWidgetItem(int equationIndex, int allowChild);
 public slots:
   void reloadTransformations();
   void findVariables();
   void fetchVariableData(const QModelIndex &index);
+  void showInfluencingEquations(bool show);
   void fetchEquationData(QTreeWidgetItem *pEquationTreeItem, int column);
+  void fetchEquationData(const QModelIndex &index);
 };
 
 #endif // TRANSFORMATIONSWIDGET_H
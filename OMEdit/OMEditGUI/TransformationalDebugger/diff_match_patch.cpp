@@ -170,6 +170,7 @@ QString Patch::toString() {
 diff_match_patch::diff_match_patch() :
   Diff_Timeout(1.0f),
   Diff_EditCost(4),
+  Diff_TokenMode(false),
   Match_Threshold(0.5f),
   Match_Distance(1000),
   Patch_DeleteThreshold(0.5f),
@@ -311,8 +312,9 @@ QList<Diff> diff_match_patch::diff_compute(QString text1, QString text2,
 
 QList<Diff> diff_match_patch::diff_lineMode(QString text1, QString text2,
     clock_t deadline) {
-  // Scan the text on a line-by-line basis first.
-  const QList<QVariant> b = diff_linesToChars(text1, text2);
+  // Scan the text on a line-by-line or token-by-token basis first.
+  const QList<QVariant> b = Diff_TokenMode ? diff_tokensToChars(text1, text2)
+                                           : diff_linesToChars(text1, text2);
   text1 = b[0].toString();
   text2 = b[1].toString();
   QStringList linearray = b[2].toStringList();
@@ -377,6 +379,9 @@ QList<Diff> diff_match_patch::diff_bisect(const QString &text1,
   // Cache the text lengths to prevent multiple calls.
   const int text1_length = text1.length();
   const int text2_length = text2.length();
+  // Compare the 16-bit code units directly.
+  const QChar *chars1 = text1.unicode();
+  const QChar *chars2 = text2.unicode();
   const int max_d = (text1_length + text2_length + 1) / 2;
   const int v_offset = max_d;
   const int v_length = 2 * max_d;
@@ -415,7 +420,7 @@ QList<Diff> diff_match_patch::diff_bisect(const QString &text1,
       }
       int y1 = x1 - k1;
       while (x1 < text1_length && y1 < text2_length
-          && text1[x1] == text2[y1]) {
+          && chars1[x1] == chars2[y1]) {
         x1++;
         y1++;
       }
@@ -452,7 +457,7 @@ QList<Diff> diff_match_patch::diff_bisect(const QString &text1,
       }
       int y2 = x2 - k2;
       while (x2 < text1_length && y2 < text2_length
-          && text1[text1_length - x2 - 1] == text2[text2_length - y2 - 1]) {
+          && chars1[text1_length - x2 - 1] == chars2[text2_length - y2 - 1]) {
         x2++;
         y2++;
       }
@@ -557,6 +562,67 @@ QString diff_match_patch::diff_linesToCharsMunge(const QString &text,
 
 
 
+QList<QVariant> diff_match_patch::diff_tokensToChars(const QString &text1,
+                                                     const QString &text2) {
+  QStringList tokenArray;
+  QHash<QString, int> tokenHash;
+  // "\x00" is a valid character, but various debuggers don't like it.
+  // So we'll insert a junk entry to avoid generating a null character.
+  tokenArray.append("");
+
+  const QString chars1 = diff_tokensToCharsMunge(text1, tokenArray, tokenHash);
+  const QString chars2 = diff_tokensToCharsMunge(text2, tokenArray, tokenHash);
+
+  QList<QVariant> listRet;
+  listRet.append(QVariant::fromValue(chars1));
+  listRet.append(QVariant::fromValue(chars2));
+  listRet.append(QVariant::fromValue(tokenArray));
+  return listRet;
+}
+
+
+QString diff_match_patch::diff_tokensToCharsMunge(const QString &text,
+                                                  QStringList &tokenArray,
+                                                  QHash<QString, int> &tokenHash) {
+  const QChar *chars = text.unicode();
+  const int text_length = text.length();
+  int tokenStart = 0;
+  QString encoded;
+  encoded.reserve(text_length / 2);
+  while (tokenStart < text_length) {
+    int tokenEnd = tokenStart + 1;
+    const QChar c = chars[tokenStart];
+    if (tokenArray.size() >= 0xFFFE) {
+      // No more characters to encode, the rest of the text is one token.
+      tokenEnd = text_length;
+    } else if (c.isLetterOrNumber() || c == '_' || c == '.' || c == '$') {
+      while (tokenEnd < text_length && (chars[tokenEnd].isLetterOrNumber()
+          || chars[tokenEnd] == '_' || chars[tokenEnd] == '.'
+          || chars[tokenEnd] == '$')) {
+        tokenEnd++;
+      }
+    } else if (c.isSpace()) {
+      while (tokenEnd < text_length && chars[tokenEnd].isSpace()) {
+        tokenEnd++;
+      }
+    }
+    const QString token = text.mid(tokenStart, tokenEnd - tokenStart);
+    tokenStart = tokenEnd;
+
+    QHash<QString, int>::const_iterator it = tokenHash.constFind(token);
+    if (it != tokenHash.constEnd()) {
+      encoded += QChar(static_cast<ushort>(it.value()));
+    } else {
+      tokenArray.append(token);
+      tokenHash.insert(token, tokenArray.size() - 1);
+      encoded += QChar(static_cast<ushort>(tokenArray.size() - 1));
+    }
+  }
+  return encoded;
+}
+
+
+
 void diff_match_patch::diff_charsToLines(QList<Diff> &diffs,
                                          const QStringList &lineArray) {
   // Qt has no mutable foreach construct.
@@ -574,8 +640,22 @@ void diff_match_patch::diff_charsToLines(QList<Diff> &diffs,
 
 int diff_match_patch::diff_commonPrefix(const QString &text1,
                                         const QString &text2) {
+  return diff_commonPrefix(text1.unicode(), text1.length(),
+                           text2.unicode(), text2.length());
+}
+
+
+int diff_match_patch::diff_commonSuffix(const QString &text1,
+                                        const QString &text2) {
+  return diff_commonSuffix(text1.unicode(), text1.length(),
+                           text2.unicode(), text2.length());
+}
+
+
+int diff_match_patch::diff_commonPrefix(const QChar *text1, int text1_length,
+                                        const QChar *text2, int text2_length) {
   // Performance analysis: http://neil.fraser.name/news/2007/10/09/
-  const int n = std::min(text1.length(), text2.length());
+  const int n = std::min(text1_length, text2_length);
   for (int i = 0; i < n; i++) {
     if (text1[i] != text2[i]) {
       return i;
@@ -585,11 +665,9 @@ int diff_match_patch::diff_commonPrefix(const QString &text1,
 }
 
 
-int diff_match_patch::diff_commonSuffix(const QString &text1,
-                                        const QString &text2) {
+int diff_match_patch::diff_commonSuffix(const QChar *text1, int text1_length,
+                                        const QChar *text2, int text2_length) {
   // Performance analysis: http://neil.fraser.name/news/2007/10/09/
-  const int text1_length = text1.length();
-  const int text2_length = text2.length();
   const int n = std::min(text1_length, text2_length);
   for (int i = 1; i <= n; i++) {
     if (text1[text1_length - i] != text2[text2_length - i]) {
@@ -687,28 +765,34 @@ QStringList diff_match_patch::diff_halfMatchI(const QString &longtext,
                                               int i) {
   // Start with a 1/4 length substring at position i as a seed.
   const QString seed = safeMid(longtext, i, longtext.length() / 4);
+  // Compare the texts in place and only copy the best match at the end.
+  const QChar *longchars = longtext.unicode();
+  const QChar *shortchars = shorttext.unicode();
+  const int longtext_length = longtext.length();
+  const int shorttext_length = shorttext.length();
   int j = -1;
-  QString best_common;
-  QString best_longtext_a, best_longtext_b;
-  QString best_shorttext_a, best_shorttext_b;
+  int best_common_length = 0;
+  int best_j = 0;
+  int best_prefix_length = 0;
+  int best_suffix_length = 0;
   while ((j = shorttext.indexOf(seed, j + 1)) != -1) {
-    const int prefixLength = diff_commonPrefix(safeMid(longtext, i),
-        safeMid(shorttext, j));
-    const int suffixLength = diff_commonSuffix(longtext.left(i),
-        shorttext.left(j));
-    if (best_common.length() < suffixLength + prefixLength) {
-      best_common = safeMid(shorttext, j - suffixLength, suffixLength)
-          + safeMid(shorttext, j, prefixLength);
-      best_longtext_a = longtext.left(i - suffixLength);
-      best_longtext_b = safeMid(longtext, i + prefixLength);
-      best_shorttext_a = shorttext.left(j - suffixLength);
-      best_shorttext_b = safeMid(shorttext, j + prefixLength);
+    const int prefixLength = diff_commonPrefix(longchars + i,
+        longtext_length - i, shortchars + j, shorttext_length - j);
+    const int suffixLength = diff_commonSuffix(longchars, i, shortchars, j);
+    if (best_common_length < suffixLength + prefixLength) {
+      best_common_length = suffixLength + prefixLength;
+      best_j = j;
+      best_prefix_length = prefixLength;
+      best_suffix_length = suffixLength;
     }
   }
-  if (best_common.length() * 2 >= longtext.length()) {
+  if (best_common_length * 2 >= longtext_length) {
     QStringList listRet;
-    listRet << best_longtext_a << best_longtext_b << best_shorttext_a
-        << best_shorttext_b << best_common;
+    listRet << longtext.left(i - best_suffix_length)
+        << safeMid(longtext, i + best_prefix_length)
+        << shorttext.left(best_j - best_suffix_length)
+        << safeMid(shorttext, best_j + best_prefix_length)
+        << safeMid(shorttext, best_j - best_suffix_length, best_common_length);
     return listRet;
   } else {
     return QStringList();
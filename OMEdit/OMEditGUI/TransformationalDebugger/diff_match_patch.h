@@ -140,6 +140,9 @@ class diff_match_patch {
   float Diff_Timeout;
   // Cost of an empty edit operation in terms of edit characters.
   short Diff_EditCost;
+  // Split the texts in tokens instead of lines for the speedup of the
+  // checklines diff.  Better for long texts with few lines e.g. equations.
+  bool Diff_TokenMode;
   // At what point is no match declared (0.0 = perfection, 1.0 = very loose).
   float Match_Threshold;
   // How far to search for a match (0 = exact location, 1000+ = broad match).
@@ -223,7 +226,7 @@ class diff_match_patch {
 
   /**
    * Do a quick line-level diff on both strings, then rediff the parts for
-   * greater accuracy.
+   * greater accuracy.  The diff is token-level if Diff_TokenMode is set.
    * This speedup can produce non-minimal diffs.
    * @param text1 Old string to be diffed.
    * @param text2 New string to be diffed.
@@ -281,6 +284,32 @@ class diff_match_patch {
   QString diff_linesToCharsMunge(const QString &text, QStringList &lineArray,
                                  QMap<QString, int> &lineHash);
 
+  /**
+   * Split two texts into a list of tokens.  Reduce the texts to a string of
+   * hashes where each Unicode character represents one token.  A token is a
+   * run of letters, digits, '_', '.' and '$', a run of whitespace or any
+   * other single character.
+   * @param text1 First string.
+   * @param text2 Second string.
+   * @return Three element Object array, containing the encoded text1, the
+   *     encoded text2 and the List of unique strings.  The zeroth element
+   *     of the List of unique strings is intentionally blank.
+   */
+ protected:
+  QList<QVariant> diff_tokensToChars(const QString &text1, const QString &text2);
+
+  /**
+   * Split a text into a list of tokens.  Reduce the texts to a string of
+   * hashes where each Unicode character represents one token.
+   * @param text String to encode.
+   * @param tokenArray List of unique strings.
+   * @param tokenHash Map of strings to indices.
+   * @return Encoded string.
+   */
+ private:
+  QString diff_tokensToCharsMunge(const QString &text, QStringList &tokenArray,
+                                  QHash<QString, int> &tokenHash);
+
   /**
    * Rehydrate the text in a diff from a string of line hashes to real lines of
    * text.
@@ -308,6 +337,23 @@ class diff_match_patch {
  public:
   int diff_commonSuffix(const QString &text1, const QString &text2);
 
+  /**
+   * Determine the common prefix and suffix of two character arrays.
+   * Compares the 16-bit code units in place so the callers don't need to
+   * copy substrings.
+   * @param text1 First character array.
+   * @param text1_length Length of the first array.
+   * @param text2 Second character array.
+   * @param text2_length Length of the second array.
+   * @return The number of characters common to the start or to the end of
+   *     each array.
+   */
+ private:
+  static int diff_commonPrefix(const QChar *text1, int text1_length,
+                               const QChar *text2, int text2_length);
+  static int diff_commonSuffix(const QChar *text1, int text1_length,
+                               const QChar *text2, int text2_length);
+
   /**
    * Determine if the suffix of one string is the prefix of another.
    * @param text1 First string.
@@ -60,6 +60,10 @@ TreeSearchFilters::TreeSearchFilters(QWidget *pParent)
   // create the filter text box
   mpFilterTextBox = new QLineEdit;
   mpFilterTextBox->installEventFilter(this);
+  // the search timer is restarted on every edit so a search connected to it is only done once the typing stops.
+  mSearchTimer.setSingleShot(true);
+  mSearchTimer.setInterval(250);
+  connect(mpFilterTextBox, SIGNAL(textEdited(QString)), &mSearchTimer, SLOT(start()));
   // show hide button
   mpShowHideButton = new QToolButton;
   QString text = tr("Show/hide filters");
@@ -81,6 +85,10 @@ TreeSearchFilters::TreeSearchFilters(QWidget *pParent)
   mpSyntaxComboBox->setItemData(1, tr("A simple pattern matching syntax similar to that used by shells (command interpreters) for \"file globbing\"."), Qt::ToolTipRole);
   mpSyntaxComboBox->addItem(tr("Fixed String"), QRegExp::FixedString);
   mpSyntaxComboBox->setItemData(2, tr("Fixed string matching."), Qt::ToolTipRole);
+  // create the search in text checkbox. Only used by the Libraries Browser so hidden by default.
+  mpSearchInTextCheckBox = new QCheckBox(tr("Search in Text"));
+  mpSearchInTextCheckBox->setToolTip(tr("Searches in the text of the classes instead of their names."));
+  mpSearchInTextCheckBox->hide();
   // expand all button
   mpExpandAllButton = new QPushButton(Helper::expandAll);
   mpExpandAllButton->setAutoDefault(false);
@@ -95,6 +103,7 @@ TreeSearchFilters::TreeSearchFilters(QWidget *pParent)
   pFiltersWidgetLayout->addWidget(mpSyntaxComboBox, 0, 1);
   pFiltersWidgetLayout->addWidget(mpExpandAllButton, 1, 0);
   pFiltersWidgetLayout->addWidget(mpCollapseAllButton, 1, 1);
+  pFiltersWidgetLayout->addWidget(mpSearchInTextCheckBox, 2, 0, 1, 2);
   mpFiltersWidget->setLayout(pFiltersWidgetLayout);
   mpFiltersWidget->hide();
   // create the layout
@@ -525,7 +534,8 @@ QFrame* Utilities::getHeadingLine()
 
 /*!
  * \brief Utilities::detectBOM
- * Detects if the file has byte order mark (BOM) or not.
+ * Detects if the file has byte order mark (BOM) or not.\n
+ * Only reads the first bytes of the file. Can be called from any thread.
  * \param fileName
  * \return
  */
@@ -534,16 +544,11 @@ bool Utilities::detectBOM(QString fileName)
   QFile file(fileName);
   if (file.exists()) {
     if (file.open(QIODevice::ReadOnly)) {
-      QByteArray data = file.readAll();
+      QByteArray data = file.read(3);
       const int bytesRead = data.size();
       const unsigned char *buf = reinterpret_cast<const unsigned char *>(data.constData());
       // code taken from qtextstream
-      if (bytesRead >= 3 && ((buf[0] == 0xef && buf[1] == 0xbb) && buf[2] == 0xbf)) {
-        return true;
-      } else {
-        return false;
-      }
-      file.close();
+      return bytesRead >= 3 && ((buf[0] == 0xef && buf[1] == 0xbb) && buf[2] == 0xbf);
     } else {
       qDebug() << QString("Failed to detect byte order mark. Unable to open file %1.").arg(fileName);
     }
@@ -36,6 +36,7 @@
 #include <QMdiArea>
 #include <QLineEdit>
 #include <QThread>
+#include <QTimer>
 #include <QToolButton>
 #include <QComboBox>
 #include <QPushButton>
@@ -97,8 +98,10 @@ public:
   QLineEdit* getFilterTextBox() {return mpFilterTextBox;}
   QComboBox* getSyntaxComboBox() {return mpSyntaxComboBox;}
   QCheckBox* getCaseSensitiveCheckBox() {return mpCaseSensitiveCheckBox;}
+  QCheckBox* getSearchInTextCheckBox() {return mpSearchInTextCheckBox;}
   QPushButton* getExpandAllButton() {return mpExpandAllButton;}
   QPushButton* getCollapseAllButton() {return mpCollapseAllButton;}
+  QTimer* getSearchTimer() {return &mSearchTimer;}
 
   bool eventFilter(QObject *pObject, QEvent *pEvent);
 private:
@@ -107,8 +110,10 @@ private:
   QWidget *mpFiltersWidget;
   QComboBox *mpSyntaxComboBox;
   QCheckBox *mpCaseSensitiveCheckBox;
+  QCheckBox *mpSearchInTextCheckBox;
   QPushButton *mpExpandAllButton;
   QPushButton *mpCollapseAllButton;
+  QTimer mSearchTimer;
 private slots:
   void showHideFilters(bool On);
 };
@@ -0,0 +1,325 @@
+/* This file is part of QJson
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License version 2.1, as published by the Free Software Foundation.
+ *
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "streamreader.h"
+#include "json_parser.hh"
+#include "json_scanner.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QVector>
+#include <QtCore/QDebug>
+
+using namespace QJson;
+
+typedef yy::json_parser::token token;
+
+namespace QJson {
+
+  class StreamReaderPrivate
+  {
+    public:
+      enum State {
+        ExpectValue,
+        ExpectValueOrArrayEnd,
+        ExpectKey,
+        ExpectKeyOrObjectEnd,
+        ExpectColon,
+        ExpectCommaOrObjectEnd,
+        ExpectCommaOrArrayEnd,
+        ExpectEnd
+      };
+
+      StreamReaderPrivate();
+
+      void reset();
+      void setError(const QString& errorMsg, int line);
+      bool read(JSonScanner* scanner, StreamHandler* handler);
+
+      bool m_error;
+      int m_errorLine;
+      QString m_errorMsg;
+      bool m_specialNumbersAllowed;
+  };
+}
+
+StreamReaderPrivate::StreamReaderPrivate()
+{
+  m_specialNumbersAllowed = false;
+  reset();
+}
+
+void StreamReaderPrivate::reset()
+{
+  m_error = false;
+  m_errorLine = 0;
+  m_errorMsg.clear();
+}
+
+void StreamReaderPrivate::setError(const QString& errorMsg, int errorLine)
+{
+  m_error = true;
+  m_errorMsg = errorMsg;
+  m_errorLine = errorLine;
+}
+
+static QString tokenName(int tokenType)
+{
+  switch (tokenType) {
+    case token::END: return QLatin1String("end of file");
+    case token::CURLY_BRACKET_OPEN: return QLatin1String("{");
+    case token::CURLY_BRACKET_CLOSE: return QLatin1String("}");
+    case token::SQUARE_BRACKET_OPEN: return QLatin1String("[");
+    case token::SQUARE_BRACKET_CLOSE: return QLatin1String("]");
+    case token::COLON: return QLatin1String(":");
+    case token::COMMA: return QLatin1String(",");
+    case token::NUMBER: return QLatin1String("number");
+    case token::TRUE_VAL: return QLatin1String("true");
+    case token::FALSE_VAL: return QLatin1String("false");
+    case token::NULL_VAL: return QLatin1String("null");
+    case token::STRING: return QLatin1String("string");
+    default: return QLatin1String("invalid");
+  }
+}
+
+/*
+ * Reads the tokens one by one and checks them against the JSON grammar with
+ * a stack of the open containers instead of building the values.
+ */
+bool StreamReaderPrivate::read(JSonScanner* scanner, StreamHandler* handler)
+{
+  QVector<char> containers;
+  State state = ExpectValue;
+  yy::location location;
+  QVariant value;
+
+  for (;;) {
+    value.clear();
+    int tokenType = scanner->yylex(&value, &location);
+    if (tokenType < 0) {
+      setError(QLatin1String("error while reading from io device"), location.end.line);
+      return false;
+    }
+
+    bool accepted = true;
+    bool valueEnded = false;
+    switch (state) {
+      case ExpectValue:
+      case ExpectValueOrArrayEnd:
+        if (tokenType == token::CURLY_BRACKET_OPEN) {
+          containers.append('{');
+          accepted = handler->startObject();
+          state = ExpectKeyOrObjectEnd;
+        } else if (tokenType == token::SQUARE_BRACKET_OPEN) {
+          containers.append('[');
+          accepted = handler->startArray();
+          state = ExpectValueOrArrayEnd;
+        } else if (tokenType == token::STRING || tokenType == token::NUMBER || tokenType == token::TRUE_VAL ||
+                   tokenType == token::FALSE_VAL || tokenType == token::NULL_VAL) {
+          accepted = handler->value(value);
+          valueEnded = true;
+        } else if (tokenType == token::SQUARE_BRACKET_CLOSE && state == ExpectValueOrArrayEnd) {
+          containers.resize(containers.size() - 1);
+          accepted = handler->endArray();
+          valueEnded = true;
+        } else {
+          setError(QLatin1String("syntax error, unexpected ") + tokenName(tokenType) + QLatin1String(", expecting value"),
+                   location.end.line);
+          return false;
+        }
+        break;
+      case ExpectKey:
+      case ExpectKeyOrObjectEnd:
+        if (tokenType == token::STRING) {
+          accepted = handler->key(value.toString());
+          state = ExpectColon;
+        } else if (tokenType == token::CURLY_BRACKET_CLOSE && state == ExpectKeyOrObjectEnd) {
+          containers.resize(containers.size() - 1);
+          accepted = handler->endObject();
+          valueEnded = true;
+        } else {
+          setError(QLatin1String("syntax error, unexpected ") + tokenName(tokenType) + QLatin1String(", expecting string"),
+                   location.end.line);
+          return false;
+        }
+        break;
+      case ExpectColon:
+        if (tokenType != token::COLON) {
+          setError(QLatin1String("syntax error, unexpected ") + tokenName(tokenType) + QLatin1String(", expecting :"),
+                   location.end.line);
+          return false;
+        }
+        state = ExpectValue;
+        break;
+      case ExpectCommaOrObjectEnd:
+        if (tokenType == token::COMMA) {
+          state = ExpectKey;
+        } else if (tokenType == token::CURLY_BRACKET_CLOSE) {
+          containers.resize(containers.size() - 1);
+          accepted = handler->endObject();
+          valueEnded = true;
+        } else {
+          setError(QLatin1String("syntax error, unexpected ") + tokenName(tokenType) + QLatin1String(", expecting , or }"),
+                   location.end.line);
+          return false;
+        }
+        break;
+      case ExpectCommaOrArrayEnd:
+        if (tokenType == token::COMMA) {
+          state = ExpectValue;
+        } else if (tokenType == token::SQUARE_BRACKET_CLOSE) {
+          containers.resize(containers.size() - 1);
+          accepted = handler->endArray();
+          valueEnded = true;
+        } else {
+          setError(QLatin1String("syntax error, unexpected ") + tokenName(tokenType) + QLatin1String(", expecting , or ]"),
+                   location.end.line);
+          return false;
+        }
+        break;
+      case ExpectEnd:
+        if (tokenType == token::END) {
+          return true;
+        }
+        setError(QLatin1String("syntax error, unexpected ") + tokenName(tokenType) + QLatin1String(", expecting end of file"),
+                 location.end.line);
+        return false;
+    }
+
+    if (!accepted) {
+      setError(QLatin1String("parsing stopped by the handler"), location.end.line);
+      return false;
+    }
+    if (valueEnded) {
+      if (containers.isEmpty()) {
+        state = ExpectEnd;
+      } else if (containers.last() == '{') {
+        state = ExpectCommaOrObjectEnd;
+      } else {
+        state = ExpectCommaOrArrayEnd;
+      }
+    }
+  }
+}
+
+StreamHandler::~StreamHandler()
+{
+}
+
+bool StreamHandler::startObject()
+{
+  return true;
+}
+
+bool StreamHandler::key(const QString& key)
+{
+  Q_UNUSED(key);
+  return true;
+}
+
+bool StreamHandler::endObject()
+{
+  return true;
+}
+
+bool StreamHandler::startArray()
+{
+  return true;
+}
+
+bool StreamHandler::endArray()
+{
+  return true;
+}
+
+bool StreamHandler::value(const QVariant& value)
+{
+  Q_UNUSED(value);
+  return true;
+}
+
+StreamReader::StreamReader() :
+    d(new StreamReaderPrivate)
+{
+}
+
+StreamReader::~StreamReader()
+{
+  delete d;
+}
+
+bool StreamReader::parse(QIODevice* io, StreamHandler* handler)
+{
+  d->reset();
+
+  if (!io->isOpen()) {
+    if (!io->open(QIODevice::ReadOnly)) {
+      qCritical ("Error opening device");
+      d->setError(QLatin1String("Error opening device"), 0);
+      return false;
+    }
+  }
+
+  if (!io->isReadable()) {
+    qCritical ("Device is not readable");
+    d->setError(QLatin1String("Device is not readable"), 0);
+    io->close();
+    return false;
+  }
+
+  if (io->atEnd()) {
+    d->setError(QLatin1String("No data"), 0);
+    io->close();
+    return false;
+  }
+
+  JSonScanner scanner(io);
+  scanner.allowSpecialNumbers(d->m_specialNumbersAllowed);
+  bool ok = d->read(&scanner, handler);
+
+  io->close();
+  return ok;
+}
+
+bool StreamReader::parse(const QByteArray& jsonString, StreamHandler* handler)
+{
+  QBuffer buffer;
+  buffer.open(QBuffer::ReadWrite | QBuffer::Text);
+  buffer.write(jsonString);
+  buffer.seek(0);
+  return parse(&buffer, handler);
+}
+
+QString StreamReader::errorString() const
+{
+  return d->m_errorMsg;
+}
+
+int StreamReader::errorLine() const
+{
+  return d->m_errorLine;
+}
+
+void StreamReader::allowSpecialNumbers(bool allowSpecialNumbers)
+{
+  d->m_specialNumbersAllowed = allowSpecialNumbers;
+}
+
+bool StreamReader::specialNumbersAllowed() const
+{
+  return d->m_specialNumbersAllowed;
+}
@@ -0,0 +1,146 @@
+/* This file is part of QJson
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License version 2.1, as published by the Free Software Foundation.
+ *
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef QJSON_STREAMREADER_H
+#define QJSON_STREAMREADER_H
+
+#include "qjson_export.h"
+
+QT_BEGIN_NAMESPACE
+class QByteArray;
+class QIODevice;
+class QString;
+class QVariant;
+QT_END_NAMESPACE
+
+namespace QJson {
+
+  /**
+   * @brief Receives the events of a StreamReader
+   *
+   * Reimplement the methods of the events you are interested in.
+   * Returning false from any method stops the parsing, StreamReader::parse
+   * then returns false.
+   */
+  class QJSON_EXPORT StreamHandler
+  {
+    public:
+      virtual ~StreamHandler();
+
+      /**
+      * Called when an object starts
+      */
+      virtual bool startObject();
+
+      /**
+      * Called for each key of an object, before the value of the key
+      * @param key the object key
+      */
+      virtual bool key(const QString& key);
+
+      /**
+      * Called when an object ends
+      */
+      virtual bool endObject();
+
+      /**
+      * Called when an array starts
+      */
+      virtual bool startArray();
+
+      /**
+      * Called when an array ends
+      */
+      virtual bool endArray();
+
+      /**
+      * Called for each scalar value i.e., a string, a number, true, false or null.
+      * @param value the scalar value, an invalid QVariant for null
+      */
+      virtual bool value(const QVariant& value);
+  };
+
+  class StreamReaderPrivate;
+
+  /**
+   * @brief Event driven JSON reader
+   *
+   * Unlike Parser, StreamReader doesn't build a QVariant of the whole document.
+   * The tokens are read from the I/O device and reported to a StreamHandler as
+   * soon as they are read, so the memory used doesn't depend on the size of
+   * the document.
+   */
+  class QJSON_EXPORT StreamReader
+  {
+    public:
+      StreamReader();
+      ~StreamReader();
+
+      /**
+      * Reads the JSON data from the I/O Device and reports it to the handler
+      * @param io Input output device
+      * @param handler the handler receiving the events
+      * @returns true if the whole document has been read, false on a syntax error
+      * or if the handler has stopped the parsing
+      * @sa errorString
+      * @sa errorLine
+      */
+      bool parse(QIODevice* io, StreamHandler* handler);
+
+      /**
+      * This is a method provided for convenience.
+      * @param jsonData data containing the JSON object representation
+      * @param handler the handler receiving the events
+      */
+      bool parse(const QByteArray& jsonData, StreamHandler* handler);
+
+      /**
+      * This method returns the error message
+      * @returns a QString object containing the error message of the last parse operation
+      * @sa errorLine
+      */
+      QString errorString() const;
+
+      /**
+      * This method returns line number where the error occurred
+      * @returns the line number where the error occurred
+      * @sa errorString
+      */
+      int errorLine() const;
+
+      /**
+       * Sets whether special numbers (Infinity, -Infinity, NaN) are allowed as an extension to
+       * the standard
+       * @param  allowSpecialNumbers new value of whether special numbers are allowed
+       * @sa specialNumbersAllowed
+       */
+      void allowSpecialNumbers(bool allowSpecialNumbers);
+
+      /**
+       * @returns whether special numbers (Infinity, -Infinity, NaN) are allowed
+       * @sa allowSpecialNumbers
+       */
+      bool specialNumbersAllowed() const;
+
+    private:
+      Q_DISABLE_COPY(StreamReader)
+      StreamReaderPrivate* const d;
+  };
+}
+
+#endif // QJSON_STREAMREADER_H
@@ -0,0 +1,98 @@
+/* This file is part of QJson
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License version 2.1, as published by the Free Software Foundation.
+ *
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <QJson/Parser>
+#include <QJson/StreamReader>
+#include <QtTest/QTest>
+#include <QTemporaryFile>
+
+/* Counts the events so that the reader can't skip anything */
+class CountingHandler : public QJson::StreamHandler {
+    public:
+        CountingHandler() : count(0) {}
+        bool startObject() { ++count; return true; }
+        bool key(const QString&) { ++count; return true; }
+        bool startArray() { ++count; return true; }
+        bool value(const QVariant&) { ++count; return true; }
+
+        qint64 count;
+};
+
+/*
+ * Compares Parser and StreamReader on a generated document shaped like the
+ * transformational debugger info files. The size of the document in megabytes
+ * is read from the QJSON_BENCHMARK_SIZE_MB environment variable, e.g.,
+ * QJSON_BENCHMARK_SIZE_MB=1024 for a 1 GB file.
+ */
+class StreamReaderBenchmark: public QObject {
+    Q_OBJECT
+    private Q_SLOTS:
+        void initTestCase();
+        void parser();
+        void streamReader();
+
+    private:
+        QTemporaryFile m_file;
+};
+
+void StreamReaderBenchmark::initTestCase() {
+    qint64 sizeMB = qgetenv("QJSON_BENCHMARK_SIZE_MB").toLongLong();
+    if (sizeMB <= 0) {
+        sizeMB = 4;
+    }
+    const qint64 size = sizeMB * 1024 * 1024;
+
+    QVERIFY(m_file.open());
+    m_file.write("{\"format\":\"Transformational debugger info\",\"version\":1,\n\"equations\":[{\"eqIndex\":0,\"tag\":\"dummy\"}");
+    for (qint64 i = 1; m_file.size() < size; ++i) {
+        const QByteArray index = QByteArray::number(i);
+        m_file.write(",\n{\"eqIndex\":" + index + ",\"section\":\"regular\",\"tag\":\"assign\","
+                     "\"defines\":[\"x" + index + "\"],\"uses\":[\"x" + QByteArray::number(i - 1) + "\",\"time\"],"
+                     "\"equation\":[\"2.5 * x" + index + " + sin(time)\"],"
+                     "\"source\":{\"info\":{\"file\":\"Model.mo\",\"lineStart\":" + index + ",\"lineEnd\":" + index +
+                     ",\"colStart\":3,\"colEnd\":42}}}");
+    }
+    m_file.write("]}\n");
+    m_file.close();
+}
+
+void StreamReaderBenchmark::parser() {
+    QJson::Parser parser;
+    bool ok = true;
+    QBENCHMARK_ONCE {
+        QVariant result = parser.parse(&m_file, &ok);
+        Q_UNUSED(result);
+    }
+    QVERIFY(ok);
+}
+
+void StreamReaderBenchmark::streamReader() {
+    QJson::StreamReader reader;
+    CountingHandler handler;
+    bool ok = true;
+    QBENCHMARK_ONCE {
+        ok = reader.parse(&m_file, &handler);
+    }
+    QVERIFY(ok);
+    QVERIFY(handler.count > 0);
+}
+
+
+QTEST_MAIN(StreamReaderBenchmark)
+
+#include "streamreaderbenchmark.moc"
@@ -0,0 +1,195 @@
+/* This file is part of QJson
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License version 2.1, as published by the Free Software Foundation.
+ *
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <QtCore/QVariant>
+
+#include <QtTest/QtTest>
+
+#include <QJson/Parser>
+#include <QJson/StreamReader>
+
+using namespace QJson;
+
+/* Records the events as a string e.g., {foo:"bar",[1,2]} */
+class RecordingHandler : public StreamHandler
+{
+  public:
+    bool startObject() { m_events += QLatin1String("{"); return true; }
+    bool key(const QString& key) {
+      m_events += key + QLatin1String(":");
+      return key != m_stopAtKey;
+    }
+    bool endObject() { m_events += QLatin1String("}"); return true; }
+    bool startArray() { m_events += QLatin1String("["); return true; }
+    bool endArray() { m_events += QLatin1String("]"); return true; }
+    bool value(const QVariant& value) {
+      if (value.type() == QVariant::String) {
+        m_events += QLatin1String("\"") + value.toString() + QLatin1String("\"");
+      } else if (value.isNull()) {
+        m_events += QLatin1String("null");
+      } else {
+        m_events += value.toString();
+      }
+      m_events += QLatin1String(",");
+      return true;
+    }
+
+    QString m_events;
+    QString m_stopAtKey;
+};
+
+/* Builds the QVariant of the document from the events */
+class BuildingHandler : public StreamHandler
+{
+  public:
+    bool startObject() { m_stack.append(QVariant(QVariantMap())); m_keys.append(QString()); return true; }
+    bool key(const QString& key) { m_keys.last() = key; return true; }
+    bool endObject() { m_keys.removeLast(); return addValue(m_stack.takeLast()); }
+    bool startArray() { m_stack.append(QVariant(QVariantList())); m_keys.append(QString()); return true; }
+    bool endArray() { m_keys.removeLast(); return addValue(m_stack.takeLast()); }
+    bool value(const QVariant& value) { return addValue(value); }
+
+    QVariant m_result;
+  private:
+    bool addValue(const QVariant& value) {
+      if (m_stack.isEmpty()) {
+        m_result = value;
+      } else if (m_stack.last().type() == QVariant::Map) {
+        QVariantMap map = m_stack.last().toMap();
+        map.insert(m_keys.last(), value);
+        m_stack.last() = map;
+      } else {
+        QVariantList list = m_stack.last().toList();
+        list.append(value);
+        m_stack.last() = list;
+      }
+      return true;
+    }
+
+    QList<QVariant> m_stack;
+    QStringList m_keys;
+};
+
+class TestStreamReader: public QObject
+{
+  Q_OBJECT
+  private slots:
+    void readEvents();
+    void readEvents_data();
+    void readSameAsParser();
+    void readSameAsParser_data();
+    void readInvalid();
+    void readInvalid_data();
+    void stopByHandler();
+};
+
+void TestStreamReader::readEvents()
+{
+  QFETCH(QByteArray, json);
+  QFETCH(QString, events);
+
+  StreamReader reader;
+  RecordingHandler handler;
+  QVERIFY(reader.parse(json, &handler));
+  QVERIFY(reader.errorString().isEmpty());
+  QCOMPARE(handler.m_events, events);
+}
+
+void TestStreamReader::readEvents_data()
+{
+  QTest::addColumn<QByteArray>("json");
+  QTest::addColumn<QString>("events");
+
+  QTest::newRow("empty object") << QByteArray("{}") << QString(QLatin1String("{}"));
+  QTest::newRow("empty array") << QByteArray("[ ]") << QString(QLatin1String("[]"));
+  QTest::newRow("scalar") << QByteArray("12") << QString(QLatin1String("12,"));
+  QTest::newRow("object") << QByteArray("{\"foo\": \"bar\", \"n\": null}") << QString(QLatin1String("{foo:\"bar\",n:null,}"));
+  QTest::newRow("nested") << QByteArray("{\"a\": [1, {\"b\": true}, []], \"c\": {}}")
+                          << QString(QLatin1String("{a:[1,{b:true,}[]]c:{}}"));
+}
+
+void TestStreamReader::readSameAsParser()
+{
+  QFETCH(QByteArray, json);
+
+  Parser parser;
+  bool ok;
+  QVariant expected = parser.parse(json, &ok);
+  QVERIFY(ok);
+
+  StreamReader reader;
+  BuildingHandler handler;
+  QVERIFY(reader.parse(json, &handler));
+  QCOMPARE(handler.m_result, expected);
+}
+
+void TestStreamReader::readSameAsParser_data()
+{
+  QTest::addColumn<QByteArray>("json");
+
+  QTest::newRow("info") << QByteArray("{\"format\":\"Transformational debugger info\",\"version\":1,\n"
+                                      "\"variables\":{\"x\":{\"comment\":\"\",\"source\":{\"info\":{\"file\":\"a.mo\",\"lineStart\":3}}}},\n"
+                                      "\"equations\":[{\"eqIndex\":0,\"tag\":\"dummy\"},{\"eqIndex\":1,\"section\":\"initial\",\"tag\":\"assign\","
+                                      "\"defines\":[\"x\"],\"uses\":[],\"equation\":[\"1.5e3\"]}]}");
+  QTest::newRow("numbers") << QByteArray("[0, -1, 1.25, -2e-3, 9223372036854775807]");
+  QTest::newRow("escapes") << QByteArray("{\"s\": \"a\\\"b\\n\\u00e4\"}");
+}
+
+void TestStreamReader::readInvalid()
+{
+  QFETCH(QByteArray, json);
+
+  StreamReader reader;
+  StreamHandler handler;
+  QVERIFY(!reader.parse(json, &handler));
+  QVERIFY(!reader.errorString().isEmpty());
+}
+
+void TestStreamReader::readInvalid_data()
+{
+  QTest::addColumn<QByteArray>("json");
+
+  QTest::newRow("empty") << QByteArray("");
+  QTest::newRow("unclosed object") << QByteArray("{\"foo\": 1");
+  QTest::newRow("unclosed array") << QByteArray("[1, 2");
+  QTest::newRow("missing colon") << QByteArray("{\"foo\" 1}");
+  QTest::newRow("trailing comma") << QByteArray("[1, ]");
+  QTest::newRow("number key") << QByteArray("{1: 2}");
+  QTest::newRow("mismatched") << QByteArray("[1}");
+  QTest::newRow("two values") << QByteArray("1 2");
+  QTest::newRow("invalid token") << QByteArray("[wrong]");
+}
+
+void TestStreamReader::stopByHandler()
+{
+  StreamReader reader;
+  RecordingHandler handler;
+  handler.m_stopAtKey = QLatin1String("stop");
+  QVERIFY(!reader.parse(QByteArray("{\"a\": 1, \"stop\": [1, 2, 3], \"b\": 2}"), &handler));
+  QCOMPARE(handler.m_events, QString(QLatin1String("{a:1,stop:")));
+  QVERIFY(!reader.errorString().isEmpty());
+}
+
+#if QT_VERSION < QT_VERSION_CHECK(5,0,0)
+// using Qt4 rather then Qt5
+QTEST_MAIN(TestStreamReader)
+#include "moc_teststreamreader.cxx"
+#else
+QTEST_GUILESS_MAIN(TestStreamReader)
+#include "teststreamreader.moc"
+#endif